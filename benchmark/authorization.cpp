@@ -0,0 +1,83 @@
+#include <benchmark.hpp>
+#include <eosio/chain/authorization_manager.hpp>
+#include <eosio/testing/tester.hpp>
+
+#include <iostream>
+
+using namespace eosio;
+using namespace eosio::chain;
+using namespace eosio::testing;
+
+// Benchmark the authorization check of transactions with and without the authorization caches.
+//
+// To run a benchmarking session, in the build directory, type
+//    benchmark/benchmark -f authorization
+
+namespace eosio::benchmark {
+
+namespace {
+
+constexpr uint32_t num_accounts = 100;
+constexpr uint32_t num_trxs     = 10'000;
+
+struct authorization_chain {
+   explicit authorization_chain( uint32_t cache_size ) {
+      chain = std::make_unique<tester>( tempdir, [&]( controller::config& cfg ) {
+         cfg.authorization_cache_size = cache_size;
+      }, true );
+      chain->execute_setup_policy( setup_policy::full );
+
+      const std::string letters = "abcdefghijklmnopqrstuvwxyz";
+      for( uint32_t i = 0; i < num_accounts; ++i )
+         accounts.emplace_back( "auth" + std::string{ letters[i / letters.size()], letters[i % letters.size()] } );
+      // without eosio.code the active authorities are keys only, which are the authorities cached
+      chain->create_accounts( accounts, false, false );
+      // link half of the accounts so that both outcomes of the permission link lookup are checked
+      for( uint32_t i = 0; i < num_accounts; i += 2 )
+         chain->link_authority( accounts[i], config::system_account_name, config::active_name, "reqauth"_n );
+
+      // accounts bypass the caches until their changes are irreversible
+      const uint32_t changed_block_num = chain->control->head().block_num() + 1;
+      while( chain->last_irreversible_block_num() < changed_block_num )
+         chain->produce_block();
+
+      // the same accounts authorize many transactions, as for a dapp with a large user base
+      for( uint32_t i = 0; i < num_trxs; ++i ) {
+         const account_name& from = accounts[i % num_accounts];
+         trxs.emplace_back( vector<action>{ action( vector<permission_level>{{from, config::active_name}},
+                                                    config::system_account_name, "reqauth"_n, fc::raw::pack( from ) ) },
+                            flat_set<public_key_type>{ chain->get_public_key( from, "active" ) } );
+      }
+   }
+
+   void check( uint32_t i ) const {
+      const auto& [actions, keys] = trxs[i % trxs.size()];
+      chain->control->get_authorization_manager().check_authorization( actions, keys );
+   }
+
+   fc::temp_directory                                             tempdir;
+   std::unique_ptr<tester>                                        chain;
+   vector<account_name>                                           accounts;
+   vector<std::pair<vector<action>, flat_set<public_key_type>>>   trxs;
+};
+
+} // anonymous namespace
+
+void authorization_benchmarking() {
+   // prevent logging from interwined with output benchmark results
+   fc::logger::get(DEFAULT_LOGGER).set_log_level(fc::log_level::off);
+
+   std::cout << num_trxs << " transactions of " << num_accounts << " accounts, time per transaction" << std::endl;
+
+   authorization_chain uncached( 0 );
+   uint32_t i = 0;
+   benchmarking( "check_authorization, no cache", [&]() { uncached.check( i++ ); }, num_trxs );
+
+   authorization_chain cached( config::default_authorization_cache_size );
+   i = 0;
+   benchmarking( "check_authorization, cold cache", [&]() { cached.check( i++ ); }, num_accounts );
+   i = 0;
+   benchmarking( "check_authorization, warm cache", [&]() { cached.check( i++ ); }, num_trxs );
+}
+
+} // namespace eosio::benchmark
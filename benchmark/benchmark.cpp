@@ -1,12 +1,54 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <locale>
+#include <memory>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fc/io/json.hpp>
+#include <fc/reflect/variant.hpp>
 
 #include <benchmark.hpp>
 
 namespace eosio::benchmark {
 
+// per run averages of the perf events counted in user space
+struct perf_counts {
+   uint64_t cycles = 0;
+   uint64_t instructions = 0;
+   uint64_t dtlb_misses = 0;
+   uint64_t itlb_misses = 0;
+};
+
+struct benchmark_result {
+   std::string feature;
+   std::string name;
+   uint32_t    runs = 0;
+   uint64_t    average_ns = 0;
+   uint64_t    min_ns = 0;
+   uint64_t    max_ns = 0;
+   uint64_t    p50_ns = 0;
+   uint64_t    p90_ns = 0;
+   uint64_t    p99_ns = 0;
+   double      ops_per_sec = 0;
+   std::optional<perf_counts> perf;
+};
+
+} // benchmark
+
+FC_REFLECT( eosio::benchmark::perf_counts, (cycles)(instructions)(dtlb_misses)(itlb_misses) )
+FC_REFLECT( eosio::benchmark::benchmark_result, (feature)(name)(runs)(average_ns)(min_ns)(max_ns)(p50_ns)(p90_ns)(p99_ns)(ops_per_sec)(perf) )
+
+namespace eosio::benchmark {
+
 // update this map when a new feature is supported
 // key is the name and value is the function doing benchmarking
 std::map<std::string, std::function<void()>> features {
@@ -16,7 +58,21 @@ std::map<std::string, std::function<void()>> features {
    { "hash", hash_benchmarking },
    { "blake2", blake2_benchmarking },
    { "bls", bls_benchmarking },
-   { "merkle", merkle_benchmarking }
+   { "merkle", merkle_benchmarking },
+   { "logging", logging_benchmarking },
+   { "expiry_wheel", expiry_wheel_benchmarking },
+   { "authorization", authorization_benchmarking },
+   { "block_apply", block_apply_benchmarking },
+   { "push_transaction", push_transaction_benchmarking },
+   { "db_i64", db_i64_benchmarking },
+   { "db_scan", db_scan_benchmarking },
+   { "snapshot", snapshot_benchmarking },
+   { "fork_switch", fork_switch_benchmarking },
+   { "random_access_file", random_access_file_benchmarking },
+   { "json", json_benchmarking },
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+   { "eosvmoc", eosvmoc_benchmarking },
+#endif
 };
 
 // values to control cout format
@@ -26,6 +82,82 @@ constexpr auto time_width = 12;
 constexpr auto ns_width = 2;
 
 uint32_t num_runs = 1;
+std::string current_feature;
+std::vector<benchmark_result> results;
+
+// Counts perf events of the calling thread between start() and stop(), events the cpu or kernel does not support are
+// reported as 0
+class perf_counters {
+public:
+   perf_counters() {
+#ifdef __linux__
+      auto cache_miss = [](uint64_t cache) {
+         return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      };
+      open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &perf_counts::cycles);
+      open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &perf_counts::instructions);
+      open_event(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB), &perf_counts::dtlb_misses);
+      open_event(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_ITLB), &perf_counts::itlb_misses);
+#endif
+   }
+   ~perf_counters() {
+#ifdef __linux__
+      for (const auto& e : events)
+         close(e.fd);
+#endif
+   }
+   perf_counters(const perf_counters&) = delete;
+   perf_counters& operator=(const perf_counters&) = delete;
+
+   bool valid() const { return !events.empty(); }
+
+   void start() {
+#ifdef __linux__
+      for (const auto& e : events) {
+         ioctl(e.fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(e.fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+
+   // adds the counts since start() to totals
+   void stop(perf_counts& totals) {
+#ifdef __linux__
+      for (const auto& e : events)
+         ioctl(e.fd, PERF_EVENT_IOC_DISABLE, 0);
+      for (const auto& e : events) {
+         uint64_t count = 0;
+         if (read(e.fd, &count, sizeof(count)) == sizeof(count))
+            totals.*e.field += count;
+      }
+#endif
+   }
+
+private:
+   struct event {
+      int fd;
+      uint64_t perf_counts::* field;
+   };
+
+#ifdef __linux__
+   void open_event(uint32_t type, uint64_t config, uint64_t perf_counts::* field) {
+      perf_event_attr attr{};
+      attr.size           = sizeof(attr);
+      attr.type           = type;
+      attr.config         = config;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1; // allowed without privileges
+      attr.exclude_hv     = 1;
+      int fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      if (fd >= 0)
+         events.push_back({fd, field});
+   }
+#endif
+
+   std::vector<event> events;
+};
+
+std::unique_ptr<perf_counters> counters;
 
 std::map<std::string, std::function<void()>> get_features() {
    return features;
@@ -39,6 +171,20 @@ uint32_t get_num_runs() {
    return num_runs;
 }
 
+bool set_perf_counters(bool enable) {
+   counters.reset();
+   if (enable) {
+      counters = std::make_unique<perf_counters>();
+      if (!counters->valid())
+         counters.reset();
+   }
+   return !enable || counters;
+}
+
+void set_current_feature(const std::string& name) {
+   current_feature = name;
+}
+
 void print_header() {
    std::cout << std::left << std::setw(name_width) << "function"
       << std::setw(runs_width) << "runs"
@@ -62,6 +208,26 @@ void print_results(std::string name, uint32_t runs, uint64_t total, uint64_t min
       << std::endl;
 }
 
+void print_perf_counts(const perf_counts& c) {
+   std::cout
+      << std::setw(name_width + runs_width) << std::right << "per run:"
+      << " cycles " << c.cycles
+      << ", instructions " << c.instructions
+      << ", dTLB misses " << c.dtlb_misses
+      << ", iTLB misses " << c.itlb_misses
+      << std::endl;
+}
+
+// nearest-rank percentile of sorted durations
+uint64_t percentile(const std::vector<uint64_t>& sorted, double p) {
+   auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+   return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void save_results(const std::string& file) {
+   fc::json::save_to_file(results, file, true, fc::json::output_formatting::legacy_generator);
+}
+
 bytes to_bytes(const std::string& source) {
    bytes output(source.length()/2);
    fc::from_hex(source, output.data(), output.size());
@@ -70,23 +236,65 @@ bytes to_bytes(const std::string& source) {
 
 void benchmarking(const std::string& name, const std::function<void()>& func,
                   std::optional<size_t> opt_num_runs /* = {} */) {
+   benchmarking(name, {}, func, opt_num_runs ? *opt_num_runs : num_runs);
+}
+
+void benchmarking(const std::string& name, const std::function<void()>& prepare, const std::function<void()>& func,
+                  size_t runs) {
    uint64_t total{0};
    uint64_t min{std::numeric_limits<uint64_t>::max()};
    uint64_t max{0};
-   uint32_t runs = opt_num_runs ? *opt_num_runs : num_runs;
+   std::vector<uint64_t> durations;
+   durations.reserve(runs);
+   perf_counts perf_totals;
 
    for (auto i = 0U; i < runs; ++i) {
+      if (prepare)
+         prepare();
+
+      if (counters)
+         counters->start();
       auto start_time = std::chrono::high_resolution_clock::now();
       func();
       auto end_time = std::chrono::high_resolution_clock::now();
+      if (counters)
+         counters->stop(perf_totals);
 
       uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
       total += duration;
       min = std::min(min, duration);
       max = std::max(max, duration);
+      durations.push_back(duration);
    }
 
    print_results(name, runs, total, min, max);
+
+   if (runs == 0)
+      return;
+   std::optional<perf_counts> perf;
+   if (counters) {
+      perf = perf_counts{
+         .cycles       = perf_totals.cycles / runs,
+         .instructions = perf_totals.instructions / runs,
+         .dtlb_misses  = perf_totals.dtlb_misses / runs,
+         .itlb_misses  = perf_totals.itlb_misses / runs
+      };
+      print_perf_counts(*perf);
+   }
+   std::sort(durations.begin(), durations.end());
+   results.push_back(benchmark_result{
+      .feature     = current_feature,
+      .name        = name,
+      .runs        = static_cast<uint32_t>(runs),
+      .average_ns  = total / runs,
+      .min_ns      = min,
+      .max_ns      = max,
+      .p50_ns      = percentile(durations, 0.50),
+      .p90_ns      = percentile(durations, 0.90),
+      .p99_ns      = percentile(durations, 0.99),
+      .ops_per_sec = total == 0 ? 0.0 : runs * 1e9 / total,
+      .perf        = perf
+   });
 }
 
 } // benchmark
@@ -13,9 +13,14 @@ using bytes = std::vector<char>;
 
 void set_num_runs(uint32_t runs);
 uint32_t get_num_runs();
+// also count cycles, instructions and TLB misses of each run with perf events; false if not available
+bool set_perf_counters(bool enable);
 std::map<std::string, std::function<void()>> get_features();
+void set_current_feature(const std::string& name);
 void print_header();
 bytes to_bytes(const std::string& source);
+// write the results of all benchmarks run so far to file as a JSON array
+void save_results(const std::string& file);
 
 void alt_bn_128_benchmarking();
 void modexp_benchmarking();
@@ -24,7 +29,21 @@ void hash_benchmarking();
 void blake2_benchmarking();
 void bls_benchmarking();
 void merkle_benchmarking();
+void logging_benchmarking();
+void expiry_wheel_benchmarking();
+void authorization_benchmarking();
+void block_apply_benchmarking();
+void push_transaction_benchmarking();
+void db_i64_benchmarking();
+void db_scan_benchmarking();
+void snapshot_benchmarking();
+void fork_switch_benchmarking();
+void random_access_file_benchmarking();
+void json_benchmarking();
+void eosvmoc_benchmarking();
 
 void benchmarking(const std::string& name, const std::function<void()>& func, std::optional<size_t> num_runs = {});
+// prepare is called before each run of func and is not included in the measured time
+void benchmarking(const std::string& name, const std::function<void()>& prepare, const std::function<void()>& func, size_t num_runs);
 
 } // benchmark
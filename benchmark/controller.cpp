@@ -0,0 +1,374 @@
+#include <benchmark.hpp>
+#include <eosio/chain/asset.hpp>
+#include <eosio/chain/snapshot.hpp>
+#include <eosio/testing/tester.hpp>
+
+#include <fc/variant_object.hpp>
+
+#include <test_contracts.hpp>
+
+#include <iostream>
+#include <sstream>
+
+using namespace eosio;
+using namespace eosio::chain;
+using namespace eosio::testing;
+
+// Benchmark the controller: applying blocks, speculative execution of transactions, database intrinsics,
+// snapshots and fork switches, in process with the tester and the test contracts.
+//
+// To run a benchmarking session, in the build directory, type
+//    benchmark/benchmark -f block_apply
+// Add `-j results.json` to also save the results, with percentiles and operations per second, as JSON.
+
+namespace eosio::benchmark {
+
+namespace {
+
+constexpr uint32_t billed_cpu_time_us = 100; // explicit billing, so that many transactions fit in a block
+
+constexpr auto token_account    = "eosio.token"_n;
+constexpr auto snapshot_account = "snapshot"_n;
+constexpr auto bulk_db_account  = "bulkdb"_n;
+
+void disable_logging() {
+   // prevent logging from interwined with output benchmark results
+   fc::logger::get(DEFAULT_LOGGER).set_log_level(fc::log_level::off);
+}
+
+vector<account_name> make_account_names( const std::string& prefix, uint32_t n ) {
+   const std::string letters = "abcdefghijklmnopqrstuvwxyz";
+   vector<account_name> names;
+   for( uint32_t i = 0; i < n; ++i ) {
+      std::string name = prefix;
+      for( uint32_t v = i, j = 0; j < 3; ++j, v /= letters.size() )
+         name += letters[v % letters.size()];
+      names.emplace_back( name );
+   }
+   return names;
+}
+
+// pushes the blocks of from that to does not have yet
+void sync_blocks( base_tester& from, base_tester& to ) {
+   for( uint32_t n = to.head().block_num() + 1; n <= from.head().block_num(); ++n )
+      to.push_block( from.fetch_block_by_number( n ) );
+}
+
+// accounts holding eosio.token CUR, transfering it round robin
+struct token_chain {
+   static constexpr uint32_t num_accounts = 100;
+
+   token_chain() {
+      chain.create_account( token_account );
+      chain.set_code( token_account, test_contracts::eosio_token_wasm() );
+      chain.set_abi( token_account, test_contracts::eosio_token_abi() );
+      chain.push_action( token_account, "create"_n, token_account, fc::mutable_variant_object()
+                         ( "issuer", token_account )
+                         ( "maximum_supply", "1000000000.0000 CUR" ) );
+      chain.push_action( token_account, "issue"_n, token_account, fc::mutable_variant_object()
+                         ( "to", token_account )
+                         ( "quantity", "1000000000.0000 CUR" )
+                         ( "memo", "" ) );
+
+      accounts = make_account_names( "bench", num_accounts );
+      chain.create_accounts( accounts, false, false );
+      chain.produce_block();
+      for( const auto& a : accounts ) {
+         chain.push_action( token_account, "transfer"_n, token_account, fc::mutable_variant_object()
+                            ( "from", token_account )
+                            ( "to", a )
+                            ( "quantity", "1000000.0000 CUR" )
+                            ( "memo", "" ) );
+      }
+      chain.produce_block();
+   }
+
+   // unique by the memo
+   signed_transaction make_transfer() {
+      const uint64_t n = num_transfers++;
+      const account_name& from = accounts[n % num_accounts];
+      const account_name& to   = accounts[(n + 1) % num_accounts];
+
+      signed_transaction trx;
+      trx.actions.emplace_back( vector<permission_level>{{from, config::active_name}}, token_account, "transfer"_n,
+                                fc::raw::pack( std::make_tuple( from, to, asset::from_string( "0.0001 CUR" ), std::to_string( n ) ) ) );
+      chain.set_transaction_headers( trx );
+      trx.sign( chain.get_private_key( from, "active" ), chain.get_chain_id() );
+      return trx;
+   }
+
+   void push_transfers( uint32_t n ) {
+      for( uint32_t i = 0; i < n; ++i ) {
+         auto trx = make_transfer();
+         chain.push_transaction( trx, fc::time_point::maximum(), billed_cpu_time_us );
+      }
+   }
+
+   tester                 chain;
+   vector<account_name>   accounts;
+   uint64_t               num_transfers = 0;
+};
+
+// loads a chain from a snapshot
+class snapshot_chain : public base_tester {
+public:
+   snapshot_chain( const fc::temp_directory& dir, const snapshot_reader_ptr& snapshot ) {
+      init( default_config( dir ).first, snapshot );
+   }
+
+   produce_block_result_t produce_block_ex( fc::microseconds skip_time = default_skip_time, bool no_throw = false ) override {
+      return _produce_block( skip_time, false, no_throw );
+   }
+
+   signed_block_ptr produce_block( fc::microseconds skip_time = default_skip_time, bool no_throw = false ) override {
+      return produce_block_ex( skip_time, no_throw ).block;
+   }
+
+   signed_block_ptr produce_empty_block( fc::microseconds skip_time = default_skip_time ) override {
+      control->abort_block();
+      return _produce_block( skip_time, true );
+   }
+
+   signed_block_ptr finish_block() override {
+      return _finish_block();
+   }
+};
+
+action make_snapshot_test_action( action_name name, uint64_t id, const std::optional<fc::sha256>& payload = {} ) {
+   vector<permission_level> auth{{snapshot_account, config::active_name}};
+   if( payload )
+      return action( std::move(auth), snapshot_account, name, fc::raw::pack( std::make_tuple( snapshot_account, id, *payload ) ) );
+   return action( std::move(auth), snapshot_account, name, fc::raw::pack( std::make_tuple( snapshot_account, id ) ) );
+}
+
+fc::sha256 row_payload( uint64_t id ) {
+   return fc::sha256::hash( std::to_string( id ) );
+}
+
+// snapshot_test contract, whose add, verify and remove actions store, find and get, and remove a row with db_*_i64
+struct db_chain {
+   db_chain() {
+      chain.create_account( snapshot_account );
+      chain.set_code( snapshot_account, test_contracts::snapshot_test_wasm() );
+      chain.set_abi( snapshot_account, test_contracts::snapshot_test_abi() );
+      chain.produce_block();
+   }
+
+   signed_transaction make_trx( action_name name, uint64_t first_id, uint32_t num_rows ) {
+      signed_transaction trx;
+      for( uint64_t id = first_id; id < first_id + num_rows; ++id ) {
+         trx.actions.emplace_back( name == "remove"_n ? make_snapshot_test_action( name, id )
+                                                      : make_snapshot_test_action( name, id, row_payload( id ) ) );
+      }
+      chain.set_transaction_headers( trx );
+      trx.sign( chain.get_private_key( snapshot_account, "active" ), chain.get_chain_id() );
+      return trx;
+   }
+
+   void push_trx( action_name name, uint64_t first_id, uint32_t num_rows ) {
+      auto trx = make_trx( name, first_id, num_rows );
+      chain.push_transaction( trx, fc::time_point::maximum(), billed_cpu_time_us );
+   }
+
+   tester chain;
+};
+
+} // anonymous namespace
+
+void block_apply_benchmarking() {
+   disable_logging();
+
+   token_chain producer;
+   tester validator( setup_policy::none );
+   validator.do_check_for_votes( false );
+   sync_blocks( producer.chain, validator );
+
+   // keys of the transactions recovered by the producer are served from the recovered key cache, as for
+   // transactions a node receives over p2p before it receives the block including them
+   for( uint32_t trxs_per_block : { 10u, 100u, 1000u } ) {
+      signed_block_ptr block;
+      benchmarking( "apply block of " + std::to_string( trxs_per_block ) + " transfers",
+         [&]() {
+            producer.push_transfers( trxs_per_block );
+            block = producer.chain.produce_block();
+         },
+         [&]() { validator.push_block( block ); },
+         trxs_per_block >= 1000 ? 10 : 50 );
+   }
+}
+
+void push_transaction_benchmarking() {
+   disable_logging();
+
+   constexpr uint32_t num_trxs       = 10'000;
+   constexpr uint32_t trxs_per_block = 1000;
+
+   token_chain producer;
+   signed_transaction trx;
+   uint32_t i = 0;
+   benchmarking( "push_transaction, transfer",
+      [&]() {
+         if( ++i % trxs_per_block == 0 )
+            producer.chain.produce_block();
+         trx = producer.make_transfer();
+      },
+      [&]() { producer.chain.push_transaction( trx, fc::time_point::maximum(), billed_cpu_time_us ); },
+      num_trxs );
+}
+
+void db_i64_benchmarking() {
+   disable_logging();
+
+   constexpr uint32_t num_trxs       = 200;
+   constexpr uint32_t rows_per_trx   = 50;
+   constexpr uint32_t trxs_per_block = 20;
+
+   std::cout << rows_per_trx << " rows per transaction, time per transaction" << std::endl;
+
+   db_chain db;
+   for( auto [act, description] : { std::pair{ "add"_n,    "db_store_i64" },
+                                     std::pair{ "verify"_n, "db_find_i64, db_get_i64" },
+                                     std::pair{ "remove"_n, "db_find_i64, db_remove_i64" } } ) {
+      signed_transaction trx;
+      uint32_t i = 0;
+      benchmarking( description,
+         [&]() {
+            if( i % trxs_per_block == 0 )
+               db.chain.produce_block();
+            trx = db.make_trx( act, uint64_t(i++) * rows_per_trx, rows_per_trx );
+         },
+         [&]() { db.chain.push_transaction( trx, fc::time_point::maximum(), billed_cpu_time_us ); },
+         num_trxs );
+   }
+}
+
+void db_scan_benchmarking() {
+   disable_logging();
+
+   constexpr uint32_t num_rows       = 10'000;
+   constexpr uint32_t rows_per_store = 1000;
+   constexpr uint32_t row_size       = 64;
+   constexpr uint32_t num_trxs       = 50;
+
+   std::cout << "scan of " << num_rows << " rows of " << row_size << " bytes, time per transaction" << std::endl;
+
+   // bulk_db_test contract, whose scan action reads the rows with db_get_i64 and db_next_i64 and whose bulkscan
+   // action reads them with db_get_rows_i64
+   tester chain;
+   chain.create_account( bulk_db_account );
+   chain.set_code( bulk_db_account, test_contracts::bulk_db_test_wasm() );
+   chain.set_abi( bulk_db_account, test_contracts::bulk_db_test_abi() );
+   chain.produce_block();
+   for( uint32_t first = 0; first < num_rows; first += rows_per_store ) {
+      chain.push_action( bulk_db_account, "store"_n, bulk_db_account, fc::mutable_variant_object()
+                         ( "first", first )
+                         ( "count", rows_per_store )
+                         ( "size", row_size ) );
+      chain.produce_block();
+   }
+
+   auto make_trx = [&]( action_name name, const std::optional<uint32_t>& max_rows, uint32_t i ) {
+      signed_transaction trx;
+      vector<permission_level> auth{{bulk_db_account, config::active_name}};
+      if( max_rows )
+         trx.actions.emplace_back( std::move(auth), bulk_db_account, name, fc::raw::pack( std::make_tuple( num_rows, *max_rows ) ) );
+      else
+         trx.actions.emplace_back( std::move(auth), bulk_db_account, name, fc::raw::pack( num_rows ) );
+      // unique by the expiration
+      chain.set_transaction_headers( trx, base_tester::DEFAULT_EXPIRATION_DELTA + i );
+      trx.sign( chain.get_private_key( bulk_db_account, "active" ), chain.get_chain_id() );
+      return trx;
+   };
+
+   for( auto [description, name, max_rows] : { std::tuple{ "db_get_i64, db_next_i64",  "scan"_n,     std::optional<uint32_t>{} },
+                                               std::tuple{ "db_get_rows_i64, 16 rows", "bulkscan"_n, std::optional<uint32_t>{16} },
+                                               std::tuple{ "db_get_rows_i64, 256 rows", "bulkscan"_n, std::optional<uint32_t>{256} } } ) {
+      signed_transaction trx;
+      uint32_t i = 0;
+      benchmarking( description,
+         [&]() { trx = make_trx( name, max_rows, i++ ); },
+         [&]() { chain.push_transaction( trx, fc::time_point::maximum(), billed_cpu_time_us ); },
+         num_trxs );
+      chain.produce_block();
+   }
+}
+
+void snapshot_benchmarking() {
+   disable_logging();
+
+   constexpr uint32_t num_accounts = 1000;
+   constexpr uint32_t num_rows     = 10'000;
+   constexpr uint32_t rows_per_trx = 100;
+   constexpr uint32_t num_runs     = 10;
+
+   std::cout << num_accounts << " accounts and " << num_rows << " contract rows" << std::endl;
+
+   db_chain db;
+   db.chain.create_accounts( make_account_names( "snap", num_accounts ), false, false );
+   for( uint32_t id = 0; id < num_rows; id += rows_per_trx ) {
+      db.push_trx( "add"_n, id, rows_per_trx );
+      db.chain.produce_block();
+   }
+   db.chain.control->abort_block();
+
+   std::string snapshot;
+   benchmarking( "write_snapshot",
+      [&]() {
+         std::ostringstream out;
+         auto writer = std::make_shared<ostream_snapshot_writer>( out );
+         db.chain.control->write_snapshot( writer );
+         writer->finalize();
+         snapshot = out.str();
+      },
+      num_runs );
+   std::cout << "snapshot size " << snapshot.size() << " bytes" << std::endl;
+
+   std::optional<fc::temp_directory> dir;
+   std::unique_ptr<snapshot_chain>   chain;
+   std::shared_ptr<std::istringstream> in;
+   snapshot_reader_ptr reader;
+   benchmarking( "startup from snapshot",
+      [&]() {
+         chain.reset();
+         dir.emplace();
+         in     = std::make_shared<std::istringstream>( snapshot );
+         reader = std::make_shared<istream_snapshot_reader>( *in );
+      },
+      [&]() { chain = std::make_unique<snapshot_chain>( *dir, reader ); },
+      num_runs );
+   chain.reset();
+}
+
+void fork_switch_benchmarking() {
+   disable_logging();
+
+   constexpr uint32_t fork_depth = 8;
+   constexpr uint32_t num_runs   = 50;
+
+   std::cout << "switch to a better fork of " << fork_depth << " blocks" << std::endl;
+
+   // c1 votes on its blocks, c2 has no finalizer and produces blocks without new QCs, so that c2 switches
+   // to the blocks of c1 branching off the same block
+   tester c1;
+   tester c2( setup_policy::none );
+   c2.do_check_for_votes( false );
+   sync_blocks( c1, c2 );
+
+   vector<signed_block_ptr> blocks;
+   benchmarking( "fork switch",
+      [&]() {
+         blocks.clear();
+         for( uint32_t i = 0; i < fork_depth; ++i ) {
+            c2.produce_block();
+            blocks.push_back( c1.produce_block() );
+         }
+      },
+      [&]() {
+         for( const auto& b : blocks )
+            c2.push_block( b );
+         FC_ASSERT( c2.head().id() == c1.head().id(), "c2 did not switch forks" );
+      },
+      num_runs );
+}
+
+} // namespace eosio::benchmark
@@ -0,0 +1,52 @@
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+
+#include <eosio/chain/wasm_eosio_constraints.hpp>
+#include <eosio/chain/webassembly/eos-vm-oc/memory.hpp>
+
+#include <cstring>
+
+#include <benchmark.hpp>
+
+namespace eosio::benchmark {
+
+using namespace eosio::chain;
+
+// Linear memory setup per action: clearing all the starting pages with memset before the action, as the executor
+// used to, against memory::reset_linear_memory after the action. Each run also writes `dirty` OS pages, spread over
+// the memory, to include the faults of discarded pages. Repeated with the memory advised for transparent huge pages,
+// run with --perf-counters to compare the TLB misses.
+void eosvmoc_benchmarking() {
+   constexpr uint64_t os_page_size = 4096;
+
+   for (bool transparent_hugepages : {false, true}) {
+      eosvmoc::memory mem(wasm_constraints::maximum_linear_memory/wasm_constraints::wasm_page_size, transparent_hugepages);
+
+      for (uint64_t pages : {1, 16, 32, 64, 128, 512}) {
+         for (uint64_t dirty : {4, 64}) {
+            const uint64_t memory_size = pages*wasm_constraints::wasm_page_size;
+            if (dirty*os_page_size > memory_size)
+               continue;
+            auto touch = [&]() {
+               const uint64_t step = memory_size/dirty/os_page_size*os_page_size;
+               for (uint64_t i = 0; i < dirty; ++i)
+                  mem.full_page_memory_base()[i*step] = 1;
+            };
+            const std::string suffix = std::to_string(pages) + " pages, " + std::to_string(dirty) + " dirty" +
+                                       (transparent_hugepages ? ", thp" : "");
+
+            benchmarking("memset " + suffix, [&]() {
+               memset(mem.full_page_memory_base(), 0, memory_size);
+               touch();
+            });
+            benchmarking("reset " + suffix, [&]() {
+               touch();
+               mem.reset_linear_memory(pages);
+            });
+         }
+      }
+   }
+}
+
+} // benchmark
+
+#endif
@@ -0,0 +1,162 @@
+#include <eosio/chain/types.hpp>
+
+#include <fc/container/expiry_wheel.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <iostream>
+#include <random>
+
+#include <benchmark.hpp>
+
+namespace eosio::benchmark {
+
+using namespace eosio::chain;
+namespace bmi = boost::multi_index;
+
+namespace {
+
+size_t allocated_bytes = 0;
+
+// tracks the bytes currently allocated by the containers under test
+template <typename T>
+struct counting_allocator {
+   using value_type = T;
+   counting_allocator() = default;
+   template <typename U>
+   counting_allocator( const counting_allocator<U>& ) {}
+   T* allocate( size_t n ) {
+      allocated_bytes += n * sizeof(T);
+      return std::allocator<T>().allocate( n );
+   }
+   void deallocate( T* p, size_t n ) {
+      allocated_bytes -= n * sizeof(T);
+      std::allocator<T>().deallocate( p, n );
+   }
+   template <typename U>
+   bool operator==( const counting_allocator<U>& ) const { return true; }
+};
+
+struct entry {
+   transaction_id_type id;
+   fc::time_point      expiry;
+   uint64_t            value = 0;
+};
+
+// the layout previously used by the transaction tracking containers
+struct by_id;
+struct by_expiry;
+using ordered_index_type = bmi::multi_index_container<
+   entry,
+   bmi::indexed_by<
+      bmi::hashed_unique<bmi::tag<by_id>, BOOST_MULTI_INDEX_MEMBER( entry, transaction_id_type, id ), std::hash<transaction_id_type>>,
+      bmi::ordered_non_unique<bmi::tag<by_expiry>, BOOST_MULTI_INDEX_MEMBER( entry, fc::time_point, expiry )>
+   >,
+   counting_allocator<entry>
+>;
+
+using wheel_type = fc::expiry_wheel<transaction_id_type, uint64_t, std::hash<transaction_id_type>, std::equal_to<transaction_id_type>,
+                                    counting_allocator<std::pair<const transaction_id_type, uint64_t>>>;
+
+constexpr size_t num_entries = 100'000;
+
+// transactions arrive in roughly time order with expirations spread over the next minute
+std::vector<entry> make_entries() {
+   std::mt19937_64 rng( 42 );
+   std::vector<entry> entries( num_entries );
+   const fc::time_point start = fc::time_point::now();
+   for( size_t i = 0; i < num_entries; ++i ) {
+      entries[i].id     = fc::sha256::hash( std::to_string( i ) );
+      entries[i].expiry = start + fc::microseconds( i * 10 ) + fc::seconds( 30 + rng() % 30 );
+      entries[i].value  = i;
+   }
+   return entries;
+}
+
+// in steady state expire is called on every block, start from the current time
+void start( ordered_index_type&, fc::time_point ) {}
+
+void start( wheel_type& c, fc::time_point now ) {
+   c.expire( now );
+}
+
+void insert( ordered_index_type& c, const std::vector<entry>& entries ) {
+   for( const auto& e : entries )
+      c.insert( e );
+}
+
+void insert( wheel_type& c, const std::vector<entry>& entries ) {
+   for( const auto& e : entries )
+      c.try_emplace( e.id, e.expiry, e.value );
+}
+
+// half of the transactions are included in a block before they expire
+void erase_half( ordered_index_type& c, const std::vector<entry>& entries ) {
+   auto& idx = c.get<by_id>();
+   for( size_t i = 0; i < entries.size(); i += 2 )
+      idx.erase( entries[i].id );
+}
+
+void erase_half( wheel_type& c, const std::vector<entry>& entries ) {
+   for( size_t i = 0; i < entries.size(); i += 2 )
+      c.erase( entries[i].id );
+}
+
+// expire in 500ms steps as done on every block
+void expire_all( ordered_index_type& c, fc::time_point from ) {
+   auto& idx = c.get<by_expiry>();
+   for( fc::time_point now = from; !idx.empty(); now += fc::milliseconds( 500 ) ) {
+      while( !idx.empty() && idx.begin()->expiry <= now )
+         idx.erase( idx.begin() );
+   }
+}
+
+void expire_all( wheel_type& c, fc::time_point from ) {
+   for( fc::time_point now = from; !c.empty(); now += fc::milliseconds( 500 ) )
+      c.expire( now );
+}
+
+template <typename Container>
+void benchmark_container( const std::string& name, const std::vector<entry>& entries ) {
+   const fc::time_point from = fc::time_point::now();
+
+   benchmarking( name + " insert", [&]() {
+      Container c;
+      start( c, from );
+      insert( c, entries );
+   } );
+   benchmarking( name + " insert, erase half", [&]() {
+      Container c;
+      start( c, from );
+      insert( c, entries );
+      erase_half( c, entries );
+   } );
+   benchmarking( name + " insert, expire", [&]() {
+      Container c;
+      start( c, from );
+      insert( c, entries );
+      expire_all( c, from );
+   } );
+
+   const size_t before = allocated_bytes;
+   {
+      Container c;
+      start( c, from );
+      insert( c, entries );
+      std::cout << name << " bytes per entry: " << (allocated_bytes - before) / entries.size() << std::endl;
+   }
+}
+
+} // anonymous namespace
+
+void expiry_wheel_benchmarking() {
+   const auto entries = make_entries();
+   std::cout << num_entries << " entries" << std::endl;
+   benchmark_container<ordered_index_type>( "multi_index by_expiry", entries );
+   benchmark_container<wheel_type>( "expiry_wheel", entries );
+}
+
+} // namespace eosio::benchmark
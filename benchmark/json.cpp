@@ -0,0 +1,49 @@
+#include <fc/io/json.hpp>
+
+#include <benchmark.hpp>
+
+namespace eosio::benchmark {
+
+namespace {
+
+// a push_transaction request body with num_actions eosio.token transfers of hex data
+std::string make_push_transaction_body(uint32_t num_actions, bool pretty) {
+   std::string actions;
+   for (uint32_t i = 0; i < num_actions; ++i) {
+      if (i > 0)
+         actions += ",";
+      actions += R"({"account":"eosio.token","name":"transfer","authorization":[{"actor":"alice","permission":"active"}],)"
+                 R"("data":")" + std::string(2 * 48, 'a') + R"("})";
+   }
+   std::string body = R"({"signatures":["SIG_K1_KfQ57wLFFvH2S4m3tU6tEMaNq9JqXxTumG3Nhsgsis36btdfR7ZVkj8Y89mRuZV4h3TKnPqrgRU3qCnDmZF5HrDe2j8Bx3"],)"
+                      R"("compression":"none","packed_context_free_data":"",)"
+                      R"("transaction":{"expiration":"2024-01-01T00:00:30","ref_block_num":12345,"ref_block_prefix":3456789012,)"
+                      R"("max_net_usage_words":0,"max_cpu_usage_ms":0,"delay_sec":0,"context_free_actions":[],)"
+                      R"("actions":[)" + actions + R"(],"transaction_extensions":[]}})";
+   if (pretty)
+      body = fc::json::to_pretty_string(fc::json::from_string(body));
+   return body;
+}
+
+} // anonymous namespace
+
+void json_benchmarking() {
+   for (uint32_t num_actions : {1, 100}) {
+      for (bool pretty : {false, true}) {
+         const std::string body = make_push_transaction_body(num_actions, pretty);
+         benchmarking("from_string " + std::to_string(num_actions) + (pretty ? " actions, pretty (" : " actions (") +
+                      std::to_string(body.size()) + " bytes)",
+                      [&]() { fc::json::from_string(body); });
+      }
+   }
+
+   // numbers and escapes, as in get_table_rows bounds and abi_json_to_bin args
+   std::string args = "[";
+   for (uint32_t i = 0; i < 1000; ++i)
+      args += (i > 0 ? "," : "") + std::to_string(i * 1000003ull) + R"(,"memo \")" + std::to_string(i) + R"(\"\n")";
+   args += "]";
+   benchmarking("from_string numbers and escapes (" + std::to_string(args.size()) + " bytes)",
+                [&]() { fc::json::from_string(args); });
+}
+
+} // namespace eosio::benchmark
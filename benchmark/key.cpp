@@ -3,6 +3,8 @@
 #include <fc/crypto/signature.hpp>
 #include <fc/crypto/k1_recover.hpp>
 
+#include <eosio/chain/recovered_key_cache.hpp>
+
 #include <benchmark.hpp>
 
 using namespace fc::crypto;
@@ -100,10 +102,33 @@ void wa_benchmarking() {
    benchmarking("webauthn_recover", recover);
 }
 
+// cold: every signature is recovered and inserted, warm: every signature is found in the cache
+void recovered_key_cache_benchmarking() {
+   constexpr uint32_t num_sigs = 1000;
+   auto key = private_key::generate();
+
+   std::vector<std::pair<sha256, signature>> sigs;
+   for (uint32_t i = 0; i < num_sigs; ++i) {
+      auto digest = sha256::hash(std::to_string(i));
+      sigs.emplace_back(digest, key.sign(digest));
+   }
+
+   eosio::chain::recovered_key_cache cache(num_sigs);
+   uint32_t i = 0;
+   auto recover_f = [&]() {
+      const auto& [digest, sig] = sigs[i++ % num_sigs];
+      cache.recover(sig, digest);
+   };
+   benchmarking("k1_recover_cache_cold", recover_f, num_sigs);
+   i = 0;
+   benchmarking("k1_recover_cache_warm", recover_f, num_sigs);
+}
+
 void key_benchmarking() {
    k1_benchmarking();
    r1_benchmarking();
    wa_benchmarking();
+   recovered_key_cache_benchmarking();
 }
 
 } // benchmark
@@ -0,0 +1,109 @@
+#include <fc/log/appender.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/log/logger_config.hpp>
+#include <fc/variant.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <benchmark.hpp>
+
+using namespace fc;
+
+namespace eosio::benchmark {
+
+namespace {
+
+// formats like console_appender and writes to /dev/null so the benchmark measures the logging path, not the terminal
+class null_appender : public appender {
+public:
+   explicit null_appender( const variant& ) : out( std::fopen( "/dev/null", "w" ) ) {}
+   ~null_appender() override { if( out ) std::fclose( out ); }
+   void initialize() override {}
+   void log( const log_message& m ) override {
+      const log_context context = m.get_context();
+      std::string line = context.get_log_level().to_string();
+      line += ' ';
+      line += time_point::now().to_iso_string();
+      line += ' ';
+      line += context.get_thread_name();
+      line += ' ';
+      line += context.get_file();
+      line += "] ";
+      line += fc::format_string( m.get_format(), m.get_data() );
+      if( out ) {
+         std::fprintf( out, "%s\n", line.c_str() );
+         std::fflush( out );
+      }
+   }
+private:
+   FILE* out = nullptr;
+};
+
+void configure( bool async ) {
+   static bool registered = log_config::register_appender<null_appender>( "null" );
+   (void)registered;
+
+   logging_config cfg;
+   cfg.appenders.push_back( appender_config( "null", "null" ) );
+   logger_config lc( "bench" );
+   lc.level = log_level::debug;
+   lc.appenders.push_back( "null" );
+   cfg.loggers.push_back( lc );
+   cfg.async.enabled    = async;
+   cfg.async.queue_size = 64*1024;
+   cfg.async.overflow   = async_logging_config::overflow_policy::block;
+   configure_logging( cfg );
+}
+
+// lines/sec with num_threads logging concurrently, includes the time to write everything out
+void lines_per_sec( const std::string& name, size_t num_threads ) {
+   constexpr size_t lines_per_thread = 20000;
+   logger lgr = logger::get( "bench" );
+
+   auto start = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   for( size_t t = 0; t < num_threads; ++t ) {
+      threads.emplace_back( [&lgr, t]() {
+         for( size_t i = 0; i < lines_per_thread; ++i )
+            fc_dlog( lgr, "thread ${t} line ${i} some payload ${p}", ("t", t)("i", i)("p", "abcdefghijklmnopqrstuvwxyz") );
+      } );
+   }
+   for( auto& t : threads )
+      t.join();
+   log_config::flush();
+   auto end = std::chrono::high_resolution_clock::now();
+
+   double secs = std::chrono::duration<double>( end - start ).count();
+   std::cout << std::left << std::setw( 40 ) << name << std::right << std::fixed << std::setprecision( 0 )
+             << std::setw( 17 ) << (num_threads * lines_per_thread) / secs << " lines/sec" << std::endl;
+}
+
+} // anonymous namespace
+
+void logging_benchmarking() {
+   logger lgr = logger::get( "bench" );
+   auto log_line = [&]() {
+      fc_dlog( lgr, "single line ${i} some payload ${p}", ("i", 42)("p", "abcdefghijklmnopqrstuvwxyz") );
+   };
+
+   for( bool async : { false, true } ) {
+      const std::string mode = async ? "async" : "sync";
+      configure( async );
+
+      // caller latency
+      benchmarking( mode + " log call", log_line );
+      log_config::flush();
+
+      for( size_t num_threads : { 1, 4, 8 } )
+         lines_per_sec( mode + " " + std::to_string( num_threads ) + " threads", num_threads );
+   }
+
+   configure_logging( logging_config::default_config() );
+}
+
+} // namespace eosio::benchmark
@@ -11,6 +11,7 @@ using bpo::variables_map;
 int main(int argc, char* argv[]) {
    uint32_t num_runs = 1;
    std::string feature_name;
+   std::string json_file;
 
    auto features = eosio::benchmark::get_features();
 
@@ -19,6 +20,8 @@ int main(int argc, char* argv[]) {
       ("feature,f", bpo::value<std::string>(), "feature to be benchmarked; if this option is not present, all features are benchmarked.")
       ("list,l", "list of supported features")
       ("runs,r", bpo::value<uint32_t>(&num_runs)->default_value(1000), "the number of times running a function during benchmarking")
+      ("json,j", bpo::value<std::string>(&json_file), "also write the results, including percentiles and operations per second, to this file as JSON")
+      ("perf-counters,p", "also report cycles, instructions, and dTLB and iTLB misses per run, counted in user space with perf events")
       ("help,h", "benchmark functions, and report average, minimum, and maximum execution time in nanoseconds");
 
    variables_map vmap;
@@ -62,19 +65,29 @@ int main(int argc, char* argv[]) {
    }
 
    eosio::benchmark::set_num_runs(num_runs);
+   if (vmap.count("perf-counters") > 0 && !eosio::benchmark::set_perf_counters(true)) {
+      std::cerr << "perf events are not available, check /proc/sys/kernel/perf_event_paranoid" << std::endl;
+      return 1;
+   }
    eosio::benchmark::print_header();
 
    if (feature_name.empty()) {
       for (auto& [name, f]: features) {
          std::cout << name << ":" << std::endl;
+         eosio::benchmark::set_current_feature(name);
          f();
          std::cout << std::endl;
       }
    } else {
       std::cout << feature_name << ":" << std::endl;
+      eosio::benchmark::set_current_feature(feature_name);
       features[feature_name]();
       std::cout << std::endl;
    }
 
+   if (!json_file.empty()) {
+      eosio::benchmark::save_results(json_file);
+   }
+
    return 0;
 }
@@ -0,0 +1,78 @@
+#include <fc/io/random_access_file.hpp>
+#include <fc/io/io_uring_reader.hpp>
+#include <fc/filesystem.hpp>
+
+#include <fcntl.h>
+
+#include <fstream>
+#include <random>
+
+#include <benchmark.hpp>
+
+namespace eosio::benchmark {
+
+// Cold cache reads of a file, as the state history and block logs do for clients catching up: a sequential range read
+// in 1 MiB windows of 256 KiB reads, and scattered 4 KiB reads as for index lookups. Each batch is read with preadv
+// one read after another, and through an io_uring with all of the batch's reads in flight at once.
+void random_access_file_benchmarking() {
+   constexpr size_t file_size = 64*1024*1024;
+   constexpr size_t window_size = 1024*1024;
+
+   fc::temp_directory tempdir;
+   const std::filesystem::path path = tempdir.path() / "data";
+   {
+      std::vector<char> data(file_size);
+      std::mt19937_64 rng(42);
+      for(char& c : data)
+         c = (char)rng();
+      std::ofstream(path, std::ios::binary).write(data.data(), data.size());
+   }
+   fc::random_access_file file(path, fc::random_access_file::read_only);
+   fc::random_access_file::device device = file.seekable_device();
+
+   auto drop_cache = [&]() {
+#ifdef POSIX_FADV_DONTNEED
+      posix_fadvise(file.native_handle(), 0, file_size, POSIX_FADV_DONTNEED);
+#endif
+   };
+
+   std::vector<char> buffer(window_size);
+   std::vector<fc::io_uring_reader::read_op> ops;
+   auto sequential_ops = [&](size_t offset, size_t op_size) {
+      ops.clear();
+      for(size_t o = 0; o < window_size; o += op_size)
+         ops.push_back({.offset = offset + o, .buffer = buffer.data() + o, .size = (uint32_t)op_size});
+   };
+   auto scattered_ops = [&]() {
+      std::mt19937_64 rng(7);
+      ops.clear();
+      for(size_t o = 0; o < window_size; o += 4096)
+         ops.push_back({.offset = rng() % (file_size/4096) * 4096, .buffer = buffer.data() + o, .size = 4096});
+   };
+
+   std::optional<fc::io_uring_reader> reader;
+   if(fc::io_uring_reader::is_supported()) {
+      reader.emplace();
+      reader->register_buffer(buffer);
+   }
+
+   const size_t num_runs = get_num_runs();
+   auto run = [&](const std::string& name, fc::io_uring_reader* r) {
+      benchmarking("range read 64 MiB, " + name, drop_cache, [&]() {
+         for(size_t offset = 0; offset < file_size; offset += window_size) {
+            sequential_ops(offset, 256*1024);
+            device.read_batch(ops, r);
+         }
+      }, num_runs);
+      benchmarking("scattered 4 KiB reads, " + name, drop_cache, [&]() {
+         scattered_ops();
+         device.read_batch(ops, r);
+      }, num_runs);
+   };
+
+   run("preadv", nullptr);
+   if(reader)
+      run("io_uring", &*reader);
+}
+
+} // benchmark
@@ -48,11 +48,12 @@ apply_context::apply_context(controller& con, transaction_context& trx_ctx, uint
 ,recurse_depth(depth)
 ,first_receiver_action_ordinal(action_ordinal)
 ,action_ordinal(action_ordinal)
-,idx64(*this)
-,idx128(*this)
-,idx256(*this)
-,idx_double(*this)
-,idx_long_double(*this)
+,db_tracer(con.get_db_access_tracer(trx_ctx.is_transient()))
+,idx64(*this, db_index_type::idx64)
+,idx128(*this, db_index_type::idx128)
+,idx256(*this, db_index_type::idx256)
+,idx_double(*this, db_index_type::idx_double)
+,idx_long_double(*this, db_index_type::idx_long_double)
 {
    action_trace& trace = trx_ctx.get_action_trace(action_ordinal);
    act = &trace.act;
@@ -829,6 +830,7 @@ int apply_context::db_store_i64( name code, name scope, name table, const accoun
    }
 
    keyval_cache.cache_table( tab );
+   trace_i64_access( db_access_type::write, obj, buffer_size );
    return keyval_cache.add( obj );
 }
 
@@ -887,6 +889,8 @@ void apply_context::db_update_i64( int iterator, account_name payer, const char*
      o.value.assign( buffer, buffer_size );
      o.payer = payer;
    });
+
+   trace_i64_access( db_access_type::write, obj, buffer_size );
 }
 
 void apply_context::db_remove_i64( int iterator ) {
@@ -908,6 +912,7 @@ void apply_context::db_remove_i64( int iterator ) {
       dm_logger->on_ram_trace(std::move(event_id), "table_row", "remove", "primary_index_remove");
    }
 
+   trace_i64_access( db_access_type::write, obj, obj.value.size() );
    update_db_usage( obj.payer,  -(obj.value.size() + config::billable_size_v<key_value_object>) );
 
    if (auto dm_logger = control.get_deep_mind_logger(trx_context.is_transient())) {
@@ -930,6 +935,7 @@ int apply_context::db_get_i64( int iterator, char* buffer, size_t buffer_size )
    const key_value_object& obj = keyval_cache.get( iterator );
 
    auto s = obj.value.size();
+   trace_i64_access( db_access_type::read, obj, s );
    if( buffer_size == 0 ) return s;
 
    auto copy_size = std::min( buffer_size, s );
@@ -938,6 +944,46 @@ int apply_context::db_get_i64( int iterator, char* buffer, size_t buffer_size )
    return copy_size;
 }
 
+int apply_context::db_get_rows_i64( int iterator, uint32_t max_rows, char* buffer, size_t buffer_size ) {
+   uint32_t num_rows = 0;
+   EOS_ASSERT( buffer_size >= sizeof(num_rows), wasm_execution_error,
+               "db_get_rows_i64 buffer of ${s} bytes cannot hold the number of rows", ("s", buffer_size) );
+   if( iterator < -1 ) { // end iterator of the table
+      auto tab = keyval_cache.find_table_by_end_iterator( iterator );
+      EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
+      memcpy( buffer, &num_rows, sizeof(num_rows) );
+      return iterator;
+   }
+
+   const auto& first = keyval_cache.get( iterator ); // Check for iterator != -1 happens in this call
+   const auto& idx = db.get_index<key_value_index, by_scope_primary>();
+
+   // rows are copied as the contract would with db_get_i64 and db_next_i64, bounded by max_rows and the buffer, so
+   // that the work of a call is linear in the bytes copied; checktime as for any loop over contract provided bounds
+   const size_t checktime_interval = 64;
+   size_t offset = sizeof(num_rows);
+   auto itr = idx.iterator_to( first );
+   for( ; itr != idx.end() && itr->t_id == first.t_id && num_rows < max_rows; ++itr ) {
+      const uint32_t s = itr->value.size();
+      if( buffer_size - offset < sizeof(uint64_t) + sizeof(s) + s ) break;
+
+      memcpy( buffer + offset, &itr->primary_key, sizeof(uint64_t) );
+      offset += sizeof(uint64_t);
+      memcpy( buffer + offset, &s, sizeof(s) );
+      offset += sizeof(s);
+      memcpy( buffer + offset, itr->value.data(), s );
+      offset += s;
+
+      trace_i64_access( db_access_type::read, *itr, s );
+      if( ++num_rows % checktime_interval == 0 )
+         trx_context.checktime();
+   }
+   memcpy( buffer, &num_rows, sizeof(num_rows) );
+
+   if( itr == idx.end() || itr->t_id != first.t_id ) return keyval_cache.get_end_iterator_by_table_id( first.t_id );
+   return keyval_cache.add( *itr );
+}
+
 int apply_context::db_next_i64( int iterator, uint64_t& primary ) {
    if( iterator < -1 ) return -1; // cannot increment past end iterator of table
 
@@ -950,6 +996,7 @@ int apply_context::db_next_i64( int iterator, uint64_t& primary ) {
    if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
 
    primary = itr->primary_key;
+   trace_i64_access( db_access_type::read, *itr, 0 );
    return keyval_cache.add( *itr );
 }
 
@@ -969,6 +1016,7 @@ int apply_context::db_previous_i64( int iterator, uint64_t& primary ) {
       if( itr->t_id != tab->id ) return -1; // Empty table
 
       primary = itr->primary_key;
+      trace_i64_access( db_access_type::read, *itr, 0 );
       return keyval_cache.add(*itr);
    }
 
@@ -982,6 +1030,7 @@ int apply_context::db_previous_i64( int iterator, uint64_t& primary ) {
    if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of table
 
    primary = itr->primary_key;
+   trace_i64_access( db_access_type::read, *itr, 0 );
    return keyval_cache.add(*itr);
 }
 
@@ -996,6 +1045,7 @@ int apply_context::db_find_i64( name code, name scope, name table, uint64_t id )
    const key_value_object* obj = db.find<key_value_object, by_scope_primary>( boost::make_tuple( tab->id, id ) );
    if( !obj ) return table_end_itr;
 
+   trace_i64_access( db_access_type::read, *obj, 0 );
    return keyval_cache.add( *obj );
 }
 
@@ -1012,6 +1062,7 @@ int apply_context::db_lowerbound_i64( name code, name scope, name table, uint64_
    if( itr == idx.end() ) return table_end_itr;
    if( itr->t_id != tab->id ) return table_end_itr;
 
+   trace_i64_access( db_access_type::read, *itr, 0 );
    return keyval_cache.add( *itr );
 }
 
@@ -1028,6 +1079,7 @@ int apply_context::db_upperbound_i64( name code, name scope, name table, uint64_
    if( itr == idx.end() ) return table_end_itr;
    if( itr->t_id != tab->id ) return table_end_itr;
 
+   trace_i64_access( db_access_type::read, *itr, 0 );
    return keyval_cache.add( *itr );
 }
 
@@ -0,0 +1,174 @@
+#include <eosio/chain/authorization_cache.hpp>
+
+#include <fc/crypto/city.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+namespace eosio { namespace chain {
+
+   namespace {
+      struct key_hash_visitor {
+         size_t operator()( const fc::crypto::webauthn::public_key& key )const {
+            return fc::city_hash_size_t( key.public_key_data.data, key.public_key_data.size() );
+         }
+
+         template<typename KeyType>
+         size_t operator()( const KeyType& key )const {
+            const auto& data = key.serialize();
+            return fc::city_hash_size_t( data.data, data.size() );
+         }
+      };
+
+      size_t hash_authority( permission_object::id_type permission, time_point last_updated, fc::microseconds delay,
+                             const flat_set<public_key_type>& keys ) {
+         size_t seed = std::hash<int64_t>()( permission._id );
+         boost::hash_combine( seed, last_updated.time_since_epoch().count() );
+         boost::hash_combine( seed, delay.count() );
+         for( const auto& k : keys )
+            boost::hash_combine( seed, std::visit( key_hash_visitor(), k._storage ) );
+         return seed;
+      }
+
+      size_t hash_link( account_name account, account_name code, action_name type ) {
+         size_t seed = std::hash<account_name>()( account );
+         boost::hash_combine( seed, code.to_uint64_t() );
+         boost::hash_combine( seed, type.to_uint64_t() );
+         return seed;
+      }
+   }
+
+   size_t authorization_cache::authority_hash::operator()( const authority_entry& e )const {
+      return hash_authority( e.permission, e.last_updated, e.provided_delay, e.provided_keys );
+   }
+
+   size_t authorization_cache::authority_hash::operator()( const authority_lookup& l )const {
+      return hash_authority( l.permission, l.last_updated, l.provided_delay, l.provided_keys );
+   }
+
+   bool authorization_cache::authority_equal::operator()( const authority_entry& a, const authority_entry& b )const {
+      return a.permission == b.permission && a.last_updated == b.last_updated &&
+             a.provided_delay == b.provided_delay && a.provided_keys == b.provided_keys;
+   }
+
+   bool authorization_cache::authority_equal::operator()( const authority_lookup& l, const authority_entry& e )const {
+      return l.permission == e.permission && l.last_updated == e.last_updated &&
+             l.provided_delay == e.provided_delay && l.provided_keys == e.provided_keys;
+   }
+
+   size_t authorization_cache::link_hash::operator()( const link_entry& e )const {
+      return hash_link( e.account, e.code, e.type );
+   }
+
+   size_t authorization_cache::link_hash::operator()( const link_lookup& l )const {
+      return hash_link( l.account, l.code, l.type );
+   }
+
+   bool authorization_cache::link_equal::operator()( const link_entry& a, const link_entry& b )const {
+      return a.account == b.account && a.code == b.code && a.type == b.type;
+   }
+
+   bool authorization_cache::link_equal::operator()( const link_lookup& l, const link_entry& e )const {
+      return l.account == e.account && l.code == e.code && l.type == e.type;
+   }
+
+   bool authorization_cache::cacheable( account_name account )const {
+      if( lib < all_invalidated )
+         return false;
+      auto itr = invalidated.find( account );
+      return itr == invalidated.end() || itr->second <= lib;
+   }
+
+   template<typename Index>
+   void authorization_cache::insert( Index& idx, typename Index::value_type&& e ) {
+      auto [itr, inserted] = idx.insert( std::move(e) );
+      if( !inserted )
+         return; // added by another thread
+      auto& lru = idx.template get<by_lru>();
+      lru.relocate( lru.begin(), idx.template project<by_lru>( itr ) );
+      while( idx.size() > max_entries )
+         lru.pop_back();
+   }
+
+   std::optional<authorization_cache::authority_result>
+   authorization_cache::find_authority( const permission_object& permission,
+                                        fc::microseconds provided_delay,
+                                        const flat_set<public_key_type>& provided_keys )
+   {
+      std::lock_guard g( mtx );
+      if( !cacheable( permission.owner ) )
+         return {};
+      auto itr = authorities.find( authority_lookup{permission.id, permission.last_updated, provided_delay, provided_keys},
+                                   authority_hash(), authority_equal() );
+      if( itr == authorities.end() )
+         return {};
+      auto& lru = authorities.get<by_lru>();
+      lru.relocate( lru.begin(), authorities.project<by_lru>( itr ) );
+      return itr->result;
+   }
+
+   void authorization_cache::insert_authority( const permission_object& permission,
+                                               fc::microseconds provided_delay,
+                                               const flat_set<public_key_type>& provided_keys,
+                                               const authority_result& result )
+   {
+      std::lock_guard g( mtx );
+      if( !cacheable( permission.owner ) )
+         return;
+      insert( authorities, authority_entry{permission.owner, permission.id, permission.last_updated, provided_delay, provided_keys, result} );
+   }
+
+   std::optional<std::optional<permission_name>>
+   authorization_cache::find_link( account_name account, account_name code, action_name type ) {
+      std::lock_guard g( mtx );
+      if( !cacheable( account ) )
+         return {};
+      auto itr = links.find( link_lookup{account, code, type}, link_hash(), link_equal() );
+      if( itr == links.end() )
+         return {};
+      auto& lru = links.get<by_lru>();
+      lru.relocate( lru.begin(), links.project<by_lru>( itr ) );
+      return itr->linked;
+   }
+
+   void authorization_cache::insert_link( account_name account, account_name code, action_name type,
+                                          const std::optional<permission_name>& linked )
+   {
+      std::lock_guard g( mtx );
+      if( !cacheable( account ) )
+         return;
+      insert( links, link_entry{account, code, type, linked} );
+   }
+
+   void authorization_cache::invalidate( account_name account, uint32_t block_num ) {
+      std::lock_guard g( mtx );
+      auto [itr, inserted] = invalidated.emplace( account, block_num );
+      if( !inserted )
+         itr->second = std::max( itr->second, block_num );
+      authorities.get<by_account>().erase( account );
+      links.get<by_account>().erase( account );
+   }
+
+   void authorization_cache::invalidate_all( uint32_t block_num ) {
+      std::lock_guard g( mtx );
+      all_invalidated = block_num;
+      authorities.clear();
+      links.clear();
+   }
+
+   void authorization_cache::current_lib( uint32_t new_lib ) {
+      std::lock_guard g( mtx );
+      lib = new_lib;
+      std::erase_if( invalidated, [&]( const auto& i ) { return i.second <= lib; } );
+   }
+
+   size_t authorization_cache::authority_size()const {
+      std::lock_guard g( mtx );
+      return authorities.size();
+   }
+
+   size_t authorization_cache::link_size()const {
+      std::lock_guard g( mtx );
+      return links.size();
+   }
+
+} } /// namespace eosio::chain
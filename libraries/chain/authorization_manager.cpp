@@ -1,4 +1,5 @@
 #include <eosio/chain/authorization_manager.hpp>
+#include <eosio/chain/authorization_cache.hpp>
 #include <eosio/chain/exceptions.hpp>
 #include <eosio/chain/permission_object.hpp>
 #include <eosio/chain/permission_link_object.hpp>
@@ -21,8 +22,10 @@ namespace eosio { namespace chain {
       permission_link_index
    >;
 
-   authorization_manager::authorization_manager(controller& c, database& d)
-   :_control(c),_db(d){}
+   authorization_manager::authorization_manager(controller& c, database& d, uint32_t cache_size)
+   :_control(c),_db(d),_cache(std::make_unique<authorization_cache>(cache_size)){}
+
+   authorization_manager::~authorization_manager() = default;
 
    void authorization_manager::add_indices() {
       authorization_index_set::add_indices(_db);
@@ -176,6 +179,7 @@ namespace eosio { namespace chain {
             dm_logger->on_create_permission(p);
          }
       });
+      invalidate_cache( account );
       return perm;
    }
 
@@ -212,6 +216,7 @@ namespace eosio { namespace chain {
             dm_logger->on_create_permission(p);
          }
       });
+      invalidate_cache( account );
       return perm;
    }
 
@@ -235,6 +240,7 @@ namespace eosio { namespace chain {
             dm_logger->on_modify_permission(*old_permission, po);
          }
       });
+      invalidate_cache( permission.owner );
    }
 
    void authorization_manager::remove_permission( const permission_object& permission, bool is_trx_transient ) {
@@ -249,9 +255,23 @@ namespace eosio { namespace chain {
          dm_logger->on_remove_permission(permission);
       }
 
+      invalidate_cache( permission.owner );
       _db.remove( permission );
    }
 
+   void authorization_manager::invalidate_cache( account_name account ) {
+      if( _cache->enabled() )
+         _cache->invalidate( account, _control.head().block_num() + 1 ); // changes are made by the pending block
+   }
+
+   void authorization_manager::invalidate_cache() {
+      _cache->invalidate_all( _control.head().block_num() );
+   }
+
+   void authorization_manager::current_lib( uint32_t lib ) {
+      _cache->current_lib( lib );
+   }
+
    void authorization_manager::update_permission_usage( const permission_object& permission ) {
       const auto& puo = _db.get<permission_usage_object, by_id>( permission.usage_id );
       _db.modify( puo, [&](permission_usage_object& p) {
@@ -281,6 +301,11 @@ namespace eosio { namespace chain {
                                                                                  )const
    {
       try {
+         if( _cache->enabled() ) {
+            if( auto cached = _cache->find_link(authorizer_account, scope, act_name) )
+               return *cached;
+         }
+
          // First look up a specific link for this message act_name
          auto key = boost::make_tuple(authorizer_account, scope, act_name);
          auto link = _db.find<permission_link_object, by_action_name>(key);
@@ -291,10 +316,13 @@ namespace eosio { namespace chain {
          }
 
          // If no specific or default link found, use active permission
+         std::optional<permission_name> linked_permission;
          if (link != nullptr) {
-            return link->required_permission;
+            linked_permission = link->required_permission;
          }
-         return std::optional<permission_name>();
+         if( _cache->enabled() )
+            _cache->insert_link(authorizer_account, scope, act_name, linked_permission);
+         return linked_permission;
       } FC_CAPTURE_AND_RETHROW((authorizer_account)(scope)(act_name))
    }
 
@@ -475,6 +503,54 @@ namespace eosio { namespace chain {
 
    std::function<void()> authorization_manager::_noop_checktime{&noop_checktime};
 
+   template<typename Checker>
+   bool authorization_manager::satisfied( Checker&                             checker,
+                                          const permission_level&              level,
+                                          fc::microseconds                     provided_delay,
+                                          const flat_set<public_key_type>&     provided_keys,
+                                          const flat_set<permission_level>&    provided_permissions,
+                                          uint16_t                             max_authority_depth
+                                        )const
+   {
+      // Only authorities of keys and waits are cached, their result does not depend on other permissions.
+      // Provided permissions are not part of the cache key.
+      if( !_cache->enabled() || !provided_permissions.empty() || max_authority_depth == 0 )
+         return checker.satisfied( level, provided_delay );
+
+      const permission_object* permission = nullptr;
+      try {
+         permission = find_permission( level );
+      } catch( const permission_query_exception& ) {}
+      if( !permission || !permission->auth.accounts.empty() )
+         return checker.satisfied( level, provided_delay );
+
+      auto result = _cache->find_authority( *permission, provided_delay, provided_keys );
+      if( !result ) {
+         // evaluate on its own so that only the keys used by this permission are recorded
+         auto permission_checker = make_auth_checker( [&](const permission_level& p) -> const shared_authority* {
+                                                         if(const permission_object* po = find_permission(p))
+                                                            return &po->auth;
+                                                         else
+                                                            return nullptr;
+                                                      },
+                                                      max_authority_depth,
+                                                      provided_keys,
+                                                      {},
+                                                      provided_delay,
+                                                      _noop_checktime
+                                                    );
+         result.emplace();
+         result->satisfied = permission_checker.satisfied( level );
+         result->used_keys = permission_checker.used_key_flags();
+         _cache->insert_authority( *permission, provided_delay, provided_keys, *result );
+      }
+
+      // as for an uncached check, keys used by an unsatisfied permission are not used
+      if( result->satisfied )
+         checker.add_used_keys( result->used_keys );
+      return result->satisfied;
+   }
+
    void
    authorization_manager::check_authorization( const vector<action>&                actions,
                                                const flat_set<public_key_type>&     provided_keys,
@@ -492,13 +568,15 @@ namespace eosio { namespace chain {
 
       auto effective_provided_delay =  (provided_delay >= delay_max_limit) ? fc::microseconds::maximum() : provided_delay;
 
+      const uint16_t max_authority_depth = _control.get_global_properties().configuration.max_authority_depth;
+
       auto checker = make_auth_checker( [&](const permission_level& p) -> const shared_authority* {
                                           if(const permission_object* po = find_permission(p))
                                              return &po->auth;
                                           else
                                              return nullptr;
                                         },
-                                        _control.get_global_properties().configuration.max_authority_depth,
+                                        max_authority_depth,
                                         provided_keys,
                                         provided_permissions,
                                         effective_provided_delay,
@@ -563,7 +641,8 @@ namespace eosio { namespace chain {
       // ascending order of the actor name with ties broken by ascending order of the permission name.
       for( const auto& p : permissions_to_satisfy ) {
          checktime(); // TODO: this should eventually move into authority_checker instead
-         EOS_ASSERT( checker.satisfied( p.first, p.second ) || check_but_dont_fail, unsatisfied_authorization,
+         EOS_ASSERT( satisfied( checker, p.first, p.second, provided_keys, provided_permissions, max_authority_depth ) || check_but_dont_fail,
+                     unsatisfied_authorization,
                      "transaction declares authority '${auth}', "
                      "but does not have signatures for it under a provided delay of ${provided_delay} ms, "
                      "provided permissions ${provided_permissions}, provided keys ${provided_keys}, "
@@ -598,20 +677,25 @@ namespace eosio { namespace chain {
 
       auto delay_max_limit = fc::seconds( _control.get_global_properties().configuration.max_transaction_delay );
 
+      auto effective_provided_delay = ( provided_delay >= delay_max_limit ) ? fc::microseconds::maximum() : provided_delay;
+
+      const uint16_t max_authority_depth = _control.get_global_properties().configuration.max_authority_depth;
+
       auto checker = make_auth_checker( [&](const permission_level& p) -> const shared_authority* {
                                           if(const permission_object* po = find_permission(p))
                                              return &po->auth;
                                           else
                                              return nullptr;
                                         },
-                                        _control.get_global_properties().configuration.max_authority_depth,
+                                        max_authority_depth,
                                         provided_keys,
                                         provided_permissions,
-                                        ( provided_delay >= delay_max_limit ) ? fc::microseconds::maximum() : provided_delay,
+                                        effective_provided_delay,
                                         checktime
                                       );
 
-      EOS_ASSERT( checker.satisfied({account, permission}), unsatisfied_authorization,
+      EOS_ASSERT( satisfied( checker, {account, permission}, effective_provided_delay, provided_keys, provided_permissions, max_authority_depth ),
+                  unsatisfied_authorization,
                   "permission '${auth}' was not satisfied under a provided delay of ${provided_delay} ms, "
                   "provided permissions ${provided_permissions}, provided keys ${provided_keys}, "
                   "and a delay max limit of ${delay_max_limit_ms} ms",
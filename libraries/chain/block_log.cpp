@@ -4,8 +4,14 @@
 #include <eosio/chain/log_catalog.hpp>
 #include <eosio/chain/log_data_base.hpp>
 #include <eosio/chain/log_index.hpp>
+#include <eosio/chain/thread_utils.hpp>
 #include <fc/bitutil.hpp>
 #include <fc/io/raw.hpp>
+#include <fc/scoped_exit.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <mutex>
 #include <string>
 
@@ -15,6 +21,8 @@ static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
 
 namespace eosio { namespace chain {
 
+   namespace bio = boost::iostreams;
+
    enum versions {
       initial_version = 1,                  ///< complete block log from genesis
       block_x_start_version = 2,            ///< adds optional partial block log, cannot be used for replay without snapshot
@@ -453,12 +461,534 @@ namespace eosio { namespace chain {
          }
       }
 
+      /// Layout of a compressed block log, blocks-N-M.zlog
+      ///
+      ///   compressed_log_header
+      ///   preamble of the original block log, uncompressed
+      ///   frames, each an independently decompressible zlib stream of blocks_per_frame consecutive block entries
+      ///   frame table, (num_frames + 1) x compressed_frame_entry, the last entry marks the end of the frames
+      ///   num_blocks x uint64_t position of each block in the original block log, i.e. the original index
+      ///   compressed_log_trailer
+      ///
+      /// Block entries keep their trailing block position so that concatenating the preamble and the decompressed
+      /// frames restores the original block log byte for byte.
+      constexpr uint32_t compressed_log_magic   = 0x5a4c4f42;
+      constexpr uint32_t compressed_log_version = 1;
+
+      struct compressed_log_header {
+         static constexpr uint64_t packed_size = 4 * sizeof(uint32_t);
+
+         uint32_t magic            = compressed_log_magic;
+         uint32_t version          = compressed_log_version;
+         uint32_t blocks_per_frame = 0;
+         uint32_t preamble_size    = 0; // first block position in the original block log
+
+         template <typename Stream>
+         void write_to(Stream& ds) const {
+            fc::raw::pack(ds, magic);
+            fc::raw::pack(ds, version);
+            fc::raw::pack(ds, blocks_per_frame);
+            fc::raw::pack(ds, preamble_size);
+         }
+
+         template <typename Stream>
+         void read_from(Stream& ds) {
+            fc::raw::unpack(ds, magic);
+            fc::raw::unpack(ds, version);
+            fc::raw::unpack(ds, blocks_per_frame);
+            fc::raw::unpack(ds, preamble_size);
+         }
+      };
+
+      struct compressed_frame_entry {
+         uint64_t compressed_pos = 0; // position of the frame in the compressed file
+         uint64_t original_pos   = 0; // position of the first block entry of the frame in the original block log
+      };
+
+      struct compressed_log_trailer {
+         static constexpr uint64_t packed_size = 3 * sizeof(uint64_t) + 3 * sizeof(uint32_t);
+
+         uint64_t frame_table_pos     = 0;
+         uint64_t block_positions_pos = 0;
+         uint64_t original_size       = 0;
+         uint32_t num_frames          = 0;
+         uint32_t num_blocks          = 0;
+         uint32_t magic               = compressed_log_magic;
+
+         template <typename Stream>
+         void write_to(Stream& ds) const {
+            fc::raw::pack(ds, frame_table_pos);
+            fc::raw::pack(ds, block_positions_pos);
+            fc::raw::pack(ds, original_size);
+            fc::raw::pack(ds, num_frames);
+            fc::raw::pack(ds, num_blocks);
+            fc::raw::pack(ds, magic);
+         }
+
+         template <typename Stream>
+         void read_from(Stream& ds) {
+            fc::raw::unpack(ds, frame_table_pos);
+            fc::raw::unpack(ds, block_positions_pos);
+            fc::raw::unpack(ds, original_size);
+            fc::raw::unpack(ds, num_frames);
+            fc::raw::unpack(ds, num_blocks);
+            fc::raw::unpack(ds, magic);
+         }
+      };
+
+      std::vector<char> compress_frame(const std::vector<char>& data) {
+         std::vector<char> out;
+         bio::filtering_ostream comp;
+         comp.push(bio::zlib_compressor(bio::zlib::default_compression));
+         comp.push(bio::back_inserter(out));
+         bio::write(comp, data.data(), data.size());
+         bio::close(comp);
+         return out;
+      }
+
+      void decompress_frame(const std::vector<char>& data, std::vector<char>& out, uint64_t expected_size,
+                            const std::filesystem::path& path) {
+         out.clear();
+         out.reserve(expected_size);
+         try {
+            bio::filtering_ostream decomp;
+            decomp.push(bio::zlib_decompressor());
+            decomp.push(bio::back_inserter(out));
+            bio::write(decomp, data.data(), data.size());
+            bio::close(decomp);
+         } catch (const std::exception& e) {
+            EOS_THROW(block_log_exception, "Unable to decompress frame of ${path}: ${e}", ("path", path)("e", e.what()));
+         }
+         EOS_ASSERT(out.size() == expected_size, block_log_exception,
+                    "Decompressed frame of ${path} has size ${s}, expected ${e}",
+                    ("path", path)("s", out.size())("e", expected_size));
+      }
+
+      /// Provide the read only view of a compressed block log, see compressed_log_header for the layout.
+      /// Only the frame containing the requested block is decompressed, the last decompressed frame is cached.
+      class compressed_block_log_data {
+         fc::datastream<fc::cfile>           file;
+         compressed_log_header               header;
+         compressed_log_trailer              trailer;
+         block_log_preamble                  preamble;
+         std::vector<compressed_frame_entry> frames;
+         uint32_t                            cached_frame = std::numeric_limits<uint32_t>::max();
+         std::vector<char>                   frame_data; // decompressed content of cached_frame
+
+       public:
+         static constexpr const char* extension      = "zlog";
+         static constexpr const char* suffix_pattern = R"(-\d+-\d+\.zlog)";
+
+         compressed_block_log_data() = default;
+         explicit compressed_block_log_data(const std::filesystem::path& path) { open(path); }
+
+         void open(const std::filesystem::path& path) {
+            if (file.is_open())
+               file.close();
+            cached_frame = std::numeric_limits<uint32_t>::max();
+            frame_data.clear();
+
+            file.set_file_path(path);
+            file.open("rb");
+            file.seek_end(0);
+            const uint64_t file_size = file.tellp();
+            EOS_ASSERT(file_size >= compressed_log_header::packed_size + compressed_log_trailer::packed_size,
+                       block_log_exception, "${path} is too small to be a compressed block log", ("path", path));
+
+            file.seek(0);
+            header.read_from(file);
+            EOS_ASSERT(header.magic == compressed_log_magic, block_log_exception,
+                       "${path} is not a compressed block log", ("path", path));
+            EOS_ASSERT(header.version == compressed_log_version, block_log_unsupported_version,
+                       "Unsupported version ${v} of compressed block log ${path}", ("v", header.version)("path", path));
+            EOS_ASSERT(header.blocks_per_frame > 0, block_log_exception,
+                       "Compressed block log ${path} has no blocks per frame", ("path", path));
+            preamble.read_from(file, path);
+            EOS_ASSERT(file.tellp() == compressed_log_header::packed_size + header.preamble_size, block_log_exception,
+                       "Compressed block log ${path} has an inconsistent preamble size", ("path", path));
+
+            file.seek(file_size - compressed_log_trailer::packed_size);
+            trailer.read_from(file);
+            EOS_ASSERT(trailer.magic == compressed_log_magic && trailer.num_blocks > 0 &&
+                       trailer.num_frames == (trailer.num_blocks + header.blocks_per_frame - 1) / header.blocks_per_frame &&
+                       trailer.block_positions_pos + uint64_t(trailer.num_blocks) * sizeof(uint64_t) ==
+                          file_size - compressed_log_trailer::packed_size,
+                       block_log_exception, "Compressed block log ${path} has an invalid trailer", ("path", path));
+
+            frames.resize(trailer.num_frames + 1);
+            file.seek(trailer.frame_table_pos);
+            for (auto& f : frames) {
+               fc::raw::unpack(file, f.compressed_pos);
+               fc::raw::unpack(file, f.original_pos);
+            }
+         }
+
+         bool is_open() const { return file.is_open(); }
+
+         const block_log_preamble& get_preamble() const { return preamble; }
+
+         uint32_t      first_block_num() const { return preamble.first_block_num; }
+         uint32_t      last_block_num() const { return first_block_num() + num_blocks() - 1; }
+         uint32_t      num_blocks() const { return trailer.num_blocks; }
+         chain_id_type chain_id() const { return preamble.chain_id(); }
+
+         /// @return stream over the serialized block, valid until the next call
+         fc::datastream<const char*> ro_stream_for_block(uint32_t block_num) {
+            EOS_ASSERT(first_block_num() <= block_num && block_num <= last_block_num(), block_log_exception,
+                       "Block ${n} is not in compressed block log ${path}",
+                       ("n", block_num)("path", file.get_file_path()));
+            const uint32_t n     = block_num - first_block_num();
+            const uint64_t pos   = block_position(n);
+            const uint64_t end   = n + 1 < num_blocks() ? block_position(n + 1) : trailer.original_size;
+            const uint32_t frame = n / header.blocks_per_frame;
+            load_frame(frame);
+
+            const uint64_t offset = pos - frames[frame].original_pos;
+            EOS_ASSERT(pos >= frames[frame].original_pos && end >= pos + sizeof(uint64_t) &&
+                       offset + (end - pos) <= frame_data.size(), block_log_exception,
+                       "Compressed block log ${path} has an invalid position for block ${n}",
+                       ("path", file.get_file_path())("n", block_num));
+            return fc::datastream<const char*>(frame_data.data() + offset, end - pos - sizeof(uint64_t));
+         }
+
+         /// Restore the original block log to log_path and its index to index_path
+         void decompress_to(const std::filesystem::path& log_path, const std::filesystem::path& index_path) {
+            fc::datastream<fc::cfile> out;
+            out.set_file_path(log_path);
+            out.open(fc::cfile::truncate_rw_mode);
+
+            std::vector<char> buf(header.preamble_size);
+            file.seek(compressed_log_header::packed_size);
+            file.read(buf.data(), buf.size());
+            out.write(buf.data(), buf.size());
+
+            for (uint32_t i = 0; i < trailer.num_frames; ++i) {
+               load_frame(i);
+               out.write(frame_data.data(), frame_data.size());
+            }
+            EOS_ASSERT(out.tellp() == trailer.original_size, block_log_exception,
+                       "Decompressed ${path} has size ${s}, expected ${e}",
+                       ("path", file.get_file_path())("s", out.tellp())("e", trailer.original_size));
+            out.flush();
+            out.close();
+
+            buf.resize(uint64_t(trailer.num_blocks) * sizeof(uint64_t));
+            file.seek(trailer.block_positions_pos);
+            file.read(buf.data(), buf.size());
+            fc::cfile index;
+            index.set_file_path(index_path);
+            index.open(fc::cfile::truncate_rw_mode);
+            index.write(buf.data(), buf.size());
+            index.flush();
+            index.close();
+         }
+
+       private:
+         uint64_t block_position(uint32_t n) {
+            return read_data_at<uint64_t>(file, trailer.block_positions_pos + uint64_t(n) * sizeof(uint64_t));
+         }
+
+         void load_frame(uint32_t i) {
+            if (i == cached_frame)
+               return;
+            cached_frame = std::numeric_limits<uint32_t>::max();
+            const auto& f    = frames[i];
+            const auto& next = frames[i + 1];
+            EOS_ASSERT(next.compressed_pos > f.compressed_pos && next.original_pos > f.original_pos,
+                       block_log_exception, "Compressed block log ${path} has an invalid frame table",
+                       ("path", file.get_file_path()));
+
+            std::vector<char> compressed(next.compressed_pos - f.compressed_pos);
+            file.seek(f.compressed_pos);
+            file.read(compressed.data(), compressed.size());
+            decompress_frame(compressed, frame_data, next.original_pos - f.original_pos, file.get_file_path());
+            cached_frame = i;
+         }
+      };
+
+      /// Write the compressed form of the block log at log_path to zlog_path, see compressed_log_header for the layout
+      void compress_block_log_file(const std::filesystem::path& log_path, const std::filesystem::path& zlog_path,
+                                   uint32_t blocks_per_frame) {
+         EOS_ASSERT(blocks_per_frame > 0, block_log_exception, "blocks per frame must be greater than 0");
+
+         block_log_data log(log_path);
+         EOS_ASSERT(!log.is_currently_pruned(), block_log_unsupported_version,
+                    "Block log ${path} is currently in pruned format, it must be vacuumed before it can be compressed",
+                    ("path", log_path));
+         const uint32_t num_blocks = log.num_blocks();
+         EOS_ASSERT(num_blocks > 0, block_log_exception, "Block log ${path} does not contain any blocks", ("path", log_path));
+
+         // position of each block in block order, the same as the index
+         std::vector<uint64_t> positions(num_blocks);
+         auto& in = log.ro_stream_at(0);
+         auto iter = reverse_block_position_iterator{ in, log.first_block_position(), log.size() };
+         for (uint32_t i = num_blocks; i > 0; --i) {
+            EOS_ASSERT(!iter.done(), block_log_exception, "Block log ${path} has fewer blocks than expected", ("path", log_path));
+            positions[i - 1] = iter.get_value_then_advance();
+         }
+         EOS_ASSERT(positions.front() == log.first_block_position(), block_log_exception,
+                    "Block log ${path} has an invalid position for its first block", ("path", log_path));
+
+         std::filesystem::path tmp_path = zlog_path;
+         tmp_path += ".tmp";
+         fc::datastream<fc::cfile> out;
+         out.set_file_path(tmp_path);
+         out.open(fc::cfile::truncate_rw_mode);
+
+         compressed_log_header header;
+         header.blocks_per_frame = blocks_per_frame;
+         header.preamble_size    = log.first_block_position();
+         header.write_to(out);
+
+         std::vector<char> buf(header.preamble_size);
+         in.seek(0);
+         in.read(buf.data(), buf.size());
+         out.write(buf.data(), buf.size());
+
+         std::vector<compressed_frame_entry> frames;
+         for (uint64_t i = 0; i < num_blocks; i += blocks_per_frame) {
+            const uint64_t begin = positions[i];
+            const uint64_t end   = i + blocks_per_frame < num_blocks ? positions[i + blocks_per_frame] : log.size();
+            buf.resize(end - begin);
+            in.seek(begin);
+            in.read(buf.data(), buf.size());
+
+            frames.push_back({ .compressed_pos = out.tellp(), .original_pos = begin });
+            auto compressed = compress_frame(buf);
+            out.write(compressed.data(), compressed.size());
+         }
+         frames.push_back({ .compressed_pos = out.tellp(), .original_pos = log.size() });
+
+         compressed_log_trailer trailer;
+         trailer.frame_table_pos = out.tellp();
+         for (const auto& f : frames) {
+            fc::raw::pack(out, f.compressed_pos);
+            fc::raw::pack(out, f.original_pos);
+         }
+         trailer.block_positions_pos = out.tellp();
+         out.write(reinterpret_cast<const char*>(positions.data()), positions.size() * sizeof(uint64_t));
+         trailer.original_size = log.size();
+         trailer.num_frames    = frames.size() - 1;
+         trailer.num_blocks    = num_blocks;
+         trailer.write_to(out);
+         out.flush();
+         out.close();
+
+         std::filesystem::rename(tmp_path, zlog_path);
+      }
+
+      /// Parallel index construction and verification over a memory mapped, unpruned blocks.log.
+      ///
+      /// For construction the log is split into byte ranges. The first block entry in each range is found on its own
+      /// by scanning for a trailing block position that points back to a block numbered one less than the block at
+      /// the candidate, confirmed by following a few more trailing positions backwards. Each chunk is then walked
+      /// backwards from the start of the next chunk and must end exactly on its own start, so a false candidate or a
+      /// corrupt log is detected rather than producing a bad index.
+      class parallel_block_log_scan {
+         static constexpr uint64_t blknum_offset  = 14; // see block_log_data::block_num_at
+         static constexpr uint64_t min_entry_size = blknum_offset + sizeof(uint32_t) + sizeof(uint64_t);
+         static constexpr uint32_t confirm_hops   = 4;
+
+         bio::mapped_file_source log;
+         const char*             data            = nullptr;
+         uint64_t                first_block_pos = 0;
+         uint64_t                end_pos         = 0;
+         uint32_t                first_block_num = 0;
+         uint32_t                last_block_num  = 0;
+         uint32_t                num_threads     = 1;
+
+         struct chunk {
+            uint64_t                begin = 0;         // position of the first block entry, or end if no block starts in range
+            uint64_t                end   = 0;
+            std::optional<block_id_type> first_previous; // previous of the first block in the chunk
+            std::optional<block_id_type> last_id;        // id of the last block in the chunk
+         };
+
+       public:
+         inline static uint64_t min_chunk_size = 16 * 1024 * 1024; // lowered by unit tests
+
+         parallel_block_log_scan(const std::filesystem::path& log_path, uint32_t threads)
+            : num_threads(std::max(threads, 1u)) {
+            block_log_data log_data(log_path);
+            EOS_ASSERT(!log_data.is_currently_pruned(), block_log_unsupported_version,
+                       "Block log ${path} is currently in pruned format, it must be vacuumed first", ("path", log_path));
+            first_block_pos = log_data.first_block_position();
+            end_pos         = log_data.size();
+            first_block_num = log_data.first_block_num();
+            last_block_num  = first_block_num - 1;
+            if (end_pos > first_block_pos) {
+               last_block_num = log_data.last_block_num();
+               log.open(log_path.generic_string());
+               data = log.data();
+            }
+         }
+
+         uint32_t num_blocks() const { return last_block_num + 1 - first_block_num; }
+
+         /// Write the position of every block to index, which must hold num_blocks() entries
+         void construct_index(uint64_t* index) {
+            if (num_blocks() == 0)
+               return;
+            std::vector<chunk> chunks = split(end_pos - first_block_pos);
+
+            run("finding block boundaries", chunks, [&](chunk& c) { c.begin = find_entry_start(c.begin, c.end); });
+            // a chunk without a block start is covered by the previous one
+            std::erase_if(chunks, [&](const chunk& c) { return c.begin >= c.end && c.begin != first_block_pos; });
+            for (size_t i = 0; i < chunks.size(); ++i)
+               chunks[i].end = i + 1 < chunks.size() ? chunks[i + 1].begin : end_pos;
+            EOS_ASSERT(!chunks.empty() && chunks.front().begin == first_block_pos, block_log_exception,
+                       "Unable to locate the first block of the block log");
+
+            run("indexing", chunks, [&](chunk& c) { index_chunk(c, index); });
+         }
+
+         /// Fully validate every block entry against the positions in index, including that each block links to its
+         /// previous block
+         void verify(const uint64_t* index) {
+            const uint32_t n = num_blocks();
+            if (n == 0)
+               return;
+            const uint64_t per_chunk = std::max<uint64_t>(n / (num_threads * 8ull), 1);
+            std::vector<chunk> chunks;
+            for (uint64_t b = 0; b < n; b += per_chunk)
+               chunks.push_back({ .begin = b, .end = std::min<uint64_t>(b + per_chunk, n) });
+
+            run("verifying", chunks, [&](chunk& c) { verify_chunk(c, index); });
+
+            for (size_t i = 1; i < chunks.size(); ++i) {
+               EOS_ASSERT(chunks[i].first_previous == chunks[i - 1].last_id, block_log_exception,
+                          "Block ${num} does not link back to previous block. Expected previous: ${expected}. "
+                          "Actual previous: ${actual}.",
+                          ("num", first_block_num + chunks[i].begin)("expected", chunks[i - 1].last_id)
+                          ("actual", chunks[i].first_previous));
+            }
+         }
+
+       private:
+         uint64_t marker_before(uint64_t pos) const {
+            uint64_t v;
+            memcpy(&v, data + pos - sizeof(uint64_t), sizeof(v));
+            return v;
+         }
+
+         uint32_t block_num_at(uint64_t pos) const {
+            uint32_t prev_block_num;
+            memcpy(&prev_block_num, data + pos + blknum_offset, sizeof(prev_block_num));
+            return fc::endian_reverse_u32(prev_block_num) + 1;
+         }
+
+         std::vector<chunk> split(uint64_t size) const {
+            const uint64_t chunk_size = std::max<uint64_t>(size / (num_threads * 8ull) + 1, min_chunk_size);
+            std::vector<chunk> chunks;
+            for (uint64_t b = first_block_pos; b < end_pos; b += chunk_size)
+               chunks.push_back({ .begin = b, .end = std::min(b + chunk_size, end_pos) });
+            return chunks;
+         }
+
+         // confirmed by following trailing block positions back confirm_hops times or to the first block
+         bool is_entry_start(uint64_t pos) const {
+            if (pos == first_block_pos)
+               return true;
+            if (pos < first_block_pos + min_entry_size || pos + min_entry_size > end_pos)
+               return false;
+            for (uint32_t hop = 0; hop < confirm_hops && pos != first_block_pos; ++hop) {
+               const uint64_t prev = marker_before(pos);
+               if (prev < first_block_pos || prev + min_entry_size > pos || block_num_at(prev) + 1 != block_num_at(pos))
+                  return false;
+               pos = prev;
+            }
+            return true;
+         }
+
+         /// @return position of the first block entry in [begin, end), or end
+         uint64_t find_entry_start(uint64_t begin, uint64_t end) const {
+            for (uint64_t pos = begin; pos < end; ++pos) {
+               if (is_entry_start(pos))
+                  return pos;
+            }
+            return end;
+         }
+
+         void index_chunk(const chunk& c, uint64_t* index) const {
+            uint64_t pos      = c.end;
+            uint32_t expected = c.end == end_pos ? last_block_num : block_num_at(c.end) - 1;
+            while (pos > c.begin) {
+               const uint64_t prev = marker_before(pos);
+               EOS_ASSERT(prev >= c.begin && prev + min_entry_size <= pos, block_log_exception,
+                          "Block log formatting is incorrect, block position ${prev} before ${pos} is not in the range "
+                          "(${begin},${pos})", ("prev", prev)("pos", pos)("begin", c.begin));
+               const uint32_t block_num = block_num_at(prev);
+               EOS_ASSERT(block_num == expected && block_num >= first_block_num, block_log_exception,
+                          "At position ${pos} expected to find block number ${exp_bnum} but found ${act_bnum}",
+                          ("pos", prev)("exp_bnum", expected)("act_bnum", block_num));
+               index[block_num - first_block_num] = prev;
+               pos = prev;
+               --expected;
+            }
+            EOS_ASSERT(c.begin != first_block_pos || expected + 1 == first_block_num, block_log_exception,
+                       "Block log first block is ${act_bnum}, expected ${exp_bnum}",
+                       ("act_bnum", expected + 1)("exp_bnum", first_block_num));
+         }
+
+         void verify_chunk(chunk& c, const uint64_t* index) const {
+            std::optional<block_id_type> previous_id;
+            for (uint64_t i = c.begin; i < c.end; ++i) {
+               const uint32_t expected = first_block_num + i;
+               const uint64_t pos      = index[i];
+               const uint64_t next     = i + 1 < num_blocks() ? index[i + 1] : end_pos;
+               EOS_ASSERT(pos >= first_block_pos && pos + min_entry_size <= next && next <= end_pos &&
+                          marker_before(next) == pos, block_log_exception,
+                          "The block position for block ${num} at the end of its block entry is incorrect or does not "
+                          "agree with the index", ("num", expected));
+
+               fc::datastream<const char*> ds(data + pos, next - pos - sizeof(uint64_t));
+               signed_block entry;
+               fc::raw::unpack(ds, entry);
+               EOS_ASSERT(ds.remaining() == 0, block_log_exception,
+                          "Block ${num} has ${n} unexpected bytes at the end of its block entry",
+                          ("num", expected)("n", ds.remaining()));
+
+               const block_header& header = entry;
+               auto id = header.calculate_id();
+               EOS_ASSERT(block_header::num_from_id(id) == expected, block_log_exception,
+                          "At position ${pos} expected to find block number ${exp_bnum} but found ${act_bnum}",
+                          ("pos", pos)("exp_bnum", expected)("act_bnum", block_header::num_from_id(id)));
+               if (previous_id) {
+                  EOS_ASSERT(*previous_id == header.previous, block_log_exception,
+                             "Block ${num} (${id}) does not link back to previous block. "
+                             "Expected previous: ${expected}. Actual previous: ${actual}.",
+                             ("num", expected)("id", id)("expected", *previous_id)("actual", header.previous));
+               } else {
+                  c.first_previous = header.previous;
+               }
+               previous_id = id;
+            }
+            c.last_id = previous_id;
+         }
+
+         template <typename F>
+         void run(const char* desc, std::vector<chunk>& chunks, F&& f) {
+            sync_threaded_work<struct blklog> work;
+            std::atomic<size_t> done = 0;
+            for (auto& c : chunks) {
+               boost::asio::post(work.io_context(), [&]() {
+                  f(c);
+                  ++done;
+               });
+            }
+            work.run(std::min<size_t>(num_threads, chunks.size()), std::chrono::seconds(10), [&]() {
+               ilog("${desc}: ${done} of ${total} chunks", ("desc", desc)("done", done.load())("total", chunks.size()));
+            });
+         }
+      };
+
    } // namespace
 
    struct block_log_verifier {
       chain_id_type chain_id = chain_id_type::empty_chain_id();
 
-      void verify(block_log_data& log, const std::filesystem::path& log_path) {
+      template <typename LogData>
+      void verify(LogData& log, const std::filesystem::path& log_path) {
          if (chain_id.empty()) {
             chain_id = log.chain_id();
          } else {
@@ -467,7 +997,8 @@ namespace eosio { namespace chain {
          }
       }
    };
-   using block_log_catalog = eosio::chain::log_catalog<block_log_data, block_log_index, block_log_verifier>;
+   using block_log_catalog =
+         eosio::chain::log_catalog<block_log_data, block_log_index, block_log_verifier, compressed_block_log_data>;
 
    namespace detail {
 
@@ -1105,6 +1636,8 @@ namespace eosio { namespace chain {
                fc::datastream_mirror dsm(*ds, block_size);
                return read_block(dsm, block_num);
             }
+            if (auto cds = catalog.compressed_stream_for_block(block_num))
+               return read_block(*cds, block_num);
             return {};
          }
 
@@ -1115,6 +1648,8 @@ namespace eosio { namespace chain {
             if (ds) {
                return read_serialized_block(*ds, block_size);
             }
+            if (auto cds = catalog.compressed_stream_for_block(block_num))
+               return read_serialized_block(*cds, cds->remaining());
             return {};
          }
 
@@ -1122,6 +1657,8 @@ namespace eosio { namespace chain {
             auto ds = catalog.ro_stream_for_block(block_num);
             if (ds)
                return read_block_header(*ds, block_num);
+            if (auto cds = catalog.compressed_stream_for_block(block_num))
+               return read_block_header(*cds, block_num);
             return {};
          }
 
@@ -1280,6 +1817,9 @@ namespace eosio { namespace chain {
    block_log::~block_log() = default;
 
    void     block_log::set_initial_version(uint32_t ver) { detail::block_log_impl::default_initial_version = ver; }
+   void     block_log::set_parallel_index_min_chunk_size(uint64_t size) {
+      parallel_block_log_scan::min_chunk_size = std::max<uint64_t>(size, 1);
+   }
    uint32_t block_log::version() const {
       std::lock_guard g(my->mtx);
       return my->version();
@@ -1360,13 +1900,39 @@ namespace eosio { namespace chain {
    }
 
    // static
-   void block_log::construct_index(const std::filesystem::path& block_file_name, const std::filesystem::path& index_file_name) {
+   void block_log::construct_index(const std::filesystem::path& block_file_name, const std::filesystem::path& index_file_name,
+                                   uint32_t num_threads) {
 
       ilog("Will read existing blocks.log file ${file}", ("file", block_file_name));
       ilog("Will write new blocks.index file ${file}", ("file", index_file_name));
 
       block_log_data log_data(block_file_name);
-      log_data.construct_index(index_file_name);
+      if (num_threads <= 1 || log_data.is_currently_pruned()) {
+         log_data.construct_index(index_file_name);
+         return;
+      }
+      log_data.close();
+
+      parallel_block_log_scan scan(block_file_name, num_threads);
+      ilog("indexing ${n} blocks with ${t} threads", ("n", scan.num_blocks())("t", num_threads));
+      if (scan.num_blocks() == 0)
+         return;
+
+      std::filesystem::path tmp_index_file_name = index_file_name;
+      tmp_index_file_name += ".tmp";
+      auto remove_tmp_index = fc::make_scoped_exit([&tmp_index_file_name]() {
+         std::error_code ec;
+         std::filesystem::remove(tmp_index_file_name, ec);
+      });
+      {
+         bio::mapped_file_params params(tmp_index_file_name.generic_string());
+         params.flags         = bio::mapped_file::readwrite;
+         params.new_file_size = uint64_t(scan.num_blocks()) * sizeof(uint64_t);
+         bio::mapped_file_sink index(params);
+         scan.construct_index(reinterpret_cast<uint64_t*>(index.data()));
+      }
+      std::filesystem::rename(tmp_index_file_name, index_file_name);
+      remove_tmp_index.cancel();
    }
 
    std::tuple<uint64_t, uint32_t, std::string>
@@ -1475,6 +2041,15 @@ namespace eosio { namespace chain {
                                       [&](std::filesystem::path log_path) {
                                           first_block_file = std::move(log_path);
                                       });
+         if (first_block_file.empty()) {
+            std::optional<block_log_preamble> result;
+            for_each_file_in_dir_matches(retained_dir, R"(blocks-1-\d+\.zlog)",
+                                         [&](std::filesystem::path log_path) {
+                                             result = compressed_block_log_data(log_path).get_preamble();
+                                         });
+            if (result)
+               return result;
+         }
       }
 
       if (first_block_file.empty() && std::filesystem::exists(block_dir / "blocks.log")) {
@@ -1486,7 +2061,7 @@ namespace eosio { namespace chain {
       }
 
       if (!retained_dir.empty() && std::filesystem::exists(retained_dir)) {
-         const std::regex        my_filter(R"(blocks-\d+-\d+\.log)");
+         const std::regex        my_filter(R"(blocks-\d+-\d+\.z?log)");
          std::smatch             what;
          std::filesystem::directory_iterator end_itr; // Default ctor yields past-the-end
          for (std::filesystem::directory_iterator p(retained_dir); p != end_itr; ++p) {
@@ -1497,6 +2072,8 @@ namespace eosio { namespace chain {
             std::string file = p->path().filename().string();
             if (!std::regex_match(file, what, my_filter))
                continue;
+            if (p->path().extension() == ".zlog")
+               return compressed_block_log_data(p->path()).get_preamble();
             return block_log_data(p->path()).get_preamble();
          }
       }
@@ -1711,6 +2288,23 @@ namespace eosio { namespace chain {
       }
    }
 
+   // static
+   void block_log::full_smoke_test(const std::filesystem::path& block_dir, uint32_t num_threads) {
+      {
+         block_log_bundle log_bundle(block_dir);
+         ilog("block log version= ${version}", ("version", log_bundle.log_data.version()));
+         ilog("first block= ${first}", ("first", log_bundle.log_data.first_block_num()));
+         ilog("last block= ${last}", ("last", log_bundle.log_data.last_block_num()));
+         ilog("blocks.log and blocks.index agree on number of blocks");
+      }
+
+      parallel_block_log_scan scan(block_dir / "blocks.log", num_threads);
+      if (scan.num_blocks() == 0)
+         return;
+      bio::mapped_file_source index((block_dir / "blocks.index").generic_string());
+      scan.verify(reinterpret_cast<const uint64_t*>(index.data()));
+   }
+
    std::pair<std::filesystem::path, std::filesystem::path> blocklog_files(const std::filesystem::path& dir, uint32_t start_block_num, uint32_t num_blocks) {
       const int bufsize = 64;
       char      buf[bufsize];
@@ -1803,6 +2397,11 @@ namespace eosio { namespace chain {
       file.set_file_path(temp_block_log);
 
       for (auto const& [first_block_num, val] : catalog.collection) {
+         if (val.compressed) {
+            wlog("${file}.${ext} is compressed, skip merging. Decompress it first to include it in the merged block log.",
+                 ("file", val.filename_base)("ext", compressed_block_log_data::extension));
+            continue;
+         }
          if (std::filesystem::exists(temp_block_log)) {
             if (first_block_num == end_block + 1) {
                block_log_data log_data;
@@ -1841,4 +2440,54 @@ namespace eosio { namespace chain {
       }
    }
 
+   // static
+   uint32_t block_log::compress_blocklogs(const std::filesystem::path& block_dir, uint32_t blocks_per_frame,
+                                          bool keep_original) {
+      std::vector<std::filesystem::path> logs;
+      for_each_file_in_dir_matches(block_dir, R"(blocks-\d+-\d+\.log)",
+                                   [&](std::filesystem::path log_path) { logs.push_back(std::move(log_path)); });
+      std::sort(logs.begin(), logs.end());
+
+      for (const auto& log_path : logs) {
+         auto zlog_path = log_path;
+         zlog_path.replace_extension(compressed_block_log_data::extension);
+         ilog("Compressing ${log} to ${zlog}", ("log", log_path)("zlog", zlog_path));
+         compress_block_log_file(log_path, zlog_path, blocks_per_frame);
+         if (!keep_original) {
+            auto index_path = log_path;
+            std::filesystem::remove(log_path);
+            std::filesystem::remove(index_path.replace_extension("index"));
+         }
+      }
+      return logs.size();
+   }
+
+   // static
+   uint32_t block_log::decompress_blocklogs(const std::filesystem::path& block_dir, bool keep_compressed) {
+      std::vector<std::filesystem::path> zlogs;
+      for_each_file_in_dir_matches(block_dir, std::string("blocks") + compressed_block_log_data::suffix_pattern,
+                                   [&](std::filesystem::path zlog_path) { zlogs.push_back(std::move(zlog_path)); });
+      std::sort(zlogs.begin(), zlogs.end());
+
+      for (const auto& zlog_path : zlogs) {
+         auto log_path = zlog_path;
+         log_path.replace_extension("log");
+         auto index_path = zlog_path;
+         index_path.replace_extension("index");
+         ilog("Decompressing ${zlog} to ${log}", ("zlog", zlog_path)("log", log_path));
+         // the catalog prefers an uncompressed log over a compressed one, only expose it once complete
+         auto tmp_log_path   = log_path;
+         auto tmp_index_path = index_path;
+         {
+            compressed_block_log_data log(zlog_path);
+            log.decompress_to(tmp_log_path += ".tmp", tmp_index_path += ".tmp");
+         }
+         std::filesystem::rename(tmp_index_path, index_path);
+         std::filesystem::rename(tmp_log_path, log_path);
+         if (!keep_compressed)
+            std::filesystem::remove(zlog_path);
+      }
+      return zlogs.size();
+   }
+
 }} // namespace eosio::chain
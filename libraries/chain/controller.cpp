@@ -20,6 +20,7 @@
 
 #include <eosio/chain/protocol_feature_manager.hpp>
 #include <eosio/chain/authorization_manager.hpp>
+#include <eosio/chain/recovered_key_cache.hpp>
 #include <eosio/chain/resource_limits.hpp>
 #include <eosio/chain/subjective_billing.hpp>
 #include <eosio/chain/chain_snapshot.hpp>
@@ -28,6 +29,7 @@
 #include <eosio/chain/platform_timer.hpp>
 #include <eosio/chain/block_header_state_utils.hpp>
 #include <eosio/chain/deep_mind.hpp>
+#include <eosio/chain/db_access_tracer.hpp>
 #include <eosio/chain/finalizer.hpp>
 #include <eosio/chain/finalizer_policy.hpp>
 #include <eosio/chain/qc.hpp>
@@ -1001,6 +1003,7 @@ struct controller_impl {
    struct chain; // chain is a namespace so use an embedded type for the named_thread_pool tag
    named_thread_pool<chain>        thread_pool;
    deep_mind_handler*              deep_mind_logger = nullptr;
+   db_access_tracer*               db_access_tracer_ptr = nullptr;
    bool                            okay_to_print_integrity_hash_on_stop = false;
    bool                            testing_allow_voting = false; // used in unit tests to create long forks or simulate not getting votes
    async_t                         async_voting = async_t::yes;  // by default we post `create_and_send_vote_msg()` calls, used in tester
@@ -1015,6 +1018,7 @@ struct controller_impl {
    thread_local static vm::wasm_allocator wasm_alloc; // a copy for main thread and each read-only thread
 #endif
    wasm_interface wasmif;
+   bool           save_wasm_warm_code_on_stop = false; // set once the warm code list was considered at startup
    app_window_type app_window = app_window_type::write;
 
    typedef pair<scope_name,action_name>                   handler_key;
@@ -1279,9 +1283,9 @@ struct controller_impl {
         cfg.read_only ? database::read_only : database::read_write,
         cfg.state_size, false, cfg.db_map_mode ),
     blog( cfg.blocks_dir, cfg.blog ),
-    fork_db_(cfg.blocks_dir / config::reversible_blocks_dir_name),
+    fork_db_(cfg.blocks_dir / config::reversible_blocks_dir_name, cfg.fork_db_journal),
     resource_limits( db, [&s](bool is_trx_transient) { return s.get_deep_mind_logger(is_trx_transient); }),
-    authorization( s, db ),
+    authorization( s, db, cfg.authorization_cache_size ),
     protocol_features( std::move(pfs), [&s](bool is_trx_transient) { return s.get_deep_mind_logger(is_trx_transient); } ),
     conf( cfg ),
     chain_id( chain_id ),
@@ -1300,7 +1304,6 @@ struct controller_impl {
          elog( "Exception in vote thread pool, exiting: ${e}", ("e", e.to_detail_string()) );
          if( shutdown ) shutdown();
       } );
-
       set_activation_handler<builtin_protocol_feature_t::preactivate_feature>();
       set_activation_handler<builtin_protocol_feature_t::replace_deferred>();
       set_activation_handler<builtin_protocol_feature_t::get_sender>();
@@ -1315,10 +1318,12 @@ struct controller_impl {
       set_activation_handler<builtin_protocol_feature_t::bls_primitives>();
       set_activation_handler<builtin_protocol_feature_t::disable_deferred_trxs_stage_2>();
       set_activation_handler<builtin_protocol_feature_t::savanna>();
+      set_activation_handler<builtin_protocol_feature_t::bulk_db_iteration>();
 
       irreversible_block.connect([this](const block_signal_params& t) {
          const auto& [ block, id] = t;
          wasmif.current_lib(block->block_num());
+         authorization.current_lib(block->block_num());
          vote_processor.notify_lib(block->block_num());
       });
 
@@ -2039,12 +2044,24 @@ struct controller_impl {
          ilog( "chain database started with hash: ${hash}", ("hash", calculate_integrity_hash()) );
       okay_to_print_integrity_hash_on_stop = true;
 
+      // changes made by reversible blocks already applied to the database were not seen by the authorization cache
+      authorization.invalidate_cache();
+
       replaying = true;
       auto replay_reset = fc::make_scoped_exit([&](){ replaying = false; });
       replay( startup ); // replay any irreversible and reversible blocks ahead of current head
 
       if( check_shutdown() ) return;
 
+      if( conf.wasm_warm_cache_size > 0 ) {
+         try {
+            auto count = wasmif.warm_from_code_list( conf.state_dir / config::wasm_warm_code_filename );
+            if( count > 0 )
+               ilog( "instantiating ${n} contracts used before the last shutdown in the background", ("n", count) );
+         } FC_LOG_AND_DROP(("Unable to load ${f}", ("f", config::wasm_warm_code_filename)))
+         save_wasm_warm_code_on_stop = true;
+      }
+
       // At this point chain_head != nullptr && fork_db.head() != nullptr && fork_db.root() != nullptr.
       // Furthermore, fork_db.root()->block_num() <= lib_num.
       // Also, even though blog.head() may still be nullptr, blog.first_block_num() is guaranteed to be lib_num + 1.
@@ -2090,6 +2107,14 @@ struct controller_impl {
       //only log this not just if configured to, but also if initialization made it to the point we'd log the startup too
       if(okay_to_print_integrity_hash_on_stop && conf.integrity_hash_on_stop)
          ilog( "chain database stopped with hash: ${hash}", ("hash", calculate_integrity_hash()) );
+      if(save_wasm_warm_code_on_stop) {
+         try {
+            wasmif.save_warm_code_list(conf.state_dir / config::wasm_warm_code_filename, conf.wasm_warm_cache_size);
+         } FC_LOG_AND_DROP(("Unable to write ${f}", ("f", config::wasm_warm_code_filename)))
+      }
+      const auto key_cache_stats = recovered_key_cache::instance().get_stats();
+      dlog( "recovered key cache hits: ${h}, misses: ${m}, hit ratio: ${r}",
+            ("h", key_cache_stats.hits)("m", key_cache_stats.misses)("r", key_cache_stats.hit_ratio()) );
    }
 
    void add_indices() {
@@ -3164,6 +3189,9 @@ struct controller_impl {
          // The head block represents the block just before this one that is about to start, so add 1 to get this block num
          dm_logger->on_start_block(chain_head.block_num() + 1);
       }
+      if (db_access_tracer_ptr) {
+         db_access_tracer_ptr->on_start_block(chain_head.block_num() + 1);
+      }
 
       auto guard_pending = fc::make_scoped_exit([this, head_block_num=chain_head.block_num()]() {
          protocol_features.popped_blocks_to( head_block_num );
@@ -3492,6 +3520,10 @@ struct controller_impl {
                         });
          }
 
+         if (db_access_tracer_ptr) {
+            db_access_tracer_ptr->on_accepted_block(chain_head.id());
+         }
+
          log_applied(s);
 
          ch.dismiss(); // don't reset chain_head if no exception
@@ -4586,6 +4618,7 @@ struct controller_impl {
 
          if (permission.auth != auth) {
             db.modify(permission, [&](auto& po) { po.auth = auth; });
+            authorization.invalidate_cache(config::producers_account_name);
          }
       };
 
@@ -4795,6 +4828,11 @@ struct controller_impl {
       return is_trx_transient ? nullptr : deep_mind_logger;
    }
 
+   inline db_access_tracer* get_db_access_tracer(bool is_trx_transient) const {
+      // read-only and dry-run transactions run in parallel on read-only threads and do not change state
+      return is_trx_transient ? nullptr : db_access_tracer_ptr;
+   }
+
    void set_savanna_lib_id(const block_id_type& id) {
       fork_db_.apply_s<void>([&](auto& fork_db) {
          fork_db.set_pending_savanna_lib_id(id);
@@ -5862,7 +5900,7 @@ void controller::validate_expiration( const transaction& trx )const { try {
                ("max_til_exp",chain_configuration.max_transaction_lifetime) );
 } FC_CAPTURE_AND_RETHROW((trx)) }
 
-void controller::validate_tapos( const transaction& trx )const { try {
+void controller::validate_tapos( const transaction_header& trx )const { try {
    const auto& tapos_block_summary = db().get<block_summary_object>((uint16_t)trx.ref_block_num);
 
    //Verify TaPoS block summary has correct ID prefix, and that this block's time is not past the expiration
@@ -5963,6 +6001,15 @@ void controller::enable_deep_mind(deep_mind_handler* logger) {
    my->deep_mind_logger = logger;
 }
 
+db_access_tracer* controller::get_db_access_tracer(bool is_trx_transient)const {
+   return my->get_db_access_tracer(is_trx_transient);
+}
+
+void controller::enable_db_access_tracing(db_access_tracer* tracer) {
+   EOS_ASSERT( tracer != nullptr, misc_exception, "Invalid tracer passed into enable_db_access_tracing, must be set" );
+   my->db_access_tracer_ptr = tracer;
+}
+
 uint32_t controller::earliest_available_block_num() const{
    return my->earliest_available_block_num();
 }
@@ -6289,6 +6336,13 @@ void controller_impl::on_activation<builtin_protocol_feature_t::savanna>() {
    } );
 }
 
+template<>
+void controller_impl::on_activation<builtin_protocol_feature_t::bulk_db_iteration>() {
+   db.modify( db.get<protocol_state_object>(), [&]( auto& ps ) {
+      add_intrinsic_to_whitelist( ps.whitelisted_intrinsics, "db_get_rows_i64" );
+   } );
+}
+
 /// End of protocol feature activation handlers
 
 } /// eosio::chain
@@ -0,0 +1,127 @@
+#include <eosio/chain/db_access_tracer.hpp>
+#include <eosio/chain/exceptions.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+
+#include <bit>
+
+namespace eosio { namespace chain {
+
+   size_t db_access_table_stats::bytes_bucket( uint32_t bytes ) {
+      return std::min<size_t>( std::bit_width( bytes ), num_bytes_buckets - 1 );
+   }
+
+   db_access_tracer::db_access_tracer( const std::filesystem::path& dump_file ) {
+      if( !dump_file.empty() ) {
+         _dump_file.set_file_path( dump_file );
+         _dump_file.open( fc::cfile::create_or_update_rw_mode );
+      }
+   }
+
+   void db_access_tracer::register_summary_callback( summary_callback&& cb ) {
+      _callbacks.emplace_back( std::move(cb) );
+   }
+
+   void db_access_tracer::on_start_block( uint32_t block_num ) {
+      _block_num = block_num;
+      _transactions = 0;
+      _trx_accesses.clear();
+      _block_accesses.clear();
+   }
+
+   void db_access_tracer::on_squash_transaction() {
+      if( _trx_accesses.empty() )
+         return;
+      ++_transactions;
+      _block_accesses.insert( _block_accesses.end(), _trx_accesses.begin(), _trx_accesses.end() );
+      _trx_accesses.clear();
+   }
+
+   void db_access_tracer::on_accepted_block( const block_id_type& id ) {
+      db_access_block_summary summary = summarize( _block_accesses );
+      summary.block_num    = _block_num;
+      summary.block_id     = id;
+      summary.transactions = _transactions;
+      _block_accesses.clear();
+
+      if( _dump_file.is_open() ) {
+         const uint32_t size = fc::raw::pack_size( summary );
+         fc::raw::pack( _dump_file, size );
+         fc::raw::pack( _dump_file, summary );
+         _dump_file.flush();
+      }
+
+      for( const auto& cb : _callbacks )
+         cb( summary );
+   }
+
+   db_access_block_summary db_access_tracer::summarize( const vector<db_access>& accesses ) {
+      using table_key = std::pair<account_name, table_name>;
+      boost::container::flat_map<table_key, db_access_table_stats>         tables;
+      boost::container::flat_map<account_name, db_access_account_stats>   accounts;
+      boost::container::flat_set<std::pair<table_key, scope_name>>          scopes;
+      boost::container::flat_set<std::tuple<table_key, scope_name, db_index_type, uint64_t>> rows;
+
+      for( const auto& a : accesses ) {
+         const table_key key{ a.code, a.table };
+         auto& t = tables[key];
+         auto& r = accounts[a.receiver];
+         if( a.type == db_access_type::read ) {
+            ++t.reads;
+            t.read_bytes += a.bytes;
+            ++r.reads;
+            r.read_bytes += a.bytes;
+         } else {
+            ++t.writes;
+            t.write_bytes += a.bytes;
+            ++r.writes;
+            r.write_bytes += a.bytes;
+         }
+         ++t.bytes_histogram[db_access_table_stats::bytes_bucket( a.bytes )];
+         scopes.emplace( key, a.scope );
+         rows.emplace( key, a.scope, a.index, a.primary_key );
+      }
+
+      for( const auto& [key, scope] : scopes )
+         ++tables[key].scopes;
+      for( const auto& row : rows )
+         ++tables[std::get<0>(row)].rows;
+
+      db_access_block_summary summary;
+      summary.tables.reserve( tables.size() );
+      for( auto& [key, t] : tables ) {
+         t.code  = key.first;
+         t.table = key.second;
+         summary.tables.push_back( t );
+      }
+      summary.accounts.reserve( accounts.size() );
+      for( auto& [receiver, r] : accounts ) {
+         r.receiver = receiver;
+         summary.accounts.push_back( r );
+      }
+      return summary;
+   }
+
+   vector<db_access_block_summary> db_access_tracer::read_dump_file( const std::filesystem::path& dump_file ) {
+      vector<db_access_block_summary> summaries;
+      try {
+         fc::datastream<fc::cfile> f;
+         f.set_file_path( dump_file );
+         f.open( "rb" );
+         const auto file_size = std::filesystem::file_size( dump_file );
+         while( f.tellp() < file_size ) {
+            uint32_t size = 0;
+            fc::raw::unpack( f, size );
+            const auto start = f.tellp();
+            fc::raw::unpack( f, summaries.emplace_back() );
+            EOS_ASSERT( f.tellp() - start == size, chain_exception,
+                        "corrupted db access dump file ${f}, summary of ${s} bytes expected", ("f", dump_file)("s", size) );
+         }
+      } FC_CAPTURE_AND_RETHROW( (dump_file) );
+      return summaries;
+   }
+
+} } /// namespace eosio::chain
@@ -467,6 +467,8 @@ void apply_eosio_linkauth(apply_context& context) {
          );
       }
 
+      context.control.get_mutable_authorization_manager().invalidate_cache(requirement.account);
+
   } FC_CAPTURE_AND_RETHROW((requirement))
 }
 
@@ -494,6 +496,8 @@ void apply_eosio_unlinkauth(apply_context& context) {
    );
 
    db.remove(*link);
+
+   context.control.get_mutable_authorization_manager().invalidate_cache(unlink.account);
 }
 
 void apply_eosio_canceldelay(apply_context& context) {
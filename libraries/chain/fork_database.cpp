@@ -1,4 +1,5 @@
 #include <eosio/chain/fork_database.hpp>
+#include <eosio/chain/fork_database_journal.hpp>
 #include <eosio/chain/exceptions.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -8,8 +9,11 @@
 #include <boost/multi_index/composite_key.hpp>
 #include <fc/io/fstream.hpp>
 #include <fc/io/cfile.hpp>
+#include <fc/scoped_exit.hpp>
+#include <array>
 #include <fstream>
 #include <mutex>
+#include <unordered_map>
 
 namespace eosio::chain {
    using boost::multi_index_container;
@@ -85,12 +89,45 @@ namespace eosio::chain {
                     ordered_non_unique<tag<by_prev>, const_mem_fun<bs_t, const block_id_type&, &bs_t::previous>>,
                     by_best_branch_t>>;
 
+      /**
+       * Immutable snapshot of root, head and the blocks of the index. Republished by writers under mtx after every
+       * modification so that lookups by id, head and root never wait on mtx behind the main thread adding blocks or
+       * advancing root. Blocks are split into shards that are shared between snapshots, an add only copies the
+       * one shard it modifies.
+       */
+      struct view_t {
+         static constexpr size_t num_shards = 64;
+         using shard_t = std::unordered_map<block_id_type, bsp_t, std::hash<block_id_type>>;
+
+         bsp_t                                                  root;
+         bsp_t                                                  head;
+         block_id_type                                          pending_savanna_lib_id;
+         size_t                                                 size = 0;
+         std::array<std::shared_ptr<const shard_t>, num_shards> shards;
+
+         // first 32 bits of an id are the block number, use the hash part
+         static size_t shard_of( const block_id_type& id ) { return id._hash[1] % num_shards; }
+
+         bsp_t get_block( const block_id_type& id, include_root_t include_root ) const;
+         bool  validated_block_exists( const block_id_type& id, const block_id_type& claimed_id ) const;
+      };
+      using view_ptr = std::shared_ptr<const view_t>;
+
       std::mutex             mtx;
       bsp_t                  root;
       block_id_type          pending_savanna_lib_id; // under Savanna the id of what will become root
       fork_multi_index_type  index;
 
-      explicit fork_database_impl() = default;
+      view_ptr                   view;          // only accessed through std::atomic_load/std::atomic_store
+      std::vector<block_id_type> modified_ids;  // inserted into or erased from index since the last publish_view()
+      bool                       modified_all = true; // index cleared, or a publish failed, since the last publish_view()
+      fork_database_journal*     journal = nullptr;
+
+      explicit fork_database_impl() { publish_view(); }
+
+      view_ptr         get_view() const { return std::atomic_load( &view ); }
+      void             publish_view();
+      void             try_publish_view();
 
       void             open_impl( const char* desc, const std::filesystem::path& fork_db_file, fc::cfile_datastream& ds, validator_t& validator );
       void             close_impl( std::ofstream& out );
@@ -98,8 +135,6 @@ namespace eosio::chain {
       bool             is_valid() const;
 
       bsp_t            get_block_impl( const block_id_type& id, include_root_t include_root = include_root_t::no ) const;
-      bool             block_exists_impl( const block_id_type& id ) const;
-      bool             validated_block_exists_impl( const block_id_type& id, const block_id_type& claimed_id ) const;
       void             reset_root_impl( const bsp_t& root_bs );
       void             advance_root_impl( const block_id_type& id );
       void             remove_impl( const block_id_type& id );
@@ -123,9 +158,61 @@ namespace eosio::chain {
    template<class BSP>
    fork_database_t<BSP>::~fork_database_t() = default; // close is performed in fork_database::~fork_database()
 
+   // called with mtx held
+   template<class BSP>
+   void fork_database_impl<BSP>::publish_view() {
+      auto cur = get_view();
+      auto v = std::make_shared<view_t>();
+      v->root = root;
+      v->head = head_impl(include_root_t::no);
+      v->pending_savanna_lib_id = pending_savanna_lib_id;
+      v->size = index.size();
+
+      using shard_t = typename view_t::shard_t;
+      if (modified_all || !cur) {
+         std::array<std::shared_ptr<shard_t>, view_t::num_shards> shards;
+         for (auto& s : shards)
+            s = std::make_shared<shard_t>();
+         for (const auto& b : index)
+            shards[view_t::shard_of(b->id())]->emplace(b->id(), b);
+         for (size_t i = 0; i < view_t::num_shards; ++i)
+            v->shards[i] = std::move(shards[i]);
+      } else {
+         v->shards = cur->shards;
+         std::array<std::shared_ptr<shard_t>, view_t::num_shards> copied;
+         for (const auto& id : modified_ids) {
+            auto s = view_t::shard_of(id);
+            if (!copied[s]) {
+               copied[s] = std::make_shared<shard_t>(*cur->shards[s]);
+               v->shards[s] = copied[s];
+            }
+            if (auto itr = index.find(id); itr != index.end())
+               copied[s]->insert_or_assign(id, *itr);
+            else
+               copied[s]->erase(id);
+         }
+      }
+
+      modified_ids.clear();
+      modified_all = false;
+      std::atomic_store( &view, view_ptr{std::move(v)} );
+   }
+
+   // called with mtx held from a scoped_exit, possibly while unwinding, so failures are logged rather than thrown.
+   // Readers keep the last published view, stale until the next publish rebuilds it from the whole index.
+   template<class BSP>
+   void fork_database_impl<BSP>::try_publish_view() {
+      try {
+         publish_view();
+         return;
+      } FC_LOG_AND_DROP(("Unable to publish fork database view"));
+      modified_all = true;
+   }
+
    template<class BSP>
    void fork_database_t<BSP>::open( const char* desc, const std::filesystem::path& fork_db_file, fc::cfile_datastream& ds, validator_t& validator ) {
       std::lock_guard g( my->mtx );
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
       my->open_impl( desc, fork_db_file, ds, validator );
    }
 
@@ -148,13 +235,13 @@ namespace eosio::chain {
    template<class BSP>
    void fork_database_t<BSP>::close(std::ofstream& out) {
       std::lock_guard g( my->mtx );
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
       my->close_impl(out);
    }
 
    template<class BSP>
    size_t fork_database_t<BSP>::size() const {
-      std::lock_guard g( my->mtx );
-      return my->index.size();
+      return my->get_view()->size;
    }
 
    template<class BSP>
@@ -182,12 +269,16 @@ namespace eosio::chain {
       }
 
       index.clear();
+      modified_all = true;
    }
 
    template<class BSP>
    void fork_database_t<BSP>::reset_root( const bsp_t& root_bsp ) {
       std::lock_guard g( my->mtx );
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
       my->reset_root_impl(root_bsp);
+      if (my->journal)
+         my->journal->reset_root(my->root);
    }
 
    template<class BSP>
@@ -197,12 +288,16 @@ namespace eosio::chain {
       root->set_valid(true);
       pending_savanna_lib_id = block_id_type{};
       index.clear();
+      modified_all = true;
    }
 
    template<class BSP>
    void fork_database_t<BSP>::advance_root( const block_id_type& id ) {
       std::lock_guard g( my->mtx );
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
       my->advance_root_impl( id );
+      if (my->journal)
+         my->journal->advance_root(my->root);
    }
 
    template<class BSP>
@@ -227,6 +322,7 @@ namespace eosio::chain {
       // The new root block should be erased from the fork database index individually rather than with the remove method,
       // because we do not want the blocks branching off of it to be removed from the fork database.
       index.erase( index.find( id ) );
+      modified_ids.push_back( id );
 
       // The other blocks to be removed are removed using the remove method so that orphaned branches do not remain in the fork database.
       for( const auto& block_id : blocks_to_remove ) {
@@ -286,6 +382,7 @@ namespace eosio::chain {
 
       if (!inserted.second)
          return fork_db_add_t::duplicate;
+      modified_ids.push_back( n->id() );
       const bool new_head = n == head_impl(include_root_t::no);
       if (new_head && n->previous() == prev_head->id())
          return fork_db_add_t::appended_to_head;
@@ -298,16 +395,36 @@ namespace eosio::chain {
    template<class BSP>
    fork_db_add_t fork_database_t<BSP>::add( const bsp_t& n, ignore_duplicate_t ignore_duplicate ) {
       std::lock_guard g( my->mtx );
-      return my->add_impl(n, ignore_duplicate, false,
-                          [](block_timestamp_type         timestamp,
-                             const flat_set<digest_type>& cur_features,
-                             const vector<digest_type>&   new_features) {});
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
+      auto result = my->add_impl(n, ignore_duplicate, false,
+                                 [](block_timestamp_type         timestamp,
+                                    const flat_set<digest_type>& cur_features,
+                                    const vector<digest_type>&   new_features) {});
+      if (my->journal && result != fork_db_add_t::duplicate)
+         my->journal->add(n);
+      return result;
    }
 
    template<class BSP>
-   bool fork_database_t<BSP>::is_valid() const {
+   void fork_database_t<BSP>::set_journal( fork_database_journal* journal ) {
       std::lock_guard g( my->mtx );
-      return my->is_valid();
+      my->journal = journal;
+      if (!journal || !my->root)
+         return;
+      // seed the journal with the current state, parents are added before their children
+      journal->reset_root(my->root);
+      if constexpr (std::is_same_v<BSP, block_state_ptr>) {
+         if (my->pending_savanna_lib_id != block_id_type{})
+            journal->set_pending_savanna_lib_id(my->pending_savanna_lib_id);
+      }
+      const auto& indx = my->index.template get<by_best_branch>();
+      for (auto itr = indx.rbegin(); itr != indx.rend(); ++itr)
+         journal->add(*itr);
+   }
+
+   template<class BSP>
+   bool fork_database_t<BSP>::is_valid() const {
+      return !!my->get_view()->root;
    }
 
    template<class BSP>
@@ -317,20 +434,20 @@ namespace eosio::chain {
 
    template<class BSP>
    bool fork_database_t<BSP>::has_root() const {
-      std::lock_guard g( my->mtx );
-      return !!my->root;
+      return !!my->get_view()->root;
    }
 
    template<class BSP>
    BSP fork_database_t<BSP>::root() const {
-      std::lock_guard g( my->mtx );
-      return my->root;
+      return my->get_view()->root;
    }
 
    template<class BSP>
    BSP fork_database_t<BSP>::head(include_root_t include_root) const {
-      std::lock_guard g( my->mtx );
-      return my->head_impl(include_root);
+      auto v = my->get_view();
+      if (!v->head && include_root == include_root_t::yes)
+         return v->root;
+      return v->head;
    }
 
    template<class BSP>
@@ -346,14 +463,19 @@ namespace eosio::chain {
 
    template<class BSP>
    block_id_type fork_database_t<BSP>::pending_savanna_lib_id() const {
-      std::lock_guard g( my->mtx );
-      return my->pending_savanna_lib_id;
+      return my->get_view()->pending_savanna_lib_id;
    }
 
    template<class BSP>
    bool fork_database_t<BSP>::set_pending_savanna_lib_id(const block_id_type& id) {
       std::lock_guard g( my->mtx );
-      return my->set_pending_savanna_lib_id_impl(id);
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
+      bool updated = my->set_pending_savanna_lib_id_impl(id);
+      if constexpr (std::is_same_v<BSP, block_state_ptr>) {
+         if (updated && my->journal)
+            my->journal->set_pending_savanna_lib_id(id);
+      }
+      return updated;
    }
 
    template<class BSP>
@@ -562,7 +684,10 @@ namespace eosio::chain {
    template<class BSP>
    void fork_database_t<BSP>::remove( const block_id_type& id ) {
       std::lock_guard g( my->mtx );
-      return my->remove_impl( id );
+      auto publish = fc::make_scoped_exit([&]() { my->try_publish_view(); });
+      my->remove_impl( id );
+      if (my->journal)
+         my->journal->remove<BSP>( id );
    }
 
    template<class BSP>
@@ -579,15 +704,15 @@ namespace eosio::chain {
       }
 
       for( const auto& block_id : remove_queue ) {
-         index.erase( block_id );
+         if( index.erase( block_id ) )
+            modified_ids.push_back( block_id );
       }
    }
 
    template<class BSP>
    BSP fork_database_t<BSP>::get_block(const block_id_type& id,
                                        include_root_t include_root /* = include_root_t::no */) const {
-      std::lock_guard g( my->mtx );
-      return my->get_block_impl(id, include_root);
+      return my->get_view()->get_block(id, include_root);
    }
 
    template<class BSP>
@@ -603,20 +728,25 @@ namespace eosio::chain {
    }
 
    template<class BSP>
-   bool fork_database_t<BSP>::block_exists(const block_id_type& id) const {
-      std::lock_guard g( my->mtx );
-      return my->block_exists_impl(id);
+   BSP fork_database_impl<BSP>::view_t::get_block(const block_id_type& id, include_root_t include_root) const {
+      if( include_root == include_root_t::yes && root && root->id() == id ) {
+         return root;
+      }
+      const auto& shard = *shards[shard_of(id)];
+      auto itr = shard.find( id );
+      if( itr != shard.end() )
+         return itr->second;
+      return {};
    }
 
    template<class BSP>
-   bool fork_database_impl<BSP>::block_exists_impl(const block_id_type& id) const {
-      return index.find( id ) != index.end();
+   bool fork_database_t<BSP>::block_exists(const block_id_type& id) const {
+      return !!my->get_view()->get_block(id, include_root_t::no);
    }
 
    template<class BSP>
    bool fork_database_t<BSP>::validated_block_exists(const block_id_type& id, const block_id_type& claimed_id) const {
-      std::lock_guard g( my->mtx );
-      return my->validated_block_exists_impl(id, claimed_id);
+      return my->get_view()->validated_block_exists(id, claimed_id);
    }
 
    // precondition: claimed_id is either id, or an ancestor of id
@@ -624,14 +754,14 @@ namespace eosio::chain {
    // and `is_valid()`.
    // ------------------------------------------------------------------------------------------------------
    template<class BSP>
-   bool fork_database_impl<BSP>::validated_block_exists_impl(const block_id_type& id, const block_id_type& claimed_id) const {
+   bool fork_database_impl<BSP>::view_t::validated_block_exists(const block_id_type& id, const block_id_type& claimed_id) const {
       bool id_present = false;
 
-      for (auto i = index.find(id); i != index.end(); i = index.find((*i)->previous())) {
+      for (auto b = get_block(id, include_root_t::no); b; b = get_block(b->previous(), include_root_t::no)) {
          id_present = true;
-         if ((*i)->is_valid())
+         if (b->is_valid())
             return true;
-         if ((*i)->id() == claimed_id)
+         if (b->id() == claimed_id)
             return false;
       }
 
@@ -642,8 +772,9 @@ namespace eosio::chain {
 
 // ------------------ fork_database -------------------------
 
-   fork_database::fork_database(const std::filesystem::path& data_dir)
+   fork_database::fork_database(const std::filesystem::path& data_dir, bool journal)
       : data_dir(data_dir)
+      , journal(journal ? std::make_unique<fork_database_journal>(data_dir / config::fork_db_journal_filename) : nullptr)
    {
    }
 
@@ -653,6 +784,13 @@ namespace eosio::chain {
 
    void fork_database::close() {
       auto fork_db_file {data_dir / config::fork_db_filename};
+      auto journal_file {data_dir / config::fork_db_journal_filename};
+      if (journal && journal->is_open()) {
+         fork_db_l.set_journal(nullptr);
+         fork_db_s.set_journal(nullptr);
+         journal->close();
+      }
+
       bool legacy_valid  = fork_db_l.is_valid();
       bool savanna_valid = fork_db_s.is_valid();
 
@@ -660,6 +798,8 @@ namespace eosio::chain {
       // check that fork_dbs are in a consistent state
       if (!legacy_valid && !savanna_valid) {
          ilog("No fork_database to persist");
+         std::error_code ec;
+         std::filesystem::remove(journal_file, ec);
          return;
       } else if (legacy_valid && savanna_valid && in_use_value == in_use_t::savanna) {
          legacy_valid = false; // don't write legacy if not needed, we delay 'clear' of legacy until close
@@ -692,6 +832,70 @@ namespace eosio::chain {
       fc::raw::pack(out, savanna_valid);
       if (savanna_valid)
          fork_db_s.close(out);
+
+      // journal is only needed when fork_db.dat could not be written
+      out.close();
+      if (out) {
+         std::error_code ec;
+         std::filesystem::remove(journal_file, ec);
+      }
+   }
+
+   void fork_database::flush_journal() {
+      if (journal)
+         journal->flush();
+   }
+
+   void fork_database::replay_journal( const std::filesystem::path& journal_file ) {
+      using op_t = fork_database_journal::op_t;
+      ilog("Recovering fork_database from journal: ${f}", ("f", journal_file));
+
+      auto apply_record = [](auto& fork_db, const auto& bsp, fork_database_journal::record& r) {
+         switch (r.op) {
+            case op_t::reset_root:
+               fork_db.reset_root(bsp);
+               break;
+            case op_t::add:
+               fork_db.add(bsp, ignore_duplicate_t::yes);
+               break;
+            case op_t::advance_root: {
+               auto new_root = fork_db.get_block(r.id);
+               EOS_ASSERT( new_root, fork_database_exception,
+                           "Fork database journal advances root to unknown block ${id}", ("id", r.id) );
+               if constexpr (std::is_same_v<std::decay_t<decltype(bsp)>, block_state_ptr>) {
+                  if (r.valid)
+                     new_root->valid = std::move(r.valid);
+               }
+               new_root->set_valid(true);
+               fork_db.advance_root(r.id);
+               break;
+            }
+            case op_t::remove:
+               fork_db.remove(r.id);
+               break;
+            case op_t::pending_savanna_lib_id:
+               fork_db.set_pending_savanna_lib_id(r.id);
+               break;
+            default:
+               break;
+         }
+      };
+
+      size_t num_records = fork_database_journal::read(journal_file, [&](fork_database_journal::record&& r) {
+         if (r.op == op_t::in_use)
+            in_use = static_cast<in_use_t>(r.in_use);
+         else if (r.savanna)
+            apply_record(fork_db_s, r.bsp_s, r);
+         else
+            apply_record(fork_db_l, r.bsp_l, r);
+      });
+
+      apply<void>([&](const auto& fork_db) {
+         auto root = fork_db.root();
+         auto head = fork_db.head();
+         ilog("Recovered fork_database from ${n} journal records, root ${rn}, head ${hn}, ${b} blocks",
+              ("n", num_records)("rn", root ? root->block_num() : 0)("hn", head ? head->block_num() : 0)("b", fork_db.size()));
+      });
    }
 
    bool fork_database::file_exists() const {
@@ -706,6 +910,7 @@ namespace eosio::chain {
       assert(!fork_db_l.is_valid() && !fork_db_s.is_valid());
 
       auto fork_db_file = data_dir / config::fork_db_filename;
+      auto journal_file = data_dir / config::fork_db_journal_filename;
       if( std::filesystem::exists( fork_db_file ) ) {
          try {
             fc::cfile f;
@@ -767,9 +972,31 @@ namespace eosio::chain {
             }
          } FC_CAPTURE_AND_RETHROW( (fork_db_file) );
          std::filesystem::remove( fork_db_file );
+      } else if( std::filesystem::exists( journal_file ) ) {
+         try {
+            replay_journal( journal_file );
+         } FC_CAPTURE_AND_RETHROW( (journal_file) );
+      }
+
+      if (journal) {
+         // replaces the journal file once the current state is written
+         journal->open([&]() {
+            journal->set_in_use(static_cast<uint32_t>(in_use.load()));
+            fork_db_l.set_journal(journal.get());
+            fork_db_s.set_journal(journal.get());
+         });
+      } else {
+         std::error_code ec;
+         std::filesystem::remove( journal_file, ec );
       }
    }
 
+   void fork_database::switch_to(in_use_t v) {
+      in_use = v;
+      if (journal && journal->is_open())
+         journal->set_in_use(static_cast<uint32_t>(v));
+   }
+
    size_t fork_database::size() const {
       return apply<size_t>([](const auto& fork_db) {
          return fork_db.size();
@@ -784,10 +1011,10 @@ namespace eosio::chain {
          fork_db_s.reset_root(root);
          if (fork_db_l.has_root()) {
             dlog("Switching fork_db from legacy to both");
-            in_use = in_use_t::both;
+            switch_to(in_use_t::both);
          } else {
             dlog("Switching fork_db from legacy to savanna");
-            in_use = in_use_t::savanna;
+            switch_to(in_use_t::savanna);
          }
       } else if (in_use == in_use_t::both) {
          dlog("Switching fork_db from legacy, already both root ${rid}, fork_db root ${fid}", ("rid", root->id())("fid", fork_db_s.root()->id()));
@@ -0,0 +1,439 @@
+#include <eosio/chain/fork_database_journal.hpp>
+#include <eosio/chain/exceptions.hpp>
+
+#include <boost/crc.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <future>
+#include <unordered_set>
+
+namespace eosio::chain {
+
+   namespace {
+      constexpr size_t frame_header_size = 2 * sizeof(uint32_t); // payload size, payload crc32
+
+      template<class BSP>
+      constexpr bool is_savanna_v = std::is_same_v<BSP, block_state_ptr>;
+
+      std::filesystem::path tmp_path(const std::filesystem::path& p) {
+         auto tmp = p;
+         tmp += ".tmp";
+         return tmp;
+      }
+
+      // makes a rename into dir durable
+      void sync_dir(const std::filesystem::path& dir) {
+         const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+         EOS_ASSERT(fd != -1, fork_database_exception, "Unable to open directory ${d}, error: ${e}", ("d", dir)("e", errno));
+         const int r = ::fsync(fd);
+         const int err = errno;
+         ::close(fd);
+         EOS_ASSERT(r != -1, fork_database_exception, "Unable to sync directory ${d}, error: ${e}", ("d", dir)("e", err));
+      }
+
+      uint32_t crc32(const char* d, size_t n) {
+         boost::crc_32_type crc;
+         crc.process_bytes(d, n);
+         return crc.checksum();
+      }
+
+      // Only what is not modified once the block state is added to the fork database. `valid` is assigned when the
+      // block is applied before it is marked valid and not modified after, so it is only written for valid blocks.
+      template<class Stream>
+      void pack_block(Stream& ds, const block_state_ptr& b) {
+         fc::raw::pack(ds, static_cast<const block_header_state&>(*b));
+         fc::raw::pack(ds, b->block);
+         fc::raw::pack(ds, b->strong_digest);
+         fc::raw::pack(ds, b->weak_digest);
+         const bool validated = b->is_valid();
+         fc::raw::pack(ds, validated);
+         if (validated)
+            fc::raw::pack(ds, b->valid);
+      }
+
+      // block_state_legacy is not modified once added other than validated which is atomic
+      template<class Stream>
+      void pack_block(Stream& ds, const block_state_legacy_ptr& b) {
+         fc::raw::pack(ds, *b);
+      }
+
+      template<class Stream>
+      void unpack_block(Stream& ds, block_state_ptr& b) {
+         b = std::make_shared<block_state>();
+         fc::raw::unpack(ds, static_cast<block_header_state&>(*b));
+         fc::raw::unpack(ds, b->block);
+         fc::raw::unpack(ds, b->strong_digest);
+         fc::raw::unpack(ds, b->weak_digest);
+         bool validated = false;
+         fc::raw::unpack(ds, validated);
+         if (validated) {
+            fc::raw::unpack(ds, b->valid);
+            b->set_valid(true);
+         }
+         // votes are not journaled
+         b->aggregating_qc = aggregating_qc_t(b->active_finalizer_policy,
+                                              b->pending_finalizer_policy ? b->pending_finalizer_policy->second : finalizer_policy_ptr{});
+      }
+
+      template<class Stream>
+      void unpack_block(Stream& ds, block_state_legacy_ptr& b) {
+         b = std::make_shared<block_state_legacy>();
+         fc::raw::unpack(ds, *b);
+      }
+
+      // blocks in block number order, parents before children
+      template<class Map>
+      auto sorted_blocks(const Map& blocks) {
+         std::vector<typename Map::mapped_type> result;
+         result.reserve(blocks.size());
+         for (const auto& [id, b] : blocks)
+            result.push_back(b);
+         std::ranges::sort(result, {}, [](const auto& b) { return b->block_num(); });
+         return result;
+      }
+   } // anonymous namespace
+
+   template<class BSP>
+   void fork_database_journal::mirror_t<BSP>::advance_root(const BSP& new_root) {
+      // same as fork_database_t::advance_root, only blocks building on the new root remain
+      root = new_root;
+      blocks.erase(new_root->id());
+      std::unordered_set<block_id_type, std::hash<block_id_type>> keep{new_root->id()};
+      for (const auto& b : sorted_blocks(blocks)) {
+         if (keep.contains(b->previous()))
+            keep.insert(b->id());
+         else
+            blocks.erase(b->id());
+      }
+   }
+
+   template<class BSP>
+   void fork_database_journal::mirror_t<BSP>::remove(const block_id_type& id) {
+      // same as fork_database_t::remove, id and all blocks building on it are removed
+      std::unordered_set<block_id_type, std::hash<block_id_type>> removed{id};
+      for (const auto& b : sorted_blocks(blocks)) {
+         if (removed.contains(b->previous()))
+            removed.insert(b->id());
+      }
+      for (const auto& r : removed)
+         blocks.erase(r);
+   }
+
+   fork_database_journal::fork_database_journal(std::filesystem::path journal_file, uint64_t compact_threshold)
+      : journal_file(std::move(journal_file))
+      , compact_threshold(compact_threshold)
+   {
+   }
+
+   fork_database_journal::~fork_database_journal() {
+      close();
+   }
+
+   template<class BSP>
+   fork_database_journal::mirror_t<BSP>& fork_database_journal::mirror() {
+      if constexpr (is_savanna_v<BSP>)
+         return mirror_s;
+      else
+         return mirror_l;
+   }
+
+   template<class F>
+   void fork_database_journal::post(F&& f) {
+      num_queued.fetch_add(1, std::memory_order_relaxed);
+      boost::asio::post(thread_pool.get_executor(), [this, f = std::forward<F>(f)]() mutable {
+         // records queued together, e.g. while syncing, are made durable with a single sync once all are written
+         const bool last_queued = num_queued.fetch_sub(1, std::memory_order_relaxed) == 1;
+         if (failed)
+            return;
+         try {
+            f();
+            file.flush();
+            maybe_compact();
+            if (last_queued && installed)
+               file.sync_data();
+         } catch (const fc::exception& e) {
+            fail(e.to_detail_string().c_str());
+         } catch (const std::exception& e) {
+            fail(e.what());
+         }
+      });
+   }
+
+   template<class F>
+   void fork_database_journal::append(op_t op, bool savanna, F&& pack_data) {
+      auto pack = [&](auto& ds) {
+         fc::raw::pack(ds, static_cast<uint8_t>(op));
+         fc::raw::pack(ds, savanna);
+         pack_data(ds);
+      };
+      fc::datastream<size_t> ps;
+      pack(ps);
+      std::vector<char> payload(ps.tellp());
+      fc::datastream<char*> ds(payload.data(), payload.size());
+      pack(ds);
+      write_frame(payload);
+   }
+
+   void fork_database_journal::write_frame(const std::vector<char>& payload) {
+      char header[frame_header_size];
+      fc::datastream<char*> ds(header, sizeof(header));
+      fc::raw::pack(ds, static_cast<uint32_t>(payload.size()));
+      fc::raw::pack(ds, crc32(payload.data(), payload.size()));
+      file.write(header, sizeof(header));
+      file.write(payload.data(), payload.size());
+      file_size += sizeof(header) + payload.size();
+   }
+
+   void fork_database_journal::open_file(const std::filesystem::path& p) {
+      file.close();
+      file.set_file_path(p);
+      file.open(fc::cfile::truncate_rw_mode);
+      char header[frame_header_size];
+      fc::datastream<char*> ds(header, sizeof(header));
+      fc::raw::pack(ds, magic_number);
+      fc::raw::pack(ds, version);
+      file.write(header, sizeof(header));
+      file_size = sizeof(header);
+   }
+
+   void fork_database_journal::fail(const char* what) {
+      elog("Fork database journal ${f} disabled after error: ${e}", ("f", journal_file)("e", what));
+      failed = true;
+      file.close();
+      // an incomplete journal must not be used for recovery
+      std::error_code ec;
+      std::filesystem::remove(journal_file, ec);
+      std::filesystem::remove(tmp_path(journal_file), ec);
+   }
+
+   void fork_database_journal::open(const std::function<void()>& seed) {
+      EOS_ASSERT(!started, fork_database_exception, "Fork database journal already open");
+      thread_pool.start(1, [](const fc::exception& e) {
+         elog("Exception in fork database journal thread: ${e}", ("e", e.to_detail_string()));
+      });
+      started = true;
+
+      // the new journal is written to a temporary file so an existing journal is only replaced once it is complete
+      const auto tmp = tmp_path(journal_file);
+      boost::asio::post(thread_pool.get_executor(), [this, tmp]() {
+         failed = false;
+         installed = false;
+         in_use = 0;
+         mirror_l = {};
+         mirror_s = {};
+         try {
+            open_file(tmp);
+         } catch (const std::exception& e) {
+            fail(e.what());
+         }
+      });
+      seed();
+      post([this, tmp]() {
+         file.flush();
+         file.sync();
+         std::filesystem::rename(tmp, journal_file);
+         sync_dir(journal_file.parent_path());
+         file.set_file_path(journal_file);
+         compacted_size = file_size;
+         installed = true;
+      });
+   }
+
+   void fork_database_journal::flush() {
+      if (!started)
+         return;
+      std::promise<void> done;
+      boost::asio::post(thread_pool.get_executor(), [&done]() { done.set_value(); });
+      done.get_future().wait();
+   }
+
+   void fork_database_journal::close() {
+      if (!started)
+         return;
+      flush();
+      thread_pool.stop();
+      file.close();
+      started = false;
+   }
+
+   void fork_database_journal::maybe_compact() {
+      if (!installed || file_size < compact_threshold || file_size - compacted_size < compacted_size)
+         return;
+      compact();
+   }
+
+   // rewrite the journal from the mirror, holding only the records needed to recreate the current fork databases
+   void fork_database_journal::compact() {
+      const auto orig_size = file_size;
+      const auto tmp = tmp_path(journal_file);
+      open_file(tmp);
+
+      append(op_t::in_use, false, [&](auto& ds) { fc::raw::pack(ds, in_use); });
+      auto write_mirror = [&](const auto& m) {
+         if (!m.root)
+            return;
+         using bsp_t = std::decay_t<decltype(m.root)>;
+         constexpr bool savanna = is_savanna_v<bsp_t>;
+         append(op_t::reset_root, savanna, [&](auto& ds) { pack_block(ds, m.root); });
+         if (m.pending_savanna_lib_id != block_id_type{})
+            append(op_t::pending_savanna_lib_id, savanna, [&](auto& ds) { fc::raw::pack(ds, m.pending_savanna_lib_id); });
+         for (const auto& b : sorted_blocks(m.blocks))
+            append(op_t::add, savanna, [&](auto& ds) { pack_block(ds, b); });
+      };
+      write_mirror(mirror_l);
+      write_mirror(mirror_s);
+
+      file.flush();
+      file.sync();
+      std::filesystem::rename(tmp, journal_file);
+      sync_dir(journal_file.parent_path());
+      file.set_file_path(journal_file);
+      compacted_size = file_size;
+      dlog("Compacted fork database journal from ${o} to ${n} bytes", ("o", orig_size)("n", file_size));
+   }
+
+   template<class BSP>
+   void fork_database_journal::reset_root(const BSP& root) {
+      post([this, root]() {
+         auto& m = mirror<BSP>();
+         m.root = root;
+         m.pending_savanna_lib_id = block_id_type{};
+         m.blocks.clear();
+         append(op_t::reset_root, is_savanna_v<BSP>, [&](auto& ds) { pack_block(ds, root); });
+      });
+   }
+
+   template<class BSP>
+   void fork_database_journal::add(const BSP& n) {
+      post([this, n]() {
+         mirror<BSP>().blocks.insert_or_assign(n->id(), n);
+         append(op_t::add, is_savanna_v<BSP>, [&](auto& ds) { pack_block(ds, n); });
+      });
+   }
+
+   template<class BSP>
+   void fork_database_journal::advance_root(const BSP& new_root) {
+      post([this, new_root]() {
+         mirror<BSP>().advance_root(new_root);
+         append(op_t::advance_root, is_savanna_v<BSP>, [&](auto& ds) {
+            fc::raw::pack(ds, new_root->id());
+            if constexpr (is_savanna_v<BSP>)
+               fc::raw::pack(ds, new_root->valid);
+         });
+      });
+   }
+
+   template<class BSP>
+   void fork_database_journal::remove(const block_id_type& id) {
+      post([this, id]() {
+         mirror<BSP>().remove(id);
+         append(op_t::remove, is_savanna_v<BSP>, [&](auto& ds) { fc::raw::pack(ds, id); });
+      });
+   }
+
+   void fork_database_journal::set_pending_savanna_lib_id(const block_id_type& id) {
+      post([this, id]() {
+         mirror_s.pending_savanna_lib_id = id;
+         append(op_t::pending_savanna_lib_id, true, [&](auto& ds) { fc::raw::pack(ds, id); });
+      });
+   }
+
+   void fork_database_journal::set_in_use(uint32_t v) {
+      post([this, v]() {
+         in_use = v;
+         append(op_t::in_use, false, [&](auto& ds) { fc::raw::pack(ds, v); });
+      });
+   }
+
+   size_t fork_database_journal::read(const std::filesystem::path& journal_file, const std::function<void(record&&)>& handler) {
+      const auto size = std::filesystem::file_size(journal_file);
+      fc::cfile f;
+      f.set_file_path(journal_file);
+      f.open("rb");
+
+      char header[frame_header_size];
+      EOS_ASSERT(size >= sizeof(header), fork_database_exception,
+                 "Fork database journal '${f}' is too small to contain a header", ("f", journal_file));
+      f.read(header, sizeof(header));
+      fc::datastream<const char*> hds(header, sizeof(header));
+      uint32_t totem = 0, ver = 0;
+      fc::raw::unpack(hds, totem);
+      fc::raw::unpack(hds, ver);
+      EOS_ASSERT(totem == magic_number, fork_database_exception,
+                 "Fork database journal '${f}' has unexpected magic number: ${t}. Expected ${m}",
+                 ("f", journal_file)("t", totem)("m", magic_number));
+      EOS_ASSERT(ver == version, fork_database_exception,
+                 "Unsupported version of fork database journal '${f}': ${v}. Expected ${e}",
+                 ("f", journal_file)("v", ver)("e", version));
+
+      uint64_t pos = sizeof(header);
+      size_t num_records = 0;
+      std::vector<char> payload;
+      while (pos + sizeof(header) <= size) {
+         f.read(header, sizeof(header));
+         fc::datastream<const char*> fds(header, sizeof(header));
+         uint32_t payload_size = 0, payload_crc = 0;
+         fc::raw::unpack(fds, payload_size);
+         fc::raw::unpack(fds, payload_crc);
+         if (pos + sizeof(header) + payload_size > size)
+            break;
+         payload.resize(payload_size);
+         f.read(payload.data(), payload.size());
+         if (crc32(payload.data(), payload.size()) != payload_crc)
+            break;
+
+         fc::datastream<const char*> ds(payload.data(), payload.size());
+         record r;
+         uint8_t op = 0;
+         fc::raw::unpack(ds, op);
+         fc::raw::unpack(ds, r.savanna);
+         r.op = static_cast<op_t>(op);
+         switch (r.op) {
+            case op_t::reset_root:
+            case op_t::add:
+               if (r.savanna)
+                  unpack_block(ds, r.bsp_s);
+               else
+                  unpack_block(ds, r.bsp_l);
+               break;
+            case op_t::advance_root:
+               fc::raw::unpack(ds, r.id);
+               if (r.savanna)
+                  fc::raw::unpack(ds, r.valid);
+               break;
+            case op_t::remove:
+            case op_t::pending_savanna_lib_id:
+               fc::raw::unpack(ds, r.id);
+               break;
+            case op_t::in_use:
+               fc::raw::unpack(ds, r.in_use);
+               break;
+            default:
+               EOS_THROW(fork_database_exception, "Fork database journal '${f}' has unknown record type ${op} at offset ${p}",
+                         ("f", journal_file)("op", op)("p", pos));
+         }
+         handler(std::move(r));
+         ++num_records;
+         pos += sizeof(header) + payload_size;
+      }
+
+      if (pos != size) {
+         wlog("Ignoring ${n} bytes of incomplete or corrupt fork database journal '${f}' after offset ${p}",
+              ("n", size - pos)("f", journal_file)("p", pos));
+      }
+      return num_records;
+   }
+
+   template void fork_database_journal::reset_root<block_state_legacy_ptr>(const block_state_legacy_ptr&);
+   template void fork_database_journal::reset_root<block_state_ptr>(const block_state_ptr&);
+   template void fork_database_journal::add<block_state_legacy_ptr>(const block_state_legacy_ptr&);
+   template void fork_database_journal::add<block_state_ptr>(const block_state_ptr&);
+   template void fork_database_journal::advance_root<block_state_legacy_ptr>(const block_state_legacy_ptr&);
+   template void fork_database_journal::advance_root<block_state_ptr>(const block_state_ptr&);
+   template void fork_database_journal::remove<block_state_legacy_ptr>(const block_id_type&);
+   template void fork_database_journal::remove<block_state_ptr>(const block_id_type&);
+
+} // namespace eosio::chain
@@ -5,6 +5,7 @@
 #include <eosio/chain/transaction_context.hpp>
 #include <eosio/chain/contract_table_objects.hpp>
 #include <eosio/chain/deep_mind.hpp>
+#include <eosio/chain/db_access_tracer.hpp>
 #include <fc/utility.hpp>
 #include <sstream>
 #include <algorithm>
@@ -174,7 +175,7 @@ class apply_context {
 
             using secondary_key_helper_t = secondary_key_helper<secondary_key_type, secondary_key_proxy_type, secondary_key_proxy_const_type>;
 
-            generic_index( apply_context& c ):context(c){}
+            generic_index( apply_context& c, db_index_type t ):context(c),index_type(t){}
 
             int store( uint64_t scope, uint64_t table, const account_name& payer,
                        uint64_t id, secondary_key_proxy_const_type value )
@@ -210,6 +211,7 @@ class apply_context {
                context.update_db_usage( payer, config::billable_size_v<ObjectType> );
 
                itr_cache.cache_table( tab );
+               trace_access( db_access_type::write, obj );
                return itr_cache.add( obj );
             }
 
@@ -230,6 +232,7 @@ class apply_context {
                   dm_logger->on_ram_trace(std::move(event_id), "secondary_index", "remove", "secondary_index_remove");
                }
 
+               trace_access( db_access_type::write, obj );
                context.update_db_usage( obj.payer, -( config::billable_size_v<ObjectType> ) );
 
 //               context.require_write_lock( table_obj.scope );
@@ -286,6 +289,8 @@ class apply_context {
                  secondary_key_helper_t::set(o.secondary_key, secondary);
                  o.payer = payer;
                });
+
+               trace_access( db_access_type::write, obj );
             }
 
             int find_secondary( uint64_t code, uint64_t scope, uint64_t table, secondary_key_proxy_const_type secondary, uint64_t& primary ) {
@@ -299,6 +304,7 @@ class apply_context {
 
                primary = obj->primary_key;
 
+               trace_access( db_access_type::read, *obj );
                return itr_cache.add( *obj );
             }
 
@@ -316,6 +322,7 @@ class apply_context {
                primary = itr->primary_key;
                secondary_key_helper_t::get(secondary, itr->secondary_key);
 
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add( *itr );
             }
 
@@ -333,6 +340,7 @@ class apply_context {
                primary = itr->primary_key;
                secondary_key_helper_t::get(secondary, itr->secondary_key);
 
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add( *itr );
             }
 
@@ -355,6 +363,7 @@ class apply_context {
                if( itr == idx.end() || itr->t_id != obj.t_id ) return itr_cache.get_end_iterator_by_table_id(obj.t_id);
 
                primary = itr->primary_key;
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add(*itr);
             }
 
@@ -374,6 +383,7 @@ class apply_context {
                   if( itr->t_id != tab->id ) return -1; // Empty index
 
                   primary = itr->primary_key;
+                  trace_access( db_access_type::read, *itr );
                   return itr_cache.add(*itr);
                }
 
@@ -387,6 +397,7 @@ class apply_context {
                if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
 
                primary = itr->primary_key;
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add(*itr);
             }
 
@@ -400,6 +411,7 @@ class apply_context {
                if( !obj ) return table_end_itr;
                secondary_key_helper_t::get(secondary, obj->secondary_key);
 
+               trace_access( db_access_type::read, *obj );
                return itr_cache.add( *obj );
             }
 
@@ -414,6 +426,7 @@ class apply_context {
                if (itr == idx.end()) return table_end_itr;
                if (itr->t_id != tab->id) return table_end_itr;
 
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add(*itr);
             }
 
@@ -429,6 +442,7 @@ class apply_context {
                if (itr->t_id != tab->id) return table_end_itr;
 
                itr_cache.cache_table(*tab);
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add(*itr);
             }
 
@@ -444,6 +458,7 @@ class apply_context {
                if( itr == idx.end() || itr->t_id != obj.t_id ) return itr_cache.get_end_iterator_by_table_id(obj.t_id);
 
                primary = itr->primary_key;
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add(*itr);
             }
 
@@ -463,6 +478,7 @@ class apply_context {
                   if( itr->t_id != tab->id ) return -1; // Empty table
 
                   primary = itr->primary_key;
+                  trace_access( db_access_type::read, *itr );
                   return itr_cache.add(*itr);
                }
 
@@ -476,6 +492,7 @@ class apply_context {
                if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
 
                primary = itr->primary_key;
+               trace_access( db_access_type::read, *itr );
                return itr_cache.add(*itr);
             }
 
@@ -486,7 +503,14 @@ class apply_context {
             }
 
          private:
+            /// records an access of obj by the action, the table of obj must be cached
+            void trace_access( db_access_type type, const ObjectType& obj ) {
+               if( BOOST_UNLIKELY(context.db_tracer != nullptr) )
+                  context.trace_db_access( index_type, type, itr_cache.get_table( obj.t_id ), obj.primary_key, sizeof(secondary_key_type) );
+            }
+
             apply_context&              context;
+            const db_index_type         index_type;
             iterator_cache<ObjectType>  itr_cache;
       }; /// class generic_index
 
@@ -562,6 +586,7 @@ class apply_context {
       void db_update_i64( int iterator, account_name payer, const char* buffer, size_t buffer_size );
       void db_remove_i64( int iterator );
       int  db_get_i64( int iterator, char* buffer, size_t buffer_size );
+      int  db_get_rows_i64( int iterator, uint32_t max_rows, char* buffer, size_t buffer_size );
       int  db_next_i64( int iterator, uint64_t& primary );
       int  db_previous_i64( int iterator, uint64_t& primary );
       int  db_find_i64( name code, name scope, name table, uint64_t id );
@@ -575,6 +600,15 @@ class apply_context {
       const table_id_object& find_or_create_table( name code, name scope, name table, const account_name &payer );
       void                   remove_table( const table_id_object& tid );
 
+      void trace_db_access( db_index_type index, db_access_type type, const table_id_object& tab, uint64_t primary_key, uint32_t bytes ) {
+         db_tracer->record( { receiver, tab.code, tab.scope, tab.table, primary_key, index, type, bytes } );
+      }
+      /// records an access of the i64 row obj by the action, the table of obj must be cached
+      void trace_i64_access( db_access_type type, const key_value_object& obj, uint32_t bytes ) {
+         if( BOOST_UNLIKELY(db_tracer != nullptr) )
+            trace_db_access( db_index_type::i64, type, keyval_cache.get_table( obj.t_id ), obj.primary_key, bytes );
+      }
+
       int  db_store_i64( name code, name scope, name table, const account_name& payer, uint64_t id, const char* buffer, size_t buffer_size );
 
 
@@ -620,6 +654,7 @@ class apply_context {
       uint32_t                      action_ordinal = 0;
       bool                          privileged   = false;
       bool                          context_free = false;
+      db_access_tracer* const       db_tracer; ///< null unless db access tracing is enabled
 
    public:
       std::vector<char>             action_return_value;
@@ -129,6 +129,18 @@ namespace detail {
             return {range.begin(), range.end()};
          }
 
+         /// @return flags in the order of the provided keys, set for used keys
+         const vector<bool>& used_key_flags() const { return _used_keys; }
+
+         /// Marks the provided keys flagged in used_flags, in the order of the provided keys, as used
+         void add_used_keys( const vector<bool>& used_flags ) {
+            EOS_ASSERT( used_flags.size() == _used_keys.size(), authorization_exception, "used key flags do not match provided keys" );
+            for( size_t i = 0; i < used_flags.size(); ++i ) {
+               if( used_flags[i] )
+                  _used_keys[i] = true;
+            }
+         }
+
          static std::optional<permission_cache_status>
          permission_status_in_cache( const permission_cache_type& permissions,
                                      const permission_level& level )
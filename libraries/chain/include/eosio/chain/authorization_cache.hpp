@@ -0,0 +1,162 @@
+#pragma once
+
+#include <eosio/chain/types.hpp>
+#include <eosio/chain/permission_object.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace eosio { namespace chain {
+
+   /**
+    * @class authorization_cache
+    * @brief bounded caches of authority check results and linked permissions shared across transactions
+    *
+    * Authority results are keyed by permission id, permission last_updated, provided delay and provided key set and
+    * hold whether the permission is satisfied and which of the provided keys satisfied it. Only permissions whose
+    * authority has no account references are cached, their result depends on nothing but the authority itself.
+    * Linked permissions are keyed by account, code and action name and hold the result of the permission link lookup.
+    *
+    * The cached values are derived from chainbase state which can be undone by a failed transaction, an aborted block
+    * or a fork switch, none of which are seen here. Instead every change to the permissions or permission links of
+    * an account is reported by invalidate(), which drops the entries of the account, and the account then bypasses
+    * the caches until the block making the change is irreversible. A value cached for an account therefore always
+    * reflects irreversible state. Changes made by reversible blocks before startup were not reported, so all accounts
+    * bypass the caches until invalidate_all() is called with the head block at startup and that block is irreversible.
+    *
+    * Both caches are LRU with at most max_entries entries each, a max_entries of 0 disables them.
+    *
+    * Thread safe.
+    */
+   class authorization_cache {
+   public:
+      struct authority_result {
+         bool          satisfied = false;
+         vector<bool>  used_keys; ///< indexed as the provided keys, set for keys used to satisfy the permission
+      };
+
+      explicit authorization_cache( uint32_t max_entries = 0 ) : max_entries( max_entries ) {}
+
+      authorization_cache( const authorization_cache& ) = delete;
+      authorization_cache& operator=( const authorization_cache& ) = delete;
+
+      bool enabled()const { return max_entries > 0; }
+
+      /// @return cached result of permission, std::nullopt if not cached or the owner of permission bypasses the cache
+      std::optional<authority_result> find_authority( const permission_object& permission,
+                                                      fc::microseconds provided_delay,
+                                                      const flat_set<public_key_type>& provided_keys );
+
+      /// Caches the result of permission, ignored if the owner of permission bypasses the cache
+      void insert_authority( const permission_object& permission,
+                             fc::microseconds provided_delay,
+                             const flat_set<public_key_type>& provided_keys,
+                             const authority_result& result );
+
+      /// @return cached permission link lookup, outer std::nullopt if not cached or account bypasses the cache
+      std::optional<std::optional<permission_name>> find_link( account_name account, account_name code, action_name type );
+
+      /// Caches a permission link lookup, ignored if account bypasses the cache
+      void insert_link( account_name account, account_name code, action_name type, const std::optional<permission_name>& linked );
+
+      /// Permissions or permission links of account were changed by block_num
+      void invalidate( account_name account, uint32_t block_num );
+
+      /// Drops all entries, changes to any account may have been made by blocks up to block_num
+      void invalidate_all( uint32_t block_num );
+
+      /// Blocks up to lib are irreversible
+      void current_lib( uint32_t lib );
+
+      size_t authority_size()const;
+      size_t link_size()const;
+
+   private:
+      struct authority_entry {
+         account_name                      owner;
+         permission_object::id_type        permission;
+         time_point                        last_updated;
+         fc::microseconds                  provided_delay;
+         flat_set<public_key_type>         provided_keys;
+         authority_result                  result;
+      };
+
+      struct link_entry {
+         account_name                      account;
+         account_name                      code;
+         action_name                       type;
+         std::optional<permission_name>    linked;
+      };
+
+      struct authority_lookup {
+         permission_object::id_type        permission;
+         time_point                        last_updated;
+         fc::microseconds                  provided_delay;
+         const flat_set<public_key_type>&  provided_keys;
+      };
+
+      struct link_lookup {
+         account_name                      account;
+         account_name                      code;
+         action_name                       type;
+      };
+
+      struct authority_hash {
+         size_t operator()( const authority_entry& e )const;
+         size_t operator()( const authority_lookup& l )const;
+      };
+      struct authority_equal {
+         bool operator()( const authority_entry& a, const authority_entry& b )const;
+         bool operator()( const authority_lookup& l, const authority_entry& e )const;
+         bool operator()( const authority_entry& e, const authority_lookup& l )const { return (*this)( l, e ); }
+      };
+      struct link_hash {
+         size_t operator()( const link_entry& e )const;
+         size_t operator()( const link_lookup& l )const;
+      };
+      struct link_equal {
+         bool operator()( const link_entry& a, const link_entry& b )const;
+         bool operator()( const link_lookup& l, const link_entry& e )const;
+         bool operator()( const link_entry& e, const link_lookup& l )const { return (*this)( l, e ); }
+      };
+
+      struct by_key;
+      struct by_lru;
+      struct by_account;
+
+      template<typename Entry, typename Hash, typename Equal, typename Account>
+      using lru_index = boost::multi_index_container<
+         Entry,
+         indexed_by<
+            bmi::hashed_unique<tag<by_key>, bmi::identity<Entry>, Hash, Equal>,
+            bmi::sequenced<tag<by_lru>>,
+            bmi::hashed_non_unique<tag<by_account>, Account, std::hash<account_name>>
+         >
+      >;
+
+      using authority_index = lru_index<authority_entry, authority_hash, authority_equal,
+                                        BOOST_MULTI_INDEX_MEMBER(authority_entry, account_name, owner)>;
+      using link_index      = lru_index<link_entry, link_hash, link_equal,
+                                        BOOST_MULTI_INDEX_MEMBER(link_entry, account_name, account)>;
+
+      bool cacheable( account_name account )const;
+      template<typename Index> void insert( Index& idx, typename Index::value_type&& e );
+
+      const uint32_t                                   max_entries;
+      mutable std::mutex                               mtx;
+      authority_index                                  authorities;
+      link_index                                       links;
+      std::unordered_map<account_name, uint32_t>       invalidated; ///< account to last block that changed it
+      uint32_t                                         all_invalidated = std::numeric_limits<uint32_t>::max();
+      uint32_t                                         lib = 0;
+   };
+
+} } /// namespace eosio::chain
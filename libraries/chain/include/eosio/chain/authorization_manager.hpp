@@ -6,6 +6,7 @@
 
 #include <utility>
 #include <functional>
+#include <memory>
 
 namespace eosio { namespace chain {
 
@@ -15,12 +16,15 @@ namespace eosio { namespace chain {
    struct linkauth;
    struct unlinkauth;
    struct canceldelay;
+   class authorization_cache;
 
    class authorization_manager {
       public:
          using permission_id_type = permission_object::id_type;
 
-         explicit authorization_manager(controller& c, chainbase::database& d);
+         /// @param cache_size maximum number of entries of each of the authorization caches, 0 disables them
+         authorization_manager(controller& c, chainbase::database& d, uint32_t cache_size);
+         ~authorization_manager();
 
          void add_indices();
          void initialize_database();
@@ -116,11 +120,37 @@ namespace eosio { namespace chain {
                                                     )const;
 
 
+         /**
+          * @brief Report a change to the permission links of @ref account made by the pending block
+          *
+          * Permission changes made through this class are reported automatically. Cached results of @ref account
+          * are dropped and not cached again until the pending block is irreversible.
+          */
+         void invalidate_cache( account_name account );
+
+         /// Drop all cached results and cache none until the head block is irreversible
+         void invalidate_cache();
+
+         /// Blocks up to @ref lib are irreversible
+         void current_lib( uint32_t lib );
+
+         const authorization_cache& get_cache()const { return *_cache; }
+
          static std::function<void()> _noop_checktime;
 
       private:
-         const controller&    _control;
-         chainbase::database& _db;
+         const controller&                     _control;
+         chainbase::database&                  _db;
+         std::unique_ptr<authorization_cache>  _cache;
+
+         template<typename Checker>
+         bool satisfied( Checker&                             checker,
+                         const permission_level&              level,
+                         fc::microseconds                     provided_delay,
+                         const flat_set<public_key_type>&     provided_keys,
+                         const flat_set<permission_level>&    provided_permissions,
+                         uint16_t                             max_authority_depth
+                       )const;
 
          void             check_updateauth_authorization( const updateauth& update, const vector<permission_level>& auths )const;
          void             check_deleteauth_authorization( const deleteauth& del, const vector<permission_level>& auths )const;
@@ -94,7 +94,12 @@ namespace eosio { namespace chain {
          static uint32_t extract_first_block_num(const std::filesystem::path& block_dir,
                                                  const std::filesystem::path& retained_dir = std::filesystem::path{});
 
-         static void construct_index(const std::filesystem::path& block_file_name, const std::filesystem::path& index_file_name);
+         /**
+          * @param num_threads when greater than 1, the log is split into chunks which are memory mapped and indexed in
+          *                    parallel. Pruned logs are always indexed on the calling thread.
+          */
+         static void construct_index(const std::filesystem::path& block_file_name, const std::filesystem::path& index_file_name,
+                                     uint32_t num_threads = 1);
 
          static bool contains_genesis_state(uint32_t version, uint32_t first_block_num);
 
@@ -111,6 +116,8 @@ namespace eosio { namespace chain {
 
          // used for unit test to generate older version blocklog
          static void set_initial_version(uint32_t);
+         // used for unit test to split a small blocks.log into many chunks in construct_index, default 16MiB
+         static void set_parallel_index_min_chunk_size(uint64_t);
          uint32_t    version() const;
          uint64_t get_block_pos(uint32_t block_num) const;
 
@@ -118,9 +125,29 @@ namespace eosio { namespace chain {
           * @param n Only test 1 block out of every n blocks. If n is 0, the interval is adjusted so that at most 8 blocks are tested.
           */
          static void smoke_test(const std::filesystem::path& block_dir, uint32_t n);
+         /**
+          * Fully deserialize every block of blocks.log, checking its position against blocks.index and that it links
+          * to the previous block, using num_threads threads.
+          */
+         static void full_smoke_test(const std::filesystem::path& block_dir, uint32_t num_threads);
 
          static void split_blocklog(const std::filesystem::path& block_dir, const std::filesystem::path& dest_dir, uint32_t stride);
          static void merge_blocklogs(const std::filesystem::path& block_dir, const std::filesystem::path& dest_dir);
+
+         static constexpr uint32_t default_blocks_per_compressed_frame = 64;
+
+         /**
+          * Compress each blocks-N-M.log in block_dir to blocks-N-M.zlog, which a partitioned block log with block_dir as
+          * its retained dir reads in place. Blocks are compressed in independently decompressible frames of
+          * blocks_per_frame blocks so that reading a block only decompresses its frame.
+          * @return number of block logs compressed
+          */
+         static uint32_t compress_blocklogs(const std::filesystem::path& block_dir, uint32_t blocks_per_frame, bool keep_original);
+         /**
+          * Restore blocks-N-M.log and blocks-N-M.index from each blocks-N-M.zlog in block_dir
+          * @return number of block logs decompressed
+          */
+         static uint32_t decompress_blocklogs(const std::filesystem::path& block_dir, bool keep_compressed);
    private:
          std::unique_ptr<detail::block_log_impl> my;
    };
@@ -13,8 +13,11 @@ const static auto reversible_blocks_dir_name  = "reversible";
 
 const static auto default_state_dir_name      = "state";
 const static auto fork_db_filename            = "fork_db.dat";
+const static auto fork_db_journal_filename    = "fork_db.journal";
 const static auto safety_filename             = "safety.dat";
 const static auto chain_head_filename         = "chain_head.dat";
+const static auto wasm_warm_code_filename     = "wasm_warm_code.dat";
+const static auto account_query_db_filename   = "account_query_db.dat";
 const static auto default_state_size          = 1*1024*1024*1024ll;
 const static auto default_state_guard_size    =    128*1024*1024ll;
 
@@ -86,6 +89,9 @@ const static uint16_t   default_vote_thread_pool_size                = 4;
 const static uint32_t   default_max_variable_signature_length        = 16384u;
 const static uint32_t   default_max_action_return_value_size         = 8192;
 const static uint32_t   default_max_reversible_blocks                = 3600u;
+const static uint32_t   default_authorization_cache_size             = 64*1024; // entries in each of the authorization caches
+const static uint32_t   default_recovered_key_cache_size             = 64*1024; // entries in the cache of keys recovered from signatures
+const static uint32_t   default_wasm_warm_cache_size                 = 0;       // instantiated codes recorded at shutdown, 0 disables
 
 const static uint32_t   default_max_transaction_finality_status_success_duration_sec = 180;
 const static uint32_t   default_max_transaction_finality_status_failure_duration_sec = 180;
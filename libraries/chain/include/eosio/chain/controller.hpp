@@ -92,6 +92,7 @@ namespace eosio::chain {
    class permission_object;
    class account_object;
    class deep_mind_handler;
+   class db_access_tracer;
    class subjective_billing;
    using resource_limits::resource_limits_manager;
    using apply_handler = std::function<void(apply_context&)>;
@@ -152,9 +153,12 @@ namespace eosio::chain {
             uint32_t                 num_configured_p2p_peers = 0;
             bool                     integrity_hash_on_start= false;
             bool                     integrity_hash_on_stop = false;
+            bool                     fork_db_journal        = false;
+            uint32_t                 authorization_cache_size = chain::config::default_authorization_cache_size;
 
             wasm_interface::vm_type  wasm_runtime = chain::config::default_wasm_runtime;
             eosvmoc::config          eosvmoc_config;
+            uint32_t                 wasm_warm_cache_size = chain::config::default_wasm_warm_cache_size;
             wasm_interface::vm_oc_enable eosvmoc_tierup     = wasm_interface::vm_oc_enable::oc_auto;
             flat_set<account_name>   eos_vm_oc_whitelist_suffixes;
 
@@ -391,7 +395,7 @@ namespace eosio::chain {
          const flat_set<account_name> &get_resource_greylist() const;
 
          void validate_expiration( const transaction& t )const;
-         void validate_tapos( const transaction& t )const;
+         void validate_tapos( const transaction_header& t )const;
          void validate_db_available_size() const;
 
          bool is_protocol_feature_activated( const digest_type& feature_digest )const;
@@ -445,6 +449,9 @@ namespace eosio::chain {
 
          deep_mind_handler* get_deep_mind_logger(bool is_trx_transient) const;
          void enable_deep_mind( deep_mind_handler* logger );
+         /// @return nullptr for transient transactions or if db access tracing is not enabled
+         db_access_tracer* get_db_access_tracer(bool is_trx_transient) const;
+         void enable_db_access_tracing( db_access_tracer* tracer );
          uint32_t earliest_available_block_num() const;
 
 #if defined(EOSIO_EOS_VM_RUNTIME_ENABLED) || defined(EOSIO_EOS_VM_JIT_RUNTIME_ENABLED)
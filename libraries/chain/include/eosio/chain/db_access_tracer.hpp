@@ -0,0 +1,135 @@
+#pragma once
+
+#include <eosio/chain/types.hpp>
+
+#include <fc/io/cfile.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <array>
+#include <filesystem>
+#include <functional>
+
+namespace eosio { namespace chain {
+
+   enum class db_index_type : uint8_t {
+      i64,
+      idx64,
+      idx128,
+      idx256,
+      idx_double,
+      idx_long_double
+   };
+
+   enum class db_access_type : uint8_t {
+      read,
+      write
+   };
+
+   /**
+    * One row level access of a contract table by an action, through a db_*_i64 or secondary index intrinsic.
+    */
+   struct db_access {
+      account_name    receiver;          ///< receiver of the action accessing the row
+      account_name    code;              ///< contract owning the table
+      scope_name      scope;
+      table_name      table;
+      uint64_t        primary_key = 0;
+      db_index_type   index = db_index_type::i64;
+      db_access_type  type  = db_access_type::read;
+      uint32_t        bytes = 0;         ///< row value bytes for i64 rows read or written, secondary key bytes for indices
+   };
+
+   /// accesses of a contract table in a block
+   struct db_access_table_stats {
+      static constexpr size_t num_bytes_buckets = 16;
+
+      account_name   code;
+      table_name     table;
+      uint64_t       reads       = 0;
+      uint64_t       writes      = 0;
+      uint64_t       read_bytes  = 0;
+      uint64_t       write_bytes = 0;
+      uint32_t       scopes      = 0;    ///< distinct scopes accessed
+      uint32_t       rows        = 0;    ///< distinct (scope, index, primary key) accessed
+      /// accesses by bytes: bucket 0 for 0 bytes, bucket n for [2^(n-1), 2^n) bytes, the last bucket for all larger
+      std::array<uint32_t, num_bytes_buckets> bytes_histogram{};
+
+      static size_t bytes_bucket( uint32_t bytes );
+   };
+
+   /// accesses by the actions of a receiver in a block
+   struct db_access_account_stats {
+      account_name   receiver;
+      uint64_t       reads       = 0;
+      uint64_t       writes      = 0;
+      uint64_t       read_bytes  = 0;
+      uint64_t       write_bytes = 0;
+   };
+
+   struct db_access_block_summary {
+      uint32_t                                block_num = 0;
+      block_id_type                           block_id;
+      uint32_t                                transactions = 0;   ///< transactions with at least one access
+      vector<db_access_table_stats>           tables;             ///< sorted by code, table
+      vector<db_access_account_stats>         accounts;           ///< sorted by receiver
+   };
+
+   /**
+    * @class db_access_tracer
+    * @brief records the row level accesses of contract tables and summarizes them per block
+    *
+    * Enabled with controller::enable_db_access_tracing. When disabled, apply_context holds a null tracer and the
+    * intrinsics only pay a pointer check.
+    *
+    * Accesses are recorded per transaction, kept when the transaction is squashed into the pending block and dropped
+    * when it is undone, so that the summary of a block only includes the accesses of the transactions it contains.
+    * Transient transactions, read-only and dry-run, are not traced.
+    *
+    * When a block is accepted its summary is passed to the registered callbacks and, if a dump file is configured,
+    * appended to it as a uint32_t size followed by the fc::raw packed db_access_block_summary.
+    *
+    * Not thread safe, called from the main thread.
+    */
+   class db_access_tracer {
+   public:
+      using summary_callback = std::function<void(const db_access_block_summary&)>;
+
+      /// @param dump_file file summaries are appended to, none if empty
+      explicit db_access_tracer( const std::filesystem::path& dump_file = {} );
+
+      db_access_tracer( const db_access_tracer& ) = delete;
+      db_access_tracer& operator=( const db_access_tracer& ) = delete;
+
+      void register_summary_callback( summary_callback&& cb );
+
+      void on_start_block( uint32_t block_num );
+      void on_start_transaction() { _trx_accesses.clear(); }
+      void on_squash_transaction();
+      void on_undo_transaction() { _trx_accesses.clear(); }
+      void on_accepted_block( const block_id_type& id );
+
+      void record( const db_access& a ) { _trx_accesses.push_back( a ); }
+
+      /// summary of accesses, block_num and block_id are left default
+      static db_access_block_summary summarize( const vector<db_access>& accesses );
+
+      /// @return summaries of a dump file written by a db_access_tracer
+      static vector<db_access_block_summary> read_dump_file( const std::filesystem::path& dump_file );
+
+   private:
+      uint32_t                   _block_num = 0;
+      uint32_t                   _transactions = 0;
+      vector<db_access>          _trx_accesses;
+      vector<db_access>          _block_accesses;
+      vector<summary_callback>   _callbacks;
+      fc::datastream<fc::cfile>  _dump_file;
+   };
+
+} } /// namespace eosio::chain
+
+FC_REFLECT_ENUM( eosio::chain::db_index_type, (i64)(idx64)(idx128)(idx256)(idx_double)(idx_long_double) )
+FC_REFLECT_ENUM( eosio::chain::db_access_type, (read)(write) )
+FC_REFLECT( eosio::chain::db_access, (receiver)(code)(scope)(table)(primary_key)(index)(type)(bytes) )
+FC_REFLECT( eosio::chain::db_access_table_stats, (code)(table)(reads)(writes)(read_bytes)(write_bytes)(scopes)(rows)(bytes_histogram) )
+FC_REFLECT( eosio::chain::db_access_account_stats, (receiver)(reads)(writes)(read_bytes)(write_bytes) )
+FC_REFLECT( eosio::chain::db_access_block_summary, (block_num)(block_id)(transactions)(tables)(accounts) )
@@ -9,6 +9,8 @@ namespace eosio::chain {
    template<class BSP>
    struct fork_database_impl;
 
+   class fork_database_journal;
+
    using block_branch_t = std::vector<signed_block_ptr>;
    enum class ignore_duplicate_t { no, yes };
    enum class include_root_t { no, yes };
@@ -33,7 +35,9 @@ namespace eosio::chain {
     * blocks older than the last irreversible block are freed after emitting the
     * irreversible signal.
     *
-    * An internal mutex is used to provide thread-safety.
+    * An internal mutex is used to provide thread-safety. Modifications publish an immutable
+    * view of root, head and the blocks by id, so get_block, block_exists, validated_block_exists,
+    * head, root, size and pending_savanna_lib_id do not take the mutex and never wait on writers.
     *
     * fork_database should be used instead of fork_database_t directly as it manages
     * the different supported types.
@@ -82,6 +86,12 @@ namespace eosio::chain {
 
       void remove( const block_id_type& id );
 
+      /**
+       *  Record all further modifications in journal, after recording the current root and blocks.
+       *  nullptr stops journaling. journal must outlive its use by this fork database.
+       */
+      void set_journal( fork_database_journal* journal );
+
       bool is_valid() const; // sanity checks on this fork_db
 
       bool   has_root() const;
@@ -171,22 +181,30 @@ namespace eosio::chain {
       std::atomic<in_use_t>  in_use = in_use_t::legacy;
       fork_database_legacy_t fork_db_l; // legacy
       fork_database_if_t     fork_db_s; // savanna
+      std::unique_ptr<fork_database_journal> journal; // only when journaling enabled
+
+      void replay_journal( const std::filesystem::path& journal_file );
 
    public:
-      explicit fork_database(const std::filesystem::path& data_dir);
+      /// @param journal continuously journal modifications so that the fork database can be recovered after a crash
+      explicit fork_database(const std::filesystem::path& data_dir, bool journal = false);
       ~fork_database(); // close on destruction
 
       // not thread safe, expected to be called from main thread before allowing concurrent access
+      // recovers from the journal if fork_db.dat does not exist, i.e. on restart after a crash
       void open( validator_t& validator );
       void close();
       bool file_exists() const;
 
+      // blocks until all modifications so far are written to the journal, if enabled
+      void flush_journal();
+
       // return the size of the active fork_database
       size_t size() const;
 
       // switches to using both legacy and savanna during transition
       void switch_from_legacy(const block_state_ptr& root);
-      void switch_to(in_use_t v) { in_use = v; }
+      void switch_to(in_use_t v);
 
       in_use_t version_in_use() const { return in_use.load(); }
 
@@ -0,0 +1,129 @@
+#pragma once
+#include <eosio/chain/block_state_legacy.hpp>
+#include <eosio/chain/block_state.hpp>
+#include <eosio/chain/thread_utils.hpp>
+
+#include <fc/io/cfile.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <unordered_map>
+
+namespace eosio::chain {
+
+   /**
+    * @class fork_database_journal
+    * @brief append-only journal of fork database modifications
+    *
+    * fork_db.dat is only written on a clean shutdown. The journal records every reset_root, add, advance_root, remove,
+    * pending savanna lib and in use change as they are made so that after a crash or kill the fork database, and
+    * therefore the reversible blocks, can be recovered on startup instead of being synced again from peers.
+    *
+    * Records are queued by the caller and serialized and written by a dedicated thread. Each record is framed with
+    * its size and a crc32 of its contents; on read a partially written or corrupt record ends the journal. The file
+    * is synced with fdatasync whenever the journal thread has written all queued records, and the journal file and
+    * its directory are synced before a new or compacted journal replaces the previous one.
+    * The journal thread keeps a mirror of the fork databases from which the journal is rewritten, compacted, once
+    * more has been appended than it held after the last compaction.
+    *
+    * Only the parts of a block state that do not change once it is added to the fork database are written, so that
+    * blocks can be serialized by the journal thread while the main thread applies them and vote threads aggregate
+    * votes. Blocks that were not yet valid when written are recovered as not valid and are validated again when
+    * applied.
+    *
+    * Queueing methods are not thread safe, they are called by fork_database_t with its mutex held.
+    */
+   class fork_database_journal {
+   public:
+      static constexpr uint32_t magic_number                   = 0x4a510FDB;
+      static constexpr uint32_t version                        = 1;
+      static constexpr uint64_t default_compact_threshold      = 64*1024*1024;
+
+      enum class op_t : uint8_t { reset_root, add, advance_root, remove, pending_savanna_lib_id, in_use };
+
+      struct record {
+         op_t                    op = op_t::add;
+         bool                    savanna = false;
+         block_state_legacy_ptr  bsp_l;   // reset_root, add of legacy fork database
+         block_state_ptr         bsp_s;   // reset_root, add of savanna fork database
+         block_id_type           id;      // advance_root, remove, pending_savanna_lib_id
+         std::optional<valid_t>  valid;   // advance_root of savanna fork database
+         uint32_t                in_use = 0;
+      };
+
+      explicit fork_database_journal(std::filesystem::path journal_file, uint64_t compact_threshold = default_compact_threshold);
+      ~fork_database_journal();
+
+      fork_database_journal(const fork_database_journal&) = delete;
+      fork_database_journal& operator=(const fork_database_journal&) = delete;
+
+      const std::filesystem::path& file_path() const { return journal_file; }
+
+      /**
+       * Starts the journal thread and a new journal. seed() is called to queue the current state of the fork
+       * databases; the new journal replaces any existing journal file only once it contains that state.
+       */
+      void open(const std::function<void()>& seed);
+
+      /// Writes all queued records and stops the journal thread, the journal file is left in place.
+      void close();
+
+      bool is_open() const { return started; }
+
+      /// Blocks until all records queued before the call are written.
+      void flush();
+
+      template<class BSP> void reset_root(const BSP& root);
+      template<class BSP> void add(const BSP& n);
+      /// new_root must be valid
+      template<class BSP> void advance_root(const BSP& new_root);
+      template<class BSP> void remove(const block_id_type& id);
+      void set_pending_savanna_lib_id(const block_id_type& id);
+      void set_in_use(uint32_t in_use);
+
+      /**
+       * Reads the records of journal_file in order, calling handler for each, until the end of the file or the first
+       * incomplete or corrupt record.
+       * @return number of records read
+       */
+      static size_t read(const std::filesystem::path& journal_file, const std::function<void(record&&)>& handler);
+
+   private:
+      template<class BSP>
+      struct mirror_t {
+         BSP                                                     root;
+         block_id_type                                           pending_savanna_lib_id;
+         std::unordered_map<block_id_type, BSP, std::hash<block_id_type>> blocks;
+
+         void advance_root(const BSP& new_root);
+         void remove(const block_id_type& id);
+      };
+
+      template<class BSP> mirror_t<BSP>& mirror();
+      template<class F> void post(F&& f);
+      template<class F> void append(op_t op, bool savanna, F&& pack_data);
+      void write_frame(const std::vector<char>& payload);
+      void open_file(const std::filesystem::path& p);
+      void maybe_compact();
+      void compact();
+      void fail(const char* what);
+
+      const std::filesystem::path          journal_file;
+      const uint64_t                       compact_threshold;
+      named_thread_pool<struct fdbjnl>     thread_pool;
+      bool                                 started = false;
+      std::atomic<uint32_t>                num_queued = 0; // records queued and not yet written
+
+      // only accessed by the journal thread
+      fc::cfile                            file;
+      uint64_t                             file_size = 0;
+      uint64_t                             compacted_size = 0;
+      bool                                 installed = false; // the journal file contains the seeded state
+      bool                                 failed = false;
+      uint32_t                             in_use = 0;
+      mirror_t<block_state_legacy_ptr>     mirror_l;
+      mirror_t<block_state_ptr>            mirror_s;
+   };
+
+} // namespace eosio::chain
@@ -4,6 +4,8 @@
 #include <filesystem>
 #include <regex>
 #include <map>
+#include <type_traits>
+#include <variant>
 
 namespace eosio {
 namespace chain {
@@ -36,13 +38,19 @@ struct block_pos_size_t {
    uint64_t size     = 0;  // size of the block
 };
 
-template <typename LogData, typename LogIndex, typename LogVerifier = null_verifier>
+/// CompressedLogData, when not void, is a read only seekable compressed representation of a log. Files matching
+/// `name` + CompressedLogData::suffix_pattern are added to the catalog next to the uncompressed logs and blocks in them
+/// are read through compressed_stream_for_block() instead of get_block_position().
+template <typename LogData, typename LogIndex, typename LogVerifier = null_verifier, typename CompressedLogData = void>
 struct log_catalog {
    using block_num_t = uint32_t;
+   static constexpr bool supports_compressed = !std::is_void_v<CompressedLogData>;
+   using compressed_log_data_t = std::conditional_t<supports_compressed, CompressedLogData, std::monostate>;
 
    struct mapped_type {
       block_num_t           last_block_num = 0;
       std::filesystem::path filename_base;
+      bool                  compressed = false; // filename_base + compressed extension instead of .log/.index
    };
    using collection_t              = std::map<block_num_t, mapped_type>;
    using size_type                 = typename collection_t::size_type;
@@ -56,6 +64,8 @@ struct log_catalog {
    LogData               log_data;
    LogIndex              log_index;
    LogVerifier           verifier;
+   size_type             active_compressed_index = npos;
+   compressed_log_data_t compressed_log_data;
 
    bool empty() const { return collection.empty(); }
 
@@ -122,6 +132,27 @@ struct log_catalog {
 
          collection.insert_or_assign(log.first_block_num(), mapped_type{log.last_block_num(), std::move(path_without_extension)});
       });
+
+      if constexpr (supports_compressed) {
+         pattern = std::string(name) + CompressedLogData::suffix_pattern;
+         for_each_file_in_dir_matches(retained_dir, pattern, [this](std::filesystem::path path) {
+            CompressedLogData log(path);
+
+            verifier.verify(log, path);
+
+            // an uncompressed log of the same range is left over from compressing or decompressing, prefer it
+            auto existing_itr = collection.find(log.first_block_num());
+            if (existing_itr != collection.end() && log.last_block_num() <= existing_itr->second.last_block_num) {
+               wlog("${log_path} contains the overlapping range with ${existing_path}, dropping ${log_path} from catalog",
+                    ("log_path", path.string())("existing_path", existing_itr->second.filename_base.string()));
+               return;
+            }
+
+            auto path_without_extension = path.parent_path() / path.stem().string();
+            collection.insert_or_assign(log.first_block_num(),
+                                        mapped_type{log.last_block_num(), std::move(path_without_extension), true});
+         });
+      }
    }
 
    bool index_matches_data(const std::filesystem::path& index_path, LogData& log) const {
@@ -150,7 +181,7 @@ struct log_catalog {
 
          auto it = --collection.upper_bound(block_num);
 
-         if (block_num <= it->second.last_block_num) {
+         if (block_num <= it->second.last_block_num && !it->second.compressed) {
             auto name = it->second.filename_base;
             log_data.open(name.replace_extension("log"));
             log_index.open(name.replace_extension("index"));
@@ -210,6 +241,31 @@ struct log_catalog {
       return nullptr;
    }
 
+   /// @return stream over the serialized block_num when it is in a compressed log, valid until the next call
+   std::optional<fc::datastream<const char*>> compressed_stream_for_block(uint32_t block_num) {
+      static_assert(supports_compressed, "catalog does not support compressed logs");
+      try {
+         if (block_num < first_block_num())
+            return {};
+
+         auto it = --collection.upper_bound(block_num);
+         if (block_num > it->second.last_block_num || !it->second.compressed)
+            return {};
+
+         auto index = static_cast<size_type>(std::distance(collection.begin(), it));
+         if (index != active_compressed_index) {
+            active_compressed_index = npos;
+            auto name = it->second.filename_base;
+            compressed_log_data.open(name.replace_extension(CompressedLogData::extension));
+            active_compressed_index = index;
+         }
+         return compressed_log_data.ro_stream_for_block(block_num);
+      } catch (...) {
+         active_compressed_index = npos;
+         return {};
+      }
+   }
+
    std::optional<block_id_type> id_for_block(uint32_t block_num) {
       auto pos = get_block_position(block_num);
       if (pos) {
@@ -228,11 +284,29 @@ struct log_catalog {
       }
    }
 
-   static void rename_bundle(std::filesystem::path orig_path, std::filesystem::path new_path) {
+   static void rename_bundle(std::filesystem::path orig_path, std::filesystem::path new_path, bool compressed = false) {
+      if constexpr (supports_compressed) {
+         if (compressed) {
+            rename_if_not_exists(orig_path.replace_extension(CompressedLogData::extension),
+                                 new_path.replace_extension(CompressedLogData::extension));
+            return;
+         }
+      }
       rename_if_not_exists(orig_path.replace_extension(".log"), new_path.replace_extension(".log"));
       rename_if_not_exists(orig_path.replace_extension(".index"), new_path.replace_extension(".index"));
    }
 
+   static void remove_bundle(std::filesystem::path name, bool compressed) {
+      if constexpr (supports_compressed) {
+         if (compressed) {
+            std::filesystem::remove(name.replace_extension(CompressedLogData::extension));
+            return;
+         }
+      }
+      std::filesystem::remove(name.replace_extension("log"));
+      std::filesystem::remove(name.replace_extension("index"));
+   }
+
    /// Add a new entry into the catalog.
    ///
    /// Notice that \c start_block_num must be monotonically increasing between the invocations of this function
@@ -255,20 +329,22 @@ struct log_catalog {
          auto last = std::next( collection.begin(), items_to_erase);
 
          for (auto it = collection.begin(); it != last; ++it) {
-            auto orig_name = it->second.filename_base;
+            const auto& orig_name = it->second.filename_base;
             if (archive_dir.empty()) {
                // delete the old files when no backup dir is specified
-               std::filesystem::remove(orig_name.replace_extension("log"));
-               std::filesystem::remove(orig_name.replace_extension("index"));
+               remove_bundle(orig_name, it->second.compressed);
             } else {
                // move the archive dir
-               rename_bundle(orig_name, archive_dir / orig_name.filename());
+               rename_bundle(orig_name, archive_dir / orig_name.filename(), it->second.compressed);
             }
          }
          collection.erase(collection.begin(), last);
          active_index = active_index == npos || active_index < items_to_erase
                         ? npos
                         : active_index - items_to_erase;
+         active_compressed_index = active_compressed_index == npos || active_compressed_index < items_to_erase
+                                   ? npos
+                                   : active_compressed_index - items_to_erase;
       }
    }
 
@@ -283,12 +359,11 @@ struct log_catalog {
          return 0;
 
       auto remove_files = [](typename collection_t::const_reference v) {
-         auto name = v.second.filename_base;
-         std::filesystem::remove(name.replace_extension("log"));
-         std::filesystem::remove(name.replace_extension("index"));
+         remove_bundle(v.second.filename_base, v.second.compressed);
       };
 
       active_index = npos;
+      active_compressed_index = npos;
       auto it = collection.upper_bound(block_num);
 
       if (it == collection.begin() || block_num > std::prev(it)->second.last_block_num) {
@@ -298,8 +373,21 @@ struct log_catalog {
       } else {
          auto truncate_it = --it;
          auto name        = truncate_it->second.filename_base;
-         std::filesystem::rename(name.replace_extension("log"), new_name.replace_extension("log"));
-         std::filesystem::rename(name.replace_extension("index"), new_name.replace_extension("index"));
+         if constexpr (supports_compressed) {
+            if (truncate_it->second.compressed) {
+               name.replace_extension(CompressedLogData::extension);
+               {
+                  CompressedLogData log(name);
+                  auto log_name = new_name;
+                  log.decompress_to(log_name.replace_extension("log"), new_name.replace_extension("index"));
+               }
+               std::filesystem::remove(name);
+            }
+         }
+         if (!truncate_it->second.compressed) {
+            std::filesystem::rename(name.replace_extension("log"), new_name.replace_extension("log"));
+            std::filesystem::rename(name.replace_extension("index"), new_name.replace_extension("index"));
+         }
          std::for_each(std::next(truncate_it), collection.end(), remove_files);
          auto result = truncate_it->first;
          collection.erase(truncate_it, collection.end());
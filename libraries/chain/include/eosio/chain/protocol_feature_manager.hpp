@@ -39,6 +39,7 @@ enum class builtin_protocol_feature_t : uint32_t {
    disable_deferred_trxs_stage_1 = 22,
    disable_deferred_trxs_stage_2 = 23,
    savanna = 24,
+   bulk_db_iteration = 25,
    reserved_private_fork_protocol_features = 500000,
 };
 
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <eosio/chain/types.hpp>
+#include <eosio/chain/multi_index_includes.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace eosio { namespace chain {
+
+   /**
+    * @class recovered_key_cache
+    * @brief bounded cache of public keys recovered from signatures, shared by every path that recovers them
+    *
+    * A transaction recovered when received over p2p or the http api is recovered again when it is evicted from the
+    * unapplied transaction queue and later arrives in a block, or when it is retried. The recovered key depends only
+    * on the signature and the digest signed, which includes the chain id, so entries keyed by (digest, signature)
+    * can be shared by all controllers of the process. The signature is kept as its sha256 so that an entry has the
+    * same size whatever the signature type, WebAuthn signatures can be several KiB.
+    *
+    * Entries are spread over num_shards LRU shards, each with its own mutex, so that recovery on the chain, net and
+    * producer threads does not contend on a single lock. A max_entries of 0 disables the cache.
+    *
+    * Thread safe.
+    */
+   class recovered_key_cache {
+   public:
+      static constexpr size_t num_shards = 16;
+
+      struct stats {
+         uint64_t hits    = 0;
+         uint64_t misses  = 0;
+         size_t   entries = 0;
+
+         double hit_ratio()const { return hits + misses == 0 ? 0.0 : double(hits) / double(hits + misses); }
+      };
+
+      explicit recovered_key_cache( uint32_t max_entries = 0 );
+
+      recovered_key_cache( const recovered_key_cache& ) = delete;
+      recovered_key_cache& operator=( const recovered_key_cache& ) = delete;
+
+      /// Process wide cache used by transaction::get_signature_keys, sized once by chain_plugin
+      static recovered_key_cache& instance();
+
+      /// @return public key recovered from sig of digest, from the cache if present
+      /// @throws as public_key_type( sig, digest ) if sig does not recover a key, failures are not cached
+      public_key_type recover( const signature_type& sig, const digest_type& digest );
+
+      /// Changes the maximum number of entries, evicting the least recently used entries that no longer fit
+      void set_max_entries( uint32_t max_entries );
+      uint32_t get_max_entries()const;
+
+      /// Drops all entries, statistics are kept
+      void clear();
+
+      stats get_stats()const;
+
+   private:
+      struct entry {
+         digest_type      digest;
+         digest_type      sig_digest;
+         public_key_type  key;
+      };
+
+      struct lookup {
+         const digest_type&  digest;
+         const digest_type&  sig_digest;
+      };
+
+      struct entry_hash {
+         size_t operator()( const entry& e )const;
+         size_t operator()( const lookup& l )const;
+      };
+      struct entry_equal {
+         bool operator()( const entry& a, const entry& b )const;
+         bool operator()( const lookup& l, const entry& e )const;
+         bool operator()( const entry& e, const lookup& l )const { return (*this)( l, e ); }
+      };
+
+      struct by_key;
+      struct by_lru;
+
+      using lru_index = boost::multi_index_container<
+         entry,
+         indexed_by<
+            bmi::hashed_unique<tag<by_key>, bmi::identity<entry>, entry_hash, entry_equal>,
+            bmi::sequenced<tag<by_lru>>
+         >
+      >;
+
+      struct shard {
+         mutable std::mutex  mtx;
+         lru_index           entries;
+         size_t              max_entries = 0;
+         uint64_t            hits = 0;
+         uint64_t            misses = 0;
+
+         void trim();
+      };
+
+      static size_t shard_max_entries( uint32_t max_entries );
+
+      std::array<shard, num_shards>  shards;
+      std::atomic<uint32_t>          max_entries;
+   };
+
+} } /// namespace eosio::chain
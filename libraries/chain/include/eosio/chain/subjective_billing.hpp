@@ -8,11 +8,7 @@
 #include <eosio/chain/config.hpp>
 
 #include <fc/time.hpp>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <fc/container/expiry_wheel.hpp>
 
 namespace eosio::chain {
 
@@ -20,21 +16,11 @@ class subjective_billing {
 private:
 
    struct trx_cache_entry {
-      chain::transaction_id_type trx_id;
       chain::account_name        account;
       int64_t                    subjective_cpu_bill = 0;
-      fc::time_point             expiry;
    };
-   struct by_id;
-   struct by_expiry;
 
-   using trx_cache_index = bmi::multi_index_container<
-         trx_cache_entry,
-         indexed_by<
-               bmi::hashed_unique<tag<by_id>, BOOST_MULTI_INDEX_MEMBER( trx_cache_entry, chain::transaction_id_type, trx_id ) >,
-               ordered_non_unique<tag<by_expiry>, BOOST_MULTI_INDEX_MEMBER( trx_cache_entry, fc::time_point, expiry ) >
-         >
-   >;
+   using trx_cache_index = fc::expiry_wheel<chain::transaction_id_type, trx_cache_entry>;
 
    using decaying_accumulator = chain::resource_limits::impl::exponential_decay_accumulator<>;
 
@@ -95,11 +81,9 @@ public: // public for tests
    static constexpr uint32_t subjective_time_interval_ms = 5'000;
    size_t get_account_cache_size() const {return _account_subjective_bill_cache.size();}
    void remove_subjective_billing( const chain::transaction_id_type& trx_id, uint32_t time_ordinal ) {
-      auto& idx = _trx_cache_index.get<by_id>();
-      auto itr = idx.find( trx_id );
-      if( itr != idx.end() ) {
-         remove_subjective_billing( *itr, time_ordinal );
-         idx.erase( itr );
+      if( const trx_cache_entry* entry = _trx_cache_index.find( trx_id ) ) {
+         remove_subjective_billing( *entry, time_ordinal );
+         _trx_cache_index.erase( trx_id );
       }
    }
 
@@ -113,11 +97,7 @@ public:
    {
       if( !_disabled && !_disabled_accounts.count( first_auth ) ) {
          int64_t bill = std::max<int64_t>( 0, elapsed.count() );
-         auto p = _trx_cache_index.emplace(
-               trx_cache_entry{id,
-                               first_auth,
-                               bill,
-                               expire.to_time_point()} );
+         auto p = _trx_cache_index.try_emplace( id, expire.to_time_point(), trx_cache_entry{first_auth, bill} );
          if( p.second ) {
             _account_subjective_bill_cache[first_auth].pending_cpu_us += bill;
          }
@@ -164,23 +144,16 @@ public:
    template <typename Yield>
    bool remove_expired( fc::logger& log, const fc::time_point& pending_block_time, const fc::time_point& now, Yield&& yield ) {
       bool exhausted = false;
-      auto& idx = _trx_cache_index.get<by_expiry>();
-      if( !idx.empty() ) {
+      if( !_trx_cache_index.empty() ) {
          const auto time_ordinal = time_ordinal_for(now);
          const auto orig_count = _trx_cache_index.size();
          uint32_t num_expired = 0;
 
-         while( !idx.empty() ) {
-            if( yield() ) {
-               exhausted = true;
-               break;
-            }
-            auto b = idx.begin();
-            if( b->expiry > pending_block_time ) break;
-            transition_to_expired( *b, time_ordinal );
-            idx.erase( b );
+         exhausted = !_trx_cache_index.expire( pending_block_time, yield,
+                                               [&]( const chain::transaction_id_type&, trx_cache_entry& entry ) {
+            transition_to_expired( entry, time_ordinal );
             num_expired++;
-         }
+         } );
 
          fc_dlog( log, "Processed ${n} subjective billed transactions, Expired ${expired}",
                   ("n", orig_count)( "expired", num_expired ) );
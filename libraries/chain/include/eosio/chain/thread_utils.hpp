@@ -7,9 +7,12 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
 #include <future>
+#include <iosfwd>
 #include <memory>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace eosio { namespace chain {
 
@@ -113,12 +116,53 @@ namespace eosio { namespace chain {
    };
 
 
-   inline std::string set_current_thread_name_to_typename(const std::type_info& tinfo, const unsigned i) {
+   /// Parses a list of cpus or memory nodes, e.g. "0-3,8,10-11"
+   /// @throw fc::exception if malformed
+   std::vector<uint32_t> parse_cpu_list(const std::string& list);
+
+   /// Restricts the calling thread to the given cpus, no-op if cpus is empty.
+   /// @return false if not supported on this platform or the affinity could not be set
+   bool set_current_thread_cpu_affinity(const std::vector<uint32_t>& cpus);
+
+   /// @return the cpus the calling thread may run on, empty if not supported on this platform
+   std::vector<uint32_t> get_current_thread_cpu_affinity();
+
+   /// Configures the cpus for the threads of the named_thread_pools without cpus of their own, e.g. the affinity of the
+   /// process saved before the main thread is pinned. Threads inherit the affinity of the thread creating them, so
+   /// without it a pinned main thread would pin every thread pool it starts. Empty, the default, keeps the inherited one.
+   void set_default_cpu_affinity(std::vector<uint32_t> cpus);
+   std::vector<uint32_t> get_default_cpu_affinity();
+
+   /// Configures the cpus for the threads of the named_thread_pools with the given name, the NamePrefixTag type name
+   /// (e.g. "net", "read"). Each thread of the pool is pinned to one of the cpus in turn. Only applies to thread pools
+   /// started afterwards.
+   void set_thread_pool_cpu_affinity(const std::string& pool_name, std::vector<uint32_t> cpus);
+   std::vector<uint32_t> get_thread_pool_cpu_affinity(const std::string& pool_name);
+
+   enum class numa_policy {
+      none,       ///< default policy of the system
+      interleave, ///< pages interleaved across all memory nodes
+      main_node   ///< pages preferably allocated from the memory node of the cpu the calling thread is running on
+   };
+
+   /// Sets the memory policy of the calling thread, inherited by the threads it creates afterwards.
+   /// @throw fc::exception if not supported on this platform or the policy could not be set
+   void set_numa_policy(numa_policy policy);
+
+   std::istream& operator>>(std::istream& in, numa_policy& policy);
+   std::ostream& operator<<(std::ostream& out, numa_policy policy);
+
+   /// NamePrefixTag type name of a named_thread_pool, e.g. "net" for named_thread_pool<struct net>
+   inline std::string thread_pool_name_from_typename(const std::type_info& tinfo) {
       std::string tn = boost::core::demangle(tinfo.name());
       const size_t offset = tn.rfind("::");
       if(offset != std::string::npos)
          tn.erase(0, offset+2);
-      tn = tn.substr(0, tn.find('>')) + "-" + std::to_string(i);
+      return tn.substr(0, tn.find('>'));
+   }
+
+   inline std::string set_current_thread_name_to_typename(const std::type_info& tinfo, const unsigned i) {
+      std::string tn = thread_pool_name_from_typename(tinfo) + "-" + std::to_string(i);
       fc::set_thread_name(tn);
       return tn;
    }
@@ -216,6 +260,12 @@ namespace eosio { namespace chain {
          try {
             try {
                tn = set_current_thread_name_to_typename( typeid(this), i );
+               if ( auto cpus = get_thread_pool_cpu_affinity( thread_pool_name_from_typename( typeid(this) ) ); !cpus.empty() ) {
+                  if ( !set_current_thread_cpu_affinity( {cpus[i % cpus.size()]} ) )
+                     wlog( "Unable to pin thread ${t} to cpu ${c}", ("t", tn)("c", cpus[i % cpus.size()]) );
+               } else if ( auto default_cpus = get_default_cpu_affinity(); !set_current_thread_cpu_affinity( default_cpus ) ) {
+                  wlog( "Unable to restore the cpus ${c} of thread ${t}", ("t", tn)("c", default_cpus) );
+               }
                if ( init )
                   init();
             } FC_LOG_AND_RETHROW()
@@ -127,6 +127,15 @@ namespace eosio { namespace chain {
                                                     bool allow_duplicate_keys = false )const;
    };
 
+   /**
+    * A transaction as packed on the wire and in blocks.
+    *
+    * Uncompressed, canonically encoded transactions are not unpacked on construction: their encoding is validated
+    * and the header, id and signature digest are computed from the packed bytes, see transaction_view. The unpacked
+    * signed_transaction is materialized on first access, so transactions that are only relayed, recovered or
+    * checked for expiration and tapos never hold a second, unpacked, copy of their data. Applied transactions are
+    * materialized, so the transactions of blocks in the fork database still hold both copies.
+    */
    struct packed_transaction : fc::reflect_init {
       enum class compression_type {
          none = 0,
@@ -135,20 +144,26 @@ namespace eosio { namespace chain {
 
       packed_transaction() = default;
       packed_transaction(packed_transaction&&) = default;
-      explicit packed_transaction(const packed_transaction&) = default;
+      explicit packed_transaction(const packed_transaction& o);
       packed_transaction& operator=(const packed_transaction&) = delete;
       packed_transaction& operator=(packed_transaction&&) = default;
 
       explicit packed_transaction(const signed_transaction& t, compression_type _compression = compression_type::none)
-      :signatures(t.signatures), compression(_compression), unpacked_trx(t), trx_id(unpacked_trx.id())
+      :signatures(t.signatures), compression(_compression), unpacked_trx(std::make_shared<const signed_transaction>(t))
       {
+         trx_id = unpacked_trx->id();
+         header = *unpacked_trx;
+         first_auth = unpacked_trx->first_authorizer();
          local_pack_transaction();
          local_pack_context_free_data();
       }
 
       explicit packed_transaction(signed_transaction&& t, compression_type _compression = compression_type::none)
-      :signatures(t.signatures), compression(_compression), unpacked_trx(std::move(t)), trx_id(unpacked_trx.id())
+      :signatures(t.signatures), compression(_compression), unpacked_trx(std::make_shared<const signed_transaction>(std::move(t)))
       {
+         trx_id = unpacked_trx->id();
+         header = *unpacked_trx;
+         first_auth = unpacked_trx->first_authorizer();
          local_pack_transaction();
          local_pack_context_free_data();
       }
@@ -169,22 +184,35 @@ namespace eosio { namespace chain {
       size_t get_estimated_size()const;
 
       digest_type packed_digest()const;
+      /// same as get_signed_transaction().sig_digest( chain_id, get_context_free_data() ), without materializing
+      digest_type sig_digest( const chain_id_type& chain_id )const;
+      /// same as get_signed_transaction().get_signature_keys(...), without materializing
+      fc::microseconds get_signature_keys( const chain_id_type& chain_id, fc::time_point deadline,
+                                           flat_set<public_key_type>& recovered_pub_keys,
+                                           bool allow_duplicate_keys = false )const;
 
       const transaction_id_type& id()const { return trx_id; }
       bytes               get_raw_transaction()const;
 
-      time_point_sec                expiration()const { return unpacked_trx.expiration; }
-      const vector<bytes>&          get_context_free_data()const { return unpacked_trx.context_free_data; }
-      const transaction&            get_transaction()const { return unpacked_trx; }
-      const signed_transaction&     get_signed_transaction()const { return unpacked_trx; }
+      time_point_sec                expiration()const { return header.expiration; }
+      const transaction_header&     get_header()const { return header; }
+      /// same as get_transaction().first_authorizer(), without materializing
+      account_name                  first_authorizer()const { return first_auth; }
+      const vector<bytes>&          get_context_free_data()const { return get_signed_transaction().context_free_data; }
+      const transaction&            get_transaction()const { return get_signed_transaction(); }
+      /// materializes the unpacked transaction on first call, thread safe
+      const signed_transaction&     get_signed_transaction()const;
+      bool                          is_materialized()const;
       const vector<signature_type>& get_signatures()const { return signatures; }
       const fc::enum_type<uint8_t,compression_type>& get_compression()const { return compression; }
       const bytes&                  get_packed_context_free_data()const { return packed_context_free_data; }
       const bytes&                  get_packed_transaction()const { return packed_trx; }
 
    private:
-      void local_unpack_transaction(vector<bytes>&& context_free_data);
-      void local_unpack_context_free_data();
+      bool init_packed_view();
+      void set_unpacked_transaction(signed_transaction&& t);
+      transaction local_unpack_transaction()const;
+      vector<bytes> local_unpack_context_free_data()const;
       void local_pack_transaction();
       void local_pack_context_free_data();
 
@@ -200,9 +228,14 @@ namespace eosio { namespace chain {
       bytes                                   packed_trx;
 
    private:
-      // cache unpacked trx, for thread safety do not modify after construction
-      signed_transaction                      unpacked_trx;
+      // unpacked trx, set at most once after construction and only through std::atomic_compare_exchange_strong
+      mutable std::shared_ptr<const signed_transaction> unpacked_trx;
       transaction_id_type                     trx_id;
+      transaction_header                      header;
+      account_name                            first_auth;
+      // size of the canonically encoded transaction at the start of packed_trx, 0 if packed_trx is not such an
+      // encoding and the id and signature digest are computed from the unpacked transaction
+      uint32_t                                packed_view_size = 0;
    };
 
    using packed_transaction_ptr = std::shared_ptr<const packed_transaction>;
@@ -2,6 +2,7 @@
 #include <eosio/chain/transaction.hpp>
 #include <eosio/chain/types.hpp>
 #include <boost/asio/io_context.hpp>
+#include <atomic>
 #include <future>
 
 namespace boost { namespace asio {
@@ -28,6 +29,15 @@ class transaction_metadata {
          read_only
       };
 
+      /// Result of pre-screening a queued transaction against head state off the main thread
+      enum class prescreen_status : uint8_t {
+         unscreened,
+         likely_good,   ///< passed expiration, duplicate, tapos and authorization checks
+         deprioritized, ///< failed a check that depends on the current fork or state, e.g. tapos or authorization
+         expired,       ///< deterministic failure, will never be valid
+         duplicate      ///< already included in a block of the current fork, screened again if head moves
+      };
+
    private:
       const packed_transaction_ptr                               _packed_trx;
       const fc::microseconds                                     _sig_cpu_usage;
@@ -37,12 +47,13 @@ class transaction_metadata {
    public:
       bool                                                       accepted = false;       // not thread safe
       uint32_t                                                   billed_cpu_time_us = 0; // not thread safe
+      std::atomic<prescreen_status>                              prescreen{prescreen_status::unscreened}; // thread safe
 
    private:
       struct private_type{};
 
       static void check_variable_sig_size(const packed_transaction_ptr& trx, uint32_t max) {
-         for(const signature_type& sig : trx->get_signed_transaction().signatures)
+         for(const signature_type& sig : trx->get_signatures())
             EOS_ASSERT(sig.variable_size() <= max, sig_variable_size_limit_exception,
                   "signature variable length component size (${s}) greater than subjective maximum (${m})", ("s", sig.variable_size())("m", max));
       }
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <eosio/chain/transaction.hpp>
+
+#include <optional>
+#include <span>
+
+namespace eosio { namespace chain {
+
+   /**
+    * Non-owning view of a packed action, valid only as long as the buffer of the transaction_view it came from.
+    */
+   struct action_view {
+      account_name            account;
+      action_name             name;
+      uint32_t                authorization_size = 0;
+      std::span<const char>   authorization_data; ///< authorization_size packed permission_level
+      std::span<const char>   data;
+
+      permission_level authorization( uint32_t i )const;
+      action           materialize()const;
+   };
+
+   /**
+    * @class transaction_view
+    * @brief non-owning, non-allocating view of a packed, uncompressed transaction
+    *
+    * parse() validates the whole encoding up front, with the same limits as fc::raw::unpack<transaction>, so a view
+    * always materializes. Only the header is decoded; actions are decoded on iteration into action_view whose data
+    * refers to the packed buffer.
+    *
+    * A view is only returned for canonically encoded transactions, those whose packed bytes are the bytes
+    * fc::raw::pack produces for the unpacked transaction, so that the transaction id and signature digest can be
+    * computed from the packed bytes. Trailing bytes after the transaction are allowed and ignored, as by unpack.
+    */
+   class transaction_view {
+   public:
+      /// @return view of the transaction packed at the start of [data, data+size), std::nullopt if it does not
+      ///         unpack or is not canonically encoded
+      static std::optional<transaction_view> parse( const char* data, size_t size );
+
+      const transaction_header& header()const { return _header; }
+
+      /// packed bytes of the transaction, trailing bytes excluded
+      std::span<const char> packed()const { return _packed; }
+
+      uint32_t context_free_actions_size()const { return _context_free_actions_size; }
+      uint32_t actions_size()const { return _actions_size; }
+
+      template<typename F>
+      void for_each_context_free_action( F&& f )const {
+         const char* pos = _context_free_actions;
+         for( uint32_t i = 0; i < _context_free_actions_size; ++i )
+            f( next_action( pos ) );
+      }
+
+      template<typename F>
+      void for_each_action( F&& f )const {
+         const char* pos = _actions;
+         for( uint32_t i = 0; i < _actions_size; ++i )
+            f( next_action( pos ) );
+      }
+
+      transaction materialize()const;
+
+   private:
+      transaction_view() = default;
+
+      /// decodes the action at pos, which must have been validated by parse, and advances pos past it
+      action_view next_action( const char*& pos )const;
+
+      transaction_header      _header;
+      std::span<const char>   _packed;
+      const char*             _context_free_actions = nullptr;
+      uint32_t                _context_free_actions_size = 0;
+      const char*             _actions = nullptr;
+      uint32_t                _actions_size = 0;
+   };
+
+   /**
+    * Validates packed context free data, a vector<bytes>, with the same limits as fc::raw::unpack.
+    * @return number of entries, std::nullopt if it does not unpack, is not canonically encoded or has trailing bytes
+    */
+   std::optional<uint32_t> parse_context_free_data( const char* data, size_t size );
+
+} } /// namespace eosio::chain
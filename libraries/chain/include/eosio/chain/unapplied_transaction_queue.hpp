@@ -4,6 +4,8 @@
 #include <eosio/chain/trace.hpp>
 #include <eosio/chain/exceptions.hpp>
 
+#include <fc/container/expiry_wheel.hpp>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
@@ -39,19 +41,21 @@ class unapplied_transaction_queue {
 private:
    struct by_trx_id;
    struct by_type;
-   struct by_expiry;
 
    typedef multi_index_container< unapplied_transaction,
       indexed_by<
          hashed_unique< tag<by_trx_id>,
                const_mem_fun<unapplied_transaction, const transaction_id_type&, &unapplied_transaction::id>
          >,
-         ordered_non_unique< tag<by_type>, member<unapplied_transaction, trx_enum_type, &unapplied_transaction::trx_type> >,
-         ordered_non_unique< tag<by_expiry>, const_mem_fun<unapplied_transaction, fc::time_point_sec, &unapplied_transaction::expiration> >
+         ordered_non_unique< tag<by_type>, member<unapplied_transaction, trx_enum_type, &unapplied_transaction::trx_type> >
       >
    > unapplied_trx_queue_type;
 
+   // expiration is only needed to purge expired trxs, tracked outside of queue to avoid an ordered index
+   using expiry_index_type = fc::expiry_wheel<transaction_id_type, unapplied_trx_queue_type::iterator>;
+
    unapplied_trx_queue_type queue;
+   expiry_index_type expiry_index;
    uint64_t max_transaction_queue_size = 1024*1024*1024; // enforced for incoming
    uint64_t size_in_bytes = 0;
    size_t incoming_count = 0;
@@ -70,6 +74,7 @@ public:
 
    void clear() {
       queue.clear();
+      expiry_index.clear();
    }
 
    size_t incoming_size()const {
@@ -84,15 +89,8 @@ public:
 
    template <typename Yield, typename Callback>
    bool clear_expired( const time_point& pending_block_time, Yield&& yield, Callback&& callback ) {
-      auto& persisted_by_expiry = queue.get<by_expiry>();
-      while( !persisted_by_expiry.empty() ) {
-         const auto& itr = persisted_by_expiry.begin();
-         if( itr->expiration().to_time_point() > pending_block_time ) {
-            break;
-         }
-         if( yield() ) {
-            return false;
-         }
+      return expiry_index.expire( pending_block_time, yield,
+                                  [&]( const transaction_id_type&, unapplied_trx_queue_type::iterator itr ) {
          callback( itr->trx_meta->packed_trx(), itr->trx_type );
          if( itr->next ) {
             itr->next( std::static_pointer_cast<fc::exception>(
@@ -102,9 +100,8 @@ public:
                                         ("bt", pending_block_time) ) ) ) );
          }
          removed( itr );
-         persisted_by_expiry.erase( itr );
-      }
-      return true;
+         queue.erase( itr );
+      } );
    }
 
    void clear_applied( const signed_block_ptr& block ) {
@@ -120,6 +117,7 @@ public:
                                 FC_LOG_MESSAGE( info, "duplicate transaction ${id}", ("id", itr->trx_meta->id())))));
                }
                removed( itr );
+               expiry_index.erase( itr->id() );
                idx.erase( itr );
             }
          }
@@ -174,12 +172,13 @@ public:
    /// caller's responsibility to call next() if applicable
    iterator erase( iterator itr ) {
       removed( itr );
+      expiry_index.erase( itr->id() );
       return queue.get<by_type>().erase( itr );
    }
 
 private:
-   template<typename Itr>
-   void added( Itr itr ) {
+   void added( unapplied_trx_queue_type::iterator itr ) {
+      expiry_index.try_emplace( itr->id(), itr->expiration().to_time_point(), itr );
       auto size = calc_size( itr->trx_meta );
       if( itr->trx_type == trx_enum_type::incoming_p2p || itr->trx_type == trx_enum_type::incoming_api ) {
          ++incoming_count;
@@ -79,6 +79,14 @@ namespace eosio { namespace chain {
          //Returns true if the code is cached
          bool is_code_cached(const digest_type& code_hash, const uint8_t& vm_type, const uint8_t& vm_version) const;
 
+         //records the most recently used instantiated codes, at most max_entries, so they can be instantiated on the next startup
+         void save_warm_code_list(const std::filesystem::path& file, uint32_t max_entries) const;
+
+         //instantiates the codes recorded by save_warm_code_list that still exist on a background thread, skipping codes
+         //already compiled by eos-vm-oc tier-up, returns how many are being instantiated
+         //call from the main thread before any transaction is applied
+         size_t warm_from_code_list(const std::filesystem::path& file);
+
          // If substitute_apply is set, then apply calls it before doing anything else. If substitute_apply returns true,
          // then apply returns immediately. Provided function must be multi-thread safe.
          std::function<bool(const digest_type& code_hash, uint8_t vm_type, uint8_t vm_version, apply_context& context)> substitute_apply;
@@ -23,7 +23,14 @@
 #include <eosio/chain/webassembly/eos-vm.hpp>
 #include <eosio/vm/allocator.hpp>
 
+#include <fc/io/cfile.hpp>
+#include <fc/io/fstream.hpp>
+#include <fc/log/logger_config.hpp>
+
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <thread>
 
 using namespace fc;
 using namespace eosio::chain::webassembly;
@@ -35,6 +42,25 @@ namespace eosio { namespace chain {
 
    namespace eosvmoc { struct config; }
 
+   // file of the codes instantiated before shutdown, see wasm_interface::save_warm_code_list
+   struct wasm_warm_code_entry {
+      digest_type code_hash;
+      uint8_t     vm_type = 0;
+      uint8_t     vm_version = 0;
+   };
+
+   struct wasm_warm_code_list {
+      uint32_t                          version = 1;
+      std::vector<wasm_warm_code_entry> codes; ///< most recently used first
+   };
+
+} } // eosio::chain
+
+FC_REFLECT(eosio::chain::wasm_warm_code_entry, (code_hash)(vm_type)(vm_version))
+FC_REFLECT(eosio::chain::wasm_warm_code_list, (version)(codes))
+
+namespace eosio { namespace chain {
+
    struct wasm_interface_impl {
       struct wasm_cache_entry {
          digest_type                                          code_hash;
@@ -42,6 +68,7 @@ namespace eosio { namespace chain {
          std::unique_ptr<wasm_instantiated_module_interface>  module;
          uint8_t                                              vm_type = 0;
          uint8_t                                              vm_version = 0;
+         mutable uint64_t                                     last_used = 0; ///< use_sequence of the last apply, not indexed
       };
       struct by_hash;
       struct by_last_block_num;
@@ -54,13 +81,14 @@ struct eosvmoc_tier {
       : cc(d, c, db, std::move(cb)) {
       // Construct exec and mem for the main thread
       exec = std::make_unique<eosvmoc::executor>(cc);
-      mem  = std::make_unique<eosvmoc::memory>(wasm_constraints::maximum_linear_memory/wasm_constraints::wasm_page_size);
+      mem  = std::make_unique<eosvmoc::memory>(wasm_constraints::maximum_linear_memory/wasm_constraints::wasm_page_size,
+                                               c.transparent_hugepages);
    }
 
    // Called from read-only threads
    void init_thread_local_data() {
       exec = std::make_unique<eosvmoc::executor>(cc);
-      mem  = std::make_unique<eosvmoc::memory>(eosvmoc::memory::sliced_pages_for_ro_thread);
+      mem  = std::make_unique<eosvmoc::memory>(eosvmoc::memory::sliced_pages_for_ro_thread, cc.get_config().transparent_hugepages);
    }
 
    eosvmoc::code_cache_async cc;
@@ -108,7 +136,11 @@ struct eosvmoc_tier {
 #endif
       }
 
-      ~wasm_interface_impl() = default;
+      ~wasm_interface_impl() {
+         warm_stop = true;
+         if (warm_thread.joinable())
+            warm_thread.join();
+      }
 
 #ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
       // called from async thread
@@ -204,7 +236,10 @@ struct eosvmoc_tier {
          // No need for an additional check if we should lock or not.
          std::lock_guard g(instantiation_cache_mutex);
          wasm_cache_index::iterator it = wasm_instantiation_cache.find( boost::make_tuple(code_hash, vm_type, vm_version) );
-         return it != wasm_instantiation_cache.end();
+         if (it != wasm_instantiation_cache.end())
+            return true;
+         std::lock_guard wg(warm_mutex);
+         return warm_modules.count(warm_key{code_hash, vm_type, vm_version}) > 0;
       }
 
       void code_block_num_last_used(const digest_type& code_hash, const uint8_t& vm_type, const uint8_t& vm_version, const uint32_t& block_num) {
@@ -268,16 +303,29 @@ struct eosvmoc_tier {
          if (it != wasm_instantiation_cache.end()) {
             // An instantiated module's module should never be null.
             assert(it->module);
+            it->last_used = ++use_sequence;
             return it->module;
          }
 
+         if (auto warm = take_warm_module(code_hash, vm_type, vm_version)) {
+            return wasm_instantiation_cache.emplace( wasm_interface_impl::wasm_cache_entry {
+               .code_hash = code_hash,
+               .last_block_num_used = UINT32_MAX,
+               .module = std::move(warm),
+               .vm_type = vm_type,
+               .vm_version = vm_version,
+               .last_used = ++use_sequence
+            } ).first->module;
+         }
+
          const code_object* codeobject = &db.get<code_object,by_code_hash>(boost::make_tuple(code_hash, vm_type, vm_version));
          it = wasm_instantiation_cache.emplace( wasm_interface_impl::wasm_cache_entry {
             .code_hash = code_hash,
             .last_block_num_used = UINT32_MAX,
             .module = nullptr,
             .vm_type = vm_type,
-            .vm_version = vm_version
+            .vm_version = vm_version,
+            .last_used = ++use_sequence
          } ).first;
          auto timer_pause = fc::make_scoped_exit([&](){
             trx_context.resume_billing_timer();
@@ -289,6 +337,112 @@ struct eosvmoc_tier {
          return it->module;
       }
 
+      // Called from the main thread at shutdown, read-only threads are not running.
+      void save_warm_code_list(const std::filesystem::path& file, uint32_t max_entries) const {
+         std::vector<const wasm_cache_entry*> entries;
+         entries.reserve(wasm_instantiation_cache.size());
+         for (const auto& e : wasm_instantiation_cache)
+            entries.push_back(&e);
+         const size_t n = std::min<size_t>(entries.size(), max_entries);
+         std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                           [](const wasm_cache_entry* a, const wasm_cache_entry* b) { return a->last_used > b->last_used; });
+
+         wasm_warm_code_list list;
+         list.codes.reserve(n);
+         for (size_t i = 0; i < n; ++i)
+            list.codes.push_back({entries[i]->code_hash, entries[i]->vm_type, entries[i]->vm_version});
+         {
+            // warmed but not used since startup, least recently used
+            std::lock_guard g(warm_mutex);
+            for (const auto& [key, module] : warm_modules) {
+               if (list.codes.size() >= max_entries)
+                  break;
+               const auto& [code_hash, vm_type, vm_version] = key;
+               if (!wasm_instantiation_cache.count(boost::make_tuple(code_hash, vm_type, vm_version)))
+                  list.codes.push_back({code_hash, vm_type, vm_version});
+            }
+         }
+
+         const auto data = fc::raw::pack(list);
+         fc::cfile f;
+         f.set_file_path(file);
+         f.open(fc::cfile::truncate_rw_mode);
+         f.write(data.data(), data.size());
+         f.flush();
+         f.close();
+      }
+
+      // Called from the main thread before any transaction is applied. The code of the listed contracts is copied and
+      // instantiated on warm_thread, which does not touch the instantiation cache: a cache miss takes the module from
+      // warm_modules if it is ready, otherwise it is instantiated as usual. Codes already compiled by EOS VM OC tier-up
+      // are skipped, as are all codes when EOS VM OC is the runtime. Returns how many codes are being instantiated.
+      size_t warm_from_code_list(const std::filesystem::path& file) {
+         if (wasm_runtime_time == wasm_interface::vm_type::eos_vm_oc || !std::filesystem::exists(file))
+            return 0;
+
+         wasm_warm_code_list list;
+         {
+            std::string data;
+            fc::read_file_contents(file, data);
+            fc::datastream<const char*> ds(data.data(), data.size());
+            fc::raw::unpack(ds, list);
+         }
+         if (list.version != wasm_warm_code_list{}.version)
+            return 0;
+
+         struct warm_code {
+            warm_key          key;
+            std::vector<char> code;
+         };
+         std::vector<warm_code> codes;
+         codes.reserve(list.codes.size());
+         for (const auto& c : list.codes) {
+            const code_object* codeobject = db.find<code_object, by_code_hash>(boost::make_tuple(c.code_hash, c.vm_type, c.vm_version));
+            if (!codeobject || wasm_instantiation_cache.count(boost::make_tuple(c.code_hash, c.vm_type, c.vm_version)))
+               continue;
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+            if (eosvmoc && eosvmoc->cc.is_cached(c.code_hash))
+               continue;
+#endif
+            codes.push_back({{c.code_hash, c.vm_type, c.vm_version},
+                             std::vector<char>(codeobject->code.data(), codeobject->code.data() + codeobject->code.size())});
+         }
+         if (codes.empty())
+            return 0;
+
+         const size_t count = codes.size();
+         warm_thread = std::thread([this, codes = std::move(codes)]() {
+            fc::set_thread_name("wasm-warm");
+            auto start = fc::time_point::now();
+            size_t n = 0;
+            for (const auto& c : codes) {
+               if (warm_stop)
+                  return;
+               const auto& [code_hash, vm_type, vm_version] = c.key;
+               try {
+                  auto module = runtime_interface->instantiate_module(c.code.data(), c.code.size(), code_hash, vm_type, vm_version);
+                  std::lock_guard g(warm_mutex);
+                  warm_modules.emplace(c.key, std::move(module));
+                  ++n;
+               } FC_LOG_AND_DROP(("Unable to instantiate ${h}", ("h", code_hash)))
+            }
+            ilog("instantiated ${n} contracts used before the last shutdown in ${t} ms",
+                 ("n", n)("t", (fc::time_point::now() - start).count() / 1000));
+         });
+         return count;
+      }
+
+      // Called on a cache miss, from any thread
+      std::unique_ptr<wasm_instantiated_module_interface> take_warm_module(const digest_type& code_hash, uint8_t vm_type, uint8_t vm_version) {
+         std::lock_guard g(warm_mutex);
+         auto it = warm_modules.find(warm_key{code_hash, vm_type, vm_version});
+         if (it == warm_modules.end())
+            return {};
+         auto module = std::move(it->second);
+         warm_modules.erase(it);
+         return module;
+      }
+
       std::unique_ptr<wasm_runtime_interface> runtime_interface;
 
       typedef boost::multi_index_container<
@@ -306,6 +460,13 @@ struct eosvmoc_tier {
       > wasm_cache_index;
       mutable std::mutex instantiation_cache_mutex;
       wasm_cache_index wasm_instantiation_cache;
+      uint64_t use_sequence = 0; ///< protected the same as wasm_instantiation_cache
+
+      using warm_key = std::tuple<digest_type, uint8_t, uint8_t>; ///< code_hash, vm_type, vm_version
+      mutable std::mutex warm_mutex;
+      std::map<warm_key, std::unique_ptr<wasm_instantiated_module_interface>> warm_modules; ///< protected by warm_mutex
+      std::thread warm_thread;
+      std::atomic<bool> warm_stop{false};
 
       const chainbase::database& db;
       platform_timer& main_thread_timer;
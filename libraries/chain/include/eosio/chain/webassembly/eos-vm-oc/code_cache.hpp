@@ -34,9 +34,13 @@ class code_cache_base {
       ~code_cache_base();
 
       const int& fd() const { return _cache_fd; }
+      const eosvmoc::config& get_config() const { return _eosvmoc_config; }
 
       void free_code(const digest_type& code_id, const uint8_t& vm_version);
 
+      // true if code_id is compiled and in the cache, called from the main thread while no transactions are applied
+      bool is_cached(const digest_type& code_id) const { return _cache_index.get<by_hash>().count(code_id) > 0; }
+
       // mode for get_descriptor_for_code calls
       struct mode {
          bool whitelisted = false;
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <optional>
+#include <vector>
 
 #include <sys/resource.h>
 
@@ -32,6 +33,8 @@ struct config {
    uint64_t cache_size = 1024u*1024u*1024u;
    uint64_t threads    = 1u;
    subjective_compile_limits non_whitelisted_limits;
+   bool                  transparent_hugepages = false; // advise huge pages for linear memory and the executed code mapping
+   std::vector<uint32_t> compile_cpu_affinity;          // cpus of the compile processes, empty for no restriction
 };
 
 //work around unexpected std::optional behavior
@@ -61,4 +64,4 @@ inline DS& operator<<(DS& ds, const eosio::chain::eosvmoc::subjective_compile_li
 
 }}}
 
-FC_REFLECT(eosio::chain::eosvmoc::config, (cache_size)(threads)(non_whitelisted_limits))
\ No newline at end of file
+FC_REFLECT(eosio::chain::eosvmoc::config, (cache_size)(threads)(non_whitelisted_limits)(transparent_hugepages)(compile_cpu_affinity))
\ No newline at end of file
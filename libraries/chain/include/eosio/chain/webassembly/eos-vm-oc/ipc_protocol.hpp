@@ -24,6 +24,7 @@ struct compile_wasm_message {
    code_tuple code;
    fc::time_point queued_time;      // when compilation was queued to begin
    std::optional<eosvmoc::subjective_compile_limits> limits;
+   std::vector<uint32_t> cpu_affinity; // cpus of the compile process, empty for no restriction
    //Two sent fd: 1) communication socket for result, 2) the wasm to compile
 };
 
@@ -66,7 +67,7 @@ using eosvmoc_message = std::variant<initialize_message,
 FC_REFLECT(eosio::chain::eosvmoc::initialize_message, )
 FC_REFLECT(eosio::chain::eosvmoc::initalize_response_message, (error_message))
 FC_REFLECT(eosio::chain::eosvmoc::code_tuple, (code_id)(vm_version))
-FC_REFLECT(eosio::chain::eosvmoc::compile_wasm_message, (code)(queued_time)(limits))
+FC_REFLECT(eosio::chain::eosvmoc::compile_wasm_message, (code)(queued_time)(limits)(cpu_affinity))
 FC_REFLECT(eosio::chain::eosvmoc::evict_wasms_message, (codes))
 FC_REFLECT(eosio::chain::eosvmoc::code_compilation_result_message, (start)(apply_offset)(starting_memory_pages)(initdata_prologue_size)(queued_time))
 FC_REFLECT(eosio::chain::eosvmoc::compilation_result_unknownfailure, )
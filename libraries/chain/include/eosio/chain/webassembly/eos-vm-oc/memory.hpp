@@ -25,7 +25,9 @@ class memory {
       static constexpr uint64_t total_memory_per_slice = memory_prologue_size + UINT64_C(0x200000000) + UINT64_C(4096);
 
    public:
-      explicit memory(uint64_t sliced_pages);
+      /// @param transparent_hugepages advise the kernel to back the memory with transparent huge pages, reducing TLB
+      ///                              misses on large memories
+      explicit memory(uint64_t sliced_pages, bool transparent_hugepages = false);
       ~memory();
       memory(const memory&) = delete;
       memory& operator=(const memory&) = delete;
@@ -35,6 +37,12 @@ class memory {
 
       control_block* const get_control_block() const { return reinterpret_cast<control_block* const>(zeropage_base - cb_offset);}
 
+      /// Zeroes the first `pages` wasm pages of linear memory, called after an action with the pages it had access to
+      /// so that the next action starts from zeroed memory without clearing all of its starting pages. Up to
+      /// max_memset_reset_pages are cleared with memset; larger memories have their pages discarded instead, so the
+      /// cost follows the pages the action actually touched. Discarded pages read back as zero on next access.
+      void reset_linear_memory(uint64_t pages);
+
       //these two are really only inteded for SEGV handling
       uint8_t* const start_of_memory_slices() const { return mapbase; }
       size_t size_of_memory_slice_mapping() const { return mapsize; }
@@ -53,6 +61,9 @@ class memory {
       // Use a small number to save upfront virtual memory consumption.
       // Memory uses beyond this limit will be handled by mprotect.
       static constexpr uint32_t sliced_pages_for_ro_thread = 10;
+      // Linear memories of at most this many wasm pages are reset with memset rather than discarded, below it the
+      // page faults after a discard cost more than clearing the memory, see the eosvmoc benchmark
+      static constexpr uint64_t max_memset_reset_pages = 32;
 
       // Changed from -cb_offset == EOS_VM_OC_CONTROL_BLOCK_OFFSET to get around
       // of compile warning about comparing integers of different signedness
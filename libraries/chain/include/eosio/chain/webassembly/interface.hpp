@@ -908,6 +908,24 @@ namespace webassembly {
           */
          int32_t db_end_i64(uint64_t code, uint64_t scope, uint64_t table);
 
+         /**
+          * Get consecutive records of a primary 64-bit integer index table, starting with the table row referenced by an iterator.
+          * Replaces a db_get_i64 and db_next_i64 call per row when scanning a table.
+          *
+          * @ingroup database primary-index
+          * @param itr - the iterator to the first table row to retrieve, or an end iterator.
+          * @param max_rows - the maximum number of records to retrieve.
+          * @param[out] buffer - the buffer which will be filled with a uint32_t count of the retrieved records followed, for each record,
+          *                      by its uint64_t primary key, its uint32_t size and its data.
+          *
+          * @return iterator to the first table row which was not retrieved, or the end iterator of the table if the last table row was retrieved.
+          * @pre `itr` points to an existing table row in the table or is an end iterator.
+          * @pre `buffer` is at least 4 bytes.
+          * @post records are retrieved until `max_rows` records are retrieved, the next record does not fit in `buffer` or the end of the table is reached.
+          * If the record of `itr` does not fit in `buffer`, no record is retrieved and `itr` is returned.
+          */
+         int32_t db_get_rows_i64(int32_t itr, uint32_t max_rows, span<char> buffer);
+
          /**
           * Store an association of a 64-bit integer secondary key to a primary key in a secondary 64-bit integer index table.
           *
@@ -363,6 +363,20 @@ host function call will trigger a transition to the Savanna consensus algorithm.
               builtin_protocol_feature_t::disable_deferred_trxs_stage_2
             }
          } )
+         (  builtin_protocol_feature_t::bulk_db_iteration, builtin_protocol_feature_spec{
+            "BULK_DB_ITERATION",
+            fc::variant("375a31a51f403f7588f02c06f5c6d834acf707ce0846ba9e8654dea74ad74f8d").as<digest_type>(),
+            // SHA256 hash of the raw message below within the comment delimiters (exclude newline after /*) (do not modify message below).
+/*
+Builtin protocol feature: BULK_DB_ITERATION
+
+Enables new `db_get_rows_i64` intrinsic which copies, in a single call, up to a
+given number of consecutive rows of a primary 64-bit integer index table,
+starting from the row referenced by an iterator, as (primary key, size, value)
+records into a buffer, and returns an iterator to the first row not copied.
+*/
+            {}
+         } )
    ;
 
 
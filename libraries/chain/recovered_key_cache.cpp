@@ -0,0 +1,121 @@
+#include <eosio/chain/recovered_key_cache.hpp>
+#include <eosio/chain/config.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+namespace eosio { namespace chain {
+
+   namespace {
+      size_t hash_key( const digest_type& digest, const digest_type& sig_digest ) {
+         size_t seed = std::hash<digest_type>()( digest );
+         boost::hash_combine( seed, sig_digest._hash[0] );
+         return seed;
+      }
+
+      // digest is a hash, use a different word of it than hash_key to spread entries over the shards
+      size_t shard_of( const digest_type& digest ) {
+         return digest._hash[1] % recovered_key_cache::num_shards;
+      }
+   }
+
+   size_t recovered_key_cache::entry_hash::operator()( const entry& e )const {
+      return hash_key( e.digest, e.sig_digest );
+   }
+
+   size_t recovered_key_cache::entry_hash::operator()( const lookup& l )const {
+      return hash_key( l.digest, l.sig_digest );
+   }
+
+   bool recovered_key_cache::entry_equal::operator()( const entry& a, const entry& b )const {
+      return a.digest == b.digest && a.sig_digest == b.sig_digest;
+   }
+
+   bool recovered_key_cache::entry_equal::operator()( const lookup& l, const entry& e )const {
+      return l.digest == e.digest && l.sig_digest == e.sig_digest;
+   }
+
+   void recovered_key_cache::shard::trim() {
+      auto& lru = entries.get<by_lru>();
+      while( entries.size() > max_entries )
+         lru.pop_back();
+   }
+
+   size_t recovered_key_cache::shard_max_entries( uint32_t max_entries ) {
+      return (max_entries + num_shards - 1) / num_shards;
+   }
+
+   recovered_key_cache::recovered_key_cache( uint32_t max_entries )
+   : max_entries( max_entries )
+   {
+      for( auto& s : shards )
+         s.max_entries = shard_max_entries( max_entries );
+   }
+
+   recovered_key_cache& recovered_key_cache::instance() {
+      static recovered_key_cache cache( config::default_recovered_key_cache_size );
+      return cache;
+   }
+
+   public_key_type recovered_key_cache::recover( const signature_type& sig, const digest_type& digest ) {
+      if( max_entries.load( std::memory_order_relaxed ) == 0 )
+         return public_key_type( sig, digest );
+
+      const digest_type sig_digest = digest_type::hash( sig );
+      shard& s = shards[shard_of( digest )];
+      {
+         std::lock_guard g( s.mtx );
+         auto itr = s.entries.find( lookup{digest, sig_digest}, entry_hash(), entry_equal() );
+         if( itr != s.entries.end() ) {
+            ++s.hits;
+            auto& lru = s.entries.get<by_lru>();
+            lru.relocate( lru.begin(), s.entries.project<by_lru>( itr ) );
+            return itr->key;
+         }
+         ++s.misses;
+      }
+
+      // recover without the lock held, recovery is the expensive part
+      public_key_type key( sig, digest );
+
+      std::lock_guard g( s.mtx );
+      auto [itr, inserted] = s.entries.insert( entry{digest, sig_digest, key} );
+      if( inserted ) { // else added by another thread
+         auto& lru = s.entries.get<by_lru>();
+         lru.relocate( lru.begin(), s.entries.project<by_lru>( itr ) );
+         s.trim();
+      }
+      return key;
+   }
+
+   void recovered_key_cache::set_max_entries( uint32_t new_max_entries ) {
+      max_entries = new_max_entries;
+      for( auto& s : shards ) {
+         std::lock_guard g( s.mtx );
+         s.max_entries = shard_max_entries( new_max_entries );
+         s.trim();
+      }
+   }
+
+   uint32_t recovered_key_cache::get_max_entries()const {
+      return max_entries;
+   }
+
+   void recovered_key_cache::clear() {
+      for( auto& s : shards ) {
+         std::lock_guard g( s.mtx );
+         s.entries.clear();
+      }
+   }
+
+   recovered_key_cache::stats recovered_key_cache::get_stats()const {
+      stats result;
+      for( const auto& s : shards ) {
+         std::lock_guard g( s.mtx );
+         result.hits    += s.hits;
+         result.misses  += s.misses;
+         result.entries += s.entries.size();
+      }
+      return result;
+   }
+
+} } /// namespace eosio::chain
@@ -0,0 +1,158 @@
+#include <eosio/chain/thread_utils.hpp>
+#include <fc/io/fstream.hpp>
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace eosio { namespace chain {
+
+namespace {
+   std::mutex                                      thread_pool_cpus_mtx;
+   std::map<std::string, std::vector<uint32_t>>    thread_pool_cpus;
+   std::vector<uint32_t>                           default_cpus; // guarded by thread_pool_cpus_mtx
+}
+
+std::vector<uint32_t> parse_cpu_list(const std::string& list) {
+   std::vector<uint32_t> result;
+   std::vector<std::string> ranges;
+   boost::split(ranges, boost::trim_copy(list), boost::is_any_of(","));
+   for (const auto& r : ranges) {
+      std::vector<std::string> bounds;
+      boost::split(bounds, r, boost::is_any_of("-"));
+      FC_ASSERT(bounds.size() <= 2 && !bounds.front().empty() && !bounds.back().empty(), "Invalid cpu list ${l}", ("l", list));
+      try {
+         const uint32_t first = std::stoul(bounds.front());
+         const uint32_t last  = std::stoul(bounds.back());
+         FC_ASSERT(first <= last, "Invalid cpu range ${r} in ${l}", ("r", r)("l", list));
+         for (uint32_t c = first; c <= last; ++c)
+            result.push_back(c);
+      } catch (const std::logic_error&) {
+         FC_THROW("Invalid cpu list ${l}", ("l", list));
+      }
+   }
+   return result;
+}
+
+bool set_current_thread_cpu_affinity(const std::vector<uint32_t>& cpus) {
+   if (cpus.empty())
+      return true;
+#ifdef __linux__
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   for (uint32_t c : cpus) {
+      if (c >= CPU_SETSIZE)
+         return false;
+      CPU_SET(c, &set);
+   }
+   return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+   return false;
+#endif
+}
+
+std::vector<uint32_t> get_current_thread_cpu_affinity() {
+   std::vector<uint32_t> result;
+#ifdef __linux__
+   cpu_set_t set;
+   if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+      for (uint32_t c = 0; c < CPU_SETSIZE; ++c) {
+         if (CPU_ISSET(c, &set))
+            result.push_back(c);
+      }
+   }
+#endif
+   return result;
+}
+
+void set_default_cpu_affinity(std::vector<uint32_t> cpus) {
+   std::lock_guard g(thread_pool_cpus_mtx);
+   default_cpus = std::move(cpus);
+}
+
+std::vector<uint32_t> get_default_cpu_affinity() {
+   std::lock_guard g(thread_pool_cpus_mtx);
+   return default_cpus;
+}
+
+void set_thread_pool_cpu_affinity(const std::string& pool_name, std::vector<uint32_t> cpus) {
+   std::lock_guard g(thread_pool_cpus_mtx);
+   thread_pool_cpus[pool_name] = std::move(cpus);
+}
+
+std::vector<uint32_t> get_thread_pool_cpu_affinity(const std::string& pool_name) {
+   std::lock_guard g(thread_pool_cpus_mtx);
+   auto i = thread_pool_cpus.find(pool_name);
+   return i == thread_pool_cpus.end() ? std::vector<uint32_t>{} : i->second;
+}
+
+void set_numa_policy(numa_policy policy) {
+   if (policy == numa_policy::none)
+      return;
+#ifdef __linux__
+   constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+   std::vector<uint32_t> nodes;
+   int mode = MPOL_INTERLEAVE;
+   if (policy == numa_policy::interleave) {
+      std::string online;
+      fc::read_file_contents("/sys/devices/system/node/online", online);
+      nodes = parse_cpu_list(online);
+   } else {
+      unsigned cpu = 0, node = 0;
+      FC_ASSERT(syscall(SYS_getcpu, &cpu, &node, nullptr) == 0, "Unable to get the memory node of the main thread");
+      nodes.push_back(node);
+      mode = MPOL_PREFERRED;
+   }
+   FC_ASSERT(!nodes.empty(), "No memory nodes found");
+
+   std::vector<unsigned long> mask(*std::max_element(nodes.begin(), nodes.end()) / bits_per_word + 1);
+   for (uint32_t n : nodes)
+      mask[n / bits_per_word] |= 1ul << (n % bits_per_word);
+   // the kernel reads maxnode-1 bits
+   const char* name = policy == numa_policy::interleave ? "interleave" : "main-node";
+   FC_ASSERT(syscall(SYS_set_mempolicy, mode, mask.data(), mask.size() * bits_per_word + 1) == 0,
+             "Unable to set memory policy ${p}: ${e}", ("p", name)("e", strerror(errno)));
+   ilog("Memory policy ${p} on memory nodes ${n}", ("p", name)("n", nodes));
+#else
+   FC_THROW("NUMA memory policies are not supported on this platform");
+#endif
+}
+
+std::istream& operator>>(std::istream& in, numa_policy& policy) {
+   std::string s;
+   in >> s;
+   if (s == "none")
+      policy = numa_policy::none;
+   else if (s == "interleave")
+      policy = numa_policy::interleave;
+   else if (s == "main-node")
+      policy = numa_policy::main_node;
+   else
+      in.setstate(std::ios_base::failbit);
+   return in;
+}
+
+std::ostream& operator<<(std::ostream& out, numa_policy policy) {
+   switch (policy) {
+      case numa_policy::none:       return out << "none";
+      case numa_policy::interleave: return out << "interleave";
+      case numa_policy::main_node:  return out << "main-node";
+   }
+   return out;
+}
+
+} } /// eosio::chain
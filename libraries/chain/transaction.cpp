@@ -10,6 +10,8 @@
 #include <eosio/chain/config.hpp>
 #include <eosio/chain/exceptions.hpp>
 #include <eosio/chain/transaction.hpp>
+#include <eosio/chain/recovered_key_cache.hpp>
+#include <eosio/chain/transaction_view.hpp>
 
 namespace eosio { namespace chain {
 
@@ -56,6 +58,23 @@ digest_type transaction::sig_digest( const chain_id_type& chain_id, const vector
    return enc.result();
 }
 
+static void recover_signature_keys( const vector<signature_type>& signatures, const digest_type& digest,
+                                    fc::time_point start, fc::time_point deadline,
+                                    flat_set<public_key_type>& recovered_pub_keys, bool allow_duplicate_keys )
+{
+   auto& key_cache = recovered_key_cache::instance();
+
+   for(const signature_type& sig : signatures) {
+      auto now = fc::time_point::now();
+      EOS_ASSERT( now < deadline, tx_cpu_usage_exceeded, "transaction signature verification executed for too long ${time}us",
+                  ("time", now - start)("now", now)("deadline", deadline)("start", start) );
+      auto[ itr, successful_insertion ] = recovered_pub_keys.emplace( key_cache.recover( sig, digest ) );
+      EOS_ASSERT( allow_duplicate_keys || successful_insertion, tx_duplicate_sig,
+                  "transaction includes more than one signature signed using the same key associated with public key: ${key}",
+                  ("key", *itr ) );
+   }
+}
+
 fc::microseconds transaction::get_signature_keys( const vector<signature_type>& signatures,
       const chain_id_type& chain_id, fc::time_point deadline, const vector<bytes>& cfd,
       flat_set<public_key_type>& recovered_pub_keys, bool allow_duplicate_keys)const
@@ -64,17 +83,7 @@ fc::microseconds transaction::get_signature_keys( const vector<signature_type>&
    recovered_pub_keys.clear();
 
    if ( !signatures.empty() ) {
-      const digest_type digest = sig_digest(chain_id, cfd);
-
-      for(const signature_type& sig : signatures) {
-         auto now = fc::time_point::now();
-         EOS_ASSERT( now < deadline, tx_cpu_usage_exceeded, "transaction signature verification executed for too long ${time}us",
-                     ("time", now - start)("now", now)("deadline", deadline)("start", start) );
-         auto[ itr, successful_insertion ] = recovered_pub_keys.emplace( sig, digest );
-         EOS_ASSERT( allow_duplicate_keys || successful_insertion, tx_duplicate_sig,
-                     "transaction includes more than one signature signed using the same key associated with public key: ${key}",
-                     ("key", *itr ) );
-      }
+      recover_signature_keys( signatures, sig_digest(chain_id, cfd), start, deadline, recovered_pub_keys, allow_duplicate_keys );
    }
 
    return fc::time_point::now() - start;
@@ -151,9 +160,11 @@ uint32_t packed_transaction::get_prunable_size()const {
 }
 
 size_t packed_transaction::get_estimated_size()const {
-   // transaction is stored packed (only transaction minus signed_transaction members) and unpacked (signed_transaction),
-   // double packed size, packed cfd size, and signature size to account for signed_transaction unpacked_trx size
-   return sizeof(*this) +
+   // transaction is stored packed (only transaction minus signed_transaction members) and, once materialized,
+   // unpacked (signed_transaction). Callers account for the estimate when adding and removing, so it must not change
+   // on materialization; always include the unpacked size estimated as double packed size, packed cfd size, and
+   // signature size
+   return sizeof(*this) + sizeof( signed_transaction ) +
           (signatures.size() * sizeof( signature_type )) * 2 +
           packed_context_free_data.size() * 2 +
           packed_trx.size() * 2;
@@ -173,6 +184,38 @@ digest_type packed_transaction::packed_digest()const {
    return enc.result();
 }
 
+digest_type packed_transaction::sig_digest( const chain_id_type& chain_id )const {
+   if( packed_view_size == 0 )
+      return get_transaction().sig_digest( chain_id, get_context_free_data() );
+
+   // packed_trx and packed_context_free_data are canonically encoded, see init_packed_view, so their bytes are
+   // those packed by transaction::sig_digest
+   digest_type::encoder enc;
+   fc::raw::pack( enc, chain_id );
+   enc.write( packed_trx.data(), packed_view_size );
+   // empty context free data is either not packed or packed as a single 0 size
+   if( packed_context_free_data.size() > 1 ) {
+      fc::raw::pack( enc, digest_type::hash( packed_context_free_data.data(), packed_context_free_data.size() ) );
+   } else {
+      fc::raw::pack( enc, digest_type() );
+   }
+   return enc.result();
+}
+
+fc::microseconds packed_transaction::get_signature_keys( const chain_id_type& chain_id, fc::time_point deadline,
+                                                         flat_set<public_key_type>& recovered_pub_keys,
+                                                         bool allow_duplicate_keys )const
+{ try {
+   auto start = fc::time_point::now();
+   recovered_pub_keys.clear();
+
+   if ( !signatures.empty() ) {
+      recover_signature_keys( signatures, sig_digest(chain_id), start, deadline, recovered_pub_keys, allow_duplicate_keys );
+   }
+
+   return fc::time_point::now() - start;
+} FC_CAPTURE_AND_RETHROW() }
+
 namespace bio = boost::iostreams;
 
 template<size_t Limit>
@@ -283,15 +326,28 @@ bytes packed_transaction::get_raw_transaction() const
    } FC_CAPTURE_AND_RETHROW((compression)(packed_trx))
 }
 
+packed_transaction::packed_transaction( const packed_transaction& o )
+:signatures(o.signatures)
+,compression(o.compression)
+,packed_context_free_data(o.packed_context_free_data)
+,packed_trx(o.packed_trx)
+,unpacked_trx(std::atomic_load(&o.unpacked_trx))
+,trx_id(o.trx_id)
+,header(o.header)
+,first_auth(o.first_auth)
+,packed_view_size(o.packed_view_size)
+{
+}
+
 packed_transaction::packed_transaction( bytes&& packed_txn, vector<signature_type>&& sigs, bytes&& packed_cfd, compression_type _compression )
 :signatures(std::move(sigs))
 ,compression(_compression)
 ,packed_context_free_data(std::move(packed_cfd))
 ,packed_trx(std::move(packed_txn))
 {
-   local_unpack_transaction({});
-   if( !packed_context_free_data.empty() ) {
-      local_unpack_context_free_data();
+   if( !init_packed_view() ) {
+      transaction t = local_unpack_transaction();
+      set_unpacked_transaction( signed_transaction( std::move(t), signatures, local_unpack_context_free_data() ) );
    }
 }
 
@@ -300,8 +356,8 @@ packed_transaction::packed_transaction( bytes&& packed_txn, vector<signature_typ
 ,compression(_compression)
 ,packed_trx(std::move(packed_txn))
 {
-   local_unpack_transaction( std::move( cfd ) );
-   if( !unpacked_trx.context_free_data.empty() ) {
+   set_unpacked_transaction( signed_transaction( local_unpack_transaction(), signatures, std::move(cfd) ) );
+   if( !unpacked_trx->context_free_data.empty() ) {
       local_pack_context_free_data();
    }
 }
@@ -310,13 +366,9 @@ packed_transaction::packed_transaction( transaction&& t, vector<signature_type>&
 :signatures(std::move(sigs))
 ,compression(_compression)
 ,packed_context_free_data(std::move(packed_cfd))
-,unpacked_trx(std::move(t), signatures, {})
-,trx_id(unpacked_trx.id())
 {
+   set_unpacked_transaction( signed_transaction( std::move(t), signatures, local_unpack_context_free_data() ) );
    local_pack_transaction();
-   if( !packed_context_free_data.empty() ) {
-      local_unpack_context_free_data();
-   }
 }
 
 void packed_transaction::reflector_init()
@@ -324,39 +376,86 @@ void packed_transaction::reflector_init()
    // called after construction, but always on the same thread and before packed_transaction passed to any other threads
    static_assert(fc::raw::has_feature_reflector_init_on_unpacked_reflected_types,
                  "FC unpack needs to call reflector_init otherwise unpacked_trx will not be initialized");
-   EOS_ASSERT( unpacked_trx.expiration == time_point_sec(), tx_decompression_error, "packed_transaction already unpacked" );
-   local_unpack_transaction({});
-   local_unpack_context_free_data();
+   EOS_ASSERT( trx_id == transaction_id_type(), tx_decompression_error, "packed_transaction already unpacked" );
+   if( !init_packed_view() ) {
+      transaction t = local_unpack_transaction();
+      set_unpacked_transaction( signed_transaction( std::move(t), signatures, local_unpack_context_free_data() ) );
+   }
+}
+
+bool packed_transaction::init_packed_view()
+{
+   if( compression != compression_type::none )
+      return false;
+   auto view = transaction_view::parse( packed_trx.data(), packed_trx.size() );
+   if( !view )
+      return false;
+   if( !packed_context_free_data.empty() &&
+       !parse_context_free_data( packed_context_free_data.data(), packed_context_free_data.size() ) )
+      return false;
+
+   // canonically encoded, the packed bytes are those transaction::id() would pack
+   header           = view->header();
+   trx_id           = digest_type::hash( view->packed().data(), view->packed().size() );
+   packed_view_size = view->packed().size();
+   first_auth       = account_name();
+   view->for_each_action( [this]( const action_view& a ) {
+      if( first_auth.empty() && a.authorization_size > 0 )
+         first_auth = a.authorization( 0 ).actor;
+   } );
+   return true;
+}
+
+const signed_transaction& packed_transaction::get_signed_transaction()const
+{
+   if( auto t = std::atomic_load( &unpacked_trx ) )
+      return *t;
+
+   transaction trx = local_unpack_transaction();
+   auto t = std::make_shared<const signed_transaction>( std::move(trx), signatures, local_unpack_context_free_data() );
+   std::shared_ptr<const signed_transaction> expected;
+   // materialized concurrently by another thread, use its copy as references to it may have been returned
+   if( !std::atomic_compare_exchange_strong( &unpacked_trx, &expected, t ) )
+      return *expected;
+   // owned by unpacked_trx, which is never reset
+   return *t;
+}
+
+bool packed_transaction::is_materialized()const
+{
+   return std::atomic_load( &unpacked_trx ) != nullptr;
 }
 
-void packed_transaction::local_unpack_transaction(vector<bytes>&& context_free_data)
+void packed_transaction::set_unpacked_transaction(signed_transaction&& t)
+{
+   unpacked_trx = std::make_shared<const signed_transaction>( std::move(t) );
+   trx_id = unpacked_trx->id();
+   header = *unpacked_trx;
+   first_auth = unpacked_trx->first_authorizer();
+}
+
+transaction packed_transaction::local_unpack_transaction()const
 {
    try {
       switch( compression ) {
          case compression_type::none:
-            unpacked_trx = signed_transaction( unpack_transaction( packed_trx ), signatures, std::move(context_free_data) );
-            break;
+            return unpack_transaction( packed_trx );
          case compression_type::zlib:
-            unpacked_trx = signed_transaction( zlib_decompress_transaction( packed_trx ), signatures, std::move(context_free_data) );
-            break;
+            return zlib_decompress_transaction( packed_trx );
          default:
             EOS_THROW( unknown_transaction_compression, "Unknown transaction compression algorithm" );
       }
-      trx_id = unpacked_trx.id();
    } FC_CAPTURE_AND_RETHROW( (compression) )
 }
 
-void packed_transaction::local_unpack_context_free_data()
+vector<bytes> packed_transaction::local_unpack_context_free_data()const
 {
    try {
-      EOS_ASSERT(unpacked_trx.context_free_data.empty(), tx_decompression_error, "packed_transaction.context_free_data not empty");
       switch( compression ) {
          case compression_type::none:
-            unpacked_trx.context_free_data = unpack_context_free_data( packed_context_free_data );
-            break;
+            return unpack_context_free_data( packed_context_free_data );
          case compression_type::zlib:
-            unpacked_trx.context_free_data = zlib_decompress_context_free_data( packed_context_free_data );
-            break;
+            return zlib_decompress_context_free_data( packed_context_free_data );
          default:
             EOS_THROW( unknown_transaction_compression, "Unknown transaction compression algorithm" );
       }
@@ -368,10 +467,10 @@ void packed_transaction::local_pack_transaction()
    try {
       switch(compression) {
          case compression_type::none:
-            packed_trx = pack_transaction(unpacked_trx);
+            packed_trx = pack_transaction(*unpacked_trx);
             break;
          case compression_type::zlib:
-            packed_trx = zlib_compress_transaction(unpacked_trx);
+            packed_trx = zlib_compress_transaction(*unpacked_trx);
             break;
          default:
             EOS_THROW(unknown_transaction_compression, "Unknown transaction compression algorithm");
@@ -384,10 +483,10 @@ void packed_transaction::local_pack_context_free_data()
    try {
       switch(compression) {
          case compression_type::none:
-            packed_context_free_data = pack_context_free_data(unpacked_trx.context_free_data);
+            packed_context_free_data = pack_context_free_data(unpacked_trx->context_free_data);
             break;
          case compression_type::zlib:
-            packed_context_free_data = zlib_compress_context_free_data(unpacked_trx.context_free_data);
+            packed_context_free_data = zlib_compress_context_free_data(unpacked_trx->context_free_data);
             break;
          default:
             EOS_THROW(unknown_transaction_compression, "Unknown transaction compression algorithm");
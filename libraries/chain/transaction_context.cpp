@@ -8,6 +8,7 @@
 #include <eosio/chain/transaction_object.hpp>
 #include <eosio/chain/global_property_object.hpp>
 #include <eosio/chain/deep_mind.hpp>
+#include <eosio/chain/db_access_tracer.hpp>
 
 #include <bit>
 
@@ -82,6 +83,9 @@ namespace eosio::chain {
       if(auto dm_logger = control.get_deep_mind_logger(is_transient())) {
          dm_logger->on_start_transaction();
       }
+      if(auto tracer = control.get_db_access_tracer(is_transient())) {
+         tracer->on_start_transaction();
+      }
    }
 
    transaction_context::~transaction_context()
@@ -444,12 +448,14 @@ namespace eosio::chain {
 
    void transaction_context::squash() {
       if (undo_session) undo_session->squash();
+      if (auto tracer = control.get_db_access_tracer(is_transient())) tracer->on_squash_transaction();
       control.apply_trx_block_context(trx_blk_context);
       transaction_timer.stop();
    }
 
    void transaction_context::undo() {
       if (undo_session) undo_session->undo();
+      if (auto tracer = control.get_db_access_tracer(is_transient())) tracer->on_undo_transaction();
       transaction_timer.stop();
    }
 
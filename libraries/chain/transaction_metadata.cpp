@@ -25,9 +25,8 @@ transaction_metadata_ptr transaction_metadata::recover_keys( packed_transaction_
    fc::time_point deadline = time_limit == fc::microseconds::maximum() ?
                              fc::time_point::maximum() : fc::time_point::now() + time_limit;
    check_variable_sig_size( trx, max_variable_sig_size );
-   const signed_transaction& trn = trx->get_signed_transaction();
    flat_set<public_key_type> recovered_pub_keys;
-   fc::microseconds cpu_usage = trn.get_signature_keys( chain_id, deadline, recovered_pub_keys );
+   fc::microseconds cpu_usage = trx->get_signature_keys( chain_id, deadline, recovered_pub_keys );
    return std::make_shared<transaction_metadata>( private_type(), std::move( trx ), cpu_usage, std::move( recovered_pub_keys ), t );
 }
 
@@ -0,0 +1,170 @@
+#include <eosio/chain/transaction_view.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <cstring>
+
+namespace eosio { namespace chain {
+
+   namespace {
+      // reads as fc::raw::unpack, failing instead of throwing; canonical is cleared by encodings that pack differently
+      struct reader {
+         const char* pos;
+         const char* end;
+         bool        canonical = true;
+
+         template<typename T>
+         bool read( T& v ) {
+            static_assert( std::is_trivially_copyable_v<T> );
+            if( size_t(end - pos) < sizeof(T) )
+               return false;
+            memcpy( &v, pos, sizeof(T) );
+            pos += sizeof(T);
+            return true;
+         }
+
+         bool skip( size_t n ) {
+            if( size_t(end - pos) < n )
+               return false;
+            pos += n;
+            return true;
+         }
+
+         // as fc::raw::unpack( s, unsigned_int& )
+         bool read_varuint32( uint32_t& value ) {
+            const char* start = pos;
+            uint64_t v = 0; char b = 0; uint8_t by = 0;
+            do {
+               if( pos == end )
+                  return false;
+               b = *pos++;
+               v |= uint32_t(uint8_t(b) & 0x7f) << by;
+               by += 7;
+            } while( uint8_t(b) & 0x80 && by < 32 );
+            value = static_cast<uint32_t>(v);
+
+            char packed[5];
+            fc::datastream<char*> ds( packed, sizeof(packed) );
+            fc::raw::pack( ds, fc::unsigned_int(value) );
+            if( size_t(pos - start) != ds.tellp() || memcmp( start, packed, ds.tellp() ) != 0 )
+               canonical = false;
+            return true;
+         }
+
+         bool read_size( uint32_t& size, uint32_t max ) {
+            return read_varuint32( size ) && size <= max;
+         }
+
+         bool skip_bytes() {
+            uint32_t size = 0;
+            return read_size( size, MAX_SIZE_OF_BYTE_ARRAYS ) && skip( size );
+         }
+
+         bool skip_actions( uint32_t& count, const char*& first ) {
+            if( !read_size( count, MAX_NUM_ARRAY_ELEMENTS ) )
+               return false;
+            first = pos;
+            for( uint32_t i = 0; i < count; ++i ) {
+               uint32_t auth_size = 0;
+               if( !skip( sizeof(account_name) + sizeof(action_name) ) ||
+                   !read_size( auth_size, MAX_NUM_ARRAY_ELEMENTS ) ||
+                   !skip( size_t(auth_size) * sizeof(permission_level) ) ||
+                   !skip_bytes() )
+                  return false;
+            }
+            return true;
+         }
+      };
+
+      static_assert( sizeof(permission_level) == 2 * sizeof(uint64_t) );
+   }
+
+   permission_level action_view::authorization( uint32_t i )const {
+      assert( i < authorization_size );
+      permission_level p;
+      memcpy( &p.actor, authorization_data.data() + i * sizeof(permission_level), sizeof(uint64_t) );
+      memcpy( &p.permission, authorization_data.data() + i * sizeof(permission_level) + sizeof(uint64_t), sizeof(uint64_t) );
+      return p;
+   }
+
+   action action_view::materialize()const {
+      vector<permission_level> auth;
+      auth.reserve( authorization_size );
+      for( uint32_t i = 0; i < authorization_size; ++i )
+         auth.push_back( authorization( i ) );
+      return action( std::move(auth), account, name, bytes( data.begin(), data.end() ) );
+   }
+
+   std::optional<transaction_view> transaction_view::parse( const char* data, size_t size ) {
+      reader r{ data, data + size };
+      transaction_view v;
+
+      uint32_t expiration = 0;
+      uint32_t max_net_usage_words = 0;
+      uint32_t delay_sec = 0;
+      if( !r.read( expiration ) ||
+          !r.read( v._header.ref_block_num ) ||
+          !r.read( v._header.ref_block_prefix ) ||
+          !r.read_varuint32( max_net_usage_words ) ||
+          !r.read( v._header.max_cpu_usage_ms ) ||
+          !r.read_varuint32( delay_sec ) )
+         return {};
+      v._header.expiration          = time_point_sec( expiration );
+      v._header.max_net_usage_words = max_net_usage_words;
+      v._header.delay_sec           = delay_sec;
+
+      if( !r.skip_actions( v._context_free_actions_size, v._context_free_actions ) ||
+          !r.skip_actions( v._actions_size, v._actions ) )
+         return {};
+
+      uint32_t extensions_size = 0;
+      if( !r.read_size( extensions_size, MAX_NUM_ARRAY_ELEMENTS ) )
+         return {};
+      for( uint32_t i = 0; i < extensions_size; ++i ) {
+         if( !r.skip( sizeof(uint16_t) ) || !r.skip_bytes() )
+            return {};
+      }
+
+      if( !r.canonical )
+         return {};
+
+      v._packed = std::span<const char>( data, r.pos );
+      return v;
+   }
+
+   action_view transaction_view::next_action( const char*& pos )const {
+      // validated by parse, reads can not fail
+      reader r{ pos, _packed.data() + _packed.size() };
+      action_view a;
+      uint32_t data_size = 0;
+      r.read( a.account );
+      r.read( a.name );
+      r.read_varuint32( a.authorization_size );
+      a.authorization_data = std::span<const char>( r.pos, size_t(a.authorization_size) * sizeof(permission_level) );
+      r.skip( a.authorization_data.size() );
+      r.read_varuint32( data_size );
+      a.data = std::span<const char>( r.pos, data_size );
+      r.skip( data_size );
+      pos = r.pos;
+      return a;
+   }
+
+   transaction transaction_view::materialize()const {
+      return fc::raw::unpack<transaction>( _packed.data(), _packed.size() );
+   }
+
+   std::optional<uint32_t> parse_context_free_data( const char* data, size_t size ) {
+      reader r{ data, data + size };
+      uint32_t count = 0;
+      if( !r.read_size( count, MAX_NUM_ARRAY_ELEMENTS ) )
+         return {};
+      for( uint32_t i = 0; i < count; ++i ) {
+         if( !r.skip_bytes() )
+            return {};
+      }
+      if( !r.canonical || r.pos != r.end )
+         return {};
+      return count;
+   }
+
+} } /// namespace eosio::chain
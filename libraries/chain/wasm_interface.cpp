@@ -95,6 +95,14 @@ namespace eosio { namespace chain {
       return my->is_code_cached(code_hash, vm_type, vm_version);
    }
 
+   void wasm_interface::save_warm_code_list(const std::filesystem::path& file, uint32_t max_entries) const {
+      my->save_warm_code_list(file, max_entries);
+   }
+
+   size_t wasm_interface::warm_from_code_list(const std::filesystem::path& file) {
+      return my->warm_from_code_list(file);
+   }
+
 #ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
    bool wasm_interface::is_eos_vm_oc_enabled() const {
       return my->is_eos_vm_oc_enabled();
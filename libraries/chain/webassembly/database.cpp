@@ -35,6 +35,9 @@ namespace eosio { namespace chain { namespace webassembly {
    int32_t interface::db_end_i64( uint64_t code, uint64_t scope, uint64_t table ) {
       return context.db_end_i64( name(code), name(scope), name(table) );
    }
+   int32_t interface::db_get_rows_i64( int32_t itr, uint32_t max_rows, span<char> buffer ) {
+      return context.db_get_rows_i64( itr, max_rows, buffer.data(), buffer.size() );
+   }
 
    /**
     * interface for uint64_t secondary
@@ -3,6 +3,7 @@
 #include <eosio/chain/webassembly/eos-vm-oc/memory.hpp>
 #include <eosio/chain/webassembly/eos-vm-oc/intrinsic.hpp>
 #include <eosio/chain/wasm_eosio_injection.hpp>
+#include <eosio/chain/thread_utils.hpp>
 
 #include <sys/prctl.h>
 #include <signal.h>
@@ -196,6 +197,9 @@ void run_compile_trampoline(int fd) {
          struct rlimit core_limits = {0u, 0u};
          setrlimit(RLIMIT_CORE, &core_limits);
 
+         if(!set_current_thread_cpu_affinity(msg.cpu_affinity))
+            std::cerr << "EOS VM OC compile could not be restricted to the configured cpus" << std::endl;
+
          run_compile(std::move(fds[0]), std::move(fds[1]), stack_size, generated_code_size_limit, msg.queued_time);
          _exit(0);
       }
@@ -22,6 +22,9 @@
 #include <sys/syscall.h>
 #include <sys/mman.h>
 
+#include <cerrno>
+#include <cstring>
+
 #if defined(__has_feature)
 #if __has_feature(shadow_call_stack)
 #error EOS VM OC is not compatible with Clang ShadowCallStack
@@ -162,6 +165,10 @@ executor::executor(const code_cache_base& cc) {
    FC_ASSERT(code_mapping != MAP_FAILED, "failed to map code cache in to executor");
    code_mapping_size = s.st_size;
    mapping_is_executable = true;
+
+   // advisory only: file backed huge pages need a kernel with read-only THP for file systems
+   if(cc.get_config().transparent_hugepages && madvise(code_mapping, code_mapping_size, MADV_HUGEPAGE))
+      wlog("EOS VM OC code mapping could not be advised for transparent huge pages: ${e}", ("e", strerror(errno)));
 }
 
 void executor::execute(const code_descriptor& code, memory& mem, apply_context& context) {
@@ -180,7 +187,7 @@ void executor::execute(const code_descriptor& code, memory& mem, apply_context&
    stack.reset(max_call_depth);
    EOS_ASSERT(code.starting_memory_pages <= (int)max_pages, wasm_execution_error, "Initial memory out of range");
 
-   //prepare initial memory, mutable globals, and table data
+   //prepare initial memory, mutable globals, and table data. Linear memory is already zero, it is reset after each action
    if(code.starting_memory_pages > 0 ) {
       uint64_t initial_page_offset = std::min(static_cast<std::size_t>(code.starting_memory_pages), mem.size_of_memory_slice_mapping()/memory::stride - 1);
       if(initial_page_offset < static_cast<uint64_t>(code.starting_memory_pages)) {
@@ -188,7 +195,6 @@ void executor::execute(const code_descriptor& code, memory& mem, apply_context&
                   (code.starting_memory_pages - initial_page_offset) * eosio::chain::wasm_constraints::wasm_page_size, PROT_READ | PROT_WRITE);
       }
       eos_vm_oc_setgs((uint64_t)mem.zero_page_memory_base()+initial_page_offset*memory::stride);
-      memset(mem.full_page_memory_base(), 0, 64u*1024u*code.starting_memory_pages);
    }
    else
       eos_vm_oc_setgs((uint64_t)mem.zero_page_memory_base());
@@ -237,6 +243,9 @@ void executor::execute(const code_descriptor& code, memory& mem, apply_context&
       cb->bounce_buffers->clear();
       tt.set_expiration_callback(nullptr, nullptr);
 
+      if(cb->current_linear_memory_pages > 0)
+         mem.reset_linear_memory(cb->current_linear_memory_pages);
+
       int64_t base_pages = mem.size_of_memory_slice_mapping()/memory::stride - 1;
       if(cb->current_linear_memory_pages > base_pages) {
          mprotect(mem.full_page_memory_base() + base_pages * eosio::chain::wasm_constraints::wasm_page_size,
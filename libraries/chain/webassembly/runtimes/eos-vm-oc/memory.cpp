@@ -5,12 +5,16 @@
 
 #include <fc/scoped_exit.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
 #include <unistd.h>
 #include <sys/mman.h>
 
 namespace eosio { namespace chain { namespace eosvmoc {
 
-memory::memory(uint64_t sliced_pages) {
+memory::memory(uint64_t sliced_pages, bool transparent_hugepages) {
    uint64_t number_slices = sliced_pages + 1;
    uint64_t wasm_memory_size = sliced_pages * wasm_constraints::wasm_page_size;
    int fd = exec_sealed_memfd_create("eosvmoc_mem");
@@ -33,6 +37,10 @@ memory::memory(uint64_t sliced_pages) {
    }
 
    FC_ASSERT(last != nullptr, "expected last not nullptr");
+
+   // advisory only: shared memory needs transparent_hugepage/shmem_enabled of advise or higher
+   if(transparent_hugepages && madvise(mapbase, mapsize, MADV_HUGEPAGE))
+      wlog("EOS VM OC linear memory could not be advised for transparent huge pages: ${e}", ("e", strerror(errno)));
    zeropage_base = mapbase + memory_prologue_size;
    fullpage_base = last + memory_prologue_size;
 
@@ -43,6 +51,27 @@ memory::memory(uint64_t sliced_pages) {
       intrinsic_jump_table[-(int)intrinsic.second.ordinal] = (uintptr_t)intrinsic.second.function_ptr;
 }
 
+void memory::reset_linear_memory(uint64_t pages) {
+   if(pages <= max_memset_reset_pages) {
+      memset(fullpage_base, 0, pages*wasm_constraints::wasm_page_size);
+      return;
+   }
+
+   // pages up to the number of slices are backed by the memory memfd, shared by all slices; pages past them are the
+   // anonymous private reservation made accessible with mprotect on demand
+   // called from the executor's cleanup, fall back to memset instead of throwing should the discard fail
+   const uint64_t sliced_pages = mapsize/stride - 1;
+   const uint64_t shared_pages = std::min(pages, sliced_pages);
+   if(shared_pages && madvise(fullpage_base, shared_pages*wasm_constraints::wasm_page_size, MADV_REMOVE))
+      memset(fullpage_base, 0, shared_pages*wasm_constraints::wasm_page_size);
+   if(pages > shared_pages) {
+      uint8_t* const anon_base = fullpage_base + shared_pages*wasm_constraints::wasm_page_size;
+      const uint64_t anon_size = (pages - shared_pages)*wasm_constraints::wasm_page_size;
+      if(madvise(anon_base, anon_size, MADV_DONTNEED))
+         memset(anon_base, 0, anon_size);
+   }
+}
+
 memory::~memory() {
    munmap(mapbase, mapsize);
 }
@@ -651,6 +651,9 @@ REGISTER_CF_HOST_FUNCTION( bls_fp_mod );
 REGISTER_CF_HOST_FUNCTION( bls_fp_mul );
 REGISTER_CF_HOST_FUNCTION( bls_fp_exp ); 
 
+// bulk_db_iteration protocol feature
+REGISTER_HOST_FUNCTION( db_get_rows_i64 );
+
 } // namespace webassembly
 } // namespace chain
 } // namespace eosio
@@ -152,6 +152,11 @@ public:
    bool read_write_queue_empty() { return pri_queue_.empty(exec_queue::read_write); }
    bool read_exclusive_queue_empty() { return pri_queue_.empty(exec_queue::read_exclusive); }
 
+   // wait times of the tasks of q executed since the last call, thread safe
+   queue_wait_histogram take_queue_wait_histogram(exec_queue q) { return pri_queue_.take_queue_wait_histogram(q); }
+   // time spent executing tasks in the read window summed over all threads, excluding waits for tasks, thread safe
+   int64_t take_read_window_exec_time_us() { return pri_queue_.take_locked_exec_time_us(); }
+
    // members are ordered taking into account that the last one is destructed first
 private:
    std::thread::id                    main_thread_id_{ std::this_thread::get_id() };
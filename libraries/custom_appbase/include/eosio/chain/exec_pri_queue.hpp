@@ -2,6 +2,10 @@
 #include <boost/asio.hpp>
 #include <boost/heap/binomial_heap.hpp>
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -34,10 +38,29 @@ enum class exec_queue {
                        // if asked to queue a read_exclusive task when init'ed with 0 read-only threads.
 };
 
+// Distribution of the time tasks waited in a queue before they were executed. Bucket n counts waits of a bit width of
+// n microseconds, i.e. less than 2^n us, and the last bucket all longer waits.
+struct queue_wait_histogram {
+   static constexpr size_t num_buckets = 24; // last bounded bucket is ~4s
+
+   std::array<uint64_t, num_buckets> buckets{};
+   uint64_t                          count   = 0;
+   int64_t                           sum_us  = 0;
+
+   queue_wait_histogram& operator+=(const queue_wait_histogram& o) {
+      for (size_t i = 0; i < num_buckets; ++i)
+         buckets[i] += o.buckets[i];
+      count  += o.count;
+      sum_us += o.sum_us;
+      return *this;
+   }
+};
+
 // Locking has to be coordinated by caller, use with care.
 class exec_pri_queue : public boost::asio::execution_context
 {
 public:
+   using clock = std::chrono::steady_clock;
 
    ~exec_pri_queue() {
       clear(read_only_handlers_);
@@ -77,10 +100,10 @@ public:
    }
 
    template <typename Function>
-   void add(int priority, exec_queue q, size_t order, Function&& function) {
+   void add(int priority, exec_queue q, size_t order, Function&& function, clock::time_point enqueued = clock::now()) {
       assert( num_read_threads_ > 0 || q != exec_queue::read_exclusive);
       prio_queue& que = priority_que(q);
-      std::unique_ptr<queued_handler_base> handler(new queued_handler<Function>(handler_id::unique, priority, order, std::forward<Function>(function)));
+      std::unique_ptr<queued_handler_base> handler(new queued_handler<Function>(handler_id::unique, priority, order, enqueued, std::forward<Function>(function)));
       if (lock_enabled_ || q == exec_queue::read_exclusive) { // called directly from any thread for read_exclusive
          std::lock_guard g( mtx_ );
          que.push( handler.release() );
@@ -93,10 +116,10 @@ public:
 
    // called from appbase::application_base::exec poll_one() or run_one()
    template <typename Function>
-   void add(handler_id id, int priority, exec_queue q, size_t order, Function&& function) {
+   void add(handler_id id, int priority, exec_queue q, size_t order, Function&& function, clock::time_point enqueued = clock::now()) {
       assert( num_read_threads_ > 0 || q != exec_queue::read_exclusive);
       if (id == handler_id::unique) {
-         return add(priority, q, order, std::forward<Function>(function));
+         return add(priority, q, order, std::forward<Function>(function), enqueued);
       }
       prio_queue& que = priority_que(q);
       std::unique_lock g( mtx_, std::defer_lock );
@@ -117,7 +140,7 @@ public:
                return;
          }
       }
-      que.push( new queued_handler<Function>(id, priority, order, std::forward<Function>(function)) );
+      que.push( new queued_handler<Function>(id, priority, order, enqueued, std::forward<Function>(function)) );
       if (g.owns_lock() && num_waiting_)
          cond_.notify_one();
    }
@@ -136,7 +159,8 @@ public:
          return false;
       auto t = pop(que);
       g.unlock();
-      t->execute();
+      record_wait(q, *t);
+      execute_timed(*t);
       return true;
    }
 
@@ -154,6 +178,7 @@ public:
       assert(que.top());
       // pop, then execute since read_write queue is used to switch to read window and the pop needs to happen before that lambda starts
       auto t = pop(que);
+      record_wait(q, *t);
       t->execute();
       --size;
       return size > 0;
@@ -186,7 +211,8 @@ public:
          q = lhs;
       auto t = pop(priority_que(q));
       g.unlock();
-      t->execute();
+      record_wait(q, *t);
+      execute_timed(*t);
       return true; // this should never return false unless all read threads should exit
    }
 
@@ -200,11 +226,29 @@ public:
    // Only call when locking disabled
    const auto& top(exec_queue q) const { return priority_que(q).top(); }
 
+   // @return the wait times of the tasks of q executed since the last call, thread safe
+   queue_wait_histogram take_queue_wait_histogram(exec_queue q) {
+      wait_stats& stats = queue_wait_stats(q);
+      queue_wait_histogram h;
+      for (size_t i = 0; i < h.buckets.size(); ++i) {
+         h.buckets[i] = stats.buckets[i].exchange(0, std::memory_order_relaxed);
+         h.count += h.buckets[i];
+      }
+      h.sum_us = stats.sum_us.exchange(0, std::memory_order_relaxed);
+      return h;
+   }
+
+   // @return the time spent executing tasks while locking is enabled, summed over all threads, since the last call.
+   // Excludes the time threads waited for tasks. Thread safe.
+   int64_t take_locked_exec_time_us() {
+      return locked_exec_us_.exchange(0, std::memory_order_relaxed);
+   }
+
    class executor
    {
    public:
       executor(exec_pri_queue& q, handler_id id, int p, size_t o, exec_queue que)
-            : context_(q), que_(que), id_(id), priority_(p), order_(o)
+            : context_(q), que_(que), id_(id), priority_(p), order_(o), posted_(clock::now())
       {
       }
 
@@ -216,19 +260,19 @@ public:
       template <typename Function, typename Allocator>
       void dispatch(Function f, const Allocator&) const
       {
-         context_.add(id_, priority_, que_, order_, std::move(f));
+         context_.add(id_, priority_, que_, order_, std::move(f), posted_);
       }
 
       template <typename Function, typename Allocator>
       void post(Function f, const Allocator&) const
       {
-         context_.add(id_, priority_, que_, order_, std::move(f));
+         context_.add(id_, priority_, que_, order_, std::move(f), posted_);
       }
 
       template <typename Function, typename Allocator>
       void defer(Function f, const Allocator&) const
       {
-         context_.add(id_, priority_, que_, order_, std::move(f));
+         context_.add(id_, priority_, que_, order_, std::move(f), posted_);
       }
 
       void on_work_started() const noexcept {}
@@ -250,6 +294,7 @@ public:
       handler_id id_;
       int priority_;
       size_t order_;
+      clock::time_point posted_; // when wrapped for posting to the io_context, counted as the start of the queue wait
    };
 
    template <typename Function>
@@ -270,10 +315,11 @@ private:
    class queued_handler_base
    {
    public:
-      queued_handler_base( handler_id id, int p, size_t order )
+      queued_handler_base( handler_id id, int p, size_t order, clock::time_point enqueued )
             : id_( id )
             , priority_( p )
             , order_( order )
+            , enqueued_( enqueued )
       {
       }
 
@@ -283,6 +329,7 @@ private:
 
       handler_id id() const { return id_; }
       int priority() const { return priority_; }
+      clock::time_point enqueued() const { return enqueued_; }
 
       friend bool operator<(const queued_handler_base& a, const queued_handler_base& b) noexcept {
          // exclude id_
@@ -293,14 +340,15 @@ private:
       handler_id id_; // unique identifier of handler
       int priority_;  // priority of handler, see application_base priority
       size_t order_;  // maintain order within priority grouping
+      clock::time_point enqueued_; // when the handler was posted
    };
 
    template <typename Function>
    class queued_handler : public queued_handler_base
    {
    public:
-      queued_handler(handler_id id, int p, size_t order, Function f)
-            : queued_handler_base( id, p, order )
+      queued_handler(handler_id id, int p, size_t order, clock::time_point enqueued, Function f)
+            : queued_handler_base( id, p, order, enqueued )
             , function_( std::move(f) )
       {
       }
@@ -364,6 +412,31 @@ private:
          pop(que);
    }
 
+   struct wait_stats {
+      std::array<std::atomic<uint64_t>, queue_wait_histogram::num_buckets> buckets{};
+      std::atomic<int64_t>                                                 sum_us{0};
+   };
+
+   wait_stats& queue_wait_stats(exec_queue q) {
+      return wait_stats_[static_cast<size_t>(q)];
+   }
+
+   void record_wait(exec_queue q, const queued_handler_base& h) {
+      const int64_t wait_us = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - h.enqueued()).count();
+      const size_t  bucket  = std::min<size_t>(std::bit_width(static_cast<uint64_t>(std::max<int64_t>(wait_us, 0))),
+                                               queue_wait_histogram::num_buckets - 1);
+      wait_stats& stats = queue_wait_stats(q);
+      stats.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+      stats.sum_us.fetch_add(wait_us, std::memory_order_relaxed);
+   }
+
+   void execute_timed(queued_handler_base& h) {
+      const auto start = clock::now();
+      h.execute();
+      locked_exec_us_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count(),
+                                std::memory_order_relaxed);
+   }
+
    size_t num_read_threads_ = 0;
    bool lock_enabled_ = false;
    mutable std::mutex mtx_;
@@ -375,6 +448,8 @@ private:
    prio_queue read_only_handlers_;
    prio_queue read_write_handlers_;
    prio_queue read_exclusive_handlers_;
+   std::array<wait_stats, 3> wait_stats_; // indexed by exec_queue
+   std::atomic<int64_t> locked_exec_us_{0};
 };
 
 } // appbase
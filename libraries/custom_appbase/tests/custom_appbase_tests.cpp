@@ -7,6 +7,7 @@
 
 #include <thread>
 #include <iostream>
+#include <numeric>
 
 using namespace appbase;
 
@@ -582,4 +583,37 @@ BOOST_AUTO_TEST_CASE( execute_many_from_read_only_and_read_exclusive_queues ) {
    BOOST_CHECK(run_on_main > 0);
 }
 
+
+// verify the time executed tasks waited in their queue is recorded per queue
+BOOST_AUTO_TEST_CASE( queue_wait_histogram_of_executed ) {
+   scoped_app_thread app(true);
+
+   // tasks posted before exec() starts wait at least 2ms
+   for (size_t i = 0; i < 5; ++i)
+      app->executor().post( priority::medium, exec_queue::read_only,  [](){} );
+   for (size_t i = 0; i < 3; ++i)
+      app->executor().post( priority::medium, exec_queue::read_write, [](){} );
+   std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+   std::promise<void> executed;
+   app->executor().post( priority::lowest, exec_queue::read_write, [&]() { executed.set_value(); } );
+   app.start_exec();
+   executed.get_future().get();
+
+   const auto ro = app->executor().take_queue_wait_histogram(exec_queue::read_only);
+   const auto rw = app->executor().take_queue_wait_histogram(exec_queue::read_write);
+   BOOST_CHECK_EQUAL( ro.count, 5u );
+   BOOST_CHECK_GE( rw.count, 4u );
+   BOOST_CHECK_GE( ro.sum_us, 5 * 2000 );
+   // waits of 2ms or more have a bit width of at least 11
+   BOOST_CHECK_EQUAL( std::accumulate(ro.buckets.begin() + 11, ro.buckets.end(), uint64_t{0}), 5u );
+
+   // taking the histogram resets it
+   BOOST_CHECK_EQUAL( app->executor().take_queue_wait_histogram(exec_queue::read_only).count, 0u );
+   BOOST_CHECK_EQUAL( app->executor().take_queue_wait_histogram(exec_queue::read_exclusive).count, 0u );
+
+   app->quit();
+   app.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,299 @@
+#pragma once
+#include <fc/time.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace fc {
+
+   /**
+    * @class expiry_wheel
+    * @brief unordered map from Key to T where every entry has an expiration time
+    *
+    * Entries are found by hashed lookup of their key and are also linked into a hierarchical timing wheel bucketed
+    * by expiration time. Insert, erase and expire are amortized O(1), unlike an ordered expiration index which pays
+    * O(log n) on every insert and erase only so that expired entries can be found.
+    *
+    * The wheel has `levels` levels of 64 slots, each slot of level n spanning 64^n ticks of `resolution`. Entries move
+    * down a level at most once per level as time advances. Entries beyond the range of the top level are kept on an
+    * overflow list until they come into range.
+    *
+    * Expiration is exact, an entry is expired only once `now >= expiry`; the resolution only controls bucketing.
+    * Entries inserted with an expiry that has already passed are expired by the next call to expire().
+    *
+    * Not thread safe.
+    */
+   template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<std::pair<const Key, T>>>
+   class expiry_wheel {
+   private:
+      // link members are not part of the key so are mutable, erase by iterator_to() is O(1) unlike std::unordered_map
+      struct entry_type {
+         template <typename... Args>
+         entry_type( const Key& key, fc::time_point expiry, uint64_t tick, Args&&... args )
+         : key( key ), value( std::forward<Args>(args)... ), expiry( expiry ), tick( tick ) {}
+
+         Key                       key;
+         mutable T                 value;
+         mutable fc::time_point    expiry;
+         mutable uint64_t          tick = 0;
+         mutable const entry_type* prev = nullptr;
+         mutable const entry_type* next = nullptr;
+         mutable uint32_t          slot = 0;
+      };
+
+      using map_type = boost::multi_index_container<
+         entry_type,
+         boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<BOOST_MULTI_INDEX_MEMBER( entry_type, Key, key ), Hash, KeyEqual>
+         >,
+         typename std::allocator_traits<Allocator>::template rebind_alloc<entry_type>
+      >;
+
+      static constexpr uint32_t slot_bits  = 6;
+      static constexpr uint32_t num_slots  = 1u << slot_bits;
+      static constexpr uint64_t slot_mask  = num_slots - 1;
+      static constexpr uint32_t levels     = 5;
+      static constexpr uint32_t far_slot   = levels * num_slots; // overflow list
+
+      fc::microseconds                            _resolution;
+      uint64_t                                    _current = 0; // all ticks before _current have been expired
+      uint64_t                                    _far_min = 0; // lower bound of the ticks on the overflow list
+      map_type                                    _map;
+      std::array<const entry_type*, far_slot + 1> _heads{};
+      std::array<uint64_t, levels>                _occupied{}; // bitmap of non-empty slots per level
+
+   public:
+      explicit expiry_wheel( fc::microseconds resolution = fc::seconds(1) )
+      : _resolution( resolution.count() > 0 ? resolution : fc::microseconds(1) ) {}
+
+      expiry_wheel( const expiry_wheel& ) = delete;
+      expiry_wheel& operator=( const expiry_wheel& ) = delete;
+      expiry_wheel( expiry_wheel&& ) = default;
+      expiry_wheel& operator=( expiry_wheel&& ) = default;
+
+      size_t size()const  { return _map.size(); }
+      bool   empty()const { return _map.empty(); }
+
+      void clear() {
+         _map.clear();
+         _heads.fill( nullptr );
+         _occupied.fill( 0 );
+      }
+
+      bool contains( const Key& k )const { return _map.find( k ) != _map.end(); }
+
+      T* find( const Key& k ) {
+         auto itr = _map.find( k );
+         return itr == _map.end() ? nullptr : &itr->value;
+      }
+
+      const T* find( const Key& k )const {
+         auto itr = _map.find( k );
+         return itr == _map.end() ? nullptr : &itr->value;
+      }
+
+      /// @return expiration of k, or default constructed time_point if k is not present
+      fc::time_point expiry_of( const Key& k )const {
+         auto itr = _map.find( k );
+         return itr == _map.end() ? fc::time_point{} : itr->expiry;
+      }
+
+      /// Constructs T from args if k is not already present.
+      /// @return pointer to the value of k and true if inserted
+      template <typename... Args>
+      std::pair<T*, bool> try_emplace( const Key& k, fc::time_point expiry, Args&&... args ) {
+         auto itr = _map.find( k );
+         if( itr != _map.end() )
+            return { &itr->value, false };
+         itr = _map.emplace( k, expiry, tick_of( expiry ), std::forward<Args>(args)... ).first;
+         link( &*itr );
+         return { &itr->value, true };
+      }
+
+      /// Change the expiration of k
+      /// @return false if k is not present
+      bool set_expiry( const Key& k, fc::time_point expiry ) {
+         auto itr = _map.find( k );
+         if( itr == _map.end() )
+            return false;
+         unlink( &*itr );
+         itr->expiry = expiry;
+         itr->tick   = tick_of( expiry );
+         link( &*itr );
+         return true;
+      }
+
+      /// @return true if k was present
+      bool erase( const Key& k ) {
+         auto itr = _map.find( k );
+         if( itr == _map.end() )
+            return false;
+         unlink( &*itr );
+         _map.erase( itr );
+         return true;
+      }
+
+      /**
+       * Remove all entries with expiry <= now, calling callback(const Key&, T&) for each before it is removed.
+       * yield() is called before each removal, if it returns true expiration stops and can be resumed by a later call.
+       * Entries are expired in order of their expiration tick, entries within the same tick are in no particular order.
+       * callback must not modify the expiry_wheel.
+       * @return false if stopped by yield
+       */
+      template <typename Yield, typename Callback>
+      bool expire( const fc::time_point& now, Yield&& yield, Callback&& callback ) {
+         const uint64_t target = tick_of( now );
+         while( true ) {
+            if( !expire_slot( _current & slot_mask, now, yield, callback ) )
+               return false;
+            if( _current >= target )
+               break;
+            if( _map.empty() ) {
+               _current = target;
+               break;
+            }
+            advance( target );
+         }
+         return true;
+      }
+
+      template <typename Callback>
+      void expire( const fc::time_point& now, Callback&& callback ) {
+         expire( now, []() { return false; }, std::forward<Callback>(callback) );
+      }
+
+      /// @return number of entries removed
+      size_t expire( const fc::time_point& now ) {
+         const size_t orig = size();
+         expire( now, []( const Key&, T& ) {} );
+         return orig - size();
+      }
+
+   private:
+      uint64_t tick_of( const fc::time_point& t )const {
+         const int64_t us = t.time_since_epoch().count();
+         return us <= 0 ? 0 : static_cast<uint64_t>( us / _resolution.count() );
+      }
+
+      static constexpr uint32_t level_shift( uint32_t level ) { return level * slot_bits; }
+
+      // first tick at which entries at tick can be placed on the top level
+      static uint64_t placeable_from( uint64_t tick ) {
+         constexpr uint32_t top = level_shift( levels - 1 );
+         const uint64_t t = tick >> top;
+         return t < num_slots ? 0 : (t - (num_slots - 1)) << top;
+      }
+
+      uint32_t slot_for( uint64_t tick )const {
+         if( tick <= _current )
+            return _current & slot_mask;
+         for( uint32_t level = 0; level < levels; ++level ) {
+            const uint32_t shift = level_shift( level );
+            if( (tick >> shift) - (_current >> shift) < num_slots )
+               return level * num_slots + ((tick >> shift) & slot_mask);
+         }
+         return far_slot;
+      }
+
+      void link( const entry_type* e ) {
+         e->slot = slot_for( e->tick );
+         e->prev = nullptr;
+         e->next = _heads[e->slot];
+         if( e->next )
+            e->next->prev = e;
+         _heads[e->slot] = e;
+         if( e->slot == far_slot ) {
+            if( !e->next || e->tick < _far_min )
+               _far_min = e->tick;
+         } else {
+            _occupied[e->slot / num_slots] |= uint64_t(1) << (e->slot & slot_mask);
+         }
+      }
+
+      void unlink( const entry_type* e ) {
+         if( e->prev )
+            e->prev->next = e->next;
+         else
+            _heads[e->slot] = e->next;
+         if( e->next )
+            e->next->prev = e->prev;
+         if( !_heads[e->slot] && e->slot != far_slot )
+            _occupied[e->slot / num_slots] &= ~(uint64_t(1) << (e->slot & slot_mask));
+      }
+
+      // detach all entries of slot and link them again relative to _current
+      void relink_slot( uint32_t slot ) {
+         const entry_type* e = _heads[slot];
+         _heads[slot] = nullptr;
+         if( slot != far_slot )
+            _occupied[slot / num_slots] &= ~(uint64_t(1) << (slot & slot_mask));
+         while( e ) {
+            const entry_type* next = e->next;
+            link( e );
+            e = next;
+         }
+      }
+
+      template <typename Yield, typename Callback>
+      bool expire_slot( uint32_t slot, const fc::time_point& now, Yield& yield, Callback& callback ) {
+         const entry_type* e = _heads[slot];
+         while( e ) {
+            const entry_type* next = e->next;
+            if( e->expiry <= now ) {
+               if( yield() )
+                  return false;
+               unlink( e );
+               callback( e->key, e->value );
+               _map.erase( _map.iterator_to( *e ) );
+            }
+            e = next;
+         }
+         return true;
+      }
+
+      // move _current forward to the next tick <= target that has entries to expire or to move down a level
+      void advance( uint64_t target ) {
+         uint64_t next = target;
+         bool occupied = false;
+         for( uint32_t level = 0; level < levels; ++level ) {
+            if( !_occupied[level] )
+               continue;
+            occupied = true;
+            const uint32_t shift = level_shift( level );
+            const uint64_t pos   = (_current >> shift) & slot_mask;
+            // slots of a level are never occupied at the current position once _current is past its tick
+            const uint64_t dist  = std::countr_zero( std::rotr( _occupied[level], static_cast<int>((pos + 1) & slot_mask) ) ) + 1;
+            next = std::min( next, ((_current >> shift) + dist) << shift );
+         }
+         if( _heads[far_slot] ) {
+            // nothing can be skipped when only the overflow list has entries, jump straight to the earliest of them
+            const uint64_t far_next = occupied ? placeable_from( _far_min ) : _far_min;
+            next = std::min( next, std::max( far_next, _current + 1 ) );
+         }
+
+         _current = next;
+         // cascade from the highest level so that entries are moved all the way down
+         for( uint32_t level = levels - 1; level > 0; --level ) {
+            const uint32_t shift = level_shift( level );
+            if( (_current & ((uint64_t(1) << shift) - 1)) == 0 ) {
+               const uint32_t slot = level * num_slots + ((_current >> shift) & slot_mask);
+               if( _heads[slot] )
+                  relink_slot( slot );
+            }
+         }
+         if( _heads[far_slot] && _current >= placeable_from( _far_min ) )
+            relink_slot( far_slot ); // recalculates _far_min for entries that remain
+      }
+   };
+
+} // namespace fc
@@ -180,6 +180,19 @@ public:
 #endif
    }
 
+   // same as sync() without flushing metadata not needed to read the data back, e.g. modification time
+   void sync_data() {
+#ifdef __linux__
+      const int fd = fileno();
+      if( -1 == fdatasync( fd ) ) {
+         throw std::ios_base::failure( "cfile: " + _file_path.generic_string() +
+                                       " unable to sync file data, error: " + std::to_string( errno ) );
+      }
+#else
+      sync();
+#endif
+   }
+
    //rounds to filesystem block boundaries; e.g. punch_hole(5000, 14000) when blocksz=4096 punches from 8192 to 12288
    //end is not inclusive; eg punch_hole(4096, 8192) will punch 4096 bytes (assuming blocksz=4096)
    void punch_hole(size_t begin, size_t end) {
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <sys/types.h>
+
+namespace fc {
+
+/**
+ * io_uring_reader submits batches of positional reads to a Linux io_uring, so that many reads, of one or several
+ * files, are in flight at once instead of blocking on one page cache miss after another.
+ *
+ * A batch is handed to submit() and completes once poll() returns 0 or wait() returns. Only one batch may be in flight
+ * at a time; a batch larger than the queue depth is submitted as earlier reads complete. Reads into a buffer passed to
+ * register_buffer() use the kernel's fixed buffer reads, avoiding the per read page pinning.
+ *
+ * event_fd() becomes readable when reads complete, which allows waiting for a batch asynchronously, e.g. with a
+ * boost::asio::posix::stream_descriptor on a dup() of it, calling poll() each time it is readable.
+ *
+ * Not thread safe; each thread or session should own its reader. is_supported() is false when io_uring is not
+ * available, as on non-Linux platforms, old kernels, or when disabled by kernel.io_uring_disabled or seccomp, in which
+ * case the constructor throws.
+ */
+class io_uring_reader {
+public:
+   struct read_op {
+      int         fd     = -1;
+      uint64_t    offset = 0;
+      char*       buffer = nullptr;
+      uint32_t    size   = 0;
+      ssize_t     result = 0;   ///< bytes read, short only at end of file; -errno on failure
+   };
+
+   static constexpr unsigned default_queue_depth = 32;
+
+   explicit io_uring_reader(unsigned queue_depth = default_queue_depth);
+   ~io_uring_reader();
+
+   io_uring_reader(const io_uring_reader&) = delete;
+   io_uring_reader& operator=(const io_uring_reader&) = delete;
+
+   static bool is_supported();
+
+   /// registers buffer for fixed buffer reads, replacing any previously registered buffer
+   /// @return false if the kernel refused, e.g. over RLIMIT_MEMLOCK; reads into buffer then work as any other
+   bool register_buffer(std::span<char> buffer);
+
+   /// submits the reads of ops, which must remain valid until the batch completes
+   void submit(std::span<read_op> ops);
+
+   /// reaps completed reads without blocking
+   /// @return number of reads of the batch not yet completed
+   size_t poll();
+
+   /// blocks until all reads of the batch are completed
+   void wait();
+
+   int event_fd() const;
+
+private:
+   struct impl;
+   std::unique_ptr<impl> my;
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <fc/filesystem.hpp>
 #include <fc/io/datastream.hpp>
+#include <fc/io/io_uring_reader.hpp>
 #include <fc/io/raw.hpp>
 
 #include <boost/beast.hpp>
@@ -44,6 +45,10 @@ There is a another important interaction between random_access_file and the read
    thefile.reset();
    fc::raw::pack(ds, (uint32_t)0xbeef);
 
+read_batch() reads several spans of the file at once, through an io_uring_reader when one is given and with one preadv after
+ another otherwise; read_ahead() hints that a span will be read soon. Both may be called from multiple threads simultaneously,
+ though an io_uring_reader must only be used by a single thread at a time. The same is available on devices.
+
 size(), resize(), and punch_hole() may be called from multiple threads simultaneously. Other threads performing reads or writes on affected
  ranges will give undefined results.
 
@@ -176,6 +181,16 @@ struct random_access_file_context {
          wlog("Failed to punch hole in file ${fn}: ${e}", ("fn", display_path)("e", strerror(errno)));
    }
 
+   void read_ahead(size_t offset, size_t size) {
+      //only a hint, errors are ignored
+#if defined(__APPLE__)
+      struct radvisory advice = {static_cast<off_t>(offset), static_cast<int>(std::min<size_t>(size, std::numeric_limits<int>::max()))};
+      fcntl(fd, F_RDADVISE, &advice);
+#else
+      posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#endif
+   }
+
    native_handle_type native_handle() const {
       return fd;
    }
@@ -252,6 +267,8 @@ struct random_access_file_context {
             wlog("Failed to punch hole on file ${fn}", ("fn", display_path));
    }
 
+   void read_ahead(size_t offset, size_t size) {}
+
    native_handle_type native_handle() {
       return file.native_handle();
    }
@@ -265,6 +282,27 @@ struct random_access_file_context {
 #endif
 
 using random_access_file_context_ptr = std::shared_ptr<impl::random_access_file_context>;
+
+inline void read_batch(random_access_file_context& ctx, std::span<io_uring_reader::read_op> ops, io_uring_reader* reader) {
+   if(reader) {
+      for(io_uring_reader::read_op& op : ops)
+         op.fd = ctx.native_handle();
+      reader->submit(ops);
+      reader->wait();
+   }
+   //without a reader, and to complete any short reads, read with preadv until the op is full or the end of file
+   for(io_uring_reader::read_op& op : ops) {
+      if(!reader)
+         op.result = 0;
+      FC_ASSERT(op.result >= 0, "read failure on file ${fn}: ${e}", ("fn", ctx.display_path)("e", strerror(-op.result)));
+      while(op.result < (ssize_t)op.size) {
+         ssize_t red = ctx.read_from(boost::asio::buffer(op.buffer + op.result, op.size - op.result), op.offset + op.result);
+         if(red == 0)
+            break;
+         op.result += red;
+      }
+   }
+}
 }
 
 class random_access_file {
@@ -409,6 +447,18 @@ public:
          return n;
       }
 
+      void read_batch(std::span<io_uring_reader::read_op> ops, io_uring_reader* reader = nullptr) {
+         impl::read_batch(*ctx, ops, reader);
+      }
+
+      void read_ahead(size_t offset, size_t size) {
+         ctx->read_ahead(offset, size);
+      }
+
+      impl::random_access_file_context::native_handle_type native_handle() const {
+         return ctx->native_handle();
+      }
+
       std::streampos seek(boost::iostreams::stream_offset off, std::ios_base::seekdir way) {
          if(way == std::ios_base::beg)
             pos = off;
@@ -470,6 +520,17 @@ public:
       return device(ctx);
    }
 
+   /// Reads each op, its fd set to this file, fully unless the end of file is reached; op.result is the bytes read.
+   /// With a reader all ops are submitted to it at once, otherwise they are read one after another.
+   void read_batch(std::span<io_uring_reader::read_op> ops, io_uring_reader* reader = nullptr) {
+      impl::read_batch(*ctx, ops, reader);
+   }
+
+   /// hints that [offset, offset+size) will be read soon so that the kernel starts reading it into the page cache
+   void read_ahead(size_t offset, size_t size) {
+      ctx->read_ahead(offset, size);
+   }
+
    size_t size() const {
       return ctx->size();
    }
@@ -31,5 +31,7 @@ namespace fc {
          virtual ~appender() = default;
          virtual void initialize() = 0;
          virtual void log( const log_message& m ) = 0;
+         /// false if messages must be written on the logging thread, see async_logging_config
+         virtual bool is_async_capable()const { return true; }
    };
 }
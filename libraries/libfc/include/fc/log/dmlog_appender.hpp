@@ -23,6 +23,8 @@ namespace fc {
             virtual void initialize() override;
 
             virtual void log( const log_message& m ) override;
+            /// deep mind output is consumed in lockstep with chain processing, never queue it
+            bool is_async_capable()const override { return false; }
 
        private:
             dmlog_appender();
@@ -9,6 +9,7 @@ namespace fc
 {
 
    class appender;
+   namespace detail { class async_log_dispatcher; }
 
    /**
     *
@@ -50,7 +51,10 @@ namespace fc
 
       private:
          friend struct log_config;
+         friend class detail::async_log_dispatcher;
          void add_appender( const std::shared_ptr<appender>& a );
+         /// run the appenders on the calling thread
+         void write( log_message m );
 
       private:
          class impl;
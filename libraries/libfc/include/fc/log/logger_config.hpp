@@ -36,11 +36,28 @@ namespace fc {
       std::vector<std::string>         appenders;
    };
 
+   /**
+    * When enabled, logging threads only capture the log_message into a per-thread ring and a single background
+    * thread formats and writes it with the configured appenders. Loggers with appenders that are not async
+    * capable, e.g. dmlog, are always written synchronously.
+    */
+   struct async_logging_config {
+      struct overflow_policy { enum type { block, drop }; };
+
+      bool                          enabled    = false;
+      /// number of messages each logging thread can queue before overflow applies, allocated on the thread's first
+      /// log call. A change takes effect on each thread's next log call.
+      uint32_t                      queue_size = 1024;
+      /// block: wait for the background thread to make room, drop: discard the message and count it
+      overflow_policy::type         overflow   = overflow_policy::block;
+   };
+
    struct logging_config {
       static logging_config default_config();
       std::vector<std::string>     includes;
       std::vector<appender_config> appenders;
       std::vector<logger_config>   loggers;
+      async_logging_config         async;
    };
 
    struct log_config {
@@ -59,6 +76,12 @@ namespace fc {
 
       static bool configure_logging( const logging_config& l );
 
+      /// Blocks until all messages queued by async logging have been written. No-op when async logging is disabled.
+      static void flush();
+      static bool async_enabled();
+      /// number of messages discarded by async logging with overflow_policy::drop
+      static uint64_t async_dropped_messages();
+
    private:
       static log_config& get();
 
@@ -80,4 +103,6 @@ namespace fc {
 #include <fc/reflect/reflect.hpp>
 FC_REFLECT( fc::appender_config, (name)(type)(args)(enabled) )
 FC_REFLECT( fc::logger_config, (name)(parent)(level)(enabled)(additivity)(appenders) )
-FC_REFLECT( fc::logging_config, (includes)(appenders)(loggers) )
+FC_REFLECT_ENUM( fc::async_logging_config::overflow_policy::type, (block)(drop) )
+FC_REFLECT( fc::async_logging_config, (enabled)(queue_size)(overflow) )
+FC_REFLECT( fc::logging_config, (includes)(appenders)(loggers)(async) )
@@ -0,0 +1,285 @@
+#include <fc/io/io_uring_reader.hpp>
+#include <fc/exception/exception.hpp>
+#include <fc/scoped_exit.hpp>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+#endif
+
+namespace fc {
+
+#ifdef __linux__
+
+namespace {
+
+int sys_io_uring_setup(unsigned entries, io_uring_params* p) {
+   return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+   return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+int sys_io_uring_register(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+   return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+}
+
+struct io_uring_reader::impl {
+   explicit impl(unsigned queue_depth) {
+      io_uring_params p;
+      memset(&p, 0, sizeof(p));
+      ring_fd = sys_io_uring_setup(queue_depth, &p);
+      FC_ASSERT(ring_fd >= 0, "io_uring setup failure: ${e}", ("e", strerror(errno)));
+      auto close_on_error = fc::make_scoped_exit([this]() { unmap_and_close(); });
+
+      sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+      cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+      const bool single_mmap = p.features & IORING_FEAT_SINGLE_MMAP;
+      if(single_mmap)
+         sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+      sq_ring = map(sq_ring_size, IORING_OFF_SQ_RING);
+      cq_ring = single_mmap ? sq_ring : map(cq_ring_size, IORING_OFF_CQ_RING);
+      sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+      sqes = (io_uring_sqe*)map(sqes_size, IORING_OFF_SQES);
+
+      sq_tail  = (unsigned*)(sq_ring + p.sq_off.tail);
+      sq_head  = (unsigned*)(sq_ring + p.sq_off.head);
+      sq_mask  = *(unsigned*)(sq_ring + p.sq_off.ring_mask);
+      sq_array = (unsigned*)(sq_ring + p.sq_off.array);
+      cq_head  = (unsigned*)(cq_ring + p.cq_off.head);
+      cq_tail  = (unsigned*)(cq_ring + p.cq_off.tail);
+      cq_mask  = *(unsigned*)(cq_ring + p.cq_off.ring_mask);
+      cqes     = (io_uring_cqe*)(cq_ring + p.cq_off.cqes);
+      // completion queue is at least as large as the submission queue, never more reads in flight than it can hold
+      depth    = p.sq_entries;
+
+      event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      FC_ASSERT(event_fd >= 0, "io_uring eventfd failure: ${e}", ("e", strerror(errno)));
+      FC_ASSERT(sys_io_uring_register(ring_fd, IORING_REGISTER_EVENTFD, &event_fd, 1) == 0,
+                "io_uring eventfd registration failure: ${e}", ("e", strerror(errno)));
+
+      close_on_error.cancel();
+   }
+
+   ~impl() {
+      // the kernel may still be reading into the buffers of an abandoned batch, let those reads complete first
+      next = ops.size();
+      try {
+         while(in_flight && reap())
+            enter(0, 1);
+      } catch(...) {}
+      unmap_and_close();
+   }
+
+   char* map(size_t size, off_t offset) {
+      void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+      FC_ASSERT(ptr != MAP_FAILED, "io_uring mmap failure: ${e}", ("e", strerror(errno)));
+      return (char*)ptr;
+   }
+
+   void unmap_and_close() {
+      if(sqes)
+         munmap(sqes, sqes_size);
+      if(cq_ring && cq_ring != sq_ring)
+         munmap(cq_ring, cq_ring_size);
+      if(sq_ring)
+         munmap(sq_ring, sq_ring_size);
+      if(event_fd >= 0)
+         close(event_fd);
+      if(ring_fd >= 0)
+         close(ring_fd);
+   }
+
+   bool is_registered(const io_uring_reader::read_op& op) const {
+      return registered.size() && op.buffer >= registered.data() && op.buffer + op.size <= registered.data() + registered.size();
+   }
+
+   // queues reads of the batch while there is room, @return number queued
+   unsigned queue() {
+      unsigned queued = 0;
+      unsigned tail = *sq_tail;
+      while(next < ops.size() && in_flight < depth) {
+         const unsigned index = tail & sq_mask;
+         io_uring_sqe* sqe = &sqes[index];
+         memset(sqe, 0, sizeof(*sqe));
+
+         io_uring_reader::read_op& op = ops[next];
+         sqe->fd = op.fd;
+         sqe->off = op.offset;
+         if(is_registered(op)) {
+            sqe->opcode = IORING_OP_READ_FIXED;
+            sqe->addr = (uintptr_t)op.buffer;
+            sqe->len = op.size;
+            sqe->buf_index = 0;
+         } else {
+            iovecs[next] = iovec{op.buffer, op.size};
+            sqe->opcode = IORING_OP_READV;
+            sqe->addr = (uintptr_t)&iovecs[next];
+            sqe->len = 1;
+         }
+         sqe->user_data = next;
+         sq_array[index] = index;
+
+         ++tail;
+         ++next;
+         ++in_flight;
+         ++queued;
+      }
+      std::atomic_ref<unsigned>(*sq_tail).store(tail, std::memory_order_release);
+      return queued;
+   }
+
+   void enter(unsigned to_submit, unsigned min_complete) {
+      while(to_submit || min_complete) {
+         int ret = sys_io_uring_enter(ring_fd, to_submit, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0);
+         if(ret < 0) {
+            if(errno == EINTR || errno == EAGAIN || errno == EBUSY)
+               continue;
+            FC_THROW("io_uring enter failure: ${e}", ("e", strerror(errno)));
+         }
+         to_submit -= std::min<unsigned>(ret, to_submit);
+         min_complete = 0; // completions are reaped by the caller, enter returns once min_complete is reached
+      }
+   }
+
+   size_t reap() {
+      uint64_t ignore;
+      [[maybe_unused]] ssize_t r = read(event_fd, &ignore, sizeof(ignore));
+
+      unsigned head = *cq_head;
+      while(head != std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire)) {
+         const io_uring_cqe& cqe = cqes[head & cq_mask];
+         ops[cqe.user_data].result = cqe.res;
+         --in_flight;
+         ++head;
+      }
+      std::atomic_ref<unsigned>(*cq_head).store(head, std::memory_order_release);
+
+      if(unsigned queued = queue())
+         enter(queued, 0);
+      return in_flight + (ops.size() - next);
+   }
+
+   int                               ring_fd  = -1;
+   int                               event_fd = -1;
+   char*                             sq_ring  = nullptr;
+   char*                             cq_ring  = nullptr;
+   io_uring_sqe*                     sqes     = nullptr;
+   size_t                            sq_ring_size = 0;
+   size_t                            cq_ring_size = 0;
+   size_t                            sqes_size    = 0;
+   unsigned*                         sq_tail  = nullptr;
+   unsigned*                         sq_head  = nullptr;
+   unsigned*                         sq_array = nullptr;
+   unsigned                          sq_mask  = 0;
+   unsigned*                         cq_head  = nullptr;
+   unsigned*                         cq_tail  = nullptr;
+   unsigned                          cq_mask  = 0;
+   io_uring_cqe*                     cqes     = nullptr;
+   unsigned                          depth    = 0;
+
+   std::span<char>                   registered;
+   std::span<io_uring_reader::read_op> ops;       ///< current batch
+   std::vector<iovec>                iovecs;      ///< of the current batch, for the reads not into the registered buffer
+   size_t                            next      = 0;   ///< next read of the batch to queue
+   unsigned                          in_flight = 0;
+};
+
+io_uring_reader::io_uring_reader(unsigned queue_depth) : my(new impl(queue_depth)) {}
+
+io_uring_reader::~io_uring_reader() = default;
+
+bool io_uring_reader::is_supported() {
+   static const bool supported = []() {
+      io_uring_params p;
+      memset(&p, 0, sizeof(p));
+      int fd = sys_io_uring_setup(1, &p);
+      if(fd < 0)
+         return false;
+      close(fd);
+      return true;
+   }();
+   return supported;
+}
+
+bool io_uring_reader::register_buffer(std::span<char> buffer) {
+   FC_ASSERT(my->next == my->ops.size() && !my->in_flight, "io_uring buffer registration while reads are in flight");
+   if(my->registered.size()) {
+      sys_io_uring_register(my->ring_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+      my->registered = {};
+   }
+   const iovec iov{buffer.data(), buffer.size()};
+   if(sys_io_uring_register(my->ring_fd, IORING_REGISTER_BUFFERS, &iov, 1) != 0)
+      return false;
+   my->registered = buffer;
+   return true;
+}
+
+void io_uring_reader::submit(std::span<read_op> ops) {
+   FC_ASSERT(my->next == my->ops.size() && !my->in_flight, "io_uring batch submitted while another is in flight");
+   my->ops = ops;
+   my->iovecs.resize(ops.size());
+   my->next = 0;
+   for(read_op& op : ops)
+      op.result = 0;
+   my->enter(my->queue(), 0);
+}
+
+size_t io_uring_reader::poll() {
+   return my->reap();
+}
+
+void io_uring_reader::wait() {
+   while(my->reap())
+      my->enter(0, 1);
+}
+
+int io_uring_reader::event_fd() const {
+   return my->event_fd;
+}
+
+#else
+
+struct io_uring_reader::impl {};
+
+io_uring_reader::io_uring_reader(unsigned) {
+   FC_THROW("io_uring is not supported on this platform");
+}
+
+io_uring_reader::~io_uring_reader() = default;
+
+bool io_uring_reader::is_supported() {
+   return false;
+}
+
+bool io_uring_reader::register_buffer(std::span<char>) {
+   return false;
+}
+
+void io_uring_reader::submit(std::span<read_op>) {}
+
+size_t io_uring_reader::poll() {
+   return 0;
+}
+
+void io_uring_reader::wait() {}
+
+int io_uring_reader::event_fd() const {
+   return -1;
+}
+
+#endif
+
+}
@@ -8,8 +8,14 @@
 #include <fstream>
 #include <sstream>
 
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <bit>
+#include <charconv>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace fc
 {
@@ -33,6 +39,146 @@ namespace fc
 
 namespace fc
 {
+   namespace {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define FC_JSON_SIMD
+#if defined(__SSE2__)
+      using bytes16 = __m128i;
+      inline bytes16 load16( const char* p ) { return _mm_loadu_si128( (const __m128i*)p ); }
+      inline bytes16 eq( bytes16 v, char c ) { return _mm_cmpeq_epi8( v, _mm_set1_epi8( c ) ); }
+      inline bytes16 either( bytes16 a, bytes16 b ) { return _mm_or_si128( a, b ); }
+      inline bytes16 is_digit( bytes16 v ) {
+         const __m128i d = _mm_sub_epi8( v, _mm_set1_epi8( '0' ) );
+         return _mm_cmpeq_epi8( _mm_min_epu8( d, _mm_set1_epi8( 9 ) ), d );
+      }
+      /// @return index of the first lane of m that is set, or clear when first_clear, 16 if none
+      inline unsigned first_lane( bytes16 m, bool first_clear ) {
+         unsigned bits = _mm_movemask_epi8( m );
+         if( first_clear )
+            bits = ~bits & 0xffff;
+         return bits ? std::countr_zero( bits ) : 16;
+      }
+#else
+      using bytes16 = uint8x16_t;
+      inline bytes16 load16( const char* p ) { return vld1q_u8( (const uint8_t*)p ); }
+      inline bytes16 eq( bytes16 v, char c ) { return vceqq_u8( v, vdupq_n_u8( c ) ); }
+      inline bytes16 either( bytes16 a, bytes16 b ) { return vorrq_u8( a, b ); }
+      inline bytes16 is_digit( bytes16 v ) { return vcleq_u8( vsubq_u8( v, vdupq_n_u8( '0' ) ), vdupq_n_u8( 9 ) ); }
+      inline unsigned first_lane( bytes16 m, bool first_clear ) {
+         if( first_clear )
+            m = vmvnq_u8( m );
+         // narrow each lane to 4 bits of a 64 bit mask
+         const uint64_t bits = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( m ), 4 ) ), 0 );
+         return bits ? std::countr_zero( bits ) / 4 : 16;
+      }
+#endif
+#endif
+
+      /// @return first of [p, end) that is '"', '\\' or ^D, the characters that end a run of plain string characters
+      const char* find_string_special( const char* p, const char* end ) {
+#ifdef FC_JSON_SIMD
+         for( ; end - p >= 16; p += 16 ) {
+            const bytes16 v = load16( p );
+            if( unsigned i = first_lane( either( either( eq( v, '"' ), eq( v, '\\' ) ), eq( v, 0x04 ) ), false ); i < 16 )
+               return p + i;
+         }
+#endif
+         while( p != end && *p != '"' && *p != '\\' && *p != 0x04 )
+            ++p;
+         return p;
+      }
+
+      /// @return first of [p, end) that is not JSON whitespace
+      const char* skip_white_space_chars( const char* p, const char* end ) {
+#ifdef FC_JSON_SIMD
+         // runs of whitespace are mostly short, only worth scanning a block at a time for indentation
+         if( end - p >= 16 && p[0] == ' ' && p[1] == ' ' ) {
+            for( ; end - p >= 16; p += 16 ) {
+               const bytes16 v = load16( p );
+               if( unsigned i = first_lane( either( either( eq( v, ' ' ), eq( v, '\t' ) ), either( eq( v, '\n' ), eq( v, '\r' ) ) ), true ); i < 16 )
+                  return p + i;
+            }
+         }
+#endif
+         while( p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') )
+            ++p;
+         return p;
+      }
+
+      /// @return first of [p, end) that is not a decimal digit
+      const char* skip_digits( const char* p, const char* end ) {
+#ifdef FC_JSON_SIMD
+         for( ; end - p >= 16; p += 16 ) {
+            if( unsigned i = first_lane( is_digit( load16( p ) ), true ); i < 16 )
+               return p + i;
+         }
+#endif
+         while( p != end && *p >= '0' && *p <= '9' )
+            ++p;
+         return p;
+      }
+   }
+
+   /**
+    *  In memory stream over the text parsed by json::from_string(). peek(), get() and eof() behave as those of the
+    *  std::istream it replaces, including at the end of the text, so the parsers give the same results and errors, but
+    *  are inlined rather than going through a streambuf. The runs of plain string characters, whitespace and digits
+    *  that make up most of the text are scanned 16 bytes at a time by the *_run() overloads for it.
+    */
+   class json_buffer_stream
+   {
+      public:
+         json_buffer_stream( const char* begin, const char* end ) : pos( begin ), end( end ) {}
+
+         int peek() {
+            if( pos == end ) {
+               at_eof = true;
+               return EOF;
+            }
+            return (unsigned char)*pos;
+         }
+
+         int get() {
+            if( pos == end ) {
+               at_eof = true;
+               return EOF;
+            }
+            return (unsigned char)*pos++;
+         }
+
+         bool eof() const { return at_eof; }
+
+         const char* pos;
+         const char* end;
+         bool        at_eof = false;
+   };
+
+   // appends the run of plain characters at the start of a string's remaining text, if T allows reading it in bulk
+   template<typename T> void append_string_run( T& in, std::string& token ) {}
+   // skips the run of whitespace, @return true if there was any, if T allows reading it in bulk
+   template<typename T> bool skip_white_space_run( T& in ) { return false; }
+   // appends the run of digits, if T allows reading it in bulk
+   template<typename T> void append_digit_run( T& in, std::string& s ) {}
+
+   void append_string_run( json_buffer_stream& in, std::string& token ) {
+      const char* run_end = find_string_special( in.pos, in.end );
+      token.append( in.pos, run_end );
+      in.pos = run_end;
+   }
+
+   bool skip_white_space_run( json_buffer_stream& in ) {
+      const char* run_end = skip_white_space_chars( in.pos, in.end );
+      const bool skipped = run_end != in.pos;
+      in.pos = run_end;
+      return skipped;
+   }
+
+   void append_digit_run( json_buffer_stream& in, std::string& s ) {
+      const char* run_end = skip_digits( in.pos, in.end );
+      s.append( in.pos, run_end );
+      in.pos = run_end;
+   }
+
    template<typename T>
    char parseEscape( T& in )
    {
@@ -65,7 +211,7 @@ namespace fc
    template<typename T>
    bool skip_white_space( T& in )
    {
-       bool skipped = false;
+       bool skipped = skip_white_space_run( in );
        while( true )
        {
           switch( in.peek() )
@@ -101,6 +247,7 @@ namespace fc
          in.get();
          while( !in.eof() )
          {
+            append_string_run( in, token );
             switch( c = in.peek() )
             {
                case '\\':
@@ -268,6 +415,7 @@ namespace fc
       {
         while( !done )
         {
+          append_digit_run( in, s );
           char c = in.peek();
           switch( c )
           {
@@ -311,8 +459,16 @@ namespace fc
         FC_THROW_EXCEPTION(parse_error_exception, "Can't parse token \"${token}\" as a JSON numeric constant", ("token", str));
       if( dot )
         return parser_type == json::parse_type::legacy_parser_with_string_doubles ? variant(str) : variant(to_double(str));
-      if( neg )
+      // from_chars accepts the same digits as to_int64()/to_uint64(), which report anything it does not, such as overflow
+      if( neg ) {
+        int64_t i;
+        if( auto r = std::from_chars( str.data(), str.data() + str.size(), i ); r.ec == std::errc() && r.ptr == str.data() + str.size() )
+          return i;
         return to_int64(str);
+      }
+      uint64_t u;
+      if( auto r = std::from_chars( str.data(), str.data() + str.size(), u ); r.ec == std::errc() && r.ptr == str.data() + str.size() )
+        return u;
       return to_uint64(str);
    }
 
@@ -443,8 +599,8 @@ namespace fc
 
    variant json::from_string( const std::string& utf8_str, const json::parse_type ptype, const uint32_t max_depth )
    { try {
-      using stream_t = boost::iostreams::stream<boost::iostreams::array_source>;
-      stream_t in(utf8_str.c_str(), utf8_str.size());
+      using stream_t = json_buffer_stream;
+      stream_t in(utf8_str.data(), utf8_str.data() + utf8_str.size());
       switch( ptype )
       {
           case parse_type::legacy_parser:
@@ -0,0 +1,188 @@
+#include "async_log_dispatcher.hpp"
+#include <fc/log/log_message.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+
+namespace fc::detail {
+
+   namespace {
+      thread_local bool tl_is_consumer = false;
+      std::terminate_handler prev_terminate_handler = nullptr;
+
+      void flush_on_terminate() {
+         try {
+            async_log_dispatcher::get().flush();
+         } catch( ... ) {}
+         if( prev_terminate_handler )
+            prev_terminate_handler();
+         std::abort();
+      }
+   }
+
+   async_log_dispatcher& async_log_dispatcher::get() {
+      // allocate dynamically which will leak on exit but allow loggers to be used until the very end of execution
+      static async_log_dispatcher* the = new async_log_dispatcher;
+      return *the;
+   }
+
+   void async_log_dispatcher::configure( const async_logging_config& cfg ) {
+      std::lock_guard g( _config_mtx );
+      _queue_size = std::max<uint32_t>( cfg.queue_size, 2 );
+      _overflow   = cfg.overflow;
+
+      if( cfg.enabled && !_thread.joinable() ) {
+         _stopping = false;
+         _thread   = std::thread( [this]() { run(); } );
+         _enabled  = true;
+
+         // write out everything queued on normal exit and on std::terminate
+         static bool registered = []() {
+            std::atexit( []() {
+               auto& d = async_log_dispatcher::get();
+               std::lock_guard g( d._config_mtx );
+               if( d._thread.joinable() )
+                  d.stop();
+            } );
+            prev_terminate_handler = std::set_terminate( flush_on_terminate );
+            return true;
+         }();
+         (void)registered;
+      } else if( !cfg.enabled && _thread.joinable() ) {
+         stop();
+      }
+   }
+
+   // called with _config_mtx held
+   void async_log_dispatcher::stop() {
+      _enabled  = false;
+      _stopping = true;
+      _cv.notify_one();
+      _thread.join();
+      // pick up anything that raced with disabling
+      std::vector<entry> batch;
+      drain( batch );
+   }
+
+   async_log_dispatcher::ring& async_log_dispatcher::thread_ring() {
+      static thread_local std::shared_ptr<ring> tl_ring;
+      const size_t capacity = _queue_size.load( std::memory_order_relaxed );
+      if( tl_ring && tl_ring->capacity != capacity ) {
+         // queue_size was reconfigured, replace the ring once everything this thread queued has been written so
+         // its messages stay in order. The old ring is released by drain() once empty.
+         while( tl_ring->queue.write_available() < tl_ring->capacity && !_stopping.load() ) {
+            wake();
+            std::this_thread::yield();
+         }
+         tl_ring.reset();
+      }
+      if( !tl_ring ) {
+         tl_ring = std::make_shared<ring>( capacity );
+         std::lock_guard g( _rings_mtx );
+         _rings.push_back( tl_ring );
+      }
+      return *tl_ring;
+   }
+
+   void async_log_dispatcher::wake() {
+      if( _consumer_waiting.load( std::memory_order_relaxed ) )
+         _cv.notify_one();
+   }
+
+   bool async_log_dispatcher::push( const logger& lgr, log_message& m ) {
+      // appenders logging from the background thread are written directly
+      if( !enabled() || tl_is_consumer )
+         return false;
+
+      ring& r = thread_ring();
+      entry e{ lgr, std::move( m ), _seq.fetch_add( 1, std::memory_order_relaxed ) };
+      if( !r.queue.push( e ) ) {
+         if( _overflow.load( std::memory_order_relaxed ) == async_logging_config::overflow_policy::drop ) {
+            _dropped.fetch_add( 1, std::memory_order_relaxed );
+            return true;
+         }
+         do {
+            if( _stopping.load() ) {
+               // no consumer to make room, caller logs synchronously
+               _processed.fetch_add( 1, std::memory_order_release );
+               m = std::move( e.msg );
+               return false;
+            }
+            wake();
+            std::this_thread::yield();
+         } while( !r.queue.push( e ) );
+      }
+      wake();
+      return true;
+   }
+
+   void async_log_dispatcher::flush() {
+      if( tl_is_consumer )
+         return;
+      const uint64_t target = _seq.load();
+      while( _processed.load( std::memory_order_acquire ) + _dropped.load( std::memory_order_relaxed ) < target ) {
+         if( !enabled() )
+            break; // stopping drains everything
+         _cv.notify_one();
+         std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+      }
+   }
+
+   size_t async_log_dispatcher::drain( std::vector<entry>& batch ) {
+      batch.clear();
+      {
+         std::lock_guard g( _rings_mtx );
+         for( auto itr = _rings.begin(); itr != _rings.end(); ) {
+            (*itr)->queue.consume_all( [&batch]( entry& e ) { batch.push_back( std::move( e ) ); } );
+            // owning thread has exited and everything it logged has been consumed
+            if( itr->use_count() == 1 && (*itr)->queue.read_available() == 0 ) {
+               itr = _rings.erase( itr );
+            } else {
+               ++itr;
+            }
+         }
+      }
+      const size_t n = batch.size();
+      if( n == 0 )
+         return 0;
+
+      // rings are per thread, restore the order in which messages were logged across threads
+      std::sort( batch.begin(), batch.end(), []( const entry& a, const entry& b ) { return a.seq < b.seq; } );
+      for( auto& e : batch )
+         e.lgr.write( std::move( e.msg ) );
+      batch.clear();
+      _processed.fetch_add( n, std::memory_order_release );
+      return n;
+   }
+
+   void async_log_dispatcher::run() {
+      set_thread_name( "log" );
+      tl_is_consumer = true;
+
+      std::vector<entry> batch;
+      while( true ) {
+         size_t n = drain( batch );
+
+         uint64_t dropped = _dropped.load( std::memory_order_relaxed );
+         if( dropped != _dropped_reported ) {
+            logger::get( DEFAULT_LOGGER ).write(
+               FC_LOG_MESSAGE( warn, "async logging dropped ${n} messages, ${t} total",
+                               ("n", dropped - _dropped_reported)("t", dropped) ) );
+            _dropped_reported = dropped;
+         }
+
+         if( n == 0 ) {
+            if( _stopping.load() )
+               break;
+            // producers only notify when waiting, a missed notification is bounded by the timeout
+            std::unique_lock g( _cv_mtx );
+            _consumer_waiting = true;
+            _cv.wait_for( g, std::chrono::milliseconds( 10 ) );
+            _consumer_waiting = false;
+         }
+      }
+   }
+
+} // namespace fc::detail
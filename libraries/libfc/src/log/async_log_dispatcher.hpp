@@ -0,0 +1,86 @@
+#pragma once
+#include <fc/log/logger.hpp>
+#include <fc/log/logger_config.hpp>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fc::detail {
+
+   /**
+    * Backend of async logging, see async_logging_config.
+    *
+    * Callers capture the log_message into a ring owned by the calling thread, a single background thread
+    * drains all rings in capture order and runs the appenders. Formatting and I/O are therefore done off the
+    * calling thread and callers never take log_config::log_mutex.
+    *
+    * Created on first use and never destroyed so that logging is available until the very end of execution,
+    * the same as log_config.
+    */
+   class async_log_dispatcher {
+   public:
+      static async_log_dispatcher& get();
+
+      /// start or stop the background thread according to cfg, stopping flushes all queued messages
+      void configure( const async_logging_config& cfg );
+
+      bool enabled()const { return _enabled.load( std::memory_order_relaxed ); }
+
+      /// Thread safe. Queues m for lgr, moving from m only if queued.
+      /// @return false if the message was not queued and should be logged synchronously by the caller
+      bool push( const logger& lgr, log_message& m );
+
+      /// Thread safe. Blocks until all messages queued before the call have been written or dropped.
+      void flush();
+
+      /// total number of messages dropped because of a full ring with overflow_policy::drop
+      uint64_t dropped()const { return _dropped.load( std::memory_order_relaxed ); }
+
+   private:
+      struct entry {
+         logger      lgr;
+         log_message msg;
+         uint64_t    seq = 0;
+      };
+      struct ring {
+         explicit ring( size_t capacity ) : capacity( capacity ), queue( capacity ) {}
+         const size_t                       capacity;
+         boost::lockfree::spsc_queue<entry> queue; // single producer is the owning thread, single consumer is _thread
+      };
+
+      async_log_dispatcher() = default;
+
+      ring& thread_ring();
+      void  wake();
+      void  run();
+      size_t drain( std::vector<entry>& batch );
+      void  stop();
+
+      std::atomic<bool>                   _enabled{false};
+      std::atomic<bool>                   _stopping{false};
+      std::atomic<bool>                   _consumer_waiting{false};
+      std::atomic<uint32_t>               _queue_size{0};
+      std::atomic<async_logging_config::overflow_policy::type> _overflow{async_logging_config::overflow_policy::block};
+
+      alignas(64) std::atomic<uint64_t>   _seq{0};       // number of messages accepted, queued or dropped
+      // number of messages written, by _thread, by stop() after _thread has exited, or synchronously by push() while stopping
+      alignas(64) std::atomic<uint64_t>   _processed{0};
+      alignas(64) std::atomic<uint64_t>   _dropped{0};
+      uint64_t                            _dropped_reported{0}; // only accessed by _thread
+
+      std::mutex                          _rings_mtx;
+      std::vector<std::shared_ptr<ring>>  _rings; // guarded by _rings_mtx
+
+      std::mutex                          _cv_mtx;
+      std::condition_variable             _cv;
+      std::mutex                          _config_mtx; // serializes configure/stop
+      std::thread                         _thread;
+   };
+
+} // namespace fc::detail
@@ -1,5 +1,6 @@
 #include <fc/log/console_appender.hpp>
 #include <fc/log/log_message.hpp>
+#include <fc/log/logger_config.hpp>
 #include <fc/string.hpp>
 #include <fc/variant.hpp>
 #include <fc/reflect/variant.hpp>
@@ -122,8 +123,9 @@ namespace fc {
          }
       }
       line += fixed_size(  5, context.get_log_level().to_string() ); line += ' ';
-      // use now() instead of context.get_timestamp() because log_message construction can include user provided long running calls
-      line += time_point::now().to_iso_string(); line += ' ';
+      // use now() instead of context.get_timestamp() because log_message construction can include user provided long running calls,
+      // unless written from the async logging thread where now() is the time of writing rather than logging
+      line += (log_config::async_enabled() ? context.get_timestamp() : time_point::now()).to_iso_string(); line += ' ';
       line += fixed_size(  9, context.get_thread_name() ); line += ' ';
       line += fixed_size( 29, file_line ); line += ' ';
 
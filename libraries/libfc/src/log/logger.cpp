@@ -4,6 +4,7 @@
 #include <fc/exception/exception.hpp>
 #include <fc/filesystem.hpp>
 #include <fc/log/logger_config.hpp>
+#include "async_log_dispatcher.hpp"
 #include <unordered_map>
 
 namespace fc {
@@ -11,11 +12,12 @@ namespace fc {
     class logger::impl {
       public:
          impl()
-         :_parent(nullptr),_enabled(true),_additivity(false),_level(log_level::warn){}
+         :_parent(nullptr),_enabled(true),_additivity(false),_async_capable(true),_level(log_level::warn){}
          std::string      _name;
          logger           _parent;
          bool             _enabled;
          bool             _additivity;
+         bool             _async_capable; // all appenders can be run from the async logging thread
          log_level        _level;
 
          std::vector<appender::ptr> _appenders;
@@ -59,6 +61,12 @@ namespace fc {
     }
 
     void logger::log( log_message m ) {
+       if( my->_async_capable && detail::async_log_dispatcher::get().push( *this, m ) )
+          return;
+       write( std::move( m ) );
+    }
+
+    void logger::write( log_message m ) {
        std::unique_lock g( log_config::get().log_mutex );
        m.get_context().append_context( my->_name );
 
@@ -100,6 +108,7 @@ namespace fc {
 
     void logger::add_appender( const std::shared_ptr<appender>& a ) {
        my->_appenders.push_back(a);
+       my->_async_capable = my->_async_capable && a->is_async_capable();
     }
 
    bool configure_logging( const logging_config& cfg );
@@ -7,6 +7,7 @@
 #include <fc/log/console_appender.hpp>
 #include <fc/log/gelf_appender.hpp>
 #include <fc/log/dmlog_appender.hpp>
+#include "async_log_dispatcher.hpp"
 #include <fc/reflect/variant.hpp>
 #include <fc/exception/exception.hpp>
 
@@ -65,6 +66,9 @@ namespace fc {
       static bool reg_gelf_appender = log_config::register_appender<gelf_appender>( "gelf" );
       static bool reg_dmlog_appender = log_config::register_appender<dmlog_appender>( "dmlog" );
 
+      // outside of log_mutex, the async logging thread takes log_mutex to write
+      detail::async_log_dispatcher::get().configure( cfg.async );
+
       std::lock_guard g( log_config::get().log_mutex );
       log_config::get().logger_map.clear();
       log_config::get().appender_map.clear();
@@ -105,6 +109,18 @@ namespace fc {
       return false;
    }
 
+   void log_config::flush() {
+      detail::async_log_dispatcher::get().flush();
+   }
+
+   bool log_config::async_enabled() {
+      return detail::async_log_dispatcher::get().enabled();
+   }
+
+   uint64_t log_config::async_dropped_messages() {
+      return detail::async_log_dispatcher::get().dropped();
+   }
+
    logging_config logging_config::default_config() {
       //slog( "default cfg" );
       logging_config cfg;
@@ -2,6 +2,9 @@
 
 #include <fc/io/json.hpp>
 #include <fc/exception/exception.hpp>
+#include <fc/filesystem.hpp>
+
+#include <fstream>
 
 using namespace fc;
 
@@ -242,4 +245,48 @@ BOOST_AUTO_TEST_CASE(escape_string_test)
    }
 }
 
+// from_string() parses an in memory buffer with bulk scanning of strings, whitespace and numbers; it must give the same
+// results and errors as parsing the same text from a std::istream, as from_file() does
+BOOST_AUTO_TEST_CASE(from_string_matches_stream_parse)
+{
+   const std::string long_str(100, 'x');
+   const std::string indent(40, ' ');
+   const std::vector<std::string> inputs = {
+      "", " ", "{}", "[]", "[,,1,,]", "{,\"a\":1,}", "null", "true", "false", "tru", "nul", "falfe", "nullZ",
+      "\"\"", "\"abc\"", "\"" + long_str + "\"", "\"" + long_str + "\\\"" + long_str + "\\n\\t\\r\\\\\\u0041" + long_str + "\"",
+      "\"" + long_str, "\"" + long_str + "\\", "\"ab\x04cd\"", std::string("\"ab\0cd\"", 7), "\"\xc3\xa9\xff" + long_str + "\"",
+      "0", "-0", "007", "-", ".", "-.", "1.5", "-1.25e3", "1.2.3", "12abc", "-12abc",
+      "18446744073709551615", "18446744073709551616", "-9223372036854775808", "-9223372036854775809",
+      "123456789012345678901234567890", "1234567890123456" + std::string(".") + "789",
+      "{\"a\":1,\"a\":2}", "{\"a\" : [1, 2, {\"b\":null}], \"c\":\"d\"}", "{\"a\" 1}", "{\"a\":1", "[1,2", "[1 2]",
+      "{\n" + indent + "\"key\": \"" + long_str + "\",\n" + indent + "\"n\": 12345678901234567890,\n" + indent + "\"f\": 0.5\n}",
+      "\t\r\n [ \t1 ,\r\n2 ] ", "[" + indent + "1" + indent + "]", "abc", "@", "{\"a\":@}", "\x04", "\xff",
+      std::string(300, '[') + std::string(300, ']'), std::string(99, '[') + std::string(99, ']'),
+   };
+
+   fc::temp_directory tempdir;
+   const auto file = tempdir.path() / "in.json";
+   for( const json::parse_type ptype : { json::parse_type::legacy_parser, json::parse_type::legacy_parser_with_string_doubles,
+                                         json::parse_type::strict_parser, json::parse_type::relaxed_parser } ) {
+      for( const std::string& input : inputs ) {
+         std::ofstream( file, std::ios::binary ).write( input.data(), input.size() );
+         std::optional<std::string> from_string, from_file;
+         std::optional<int64_t> from_string_error, from_file_error;
+         try {
+            from_string = json::to_string( json::from_string( input, ptype ), fc::time_point::maximum() );
+         } catch( const fc::exception& e ) {
+            from_string_error = e.code();
+         }
+         try {
+            from_file = json::to_string( json::from_file( file, ptype ), fc::time_point::maximum() );
+         } catch( const fc::exception& e ) {
+            from_file_error = e.code();
+         }
+         BOOST_TEST_INFO( "parser " << (int)ptype << ", input " << input );
+         BOOST_CHECK( from_string == from_file );
+         BOOST_CHECK( from_string_error == from_file_error );
+      }
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
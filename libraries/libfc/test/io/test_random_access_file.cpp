@@ -364,4 +364,54 @@ BOOST_AUTO_TEST_CASE(read_only) try {
 
 } FC_LOG_AND_RETHROW();
 
+BOOST_AUTO_TEST_CASE(read_batch) try {
+   fc::temp_directory tmpdir;
+   std::filesystem::path filepath = tmpdir.path() / "file";
+
+   const size_t file_size = 3*1024*1024 + 1234;
+   std::vector<char> data(file_size);
+   fc::rand_bytes(data.data(), data.size());
+   fc::random_access_file f(filepath);
+   f.pack_to(data, 0); //packed size as varuint first
+   const size_t data_offset = fc::raw::pack_size(data) - data.size();
+
+   auto check = [&](fc::io_uring_reader* reader) {
+      const uint32_t op_size = 200*1024;
+      std::vector<char> buff(file_size + op_size);
+      std::vector<fc::io_uring_reader::read_op> ops;
+      for(size_t offs = 0; offs < buff.size(); offs += op_size)
+         ops.push_back({.offset = data_offset + offs, .buffer = buff.data() + offs, .size = op_size});
+      f.read_ahead(data_offset, file_size);
+      f.read_batch(ops, reader);
+
+      size_t total_red = 0;
+      for(const fc::io_uring_reader::read_op& op : ops)
+         total_red += op.result;
+      BOOST_REQUIRE_EQUAL(total_red, file_size); //last ops are short or empty, at end of file
+      BOOST_REQUIRE(std::equal(data.begin(), data.end(), buff.begin()));
+
+      //device too, reading a single span
+      std::vector<char> part(1000);
+      fc::io_uring_reader::read_op op{.offset = data_offset + 12345, .buffer = part.data(), .size = (uint32_t)part.size()};
+      f.seekable_device().read_batch({&op, 1}, reader);
+      BOOST_REQUIRE_EQUAL(op.result, (ssize_t)part.size());
+      BOOST_REQUIRE(std::equal(part.begin(), part.end(), data.begin() + 12345));
+   };
+
+   check(nullptr);
+   if(fc::io_uring_reader::is_supported()) {
+      fc::io_uring_reader reader(4);
+      check(&reader);
+      //reads into a registered buffer, reused for a second batch
+      std::vector<char> registered(1024*1024);
+      reader.register_buffer({registered.data(), registered.size()});
+      std::vector<fc::io_uring_reader::read_op> ops{{.offset = data_offset,           .buffer = registered.data(),          .size = 512*1024},
+                                                   {.offset = data_offset + 512*1024, .buffer = registered.data() + 512*1024, .size = 512*1024}};
+      for(unsigned i = 0; i < 2; ++i) {
+         f.read_batch(ops, &reader);
+         BOOST_REQUIRE(std::equal(registered.begin(), registered.end(), data.begin()));
+      }
+   }
+} FC_LOG_AND_RETHROW();
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fc/log/appender.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/log/logger_config.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace fc;
+
+namespace {
+
+// records the formatted messages it is given, optionally slowly
+class capture_appender : public appender {
+public:
+   explicit capture_appender( const variant& ) {}
+   void initialize() override {}
+   void log( const log_message& m ) override {
+      if( delay.count() > 0 )
+         std::this_thread::sleep_for( delay );
+      std::lock_guard g( mtx );
+      messages.push_back( m.get_message() );
+      thread_ids.push_back( std::this_thread::get_id() );
+   }
+
+   static void reset() {
+      std::lock_guard g( mtx );
+      messages.clear();
+      thread_ids.clear();
+   }
+
+   inline static std::mutex                   mtx;
+   inline static std::vector<std::string>     messages;
+   inline static std::vector<std::thread::id> thread_ids;
+   inline static std::chrono::microseconds    delay{0};
+};
+
+logging_config make_config( bool async, uint32_t queue_size, async_logging_config::overflow_policy::type overflow ) {
+   static bool registered = log_config::register_appender<capture_appender>( "capture" );
+   (void)registered;
+
+   logging_config cfg;
+   cfg.appenders.push_back( appender_config( "capture", "capture" ) );
+   logger_config lc( "async_test" );
+   lc.level = log_level::debug;
+   lc.appenders.push_back( "capture" );
+   cfg.loggers.push_back( lc );
+   cfg.async.enabled    = async;
+   cfg.async.queue_size = queue_size;
+   cfg.async.overflow   = overflow;
+   return cfg;
+}
+
+struct restore_logging {
+   ~restore_logging() {
+      capture_appender::delay = std::chrono::microseconds( 0 );
+      configure_logging( logging_config::default_config() );
+      capture_appender::reset();
+   }
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(async_logging_test)
+
+BOOST_AUTO_TEST_CASE(async_logs_off_calling_thread) try {
+   restore_logging restore;
+   capture_appender::reset();
+   configure_logging( make_config( true, 1024, async_logging_config::overflow_policy::block ) );
+   BOOST_TEST( log_config::async_enabled() );
+
+   logger lgr = logger::get( "async_test" );
+   constexpr size_t num_threads = 4, per_thread = 500;
+   std::vector<std::thread> threads;
+   for( size_t t = 0; t < num_threads; ++t ) {
+      threads.emplace_back( [&lgr, t]() {
+         for( size_t i = 0; i < per_thread; ++i )
+            fc_dlog( lgr, "${t} ${i}", ("t", t)("i", i) );
+      } );
+   }
+   for( auto& t : threads )
+      t.join();
+   log_config::flush();
+
+   std::lock_guard g( capture_appender::mtx );
+   BOOST_REQUIRE_EQUAL( capture_appender::messages.size(), num_threads * per_thread );
+
+   // every message is written by the single logging thread, in logged order per calling thread
+   std::vector<size_t> next( num_threads, 0 );
+   for( size_t m = 0; m < capture_appender::messages.size(); ++m ) {
+      BOOST_CHECK( capture_appender::thread_ids[m] == capture_appender::thread_ids[0] );
+      size_t t = 0, i = 0;
+      BOOST_REQUIRE_EQUAL( sscanf( capture_appender::messages[m].c_str(), "%zu %zu", &t, &i ), 2 );
+      BOOST_REQUIRE_LT( t, num_threads );
+      BOOST_CHECK_EQUAL( i, next[t] );
+      next[t] = i + 1;
+   }
+   BOOST_CHECK( capture_appender::thread_ids[0] != std::this_thread::get_id() );
+} FC_LOG_AND_RETHROW();
+
+BOOST_AUTO_TEST_CASE(async_drop_overflow) try {
+   restore_logging restore;
+   capture_appender::reset();
+   capture_appender::delay = std::chrono::microseconds( 500 );
+   configure_logging( make_config( true, 2, async_logging_config::overflow_policy::drop ) );
+
+   const uint64_t dropped_before = log_config::async_dropped_messages();
+   logger lgr = logger::get( "async_test" );
+   constexpr size_t num_msgs = 200;
+   for( size_t i = 0; i < num_msgs; ++i )
+      fc_ilog( lgr, "msg ${i}", ("i", i) );
+   log_config::flush();
+
+   const uint64_t dropped = log_config::async_dropped_messages() - dropped_before;
+   std::lock_guard g( capture_appender::mtx );
+   BOOST_CHECK_GT( dropped, 0u );
+   BOOST_CHECK_EQUAL( capture_appender::messages.size() + dropped, num_msgs );
+} FC_LOG_AND_RETHROW();
+
+BOOST_AUTO_TEST_CASE(async_block_overflow) try {
+   restore_logging restore;
+   capture_appender::reset();
+   capture_appender::delay = std::chrono::microseconds( 50 );
+   configure_logging( make_config( true, 2, async_logging_config::overflow_policy::block ) );
+
+   logger lgr = logger::get( "async_test" );
+   constexpr size_t num_msgs = 200;
+   for( size_t i = 0; i < num_msgs; ++i )
+      fc_ilog( lgr, "msg ${i}", ("i", i) );
+
+   // disabling async logging writes everything queued
+   configure_logging( make_config( false, 2, async_logging_config::overflow_policy::block ) );
+   BOOST_TEST( !log_config::async_enabled() );
+
+   std::lock_guard g( capture_appender::mtx );
+   BOOST_REQUIRE_EQUAL( capture_appender::messages.size(), num_msgs );
+   for( size_t i = 0; i < num_msgs; ++i )
+      BOOST_CHECK_EQUAL( capture_appender::messages[i], "msg " + std::to_string( i ) );
+} FC_LOG_AND_RETHROW();
+
+BOOST_AUTO_TEST_CASE(async_queue_size_reconfigured) try {
+   restore_logging restore;
+   capture_appender::reset();
+   configure_logging( make_config( true, 1024, async_logging_config::overflow_policy::drop ) );
+
+   logger lgr = logger::get( "async_test" );
+   fc_ilog( lgr, "first" ); // allocates this thread's ring with room for 1024
+   log_config::flush();
+
+   // the smaller queue_size applies to the existing ring of this thread
+   capture_appender::delay = std::chrono::microseconds( 500 );
+   configure_logging( make_config( true, 2, async_logging_config::overflow_policy::drop ) );
+   const uint64_t dropped_before = log_config::async_dropped_messages();
+   constexpr size_t num_msgs = 200;
+   for( size_t i = 0; i < num_msgs; ++i )
+      fc_ilog( lgr, "msg ${i}", ("i", i) );
+   log_config::flush();
+
+   const uint64_t dropped = log_config::async_dropped_messages() - dropped_before;
+   std::lock_guard g( capture_appender::mtx );
+   BOOST_CHECK_GT( dropped, 0u );
+   BOOST_CHECK_EQUAL( capture_appender::messages.size() + dropped, num_msgs + 1 );
+   BOOST_CHECK_EQUAL( capture_appender::messages.front(), "first" );
+} FC_LOG_AND_RETHROW();
+
+BOOST_AUTO_TEST_CASE(sync_by_default) try {
+   restore_logging restore;
+   capture_appender::reset();
+   configure_logging( make_config( false, 1024, async_logging_config::overflow_policy::block ) );
+   BOOST_TEST( !log_config::async_enabled() );
+
+   logger lgr = logger::get( "async_test" );
+   fc_ilog( lgr, "sync" );
+
+   std::lock_guard g( capture_appender::mtx );
+   BOOST_REQUIRE_EQUAL( capture_appender::messages.size(), 1u );
+   BOOST_CHECK( capture_appender::thread_ids[0] == std::this_thread::get_id() );
+} FC_LOG_AND_RETHROW();
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fc/container/expiry_wheel.hpp>
+
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace fc;
+
+namespace {
+   time_point tp( int64_t us ) { return time_point( microseconds( us ) ); }
+   const int64_t base = 1'700'000'000'000'000; // realistic epoch microseconds
+}
+
+BOOST_AUTO_TEST_SUITE(expiry_wheel_tests)
+
+BOOST_AUTO_TEST_CASE(insert_find_erase) {
+   expiry_wheel<uint64_t, std::string> w;
+   BOOST_TEST( w.empty() );
+
+   auto [v, inserted] = w.try_emplace( 1, tp( base + 10 ), "one" );
+   BOOST_TEST( inserted );
+   BOOST_TEST( *v == "one" );
+   BOOST_TEST( !w.try_emplace( 1, tp( base + 20 ), "uno" ).second );
+   BOOST_TEST( *w.find( 1 ) == "one" );
+   BOOST_TEST( w.expiry_of( 1 ).time_since_epoch().count() == base + 10 ); // not updated by the failed emplace
+
+   w.try_emplace( 2, tp( base + 20 ), "two" );
+   BOOST_TEST( w.size() == 2u );
+   BOOST_TEST( w.contains( 2 ) );
+   BOOST_TEST( w.erase( 2 ) );
+   BOOST_TEST( !w.erase( 2 ) );
+   BOOST_TEST( !w.contains( 2 ) );
+   BOOST_TEST( w.find( 2 ) == nullptr );
+   BOOST_TEST( w.size() == 1u );
+
+   w.clear();
+   BOOST_TEST( w.empty() );
+   BOOST_TEST( w.expire( time_point::maximum() ) == 0u );
+}
+
+BOOST_AUTO_TEST_CASE(expire_is_exact) {
+   expiry_wheel<uint64_t, int> w; // 1 second resolution, expiration is still to the microsecond
+   w.try_emplace( 1, tp( base + 500'000 ), 1 );
+   w.try_emplace( 2, tp( base + 500'001 ), 2 );
+   w.try_emplace( 3, tp( base + 1'500'000 ), 3 );
+
+   BOOST_TEST( w.expire( tp( base + 499'999 ) ) == 0u );
+   std::vector<uint64_t> expired;
+   w.expire( tp( base + 500'000 ), [&]( const uint64_t& k, int& v ) { BOOST_TEST( k == uint64_t(v) ); expired.push_back( k ); } );
+   BOOST_TEST( expired == std::vector<uint64_t>{1} );
+   BOOST_TEST( w.expire( tp( base + 500'001 ) ) == 1u );
+   BOOST_TEST( w.size() == 1u );
+
+   // time going backwards does not expire anything
+   BOOST_TEST( w.expire( tp( base ) ) == 0u );
+   BOOST_TEST( w.expire( tp( base + 1'500'000 ) ) == 1u );
+   BOOST_TEST( w.empty() );
+
+   // already expired at insertion
+   w.try_emplace( 4, tp( base ), 4 );
+   BOOST_TEST( w.expire( tp( base + 1'500'000 ) ) == 1u );
+}
+
+BOOST_AUTO_TEST_CASE(expire_in_tick_order) {
+   expiry_wheel<uint64_t, int> w( milliseconds( 1 ) );
+   for( uint64_t i = 0; i < 1000; ++i )
+      w.try_emplace( i, tp( base + (999 - i) * 1'000'000 ), 0 ); // spread over levels
+   w.try_emplace( 1000, time_point::maximum(), 0 );              // beyond the range of the wheel
+
+   std::vector<uint64_t> expired;
+   w.expire( tp( base + 998 * 1'000'000 ), [&]( const uint64_t& k, int& ) { expired.push_back( k ); } );
+   BOOST_REQUIRE( expired.size() == 999u );
+   for( size_t i = 0; i < expired.size(); ++i )
+      BOOST_TEST( expired[i] == 999 - i );
+
+   BOOST_TEST( w.expire( tp( base + 1000 * 1'000'000 ) ) == 1u );
+   BOOST_TEST( w.size() == 1u );
+   BOOST_TEST( w.expire( time_point::maximum() ) == 1u );
+   BOOST_TEST( w.empty() );
+}
+
+BOOST_AUTO_TEST_CASE(set_expiry) {
+   expiry_wheel<uint64_t, int> w;
+   w.try_emplace( 1, tp( base + 1'000'000 ), 0 );
+   BOOST_TEST( w.set_expiry( 1, tp( base + 60'000'000 ) ) );
+   BOOST_TEST( !w.set_expiry( 2, tp( base ) ) );
+   BOOST_TEST( w.expire( tp( base + 59'000'000 ) ) == 0u );
+   BOOST_TEST( w.set_expiry( 1, tp( base ) ) );
+   BOOST_TEST( w.expire( tp( base + 59'000'000 ) ) == 1u );
+}
+
+BOOST_AUTO_TEST_CASE(yield_resumes) {
+   expiry_wheel<uint64_t, int> w;
+   for( uint64_t i = 0; i < 10; ++i )
+      w.try_emplace( i, tp( base + i * 1'000'000 ), 0 );
+
+   size_t count = 0;
+   auto yield = [&]() { return count == 4; };
+   BOOST_TEST( !w.expire( tp( base + 20'000'000 ), yield, [&]( const uint64_t&, int& ) { ++count; } ) );
+   BOOST_TEST( count == 4u );
+   BOOST_TEST( w.size() == 6u );
+   BOOST_TEST( w.expire( tp( base + 20'000'000 ), []() { return false; }, [&]( const uint64_t&, int& ) { ++count; } ) );
+   BOOST_TEST( count == 10u );
+   BOOST_TEST( w.empty() );
+}
+
+// compare against an ordered reference with random inserts, erases, expiry changes and time jumps
+BOOST_AUTO_TEST_CASE(randomized) {
+   for( int64_t res : { int64_t(1), int64_t(1'000), int64_t(1'000'000) } ) {
+      std::mt19937_64 rng( res );
+      expiry_wheel<uint64_t, int> w{ microseconds( res ) };
+      std::map<uint64_t, int64_t> ref; // key -> expiry
+      int64_t now = base;
+      uint64_t next_key = 0;
+
+      auto random_key = [&]() {
+         auto itr = ref.lower_bound( rng() % next_key );
+         return itr == ref.end() ? ref.begin() : itr;
+      };
+
+      for( int i = 0; i < 50'000; ++i ) {
+         const auto op = rng() % 10;
+         if( op < 5 ) {
+            int64_t d = 0;
+            switch( rng() % 5 ) {
+               case 0:  d = rng() % 100; break;
+               case 1:  d = rng() % 100'000; break;
+               case 2:  d = rng() % 100'000'000; break;
+               case 3:  d = rng() % 1'000'000'000'000; break;
+               default: d = -int64_t( rng() % 1'000'000 );
+            }
+            const int64_t e = rng() % 500 == 0 ? time_point::maximum().time_since_epoch().count() : now + d;
+            const uint64_t k = next_key++;
+            BOOST_REQUIRE( w.try_emplace( k, tp( e ), 0 ).second );
+            ref[k] = e;
+         } else if( op < 7 && !ref.empty() ) {
+            auto itr = random_key();
+            BOOST_REQUIRE( w.erase( itr->first ) );
+            ref.erase( itr );
+         } else if( op < 8 && !ref.empty() ) {
+            auto itr = random_key();
+            itr->second = now + int64_t( rng() % 10'000'000 );
+            BOOST_REQUIRE( w.set_expiry( itr->first, tp( itr->second ) ) );
+         } else {
+            if( rng() % 50 == 0 )
+               now += rng() % 100'000'000'000;
+            else
+               now += rng() % 1'000'000;
+            size_t count = 0;
+            const size_t stop_after = rng() % 4 == 0 ? rng() % 5 : std::numeric_limits<size_t>::max();
+            bool done = w.expire( tp( now ), [&]() { return count >= stop_after; },
+                                  [&]( const uint64_t& k, int& ) {
+               ++count;
+               auto itr = ref.find( k );
+               BOOST_REQUIRE( itr != ref.end() );
+               BOOST_REQUIRE( itr->second <= now );
+               ref.erase( itr );
+            } );
+            if( done ) {
+               for( const auto& [k, e] : ref )
+                  BOOST_REQUIRE( e > now );
+            }
+         }
+         BOOST_REQUIRE( w.size() == ref.size() );
+      }
+      w.expire( time_point::maximum() );
+      BOOST_TEST( w.empty() );
+   }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
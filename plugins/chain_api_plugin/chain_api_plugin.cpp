@@ -4,6 +4,19 @@
 #include <fc/time.hpp>
 #include <fc/io/json.hpp>
 
+#include <functional>
+#include <type_traits>
+
+namespace eosio::chain_apis {
+   /// sub-request of /v1/chain/batch
+   struct batch_request {
+      std::string path; ///< chain api call, e.g. "get_account" or "/v1/chain/get_account"
+      fc::variant params;
+   };
+}
+
+FC_REFLECT( eosio::chain_apis::batch_request, (path)(params) )
+
 namespace eosio {
 
    static auto _chain_api_plugin = application::register_plugin<chain_api_plugin>();
@@ -113,6 +126,113 @@ parse_params<chain_apis::read_only::get_transaction_id_params, http_params_types
 
 #define CHAIN_RO_CALL_WITH_400(call_name, http_response_code, params_type) CALL_WITH_400(chain, chain_ro, ro_api, chain_apis::read_only, call_name, http_response_code, params_type)
 
+namespace {
+
+// Calls of /v1/chain/batch. The read_only part runs in the batch's task and returns the rest, usually the
+// serialization, to run on the http thread pool
+using batch_fwd_t  = std::function<fc::variant()>;
+using batch_call_t = std::function<batch_fwd_t(const chain_apis::read_only&, const fc::variant&, const fc::time_point&)>;
+
+constexpr size_t max_batch_requests = 100;
+
+template<typename T>
+struct is_http_fwd : std::false_type {};
+template<typename T>
+struct is_http_fwd<std::function<chain::t_or_exception<T>()>> : std::true_type {};
+
+template<typename Params, typename Result>
+batch_call_t make_batch_call(Result (chain_apis::read_only::*call)(const Params&, const fc::time_point&) const) {
+   return [call](const chain_apis::read_only& api, const fc::variant& v, const fc::time_point& deadline) -> batch_fwd_t {
+      Params params;
+      try {
+         params = v.as<Params>();
+      } EOS_RETHROW_EXCEPTIONS(chain::invalid_http_request, "Unable to parse valid input from batch params");
+
+      Result result = (api.*call)(params, deadline);
+      if constexpr (is_http_fwd<Result>::value) {
+         return [http_fwd = std::move(result)]() -> fc::variant {
+            auto r = http_fwd();
+            if (std::holds_alternative<fc::exception_ptr>(r))
+               std::get<fc::exception_ptr>(r)->dynamic_rethrow_exception();
+            return fc::variant(std::get<0>(std::move(r)));
+         };
+      } else {
+         return [v = fc::variant(std::move(result))]() mutable { return std::move(v); };
+      }
+   };
+}
+
+api_entry make_batch_api(const chain_apis::read_only& ro_api, http_plugin& _http_plugin) {
+   using chain_apis::read_only;
+   static const std::map<std::string, batch_call_t, std::less<>> batch_calls = {
+      {"get_account",          make_batch_call(&read_only::get_account)},
+      {"get_abi",              make_batch_call(&read_only::get_abi)},
+      {"get_block",            make_batch_call(&read_only::get_block)},
+      {"get_block_info",       make_batch_call(&read_only::get_block_info)},
+      {"get_code_hash",        make_batch_call(&read_only::get_code_hash)},
+      {"get_currency_balance", make_batch_call(&read_only::get_currency_balance)},
+      {"get_currency_stats",   make_batch_call(&read_only::get_currency_stats)},
+      {"get_producers",        make_batch_call(&read_only::get_producers)},
+      {"get_table_by_scope",   make_batch_call(&read_only::get_table_by_scope)},
+      {"get_table_rows",       make_batch_call(&read_only::get_table_rows)}
+   };
+
+   return {std::string("/v1/chain/batch"), api_category::chain_ro,
+      [ro_api, &_http_plugin](string&&, string&& body, url_response_callback&& cb) mutable {
+         try {
+            auto requests = parse_params<std::vector<chain_apis::batch_request>, http_params_types::params_required>(body);
+            EOS_ASSERT(requests.size() <= max_batch_requests, chain::invalid_http_request,
+                       "Batch of ${n} requests exceeds the maximum of ${m}", ("n", requests.size())("m", max_batch_requests));
+
+            // all read_only parts run here against the same state, sharing the deadline of the batch, calls not
+            // started by the deadline fail without running
+            const auto deadline = ro_api.start();
+            std::vector<std::string> paths;
+            std::vector<batch_fwd_t> http_fwds;
+            paths.reserve(requests.size());
+            http_fwds.reserve(requests.size());
+            for (auto& req : requests) {
+               std::string_view call = req.path;
+               if (call.starts_with("/v1/chain/"))
+                  call.remove_prefix(std::string_view("/v1/chain/").size());
+               paths.emplace_back(call);
+               try {
+                  EOS_ASSERT(fc::time_point::now() < deadline, chain::deadline_exception,
+                             "Batch response time exceeded before ${p} started", ("p", req.path));
+                  auto itr = batch_calls.find(call);
+                  EOS_ASSERT(itr != batch_calls.end(), chain::invalid_http_request, "Unsupported batch call ${p}", ("p", req.path));
+                  http_fwds.emplace_back(itr->second(ro_api, req.params, deadline));
+               } catch (...) {
+                  http_fwds.emplace_back([e = std::current_exception()]() -> fc::variant { std::rethrow_exception(e); });
+               }
+            }
+
+            _http_plugin.post_http_thread_pool([cb=std::move(cb), body=std::move(body), paths=std::move(paths),
+                                                http_fwds=std::move(http_fwds)]() {
+               // one response, sub-request failures are reported in their result
+               fc::variants results;
+               results.reserve(http_fwds.size());
+               for (size_t i = 0; i < http_fwds.size(); ++i) {
+                  try {
+                     results.emplace_back(fc::mutable_variant_object()("code", 200)("result", http_fwds[i]()));
+                  } catch (...) {
+                     http_plugin::handle_exception("chain", paths[i].c_str(), body,
+                                                   [&results](int code, std::optional<fc::variant> r) {
+                                                      results.emplace_back(fc::mutable_variant_object()("code", code)
+                                                                              ("result", r ? std::move(*r) : fc::variant()));
+                                                   });
+                  }
+               }
+               cb(200, fc::variant(std::move(results)));
+            });
+         } catch (...) {
+            http_plugin::handle_exception("chain", "batch", body, cb);
+         }
+      }};
+}
+
+} // anonymous namespace
+
 void chain_api_plugin::plugin_startup() {
    dlog( "starting chain_api_plugin" );
    my.reset(new chain_api_plugin_impl(app().get_plugin<chain_plugin>().chain()));
@@ -130,6 +250,15 @@ void chain_api_plugin::plugin_startup() {
       CALL_WITH_400(chain, node, ro_api, chain_apis::read_only, get_info, 200, http_params_types::no_params)
    });
 
+   // Answered from the read snapshot published by chain_plugin on each accepted block, so run on the http thread
+   // pool at any time rather than waiting for the read window. The other read-only calls read chainbase and still
+   // wait for it.
+   _http_plugin.add_async_api({
+      CHAIN_RO_CALL_WITH_400(get_consensus_parameters, 200, http_params_types::no_params),
+      CHAIN_RO_CALL_WITH_400(get_finalizer_info, 200, http_params_types::no_params),
+      CHAIN_RO_CALL_WITH_400(get_producer_schedule, 200, http_params_types::no_params)
+   });
+
    _http_plugin.add_api({
       CHAIN_RO_CALL(get_activated_protocol_features, 200, http_params_types::possible_no_params),
       CHAIN_RO_CALL_POST(get_block, fc::variant, 200, http_params_types::params_required), // _POST because get_block() returns a lambda to be executed on the http thread pool
@@ -138,17 +267,14 @@ void chain_api_plugin::plugin_startup() {
       CHAIN_RO_CALL_POST(get_account, chain_apis::read_only::get_account_results, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_code, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_code_hash, 200, http_params_types::params_required),
-      CHAIN_RO_CALL(get_consensus_parameters, 200, http_params_types::no_params),
       CHAIN_RO_CALL(get_abi, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_raw_code_and_abi, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_raw_abi, 200, http_params_types::params_required),
-      CHAIN_RO_CALL(get_finalizer_info, 200, http_params_types::no_params),
       CHAIN_RO_CALL_POST(get_table_rows, chain_apis::read_only::get_table_rows_result, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_table_by_scope, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_currency_balance, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_currency_stats, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_producers, 200, http_params_types::params_required),
-      CHAIN_RO_CALL(get_producer_schedule, 200, http_params_types::no_params),
       CHAIN_RO_CALL(get_scheduled_transactions, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_required_keys, 200, http_params_types::params_required),
       CHAIN_RO_CALL(get_transaction_id, 200, http_params_types::params_required),
@@ -160,6 +286,16 @@ void chain_api_plugin::plugin_startup() {
       CHAIN_RW_CALL_ASYNC(send_transaction2, chain_apis::read_write::send_transaction_results, 202, http_params_types::params_required)
    }, appbase::exec_queue::read_only);
 
+   // sub-requests run in one read_only task, against the same state
+   _http_plugin.add_api({
+      make_batch_api(ro_api, _http_plugin)
+   }, appbase::exec_queue::read_only);
+
+   // table exports, newline delimited JSON serialized on the http thread pool
+   _http_plugin.add_api({
+      CHAIN_RO_CALL_POST(get_table_rows_stream, fc::variants, 200, http_params_types::params_required)
+   }, appbase::exec_queue::read_only, appbase::priority::medium_low, http_content_type::ndjson);
+
    // Not safe to run in parallel with read-only transactions
    _http_plugin.add_api({
       CHAIN_RW_CALL_ASYNC(push_block, chain_apis::read_write::push_block_results, 202, http_params_types::params_required)
@@ -13,6 +13,10 @@
 #include <boost/bimap/multiset_of.hpp>
 #include <boost/bimap/set_of.hpp>
 
+#include <fc/io/cfile.hpp>
+#include <fc/scoped_exit.hpp>
+
+#include <filesystem>
 #include <shared_mutex>
 
 using namespace eosio;
@@ -144,7 +148,22 @@ namespace eosio::chain_apis {
          auto start = fc::time_point::now();
          const auto& index = controller.db().get_index<chain::permission_index>().indices().get<by_id>();
 
-         // build an initial time to block number map
+         build_time_map();
+
+         for (const auto& po : index ) {
+            uint32_t last_updated_height = last_updated_time_to_height(po.last_updated);
+            const auto& pi = permission_info_index.emplace( permission_info{ po.owner, po.name, last_updated_height, po.auth.threshold } ).first;
+            add_to_bimaps(*pi, po);
+         }
+         auto duration = fc::time_point::now() - start;
+         ilog("Finished building account query DB of ${n} permissions in ${sec}",
+              ("n", permission_info_index.size())("sec", (duration.count() / 1'000'000.0 )));
+      }
+
+      /**
+       * build an initial time to block number map of the reversible blocks
+       */
+      void build_time_map() {
          const auto fork_db_root_num = controller.fork_db_root().block_num();
          const auto head_num         = controller.head().block_num();
 
@@ -153,14 +172,128 @@ namespace eosio::chain_apis {
             EOS_ASSERT(block_p, chain::plugin_exception, "cannot fetch reversible block ${block_num}, required for account_db initialization", ("block_num", block_num));
             time_to_block_num.emplace(block_p->timestamp.to_time_point(), block_num);
          }
+      }
 
-         for (const auto& po : index ) {
-            uint32_t last_updated_height = last_updated_time_to_height(po.last_updated);
-            const auto& pi = permission_info_index.emplace( permission_info{ po.owner, po.name, last_updated_height, po.auth.threshold } ).first;
-            add_to_bimaps(*pi, po);
+      /**
+       * Save the database with the id of the HEAD block it was built at
+       */
+      void save(const std::filesystem::path& file) const {
+         std::shared_lock read_lock(rw_mutex);
+
+         auto start = fc::time_point::now();
+         fc::cfile f;
+         f.set_file_path(file);
+         f.open(fc::cfile::truncate_rw_mode);
+         fc::cfile_datastream ds(f);
+
+         fc::raw::pack(ds, magic_number);
+         fc::raw::pack(ds, current_version);
+         fc::raw::pack(ds, controller.head().id());
+         fc::raw::pack(ds, fc::unsigned_int(permission_info_index.size()));
+         for (const auto& pi : permission_info_index) {
+            fc::raw::pack(ds, pi.owner);
+            fc::raw::pack(ds, pi.name);
+            fc::raw::pack(ds, pi.last_updated_height);
+            fc::raw::pack(ds, pi.threshold);
+
+            const auto name_range = name_bimap.right.equal_range(permission_info::cref(pi));
+            fc::raw::pack(ds, fc::unsigned_int(std::distance(name_range.first, name_range.second)));
+            for (auto itr = name_range.first; itr != name_range.second; ++itr) {
+               fc::raw::pack(ds, itr->second.value);
+               fc::raw::pack(ds, itr->second.weight);
+            }
+            const auto key_range = key_bimap.right.equal_range(permission_info::cref(pi));
+            fc::raw::pack(ds, fc::unsigned_int(std::distance(key_range.first, key_range.second)));
+            for (auto itr = key_range.first; itr != key_range.second; ++itr) {
+               fc::raw::pack(ds, itr->second.value);
+               fc::raw::pack(ds, itr->second.weight);
+            }
          }
+         f.flush();
+         f.close();
+
          auto duration = fc::time_point::now() - start;
-         ilog("Finished building account query DB in ${sec}", ("sec", (duration.count() / 1'000'000.0 )));
+         ilog("Saved account query DB of ${n} permissions to ${f} in ${sec}",
+              ("n", permission_info_index.size())("f", file)("sec", (duration.count() / 1'000'000.0 )));
+      }
+
+      /**
+       * Load the database saved by save() if it was saved at the current HEAD block, the file is removed either way
+       * as it goes stale once HEAD moves.
+       * @return false if there is no file for the current HEAD block, the database is left empty
+       */
+      bool load(const std::filesystem::path& file) {
+         if (file.empty() || !std::filesystem::exists(file))
+            return false;
+         auto remove_file = fc::make_scoped_exit([&file]() {
+            std::error_code ec;
+            std::filesystem::remove(file, ec);
+         });
+
+         std::unique_lock write_lock(rw_mutex);
+         try {
+            auto start = fc::time_point::now();
+            fc::cfile f;
+            f.set_file_path(file);
+            f.open(fc::cfile::update_rw_mode);
+            fc::cfile_datastream ds(f);
+
+            uint32_t magic = 0, version = 0;
+            chain::block_id_type head_id;
+            fc::raw::unpack(ds, magic);
+            fc::raw::unpack(ds, version);
+            if (magic != magic_number || version != current_version) {
+               ilog("Ignoring account query DB ${f} of unsupported version ${v}", ("f", file)("v", version));
+               return false;
+            }
+            fc::raw::unpack(ds, head_id);
+            if (head_id != controller.head().id()) {
+               ilog("Ignoring account query DB ${f} saved at block ${b}, head is ${h}",
+                    ("f", file)("b", chain::block_header::num_from_id(head_id))("h", controller.head().block_num()));
+               return false;
+            }
+
+            build_time_map();
+
+            fc::unsigned_int num_permissions;
+            fc::raw::unpack(ds, num_permissions);
+            for (uint32_t i = 0; i < num_permissions.value; ++i) {
+               permission_info info;
+               fc::raw::unpack(ds, info.owner);
+               fc::raw::unpack(ds, info.name);
+               fc::raw::unpack(ds, info.last_updated_height);
+               fc::raw::unpack(ds, info.threshold);
+               const auto& pi = *permission_info_index.emplace(info).first;
+
+               fc::unsigned_int n;
+               fc::raw::unpack(ds, n);
+               for (uint32_t a = 0; a < n.value; ++a) {
+                  weighted<chain::permission_level> w;
+                  fc::raw::unpack(ds, w.value);
+                  fc::raw::unpack(ds, w.weight);
+                  name_bimap.insert(name_bimap_t::value_type{std::move(w), pi});
+               }
+               fc::raw::unpack(ds, n);
+               for (uint32_t k = 0; k < n.value; ++k) {
+                  weighted<chain::public_key_type> w;
+                  fc::raw::unpack(ds, w.value);
+                  fc::raw::unpack(ds, w.weight);
+                  key_bimap.insert(key_bimap_t::value_type{std::move(w), pi});
+               }
+            }
+
+            auto duration = fc::time_point::now() - start;
+            ilog("Loaded account query DB of ${n} permissions from ${f} in ${sec}",
+                 ("n", permission_info_index.size())("f", file)("sec", (duration.count() / 1'000'000.0 )));
+            return true;
+         } FC_LOG_AND_DROP(("Unable to load account query DB ${f}", ("f", file)));
+
+         // rebuilt from the chain state instead
+         time_to_block_num.clear();
+         name_bimap.clear();
+         key_bimap.clear();
+         permission_info_index.clear();
+         return false;
       }
 
       /**
@@ -186,11 +319,11 @@ namespace eosio::chain_apis {
        */
       void remove_from_bimaps( const permission_info& pi ) {
          // remove all entries from the name bimap that refer to this permission_info's reference
-         const auto name_range = name_bimap.right.equal_range(pi);
+         const auto name_range = name_bimap.right.equal_range(permission_info::cref(pi));
          name_bimap.right.erase(name_range.first, name_range.second);
 
          // remove all entries from the key bimap that refer to this permission_info's reference
-         const auto key_range = key_bimap.right.equal_range(pi);
+         const auto key_range = key_bimap.right.equal_range(permission_info::cref(pi));
          key_bimap.right.erase(key_range.first, key_range.second);
       }
 
@@ -211,13 +344,10 @@ namespace eosio::chain_apis {
          return true;
       }
 
-      uint32_t last_updated_time_to_height( const fc::time_point& last_updated) {
+      uint32_t last_updated_time_to_height( const fc::time_point& last_updated) const {
          const auto fork_db_root = controller.fork_db_root();
-         const auto fork_db_root_num  = fork_db_root.block_num();
-         const auto fork_db_root_time = fork_db_root.block_time();
-
-         uint32_t last_updated_height = fork_db_root_num;
-         if (last_updated > fork_db_root_time) {
+         uint32_t last_updated_height = fork_db_root.block_num();
+         if (last_updated > fork_db_root.block_time()) {
             const auto iter = time_to_block_num.find(last_updated);
             EOS_ASSERT(iter != time_to_block_num.end(), chain::plugin_exception, "invalid block time encountered in on-chain accounts ${time}", ("time", last_updated));
             last_updated_height = iter->second;
@@ -505,12 +635,20 @@ namespace eosio::chain_apis {
       key_bimap_t                key_bimap;                ///< many:many bimap of keys:permission_infos
 
       mutable std::shared_mutex  rw_mutex;                 ///< mutex for read/write locking on the Multi-index and bimaps
+
+      static constexpr uint32_t  magic_number    = 0x41514442; ///< "AQDB"
+      static constexpr uint32_t  current_version = 1;
    };
 
-   account_query_db::account_query_db( const chain::controller& controller )
+   account_query_db::account_query_db( const chain::controller& controller, const std::filesystem::path& saved_file )
    :_impl(std::make_unique<account_query_db_impl>(controller))
    {
-      _impl->build_account_query_map();
+      if (!_impl->load(saved_file))
+         _impl->build_account_query_map();
+   }
+
+   void account_query_db::save( const std::filesystem::path& file ) const {
+      _impl->save(file);
    }
 
    account_query_db::~account_query_db() = default;
@@ -13,6 +13,9 @@
 #include <eosio/chain/snapshot.hpp>
 #include <eosio/chain/subjective_billing.hpp>
 #include <eosio/chain/deep_mind.hpp>
+#include <eosio/chain/db_access_tracer.hpp>
+#include <eosio/chain/thread_utils.hpp>
+#include <eosio/chain/recovered_key_cache.hpp>
 #include <eosio/chain_plugin/trx_finality_status_processing.hpp>
 #include <eosio/chain/permission_link_object.hpp>
 #include <eosio/chain/global_property_object.hpp>
@@ -26,6 +29,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <fc/io/json.hpp>
+#include <fc/crypto/base64.hpp>
 #include <fc/variant.hpp>
 #include <cstdlib>
 
@@ -181,6 +185,7 @@ public:
    bool                              account_queries_enabled = false;
 
    std::optional<controller::config> chain_config;
+   std::optional<db_access_tracer>   _db_access_tracer; // before chain, which refers to it
    std::optional<controller>         chain;
    std::optional<genesis_state>      genesis;
    std::optional<vm_type>            wasm_runtime;
@@ -209,6 +214,7 @@ public:
    std::optional<scoped_connection>                                   block_start_connection;
 
    std::optional<chain_apis::get_info_db>                             _get_info_db;
+   std::optional<chain_apis::read_snapshot_db>                        _read_snapshot_db;
    std::optional<chain_apis::account_query_db>                        _account_query_db;
    std::optional<chain_apis::trx_retry_db>                            _trx_retry_db;
    chain_apis::trx_finality_status_processing_ptr                     _trx_finality_status_processing;
@@ -304,6 +310,11 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
           "print contract's output to console")
          ("deep-mind", bpo::bool_switch()->default_value(false),
           "print deeper information about chain operations")
+         ("db-access-trace", bpo::bool_switch()->default_value(false),
+          "Record the contract table rows read and written by each action, summarized per block by table and receiver. "
+          "Summaries are exported by the prometheus_plugin on /v1/prometheus/db_access and written to db-access-trace-file.")
+         ("db-access-trace-file", bpo::value<std::filesystem::path>(),
+          "File, relative to the data directory if not absolute, to append the binary per block db access summaries to. Requires db-access-trace.")
          ("actor-whitelist", boost::program_options::value<vector<string>>()->composing()->multitoken(),
           "Account added to actor whitelist (may specify multiple times)")
          ("actor-blacklist", boost::program_options::value<vector<string>>()->composing()->multitoken(),
@@ -365,7 +376,19 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
           "'none' - EOS VM OC tier-up is completely disabled.\n")
          ("eos-vm-oc-whitelist", bpo::value<vector<string>>()->composing()->multitoken()->default_value(std::vector<string>{{"xsat"}}),
           "EOS VM OC tier-up whitelist account suffixes for tier-up runtime 'auto'.")
+         ("eos-vm-oc-transparent-hugepages", bpo::bool_switch(),
+          "Advise the kernel to back EOS VM OC linear memory and executed code with transparent huge pages. "
+          "Linear memory requires /sys/kernel/mm/transparent_hugepage/shmem_enabled set to 'advise'")
 #endif
+         ("numa-policy", bpo::value<numa_policy>()->default_value(numa_policy::none),
+          "Memory policy of nodeos on multi-socket machines ('none', 'interleave', 'main-node'). Combine with \"database-map-mode\" heap or locked for the chain state.\n"
+          "'none'       - the default policy of the system.\n"
+          "'interleave' - pages interleaved across all memory nodes.\n"
+          "'main-node'  - pages preferably from the memory node of the main thread, pin the main thread with thread-cpu-affinity.\n")
+         ("thread-cpu-affinity", bpo::value<vector<string>>()->composing(),
+          "Pin threads to cpus, as <threads>=<cpus> e.g. main=0 or read=8-15. <threads> is 'main' for the main thread, "
+          "'oc-compile' for the EOS VM OC compile processes, or the name of a thread pool as shown in thread names "
+          "(chain, vote, net, http, read, prod, ship). Each thread of a pool is pinned to one of its cpus in turn.")
          ("enable-account-queries", bpo::value<bool>()->default_value(false), "enable queries to find accounts by various metadata.")
          ("transaction-retry-max-storage-size-gb", bpo::value<uint64_t>(),
           "Maximum size (in GiB) allowed to be allocated for the Transaction Retry feature. Setting above 0 enables this feature.")
@@ -384,7 +407,18 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
          ("disable-replay-opts", bpo::bool_switch()->default_value(false),
           "disable optimizations that specifically target replay")
          ("integrity-hash-on-start", bpo::bool_switch(), "Log the state integrity hash on startup")
-         ("integrity-hash-on-stop", bpo::bool_switch(), "Log the state integrity hash on shutdown");
+         ("integrity-hash-on-stop", bpo::bool_switch(), "Log the state integrity hash on shutdown")
+         ("fork-db-journal", bpo::bool_switch(),
+          "Continuously journal changes to the fork database so that reversible blocks are recovered on restart after a crash instead of being synced again")
+         ("authorization-cache-size", bpo::value<uint32_t>()->default_value(config::default_authorization_cache_size),
+          "Maximum number of entries in each of the caches of authorization check results and permission links shared across transactions, 0 to disable")
+         ("recovered-key-cache-size", bpo::value<uint32_t>()->default_value(config::default_recovered_key_cache_size),
+          "Maximum number of public keys recovered from transaction signatures kept so that a transaction seen again is not recovered again, 0 to disable")
+         ("wasm-warm-cache-size", bpo::value<uint32_t>()->default_value(config::default_wasm_warm_cache_size),
+          "Number of most recently used contracts recorded in the state directory at shutdown and instantiated at startup, "
+          "so the first transactions after a restart do not wait on their instantiation, 0 to disable. The contracts are "
+          "instantiated on a background thread, a contract used before it is ready is instantiated as usual. Contracts "
+          "already compiled by eos-vm-oc tier-up are skipped. Not used by eos-vm-oc");
 
     cfg.add_options()("block-log-retain-blocks", bpo::value<uint32_t>(), "If set to greater than 0, periodically prune the block log to store only configured number of most recent blocks.\n"
         "If set to 0, no blocks are be written to the block log; block log file is removed after startup.");
@@ -502,6 +536,34 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
 
       chain_config = controller::config();
 
+      // before the controller and any thread pool is created so they inherit the memory policy and affinity
+      if( options.count( "thread-cpu-affinity" ) ) {
+         // thread pools without cpus of their own are started on these instead of inheriting those of the main thread
+         set_default_cpu_affinity( get_current_thread_cpu_affinity() );
+         for( const auto& a : options.at( "thread-cpu-affinity" ).as<vector<string>>() ) {
+            auto eq = a.find( '=' );
+            EOS_ASSERT( eq != string::npos && eq > 0, plugin_config_exception,
+                        "Invalid thread-cpu-affinity ${a}, expected <threads>=<cpus>", ("a", a) );
+            const string threads = a.substr( 0, eq );
+            auto cpus = parse_cpu_list( a.substr( eq + 1 ) );
+            if( threads == "main" ) {
+               EOS_ASSERT( set_current_thread_cpu_affinity( cpus ), plugin_config_exception,
+                           "Unable to pin the main thread to cpus ${c}", ("c", cpus) );
+            } else if( threads == "oc-compile" ) {
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+               chain_config->eosvmoc_config.compile_cpu_affinity = std::move( cpus );
+#endif
+            } else {
+               static const std::set<string> pools = { "chain", "vote", "net", "http", "read", "prod", "ship" };
+               EOS_ASSERT( pools.count( threads ), plugin_config_exception,
+                           "Unknown thread-cpu-affinity threads ${t}, expected main, oc-compile, chain, vote, net, http, read, prod or ship",
+                           ("t", threads) );
+               set_thread_pool_cpu_affinity( threads, std::move( cpus ) );
+            }
+         }
+      }
+      set_numa_policy( options.at( "numa-policy" ).as<numa_policy>() );
+
       if( options.at( "print-build-info" ).as<bool>() || options.count( "extract-build-info") ) {
          if( options.at( "print-build-info" ).as<bool>() ) {
             ilog( "Build environment JSON:\n${e}", ("e", json::to_pretty_string( chainbase::environment() )) );
@@ -963,12 +1025,18 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
       if( options.count("eos-vm-oc-compile-threads") )
          chain_config->eosvmoc_config.threads = options.at("eos-vm-oc-compile-threads").as<uint64_t>();
       chain_config->eosvmoc_tierup = options["eos-vm-oc-enable"].as<chain::wasm_interface::vm_oc_enable>();
+      chain_config->eosvmoc_config.transparent_hugepages = options.at("eos-vm-oc-transparent-hugepages").as<bool>();
 #endif
 
       account_queries_enabled = options.at("enable-account-queries").as<bool>();
 
       chain_config->integrity_hash_on_start = options.at("integrity-hash-on-start").as<bool>();
       chain_config->integrity_hash_on_stop = options.at("integrity-hash-on-stop").as<bool>();
+      chain_config->fork_db_journal = options.at("fork-db-journal").as<bool>();
+      chain_config->authorization_cache_size = options.at("authorization-cache-size").as<uint32_t>();
+      // shared by all controllers of the process, entries are keyed by digests which include the chain id
+      recovered_key_cache::instance().set_max_entries( options.at("recovered-key-cache-size").as<uint32_t>() );
+      chain_config->wasm_warm_cache_size = options.at("wasm-warm-cache-size").as<uint32_t>();
 
       chain.emplace( *chain_config, std::move(pfs), *chain_id );
 
@@ -1002,6 +1070,9 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
 
       // only enable _get_info_db if chain_api_plugin enabled.
       _get_info_db.emplace(*chain, chain_api_plugin_configured);
+      // likewise the read snapshots that let chain_api_plugin serve some read-only calls outside of the read window
+      if (chain_api_plugin_configured)
+         _read_snapshot_db.emplace(*chain);
 
       // initialize deep mind logging
       if ( options.at( "deep-mind" ).as<bool>() ) {
@@ -1039,6 +1110,21 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
          chain->enable_deep_mind( &_deep_mind_log );
       }
 
+      // initialize db access tracing
+      EOS_ASSERT( !options.count( "db-access-trace-file" ) || options.at( "db-access-trace" ).as<bool>(), plugin_config_exception,
+                  "db-access-trace must be enabled to write db-access-trace-file" );
+      if ( options.at( "db-access-trace" ).as<bool>() ) {
+         std::filesystem::path dump_file;
+         if( options.count( "db-access-trace-file" ) ) {
+            dump_file = options.at( "db-access-trace-file" ).as<std::filesystem::path>();
+            if( dump_file.is_relative() )
+               dump_file = app().data_dir() / dump_file;
+         }
+         _db_access_tracer.emplace( dump_file );
+         chain->enable_db_access_tracing( &*_db_access_tracer );
+         ilog( "db access tracing enabled${f}", ("f", dump_file.empty() ? std::string() : ", writing summaries to " + dump_file.string()) );
+      }
+
       get_block_by_id_provider = app().get_method<methods::get_block_by_id>().register_provider(
             [this]( block_id_type id ) -> signed_block_ptr {
                return chain->fetch_block_by_id( id );
@@ -1076,6 +1162,10 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
             _get_info_db->on_accepted_block();
          }
 
+         if (_read_snapshot_db) {
+            _read_snapshot_db->on_accepted_block();
+         }
+
          accepted_block_channel.publish( priority::high, t );
       } );
 
@@ -1094,6 +1184,10 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
             _get_info_db->on_irreversible_block(block, id);
          }
 
+         if (_read_snapshot_db) {
+            _read_snapshot_db->on_irreversible_block();
+         }
+
          irreversible_block_channel.publish( priority::low, t );
       } );
       
@@ -1170,10 +1264,15 @@ void chain_plugin_impl::plugin_startup()
 
    chain_config.reset();
 
+   // no block may be accepted before the first api call, e.g. when started from a snapshot
+   if (_read_snapshot_db) {
+      _read_snapshot_db->publish();
+   }
+
    if (account_queries_enabled) {
       account_queries_enabled = false;
       try {
-         _account_query_db.emplace(*chain);
+         _account_query_db.emplace(*chain, state_dir / config::account_query_db_filename);
          account_queries_enabled = true;
       } FC_LOG_AND_DROP(("Unable to enable account queries"));
    }
@@ -1186,6 +1285,11 @@ void chain_plugin::plugin_startup() {
 
 void chain_plugin::plugin_shutdown() {
    dlog("shutdown");
+   if (my->_account_query_db) {
+      try {
+         my->_account_query_db->save(my->state_dir / config::account_query_db_filename);
+      } FC_LOG_AND_DROP(("Unable to save account query DB"));
+   }
 }
 
 void chain_plugin::handle_sighup() {
@@ -1216,7 +1320,8 @@ chain_apis::read_write chain_plugin::get_read_write_api(const fc::microseconds&
 }
 
 chain_apis::read_only chain_plugin::get_read_only_api(const fc::microseconds& http_max_response_time) const {
-   return chain_apis::read_only(chain(), my->_get_info_db, my->_account_query_db, my->_last_tracked_votes, get_abi_serializer_max_time(), http_max_response_time, my->_trx_finality_status_processing.get());
+   return chain_apis::read_only(chain(), my->_get_info_db, my->_account_query_db, my->_last_tracked_votes, get_abi_serializer_max_time(), http_max_response_time, my->_trx_finality_status_processing.get(),
+                                my->_read_snapshot_db ? &*my->_read_snapshot_db : nullptr);
 }
 
 void chain_plugin::accept_transaction(const chain::packed_transaction_ptr& trx, next_function<chain::transaction_trace_ptr> next) {
@@ -1441,6 +1546,27 @@ uint64_t read_only::get_table_index_name(const read_only::get_table_rows_params&
    return index;
 }
 
+string read_only::encode_table_rows_cursor( const table_rows_cursor& c ) {
+   const auto packed = fc::raw::pack( c );
+   return fc::base64url_encode( packed.data(), packed.size() );
+}
+
+read_only::table_rows_cursor
+read_only::decode_table_rows_cursor( const get_table_rows_params& p, name scope, uint64_t index, bool primary ) {
+   table_rows_cursor c;
+   try {
+      c = fc::raw::unpack<table_rows_cursor>( fc::base64url_decode( *p.cursor ) );
+   } EOS_RETHROW_EXCEPTIONS( chain::contract_table_query_exception, "Invalid cursor: ${c}", ("c", *p.cursor) )
+
+   EOS_ASSERT( c.version == table_rows_cursor{}.version, chain::contract_table_query_exception,
+               "Unsupported cursor version ${v}", ("v", c.version) );
+   EOS_ASSERT( c.code == p.code && c.scope == scope && c.table == p.table && c.index == index &&
+               c.reverse == (p.reverse && *p.reverse) && c.secondary_key.empty() == primary,
+               chain::contract_table_query_exception,
+               "Cursor was not returned for this code, scope, table, index_position and reverse" );
+   return c;
+}
+
 uint64_t convert_to_type(const eosio::name &n, const string &desc) {
    return n.to_uint64_t();
 }
@@ -1545,6 +1671,11 @@ string get_table_type( const abi_def& abi, const name& table_name ) {
 
 read_only::get_table_rows_return_t
 read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::time_point& deadline ) const {
+   return get_table_rows( p, deadline, max_return_items );
+}
+
+read_only::get_table_rows_return_t
+read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::time_point& deadline, uint32_t max_rows ) const {
    abi_def abi = eosio::chain_apis::get_abi( db, p.code );
    bool primary = false;
    auto table_with_index = get_table_index_name( p, primary );
@@ -1552,32 +1683,32 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
       EOS_ASSERT( p.table == table_with_index, chain::contract_table_query_exception, "Invalid table name ${t}", ( "t", p.table ));
       auto table_type = get_table_type( abi, p.table );
       if( table_type == KEYi64 || p.key_type == "i64" || p.key_type == "name" ) {
-         return get_table_rows_ex<key_value_index>(p,std::move(abi),deadline);
+         return get_table_rows_ex<key_value_index>(p,std::move(abi),deadline,max_rows);
       }
       EOS_ASSERT( false, chain::contract_table_query_exception,  "Invalid table type ${type}", ("type",table_type)("abi",abi));
    } else {
       EOS_ASSERT( !p.key_type.empty(), chain::contract_table_query_exception, "key type required for non-primary index" );
 
       if (p.key_type == chain_apis::i64 || p.key_type == "name") {
-         return get_table_rows_by_seckey<index64_index, uint64_t>(p, std::move(abi), deadline, [](uint64_t v)->uint64_t {
+         return get_table_rows_by_seckey<index64_index, uint64_t>(p, std::move(abi), deadline, max_rows, [](uint64_t v)->uint64_t {
             return v;
          });
       }
       else if (p.key_type == chain_apis::i128) {
-         return get_table_rows_by_seckey<index128_index, uint128_t>(p, std::move(abi), deadline, [](uint128_t v)->uint128_t {
+         return get_table_rows_by_seckey<index128_index, uint128_t>(p, std::move(abi), deadline, max_rows, [](uint128_t v)->uint128_t {
             return v;
          });
       }
       else if (p.key_type == chain_apis::i256) {
          if ( p.encode_type == chain_apis::hex) {
             using  conv = keytype_converter<chain_apis::sha256,chain_apis::hex>;
-            return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+            return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, max_rows, conv::function());
          }
          using  conv = keytype_converter<chain_apis::i256>;
-         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, max_rows, conv::function());
       }
       else if (p.key_type == chain_apis::float64) {
-         return get_table_rows_by_seckey<index_double_index, double>(p, std::move(abi), deadline, [](double v)->float64_t {
+         return get_table_rows_by_seckey<index_double_index, double>(p, std::move(abi), deadline, max_rows, [](double v)->float64_t {
             float64_t f;
             double_to_float64(v, f);
             return f;
@@ -1585,13 +1716,13 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
       }
       else if (p.key_type == chain_apis::float128) {
          if ( p.encode_type == chain_apis::hex) {
-            return get_table_rows_by_seckey<index_long_double_index, uint128_t>(p, std::move(abi), deadline, [](uint128_t v)->float128_t{
+            return get_table_rows_by_seckey<index_long_double_index, uint128_t>(p, std::move(abi), deadline, max_rows, [](uint128_t v)->float128_t{
                float128_t f;
                uint128_to_float128(v, f);
                return f;
             });
          }
-         return get_table_rows_by_seckey<index_long_double_index, double>(p, std::move(abi), deadline, [](double v)->float128_t{
+         return get_table_rows_by_seckey<index_long_double_index, double>(p, std::move(abi), deadline, max_rows, [](double v)->float128_t{
             float64_t f;
             double_to_float64(v, f);
             float128_t f128;
@@ -1601,16 +1732,38 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
       }
       else if (p.key_type == chain_apis::sha256) {
          using  conv = keytype_converter<chain_apis::sha256,chain_apis::hex>;
-         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, max_rows, conv::function());
       }
       else if(p.key_type == chain_apis::ripemd160) {
          using  conv = keytype_converter<chain_apis::ripemd160,chain_apis::hex>;
-         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, max_rows, conv::function());
       }
       EOS_ASSERT(false, chain::contract_table_query_exception,  "Unsupported secondary index type: ${t}", ("t", p.key_type));
    }
 }
 
+read_only::get_table_rows_stream_return_t
+read_only::get_table_rows_stream( const read_only::get_table_rows_stream_params& params, const fc::time_point& deadline ) const {
+   get_table_rows_params p = params;
+   if( !p.cursor )
+      p.cursor.emplace();
+   // limited by the time limit instead of max_return_items
+   auto rows_fwd = get_table_rows( p, deadline, std::numeric_limits<uint32_t>::max() );
+
+   return [rows_fwd = std::move(rows_fwd)]() -> chain::t_or_exception<fc::variants> {
+      auto result = rows_fwd();
+      if( std::holds_alternative<fc::exception_ptr>(result) )
+         return std::get<fc::exception_ptr>(std::move(result));
+      auto& r = std::get<get_table_rows_result>(result);
+      fc::variants lines = std::move(r.rows);
+      lines.emplace_back( fc::mutable_variant_object()
+                             ("more", r.more)
+                             ("next_key", std::move(r.next_key))
+                             ("next_cursor", r.next_cursor ? std::move(*r.next_cursor) : string()) );
+      return lines;
+   };
+}
+
 read_only::get_table_by_scope_result read_only::get_table_by_scope( const read_only::get_table_by_scope_params& p,
                                                                     const fc::time_point& deadline )const {
 
@@ -1752,8 +1905,14 @@ read_only::get_finalizer_info_result read_only::get_finalizer_info( const read_o
    };
 
    // Populate active_finalizer_policy and pending_finalizer_policy
-   add_policy_to_result(db.head_active_finalizer_policy(), result.active_finalizer_policy);
-   add_policy_to_result(db.head_pending_finalizer_policy(), result.pending_finalizer_policy);
+   if (rsdb) {
+      auto snapshot = get_read_snapshot(); // may be called on the http thread pool, see chain_api_plugin
+      add_policy_to_result(snapshot->active_finalizer_policy, result.active_finalizer_policy);
+      add_policy_to_result(snapshot->pending_finalizer_policy, result.pending_finalizer_policy);
+   } else {
+      add_policy_to_result(db.head_active_finalizer_policy(), result.active_finalizer_policy);
+      add_policy_to_result(db.head_pending_finalizer_policy(), result.pending_finalizer_policy);
+   }
 
    // Populate last_tracked_votes
    if (last_tracked_votes) {
@@ -1852,8 +2011,21 @@ read_only::get_producers( const read_only::get_producers_params& params, const f
    return result;
 }
 
+read_snapshot_db::read_snapshot_ptr read_only::get_read_snapshot() const {
+   auto snapshot = rsdb->get_snapshot();
+   EOS_ASSERT(snapshot, plugin_exception, "No read snapshot of the chain state has been published yet");
+   return snapshot;
+}
+
 read_only::get_producer_schedule_result read_only::get_producer_schedule( const read_only::get_producer_schedule_params& p, const fc::time_point& ) const {
    read_only::get_producer_schedule_result result;
+   if (rsdb) {
+      auto snapshot = get_read_snapshot(); // may be called on the http thread pool, see chain_api_plugin
+      result.active   = snapshot->active_producers;
+      result.pending  = snapshot->pending_producers;
+      result.proposed = snapshot->proposed_producers;
+      return result;
+   }
    to_variant(db.active_producers(), result.active);
    if (const auto* pending = db.pending_producers())
       to_variant(*pending, result.pending);
@@ -2678,6 +2850,13 @@ read_only::get_consensus_parameters_results
 read_only::get_consensus_parameters(const get_consensus_parameters_params&, const fc::time_point& ) const {
    get_consensus_parameters_results results;
 
+   if (rsdb) {
+      auto snapshot = get_read_snapshot(); // may be called on the http thread pool, see chain_api_plugin
+      results.chain_config = snapshot->chain_config;
+      results.wasm_config  = snapshot->wasm_config;
+      return results;
+   }
+
    results.chain_config = db.get_global_properties().configuration;
    if (db.is_builtin_activated(builtin_protocol_feature_t::configurable_wasm_limits)) {
       results.wasm_config = db.get_global_properties().wasm_configuration;
@@ -2,11 +2,13 @@
 #include <eosio/chain/types.hpp>
 #include <eosio/chain/trace.hpp>
 
+#include <filesystem>
+
 namespace eosio::chain_apis {
    /**
     * This class manages the ephemeral indices and data that provide the `get_accounts_by_authorizers` RPC call
-    * There is no persistence and the indices/caches are recreated when the class is instantiated based on the
-    * current state of the chain.
+    * The indices/caches are recreated when the class is instantiated based on the current state of the chain, unless
+    * they were saved at the current HEAD block by a clean shutdown.
     */
    class account_query_db {
    public:
@@ -16,10 +18,18 @@ namespace eosio::chain_apis {
        * The caller is expected to manage lifetimes such that this controller reference does not go stale
        * for the life of the account query DB
        * @param chain - controller to read data from
+       * @param saved_file - file written by `save`, loaded instead of rebuilding if it was saved at the current HEAD
+       *                     block, it is removed once read
        */
-      account_query_db( const class eosio::chain::controller& chain );
+      account_query_db( const class eosio::chain::controller& chain, const std::filesystem::path& saved_file = {} );
       ~account_query_db();
 
+      /**
+       * Save the account query DB along with the id of the HEAD block of chain, to be loaded on the next start
+       * @param file
+       */
+      void save( const std::filesystem::path& file ) const;
+
       /**
        * Allow moving the account query DB (including by assignment)
        */
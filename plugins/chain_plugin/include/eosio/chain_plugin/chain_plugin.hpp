@@ -5,6 +5,7 @@
 #include <eosio/chain_plugin/trx_finality_status_processing.hpp>
 #include <eosio/chain_plugin/tracked_votes.hpp>
 #include <eosio/chain_plugin/get_info_db.hpp>
+#include <eosio/chain_plugin/read_snapshot_db.hpp>
 
 #include <eosio/chain/application.hpp>
 #include <eosio/chain/asset.hpp>
@@ -147,7 +148,11 @@ class read_only : public api_base {
    const fc::microseconds http_max_response_time;
    bool  shorten_abi_errors = true;
    const trx_finality_status_processing* trx_finality_status_proc;
+   const read_snapshot_db* rsdb;
    friend class api_base;
+
+   // the last published read snapshot, only when rsdb is set
+   read_snapshot_db::read_snapshot_ptr get_read_snapshot() const;
    
 public:
    static const string KEYi64;
@@ -158,14 +163,16 @@ public:
              std::optional<tracked_votes>&          last_tracked_votes, // tracking_enabled of last_tracked_votes is set after it is constructed. const cannot be used here.
              const fc::microseconds&                abi_serializer_max_time,
              const fc::microseconds&                http_max_response_time,
-             const trx_finality_status_processing*  trx_finality_status_proc)
+             const trx_finality_status_processing*  trx_finality_status_proc,
+             const read_snapshot_db*                rsdb = nullptr)
       : db(db)
       , gidb(gidb)
       , aqdb(aqdb)
       , last_tracked_votes(last_tracked_votes)
       , abi_serializer_max_time(abi_serializer_max_time)
       , http_max_response_time(http_max_response_time)
-      , trx_finality_status_proc(trx_finality_status_proc) {
+      , trx_finality_status_proc(trx_finality_status_proc)
+      , rsdb(rsdb) {
    }
 
    void validate() const {}
@@ -419,18 +426,41 @@ public:
       std::optional<bool>  reverse;
       std::optional<bool>  show_payer; // show RAM payer
       std::optional<uint32_t> time_limit_ms; // defaults to http-max-response-time-ms
+      std::optional<string>   cursor; // next_cursor of the previous page, empty string to start a cursor scan
     };
 
    struct get_table_rows_result {
       vector<fc::variant> rows; ///< one row per item, either encoded as hex String or JSON object
       bool                more = false; ///< true if last element in data is not the end and sizeof data() < limit
       string              next_key; ///< fill lower_bound with this value to fetch more rows
+      std::optional<string> next_cursor; ///< only when cursor requested, fill cursor with this value to fetch more rows, empty when done
    };
 
    using get_table_rows_return_t = std::function<chain::t_or_exception<get_table_rows_result>()>;
    
    get_table_rows_return_t get_table_rows( const get_table_rows_params& params, const fc::time_point& deadline )const;
 
+   /// Position of the next row of a get_table_rows walk, passed to the client as an opaque base64url token.
+   /// Unlike next_key it identifies a single row of a secondary index with duplicate keys.
+   struct table_rows_cursor {
+      uint8_t      version = 1;
+      name         code;
+      name         scope;
+      name         table;
+      uint64_t     index = 0; ///< table with index of the walked index
+      bool         reverse = false;
+      uint64_t     primary_key = 0;
+      vector<char> secondary_key; ///< raw secondary key, empty for the primary index
+   };
+
+   /// get_table_rows for table exports, rows are not limited to max_return_items, only by limit and time_limit_ms.
+   /// Always a cursor scan, the response is newline delimited JSON, one line per row followed by
+   /// a line of {"more", "next_key", "next_cursor"}.
+   using get_table_rows_stream_params = get_table_rows_params;
+   using get_table_rows_stream_return_t = std::function<chain::t_or_exception<fc::variants>()>;
+
+   get_table_rows_stream_return_t get_table_rows_stream( const get_table_rows_stream_params& params, const fc::time_point& deadline )const;
+
    struct get_table_by_scope_params {
       name                 code; // mandatory
       name                 table; // optional, act as filter
@@ -577,11 +607,35 @@ public:
 
    static uint64_t get_table_index_name(const read_only::get_table_rows_params& p, bool& primary);
 
+   get_table_rows_return_t get_table_rows( const get_table_rows_params& params, const fc::time_point& deadline, uint32_t max_rows )const;
+
+   static string encode_table_rows_cursor( const table_rows_cursor& c );
+   // throws contract_table_query_exception if the cursor was not returned for the same table, index and direction
+   static table_rows_cursor decode_table_rows_cursor( const get_table_rows_params& p, name scope, uint64_t index, bool primary );
+
+   template<typename SecondaryKeyType>
+   static vector<char> secondary_key_to_cursor( const SecondaryKeyType& k ) {
+      static_assert( std::is_trivially_copyable_v<SecondaryKeyType> );
+      vector<char> data( sizeof(k) );
+      memcpy( data.data(), &k, sizeof(k) );
+      return data;
+   }
+
+   template<typename SecondaryKeyType>
+   static SecondaryKeyType secondary_key_from_cursor( const table_rows_cursor& c ) {
+      static_assert( std::is_trivially_copyable_v<SecondaryKeyType> );
+      EOS_ASSERT( c.secondary_key.size() == sizeof(SecondaryKeyType), chain::contract_table_query_exception, "Invalid cursor secondary key" );
+      SecondaryKeyType k;
+      memcpy( &k, c.secondary_key.data(), sizeof(k) );
+      return k;
+   }
+
    template <typename IndexType, typename SecKeyType, typename ConvFn>
    get_table_rows_return_t
    get_table_rows_by_seckey( const read_only::get_table_rows_params& p,
                              abi_def&& abi,
                              const fc::time_point& deadline,
+                             uint32_t max_rows,
                              ConvFn conv ) const {
 
       fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(*p.time_limit_ms)), deadline) : deadline;
@@ -594,9 +648,12 @@ public:
          bool more;
          std::string next_key;
          vector<std::pair<vector<char>, name>> rows;
+         std::optional<std::string> next_cursor;
       };
       
       http_params_t http_params { p.table, shorten_abi_errors, p.json, p.show_payer && *p.show_payer, false  };
+      if( p.cursor )
+         http_params.next_cursor.emplace();
          
       const auto& d = db.db();
 
@@ -604,6 +661,9 @@ public:
 
       bool primary = false;
       const uint64_t table_with_index = get_table_index_name(p, primary);
+      std::optional<table_rows_cursor> cursor;
+      if( p.cursor && !p.cursor->empty() )
+         cursor = decode_table_rows_cursor(p, scope, table_with_index, false);
       const auto* t_id = d.find<chain::table_id_object, chain::by_code_scope_table>(boost::make_tuple(p.code, scope, p.table));
       const auto* index_t_id = d.find<chain::table_id_object, chain::by_code_scope_table>(boost::make_tuple(p.code, scope, name(table_with_index)));
       if( t_id != nullptr && index_t_id != nullptr ) {
@@ -646,6 +706,17 @@ public:
             }
          }
 
+         if( cursor ) {
+            // resume at the exact row, including its primary key, within the requested bounds
+            decltype(lower_bound_lookup_tuple) cursor_lookup_tuple{ index_t_id->id._id,
+                                                                    secondary_key_from_cursor<secondary_key_type>(*cursor),
+                                                                    cursor->primary_key };
+            if( p.reverse && *p.reverse )
+               upper_bound_lookup_tuple = std::min( upper_bound_lookup_tuple, cursor_lookup_tuple );
+            else
+               lower_bound_lookup_tuple = std::max( lower_bound_lookup_tuple, cursor_lookup_tuple );
+         }
+
          if( upper_bound_lookup_tuple < lower_bound_lookup_tuple )
             return []() ->  chain::t_or_exception<read_only::get_table_rows_result> {
                return read_only::get_table_rows_result();
@@ -654,19 +725,26 @@ public:
          auto walk_table_row_range = [&]( auto itr, auto end_itr ) {
             vector<char> data;
             uint32_t limit = p.limit;
-            if (deadline != fc::time_point::maximum() && limit > max_return_items)
-               limit = max_return_items;
+            if (deadline != fc::time_point::maximum() && limit > max_rows)
+               limit = max_rows;
             for( unsigned int count = 0; count < limit && itr != end_itr; ++count, ++itr ) {
                const auto* itr2 = d.find<chain::key_value_object, chain::by_scope_primary>( boost::make_tuple(t_id->id, itr->primary_key) );
                if( itr2 == nullptr ) continue;
                copy_inline_row(*itr2, data);
                http_params.rows.emplace_back(std::move(data), itr->payer);
-               if (fc::time_point::now() >= params_deadline)
+               if (fc::time_point::now() >= params_deadline) {
+                  ++itr; // next_key and next_cursor are the first row not returned
                   break;
+               }
             }
             if( itr != end_itr ) {
                http_params.more = true;
                http_params.next_key = convert_to_string(itr->secondary_key, p.key_type, p.encode_type, "next_key - next lower bound");
+               if( p.cursor )
+                  http_params.next_cursor = encode_table_rows_cursor( { .code = p.code, .scope = scope, .table = p.table,
+                                                                        .index = table_with_index, .reverse = p.reverse && *p.reverse,
+                                                                        .primary_key = itr->primary_key,
+                                                                        .secondary_key = secondary_key_to_cursor(itr->secondary_key) } );
             }
          };
 
@@ -706,6 +784,7 @@ public:
          }
          result.more = p.more;
          result.next_key = p.next_key;
+         result.next_cursor = std::move(p.next_cursor);
          return result;
       };
    }
@@ -714,7 +793,8 @@ public:
    get_table_rows_return_t
    get_table_rows_ex( const read_only::get_table_rows_params& p,
                       abi_def&& abi,
-                      const fc::time_point& deadline ) const {
+                      const fc::time_point& deadline,
+                      uint32_t max_rows ) const {
 
       fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(*p.time_limit_ms)), deadline) : deadline;
 
@@ -726,14 +806,21 @@ public:
          bool more;
          std::string next_key;
          vector<std::pair<vector<char>, name>> rows;
+         std::optional<std::string> next_cursor;
       };
       
       http_params_t http_params { p.table, shorten_abi_errors, p.json, p.show_payer && *p.show_payer, false  };
+      if( p.cursor )
+         http_params.next_cursor.emplace();
          
       const auto& d = db.db();
 
       uint64_t scope = convert_to_type<uint64_t>(p.scope, "scope");
 
+      std::optional<table_rows_cursor> cursor;
+      if( p.cursor && !p.cursor->empty() )
+         cursor = decode_table_rows_cursor(p, name(scope), p.table.to_uint64_t(), true);
+
       const auto* t_id = d.find<chain::table_id_object, chain::by_code_scope_table>(boost::make_tuple(p.code, name(scope), p.table));
       if( t_id != nullptr ) {
          const auto& idx = d.get_index<IndexType, chain::by_scope_primary>();
@@ -760,6 +847,13 @@ public:
             }
          }
 
+         if( cursor ) {
+            if( p.reverse && *p.reverse )
+               std::get<1>(upper_bound_lookup_tuple) = std::min( std::get<1>(upper_bound_lookup_tuple), cursor->primary_key );
+            else
+               std::get<1>(lower_bound_lookup_tuple) = std::max( std::get<1>(lower_bound_lookup_tuple), cursor->primary_key );
+         }
+
          if( upper_bound_lookup_tuple < lower_bound_lookup_tuple  )
             return []() ->  chain::t_or_exception<read_only::get_table_rows_result> {
                return read_only::get_table_rows_result();
@@ -768,17 +862,23 @@ public:
          auto walk_table_row_range = [&]( auto itr, auto end_itr ) {
             vector<char> data;
             uint32_t limit = p.limit;
-            if (deadline != fc::time_point::maximum() && limit > max_return_items)
-               limit = max_return_items;
+            if (deadline != fc::time_point::maximum() && limit > max_rows)
+               limit = max_rows;
             for( unsigned int count = 0; count < limit && itr != end_itr; ++count, ++itr ) {
                copy_inline_row(*itr, data);
                http_params.rows.emplace_back(std::move(data), itr->payer);
-               if (fc::time_point::now() >= params_deadline)
+               if (fc::time_point::now() >= params_deadline) {
+                  ++itr; // next_key and next_cursor are the first row not returned
                   break;
+               }
             }
             if( itr != end_itr ) {
                http_params.more = true;
                http_params.next_key = convert_to_string(itr->primary_key, p.key_type, p.encode_type, "next_key - next lower bound");
+               if( p.cursor )
+                  http_params.next_cursor = encode_table_rows_cursor( { .code = p.code, .scope = name(scope), .table = p.table,
+                                                                        .index = p.table.to_uint64_t(), .reverse = p.reverse && *p.reverse,
+                                                                        .primary_key = itr->primary_key } );
             }
          };
 
@@ -818,6 +918,7 @@ public:
          }
          result.more = p.more;
          result.next_key = p.next_key;
+         result.next_cursor = std::move(p.next_cursor);
          return result;
       };
    }
@@ -1027,8 +1128,9 @@ FC_REFLECT(eosio::chain_apis::read_only::get_block_header_result, (id)(signed_bl
 FC_REFLECT( eosio::chain_apis::read_write::push_transaction_results, (transaction_id)(processed) )
 FC_REFLECT( eosio::chain_apis::read_write::send_transaction2_params, (return_failure_trace)(retry_trx)(retry_trx_num_blocks)(transaction) )
 
-FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_params, (json)(code)(scope)(table)(table_key)(lower_bound)(upper_bound)(limit)(key_type)(index_position)(encode_type)(reverse)(show_payer)(time_limit_ms) )
-FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_result, (rows)(more)(next_key) );
+FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_params, (json)(code)(scope)(table)(table_key)(lower_bound)(upper_bound)(limit)(key_type)(index_position)(encode_type)(reverse)(show_payer)(time_limit_ms)(cursor) )
+FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_result, (rows)(more)(next_key)(next_cursor) );
+FC_REFLECT( eosio::chain_apis::read_only::table_rows_cursor, (version)(code)(scope)(table)(index)(reverse)(primary_key)(secondary_key) )
 
 FC_REFLECT( eosio::chain_apis::read_only::get_table_by_scope_params, (code)(table)(lower_bound)(upper_bound)(limit)(reverse)(time_limit_ms) )
 FC_REFLECT( eosio::chain_apis::read_only::get_table_by_scope_result_row, (code)(scope)(table)(payer)(count));
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <eosio/chain/controller.hpp>
+#include <eosio/chain/finalizer_policy.hpp>
+
+namespace eosio::chain_apis {
+   /**
+    * This class publishes immutable snapshots of the chain state that read-only RPC calls such as
+    * `get_consensus_parameters`, `get_producer_schedule` and `get_finalizer_info` need, so they can be
+    * answered on the http thread pool at any time instead of waiting for a read window of the producer.
+    *
+    * A snapshot reflects the chain as of the last accepted block, or the last irreversible block in
+    * IRREVERSIBLE mode, the same staleness as `get_info`. It is replaced as a whole, so a call sees a
+    * consistent state and the head_block_num it was taken at, never a block being applied.
+    *
+    * Only those three calls are served from it. It copies a few small objects, it is not a versioned view of the
+    * chainbase state: table, account and ABI queries and read-only transactions still run in the read window.
+    */
+   class read_snapshot_db {
+   public:
+
+      struct read_snapshot {
+         uint32_t                           head_block_num = 0;
+         chain::block_id_type               head_block_id;
+         fc::time_point                     head_block_time;
+
+         chain::chain_config                chain_config;
+         std::optional<chain::wasm_config>  wasm_config;
+
+         fc::variant                        active_producers;
+         fc::variant                        pending_producers;
+         fc::variant                        proposed_producers;
+
+         chain::finalizer_policy_ptr        active_finalizer_policy;  // nullptr pre-savanna
+         chain::finalizer_policy_ptr        pending_finalizer_policy; // nullptr pre-savanna
+      };
+      using read_snapshot_ptr = std::shared_ptr<const read_snapshot>;
+
+      /**
+       * Instantiate a read snapshot publisher for the given chain controller.
+       * The caller is expected to manage lifetimes such that this controller
+       * reference does not go stale for the life of the publisher.
+       *
+       * @param chain - controller to read data from
+       */
+      explicit read_snapshot_db( const class eosio::chain::controller& chain );
+      ~read_snapshot_db();
+
+      // Called on accepted_block signal, from the main thread
+      void on_accepted_block();
+
+      // Called on irreversible_block signal, from the main thread
+      void on_irreversible_block();
+
+      // Publishes a snapshot of the current head, from the main thread, e.g. at startup when no block has been accepted
+      void publish();
+
+      // Returns the last published snapshot, nullptr before the first one. Safe to call from any thread.
+      read_snapshot_ptr get_snapshot() const;
+
+   private:
+      std::unique_ptr<struct read_snapshot_db_impl> _impl;
+   }; // read_snapshot_db
+} // namespace eosio::chain_apis
@@ -0,0 +1,102 @@
+#include <eosio/chain_plugin/read_snapshot_db.hpp>
+#include <eosio/chain/global_property_object.hpp>
+
+//libstdc++ flags atomic_*<shared_ptr> as deprecated in c++20. while libstdc++ 12 adds atomic<shared_ptr>, it is
+// still missing in libc++ 19
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+using namespace eosio;
+using namespace eosio::chain;
+
+namespace eosio::chain_apis {
+   /**
+    * Implementation details of the read snapshots
+    */
+   struct read_snapshot_db_impl {
+      explicit read_snapshot_db_impl(const chain::controller& controller)
+         : controller(controller) {}
+
+      void on_accepted_block() {
+         try {
+            // In IRREVERSIBLE mode the head only moves with the irreversible block, see on_irreversible_block()
+            if (controller.get_read_mode() != db_read_mode::IRREVERSIBLE) {
+               publish();
+            }
+         } FC_LOG_AND_DROP(("read_snapshot_db_impl on_accepted_block ERROR"));
+      }
+
+      void on_irreversible_block() {
+         try {
+            if (controller.get_read_mode() == db_read_mode::IRREVERSIBLE) {
+               publish();
+            }
+         } FC_LOG_AND_DROP(("read_snapshot_db_impl on_irreversible_block ERROR"));
+      }
+
+      void publish() {
+         const auto& head = controller.head();
+         if (!head.is_valid())
+            return;
+
+         auto snapshot = std::make_shared<read_snapshot_db::read_snapshot>();
+
+         snapshot->head_block_id   = head.id();
+         snapshot->head_block_num  = head.block_num();
+         snapshot->head_block_time = head.block_time();
+
+         const auto& gpo = controller.get_global_properties();
+         snapshot->chain_config = gpo.configuration;
+         if (controller.is_builtin_activated(builtin_protocol_feature_t::configurable_wasm_limits)) {
+            snapshot->wasm_config = gpo.wasm_configuration;
+         }
+
+         to_variant(controller.active_producers(), snapshot->active_producers);
+         if (const auto* pending = controller.pending_producers())
+            to_variant(*pending, snapshot->pending_producers);
+         auto proposed = controller.proposed_producers_legacy(); // empty for savanna
+         if (proposed && !proposed->producers.empty())
+            to_variant(*proposed, snapshot->proposed_producers);
+
+         snapshot->active_finalizer_policy  = controller.head_active_finalizer_policy();
+         snapshot->pending_finalizer_policy = controller.head_pending_finalizer_policy();
+
+         std::atomic_store(&current, read_snapshot_db::read_snapshot_ptr{std::move(snapshot)}); // replace current snapshot safely
+      }
+
+      read_snapshot_db::read_snapshot_ptr get_snapshot() const {
+         return std::atomic_load(&current);
+      }
+
+   private:
+      // A handle to the controller.
+      const chain::controller& controller;
+
+      // The last published snapshot.
+      // Using std::atomic_load and std::atomic_store to switch pointers.
+      read_snapshot_db::read_snapshot_ptr current;
+   }; // read_snapshot_db_impl
+
+   read_snapshot_db::read_snapshot_db( const chain::controller& controller )
+      :_impl(std::make_unique<read_snapshot_db_impl>(controller)) {}
+
+   read_snapshot_db::~read_snapshot_db() = default;
+
+   void read_snapshot_db::on_accepted_block() {
+      _impl->on_accepted_block();
+   }
+
+   void read_snapshot_db::on_irreversible_block() {
+      _impl->on_irreversible_block();
+   }
+
+   void read_snapshot_db::publish() {
+      _impl->publish();
+   }
+
+   read_snapshot_db::read_snapshot_ptr read_snapshot_db::get_snapshot() const {
+      return _impl->get_snapshot();
+   }
+} // namespace eosio::chain_apis
+
+#pragma GCC diagnostic pop
@@ -39,3 +39,20 @@ BOOST_AUTO_TEST_CASE(chain_plugin_eos_vm_oc_whitelist) {
    BOOST_CHECK(plugin.chain().is_eos_vm_oc_whitelisted(eosio::chain::name{"xs.hello"}));
    BOOST_CHECK(!plugin.chain().is_eos_vm_oc_whitelisted(eosio::chain::name{"xsat"}));
 }
+
+BOOST_AUTO_TEST_CASE(chain_plugin_thread_cpu_affinity_unknown_pool) {
+   fc::temp_directory  tmp;
+   appbase::scoped_app app;
+
+   auto tmp_path = tmp.path().string();
+   std::array          args = {
+      "test_chain_plugin", "--thread-cpu-affinity", "reads=0", "--data-dir", tmp_path.c_str(),
+   };
+
+   // a misspelled pool name fails the configuration instead of pinning nothing
+   bool result = false;
+   try {
+      result = app->initialize<eosio::chain_plugin>(args.size(), const_cast<char**>(args.data()));
+   } catch(...) {}
+   BOOST_CHECK(!result);
+}
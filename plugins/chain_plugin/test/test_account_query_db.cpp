@@ -4,6 +4,7 @@
 #include <eosio/chain/types.hpp>
 #include <eosio/chain_plugin/account_query_db.hpp>
 #include <eosio/chain/thread_utils.hpp>
+#include <fc/io/json.hpp>
 
 using namespace eosio;
 using namespace eosio::chain;
@@ -143,6 +144,82 @@ BOOST_FIXTURE_TEST_CASE(updateauth_test_multi_threaded, validating_tester) { try
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_FIXTURE_TEST_CASE(persistence_test, validating_tester) { try {
+
+   std::vector<account_name> accounts;
+   for (char c = 'a'; c <= 'z'; ++c) {
+      accounts.emplace_back(std::string("acct") + c);
+      accounts.emplace_back(std::string("user") + c);
+   }
+   create_accounts(accounts);
+   produce_block();
+
+   // permissions sharing a key and delegating to other accounts
+   for (size_t i = 0; i < accounts.size(); i += 3) {
+      authority auth(1, {key_weight{get_public_key("shared"_n, "active"), 1}},
+                     {permission_level_weight{{accounts[(i + 1) % accounts.size()], config::active_name}, 1}});
+      push_action(config::system_account_name, updateauth::get_name(), accounts[i], fc::mutable_variant_object()
+                  ("account", accounts[i])
+                  ("permission", "role"_n)
+                  ("parent", "active")
+                  ("auth", auth));
+   }
+   produce_block();
+
+   params pars;
+   pars.keys.emplace_back(get_public_key("shared"_n, "active"));
+   for (const auto& a : accounts) {
+      pars.keys.emplace_back(get_public_key(a, "owner"));
+      pars.accounts.push_back({{a, {}}});
+   }
+   auto to_json = [](const results& r) { return fc::json::to_string(fc::variant(r), fc::time_point::maximum()); };
+
+   fc::temp_directory tmp;
+   const auto file = tmp.path() / "account_query_db.dat";
+
+   auto timed = [](const char* what, auto&& f) {
+      auto start = fc::time_point::now();
+      f();
+      BOOST_TEST_MESSAGE("account query DB " << what << " in " << (fc::time_point::now() - start).count() << "us");
+   };
+
+   std::optional<account_query_db> built, loaded;
+   timed("built", [&]() { built.emplace(*control, file); });
+   timed("saved", [&]() { built->save(file); });
+   BOOST_TEST(std::filesystem::exists(file));
+   timed("loaded", [&]() { loaded.emplace(*control, file); });
+   BOOST_TEST(!std::filesystem::exists(file));
+
+   results expected;
+   timed("queried", [&]() { expected = built->get_accounts_by_authorizers(pars); });
+   BOOST_TEST(find_account_auth(expected, accounts[0], "role"_n));
+   BOOST_TEST(expected.accounts.size() > accounts.size());
+   BOOST_TEST(to_json(loaded->get_accounts_by_authorizers(pars)) == to_json(expected));
+
+   // saved before head moved, rebuilt from the chain state instead of loaded
+   loaded->save(file);
+   push_action(config::system_account_name, updateauth::get_name(), accounts[1], fc::mutable_variant_object()
+               ("account", accounts[1])
+               ("permission", "role"_n)
+               ("parent", "active")
+               ("auth", authority(get_public_key("shared"_n, "active"))));
+   produce_block();
+
+   std::optional<account_query_db> stale;
+   stale.emplace(*control, file);
+   BOOST_TEST(!std::filesystem::exists(file));
+   const auto rebuilt = stale->get_accounts_by_authorizers(pars);
+   BOOST_TEST(find_account_auth(rebuilt, accounts[1], "role"_n));
+   BOOST_TEST(rebuilt.accounts.size() == expected.accounts.size() + 1);
+
+   // unreadable file is ignored
+   fc::json::save_to_file(fc::variant("garbage"), file);
+   std::optional<account_query_db> corrupt;
+   corrupt.emplace(*control, file);
+   BOOST_TEST(to_json(corrupt->get_accounts_by_authorizers(pars)) == to_json(rebuilt));
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE(future_fork_test) { try {
    tester node_a(setup_policy::none);
    tester node_b(setup_policy::none);
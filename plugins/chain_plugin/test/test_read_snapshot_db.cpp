@@ -0,0 +1,96 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/testing/tester.hpp>
+#include <eosio/chain_plugin/chain_plugin.hpp>
+#include <eosio/chain_plugin/read_snapshot_db.hpp>
+#include <eosio/chain/thread_utils.hpp>
+
+#include <atomic>
+
+using namespace eosio;
+using namespace eosio::chain;
+using namespace eosio::testing;
+using namespace eosio::chain_apis;
+
+BOOST_AUTO_TEST_SUITE(read_snapshot_db_tests)
+
+BOOST_FIXTURE_TEST_CASE(snapshot_follows_head_test, legacy_validating_tester) { try {
+
+   read_snapshot_db rs_db(*control);
+   BOOST_TEST(!rs_db.get_snapshot());
+
+   rs_db.publish();
+   BOOST_TEST_REQUIRE(!!rs_db.get_snapshot());
+   BOOST_TEST(rs_db.get_snapshot()->head_block_num == control->head().block_num());
+
+   //link rs_db to the `accepted_block` signal on the controller
+   auto c = control->accepted_block().connect([&](const block_signal_params&) {
+      rs_db.on_accepted_block();
+   });
+
+   create_accounts({"alice"_n, "bob"_n});
+   set_producers_legacy({"alice"_n, "bob"_n});
+   produce_block();
+
+   std::optional<tracked_votes> _tracked_votes;
+   read_only plugin(*control, {}, {}, _tracked_votes, fc::microseconds::maximum(), fc::microseconds::maximum(), {});
+   read_only snapshot_plugin(*control, {}, {}, _tracked_votes, fc::microseconds::maximum(), fc::microseconds::maximum(), {}, &rs_db);
+
+   for (uint32_t i = 0; i < 3 * config::producer_repetitions; ++i) {
+      const auto snapshot = rs_db.get_snapshot();
+      BOOST_TEST(snapshot->head_block_num == control->head().block_num());
+      BOOST_TEST(snapshot->head_block_id == control->head().id());
+
+      const auto schedule          = plugin.get_producer_schedule({}, fc::time_point::maximum());
+      const auto snapshot_schedule = snapshot_plugin.get_producer_schedule({}, fc::time_point::maximum());
+      BOOST_TEST(fc::json::to_string(schedule, fc::time_point::maximum()) == fc::json::to_string(snapshot_schedule, fc::time_point::maximum()));
+
+      const auto params          = plugin.get_consensus_parameters({}, fc::time_point::maximum());
+      const auto snapshot_params = snapshot_plugin.get_consensus_parameters({}, fc::time_point::maximum());
+      BOOST_TEST(fc::json::to_string(params, fc::time_point::maximum()) == fc::json::to_string(snapshot_params, fc::time_point::maximum()));
+
+      produce_block();
+   }
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_FIXTURE_TEST_CASE(snapshot_read_while_applying_test, validating_tester) { try {
+
+   read_snapshot_db rs_db(*control);
+   rs_db.publish();
+
+   auto c = control->accepted_block().connect([&](const block_signal_params&) {
+      rs_db.on_accepted_block();
+   });
+
+   named_thread_pool<struct test> thread_pool;
+   thread_pool.start( 4, {} );
+
+   // readers never see a snapshot older than one they have already seen, nor one that is partially published
+   std::atomic<bool> done = false;
+   std::atomic<uint32_t> errors = 0;
+   for( size_t i = 0; i < 4; ++i ) {
+      boost::asio::post( thread_pool.get_executor(), [&]() {
+         uint32_t last_num = 0;
+         while( !done ) {
+            const auto snapshot = rs_db.get_snapshot();
+            if( snapshot->head_block_num < last_num || block_header::num_from_id(snapshot->head_block_id) != snapshot->head_block_num )
+               ++errors;
+            last_num = snapshot->head_block_num;
+         }
+      } );
+   }
+
+   for( size_t i = 0; i < 50; ++i ) {
+      create_account(name("acct" + std::string(1, char('a' + i / 26)) + std::string(1, char('a' + i % 26))));
+      produce_block();
+   }
+
+   done = true;
+   thread_pool.stop();
+
+   BOOST_TEST(errors.load() == 0u);
+   BOOST_TEST(rs_db.get_snapshot()->head_block_num == control->head().block_num());
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,7 +18,9 @@ namespace eosio::chain_apis {
 
       // Cache to store last vote information for each known finalizer.
       // A map of finalizer public key --> vote info.
-      std::map<fc::crypto::blslib::bls_public_key, tracked_votes::vote_info> last_votes;
+      // Written on the main thread, read by get_finalizer_info on the http thread pool.
+      mutable std::shared_mutex mtx;
+      std::map<fc::crypto::blslib::bls_public_key, tracked_votes::vote_info> last_votes; // guarded by mtx
 
       // A handle to the controller.
       const chain::controller& controller;
@@ -54,6 +56,7 @@ namespace eosio::chain_apis {
                chain::qc_vote_metrics_t vm = controller.vote_metrics(id, qc_ext.qc);
 
                if (tracking_enabled) {
+                  std::unique_lock g(mtx);
                   auto track_votes = [&](const chain::qc_vote_metrics_t::fin_auth_set_t& finalizers, bool is_strong) {
                      for (auto& f: finalizers) {
                         assert(f.fin_auth);
@@ -87,6 +90,7 @@ namespace eosio::chain_apis {
 
       // Returns last vote information by a given finalizer
       std::optional<tracked_votes::vote_info> get_last_vote_info(const fc::crypto::blslib::bls_public_key& finalizer_pub_key) const {
+         std::shared_lock g(mtx);
          auto it = last_votes.find(finalizer_pub_key);
          if (it != last_votes.end()) {
              return it->second;
@@ -8,6 +8,7 @@
 #include <eosio/chain/application.hpp>
 #include <eosio/chain/plugin_interface.hpp>
 
+#include <fc/container/expiry_wheel.hpp>
 #include <fc/container/tracked_storage.hpp>
 
 #include <boost/multi_index_container.hpp>
@@ -56,7 +57,6 @@ struct tracked_transaction {
 };
 
 struct by_trx_id;
-struct by_expiry;
 struct by_ready_block_num;
 struct by_block_num;
 struct by_last_try;
@@ -66,9 +66,6 @@ using tracked_transaction_index_t = multi_index_container<tracked_transaction,
             hashed_unique<tag<by_trx_id>,
                   const_mem_fun<tracked_transaction, const transaction_id_type&, &tracked_transaction::id>, std::hash<transaction_id_type>
             >,
-            ordered_non_unique<tag<by_expiry>,
-                  const_mem_fun<tracked_transaction, fc::time_point_sec, &tracked_transaction::expiry>
-            >,
             ordered_non_unique<tag<by_ready_block_num>,
                   const_mem_fun<tracked_transaction, uint32_t, &tracked_transaction::ready_block_num>
             >,
@@ -81,6 +78,9 @@ using tracked_transaction_index_t = multi_index_container<tracked_transaction,
       >
 >;
 
+// expiration is only needed to purge expired trxs, tracked outside of the multi_index to avoid an ordered index
+using tracked_transaction_expiry_t = fc::expiry_wheel<transaction_id_type, tracked_transaction_index_t::iterator>;
+
 } // anonymous namespace
 
 namespace eosio::chain_apis {
@@ -110,12 +110,14 @@ struct trx_retry_db_impl {
                   "Transaction exceeded  transaction-retry-max-storage-size-gb limit: ${m} bytes", ("m", _tracked_trxs.memory_size()) );
       auto i = _tracked_trxs.index().get<by_trx_id>().find( ptrx->id() );
       if( i == _tracked_trxs.index().end() ) {
-         _tracked_trxs.insert( {std::move(ptrx),
-                                !num_blocks.has_value() ? lib_totem : *num_blocks,
-                                0,
-                                {},
-                                fc::time_point::now(),
-                                std::move(next)} );
+         auto [itr, inserted] = _tracked_trxs.insert( {std::move(ptrx),
+                                                       !num_blocks.has_value() ? lib_totem : *num_blocks,
+                                                       0,
+                                                       {},
+                                                       fc::time_point::now(),
+                                                       std::move(next)} );
+         if( inserted )
+            _expiry.try_emplace( itr->id(), itr->expiry().to_time_point(), itr );
       } else {
          // already tracking transaction
       }
@@ -238,6 +240,7 @@ private:
             tt.next( std::make_unique<fc::variant>( std::move( tt.trx_trace_v ) ) );
             tt.trx_trace_v.clear();
          } );
+         _expiry.erase( i->id() );
          _tracked_trxs.erase( i );
       }
    }
@@ -256,25 +259,21 @@ private:
             tt.next( std::make_unique<fc::variant>( std::move( tt.trx_trace_v ) ) );
             tt.trx_trace_v.clear();
          } );
+         _expiry.erase( i->id() );
          _tracked_trxs.erase( i );
       }
    }
 
    void clear_expired(const block_timestamp_type& block_timestamp) {
       const fc::time_point block_time = block_timestamp;
-      auto& idx = _tracked_trxs.index().get<by_expiry>();
-      while( !idx.empty() ) {
-         auto itr = idx.begin();
-         if( itr->expiry().to_time_point() > block_time ) {
-            break;
-         }
+      _expiry.expire( block_time, [&]( const transaction_id_type&, tracked_transaction_index_t::iterator itr ) {
          itr->next( std::static_pointer_cast<fc::exception>(
                std::make_shared<expired_tx_exception>(
                      FC_LOG_MESSAGE( error, "expired retry transaction ${id}, expiration ${e}, block time ${bt}",
                                      ("id", itr->id())("e", itr->ptrx->expiration())
                                      ("bt", block_timestamp) ) ) ) );
-         _tracked_trxs.erase( _tracked_trxs.index().project<0>( itr ) );
-      }
+         _tracked_trxs.erase( itr );
+      } );
    }
 
 private:
@@ -285,6 +284,7 @@ private:
    const fc::microseconds _retry_interval; ///< how often to resend not seen transactions
    const fc::microseconds _max_expiration_time; ///< limit to expiration on transactions that are tracked
    fc::tracked_storage<tracked_transaction_index_t> _tracked_trxs;
+   tracked_transaction_expiry_t _expiry; ///< expiration of _tracked_trxs
 };
 
 trx_retry_db::trx_retry_db( const chain::controller& controller, size_t max_mem_usage_size,
@@ -136,7 +136,7 @@ namespace eosio {
           * @param to_queue - execution queue to post to
           * @param next - the next handler for responses
           * @param my - the http_plugin_impl
-          * @param content_type - json or plain txt
+          * @param content_type - json, newline delimited json or plain txt
           * @return the constructed internal_url_handler
           */
          static detail::internal_url_handler make_app_thread_url_handler(api_entry&& entry, appbase::exec_queue to_queue, int priority, http_content_type content_type ) {
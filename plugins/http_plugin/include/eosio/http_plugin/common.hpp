@@ -144,6 +144,20 @@ struct http_plugin_state {
 
 };
 
+/**
+* Newline delimited JSON, one line per element of an array response. Any other response, e.g. an error, is one line.
+*/
+inline std::string to_ndjson(const fc::variant& response) {
+   if (!response.is_array())
+      return fc::json::to_string(response, fc::time_point::maximum()) + '\n';
+   std::string result;
+   for (const auto& v : response.get_array()) {
+      result += fc::json::to_string(v, fc::time_point::maximum());
+      result += '\n';
+   }
+   return result;
+}
+
 /**
 * Construct a lambda appropriate for url_response_callback that will
 * JSON-stringify the provided response
@@ -170,7 +184,9 @@ inline auto make_http_response_handler(http_plugin_state& plugin_state, detail::
 
                            try {
                               if (response.has_value()) {
-                                 std::string json = (content_type == http_content_type::plaintext) ? response->as_string() : fc::json::to_string(*response, fc::time_point::maximum());
+                                 std::string json = (content_type == http_content_type::plaintext) ? response->as_string()
+                                                  : (content_type == http_content_type::ndjson)  ? to_ndjson(*response)
+                                                  : fc::json::to_string(*response, fc::time_point::maximum());
                                  if (auto error_str = session_ptr->verify_max_bytes_in_flight(json.size()); error_str.empty())
                                     session_ptr->send_response(std::move(json), code);
                                  else
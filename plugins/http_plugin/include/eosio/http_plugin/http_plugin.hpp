@@ -46,7 +46,8 @@ namespace eosio {
 
    enum class http_content_type {
       json = 1,
-      plaintext = 2
+      plaintext = 2,
+      ndjson = 3 // response is an array, each element sent as a JSON document on its own line
    };
 
    struct http_plugin_defaults {
@@ -59,6 +59,8 @@ namespace eosio {
                size_t block_sync_bytes_received{0};
                size_t block_sync_bytes_sent{0};
                bool block_sync_throttling{false};
+               size_t writes{0};
+               size_t write_buffers{0};
                std::chrono::nanoseconds connection_start_time{0};
                std::string p2p_address;
                std::string unique_conn_node_id;
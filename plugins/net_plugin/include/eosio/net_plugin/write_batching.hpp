@@ -0,0 +1,109 @@
+#pragma once
+#include <eosio/chain/thread_utils.hpp>
+#include <fc/mutex.hpp>
+#include <boost/asio/buffer.hpp>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace eosio {
+
+   constexpr auto     def_send_slab_size = 16*1024;         // small queued messages are coalesced into slabs of this size
+   constexpr auto     def_max_coalesce_msg_size = 1024;     // larger messages are written from their own buffer
+   constexpr auto     def_max_free_send_slabs = 4;          // slabs kept per connection for reuse
+
+   /// Small messages, votes, notices, time messages, are copied into a send slab instead of being handed to the
+   /// socket as one buffer each, so that a write of many small messages gathers a few cache-aligned buffers.
+   struct alignas(chain::hardware_destructive_interference_sz) send_slab {
+      size_t                              size = 0;
+      std::array<char, def_send_slab_size> data;
+
+      bool append( const std::vector<char>& b ) {
+         if( b.size() > data.size() - size )
+            return false;
+         memcpy( data.data() + size, b.data(), b.size() );
+         size += b.size();
+         return true;
+      }
+   };
+   using send_slab_ptr = std::unique_ptr<send_slab>;
+
+   /// Gathers the messages of a write into buffers, in order. Messages of at most def_max_coalesce_msg_size are
+   /// copied into send slabs, consecutive ones sharing a slab until it is full. Not thread safe.
+   class send_slab_pool {
+   public:
+      /// Appends msg to the buffers of the write after the messages already gathered into bufs
+      /// @return true if msg was copied into a slab, its buffer need not be kept until the write completes
+      bool gather( std::vector<boost::asio::const_buffer>& bufs, const std::vector<char>& msg ) {
+         if( msg.size() > def_max_coalesce_msg_size ) {
+            bufs.emplace_back( msg.data(), msg.size() );
+            return false;
+         }
+         send_slab* slab = bufs.empty() || _out_slabs.empty() ? nullptr : _out_slabs.back().get();
+         if( !slab || bufs.back().data() != slab->data.data() || !slab->append( msg ) ) {
+            slab = get_slab();
+            slab->append( msg );
+            bufs.emplace_back();
+         }
+         bufs.back() = boost::asio::const_buffer( slab->data.data(), slab->size );
+         return true;
+      }
+
+      /// Called once the write of the gathered buffers completed or failed, keeps up to def_max_free_send_slabs
+      void release() {
+         for( auto& s : _out_slabs ) {
+            if( _free_slabs.size() >= def_max_free_send_slabs )
+               break;
+            s->size = 0;
+            _free_slabs.emplace_back( std::move(s) );
+         }
+         _out_slabs.clear();
+      }
+
+      size_t out_slabs() const { return _out_slabs.size(); }
+      size_t free_slabs() const { return _free_slabs.size(); }
+
+   private:
+      send_slab* get_slab() {
+         if( _free_slabs.empty() ) {
+            _out_slabs.emplace_back( std::make_unique<send_slab>() );
+         } else {
+            _out_slabs.emplace_back( std::move(_free_slabs.back()) );
+            _free_slabs.pop_back();
+         }
+         return _out_slabs.back().get();
+      }
+
+      std::vector<send_slab_ptr> _out_slabs;  // slabs of the write in progress
+      std::vector<send_slab_ptr> _free_slabs; // pool of slabs for reuse
+   };
+
+   /// Items added from any thread and taken together, so that a burst of items for a peer, e.g. votes, is handled
+   /// by one strand handler rather than one handler per item. Thread safe.
+   template <typename T>
+   class pending_batch {
+   public:
+      /// @return true if the batch was empty, the caller schedules a take() which will include item
+      bool add( T item ) {
+         fc::lock_guard g( _mtx );
+         _items.emplace_back( std::move(item) );
+         return _items.size() == 1;
+      }
+
+      /// @return the items added since the last take, in the order they were added
+      std::vector<T> take() {
+         std::vector<T> items;
+         fc::lock_guard g( _mtx );
+         items.swap( _items );
+         return items;
+      }
+
+   private:
+      alignas(chain::hardware_destructive_interference_sz)
+      fc::mutex      _mtx;
+      std::vector<T> _items GUARDED_BY(_mtx);
+   };
+
+} // namespace eosio
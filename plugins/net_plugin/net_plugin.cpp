@@ -2,6 +2,7 @@
 #include <eosio/net_plugin/protocol.hpp>
 #include <eosio/net_plugin/net_utils.hpp>
 #include <eosio/net_plugin/auto_bp_peering.hpp>
+#include <eosio/net_plugin/write_batching.hpp>
 #include <eosio/chain/types.hpp>
 #include <eosio/chain/controller.hpp>
 #include <eosio/chain/exceptions.hpp>
@@ -22,14 +23,17 @@
 #include <fc/time.hpp>
 #include <fc/mutex.hpp>
 #include <fc/network/listener.hpp>
+#include <fc/container/expiry_wheel.hpp>
 
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ip/host_name.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/multi_index/key.hpp>
 
+#include <array>
 #include <atomic>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <new>
 
@@ -89,30 +93,11 @@ namespace eosio {
    }
 
    struct node_transaction_state {
-      transaction_id_type id;
-      time_point_sec  expires;        /// time after which this may be purged.
-      uint32_t        connection_id = 0;
+      std::vector<uint32_t> connection_ids; /// connections the transaction has been received from
    };
 
-   struct by_expiry;
-
-   typedef multi_index_container<
-      node_transaction_state,
-      indexed_by<
-         ordered_unique<
-            tag<by_id>,
-            composite_key< node_transaction_state,
-               member<node_transaction_state, transaction_id_type, &node_transaction_state::id>,
-               member<node_transaction_state, uint32_t, &node_transaction_state::connection_id>
-            >,
-            composite_key_compare< std::less<transaction_id_type>, std::less<> >
-         >,
-         ordered_non_unique<
-            tag< by_expiry >,
-            member< node_transaction_state, fc::time_point_sec, &node_transaction_state::expires > >
-         >
-      >
-   node_transaction_index;
+   /// keyed by transaction id, expires at the latest expiration of any connection, after which it may be purged
+   using node_transaction_index = fc::expiry_wheel<transaction_id_type, node_transaction_state>;
 
    struct peer_block_state {
       block_id_type id;
@@ -650,6 +635,7 @@ namespace eosio {
          _trx_write_queue.clear();
          _write_queue_size = 0;
          _out_queue.clear();
+         _slabs.release();
       }
 
       void clear_write_queue() {
@@ -664,6 +650,7 @@ namespace eosio {
          fc::lock_guard g( _mtx );
          out_callback( ec, number_of_bytes_written );
          _out_queue.clear();
+         _slabs.release();
       }
 
       uint32_t write_queue_size() const {
@@ -723,9 +710,11 @@ namespace eosio {
                             deque<queued_write>& w_queue ) REQUIRES(_mtx) {
          while ( !w_queue.empty() ) {
             auto& m = w_queue.front();
-            bufs.emplace_back( m.buff->data(), m.buff->size() );
-            _write_queue_size -= m.buff->size();
-            _out_queue.emplace_back( m );
+            const size_t size = m.buff->size();
+            if( _slabs.gather( bufs, *m.buff ) )
+               m.buff.reset(); // copied, no need to keep it until the write completes
+            _write_queue_size -= size;
+            _out_queue.emplace_back( std::move(m) );
             w_queue.pop_front();
          }
       }
@@ -749,6 +738,7 @@ namespace eosio {
       deque<queued_write> _sync_write_queue GUARDED_BY(_mtx); // sync_write_queue blocks will be sent first
       deque<queued_write> _trx_write_queue  GUARDED_BY(_mtx); // queued trx messages, trx_write_queue will be sent last
       deque<queued_write> _out_queue        GUARDED_BY(_mtx); // currently being async_write
+      send_slab_pool      _slabs            GUARDED_BY(_mtx); // slabs of coalesced _out_queue messages
 
    }; // queued_buffer
 
@@ -833,6 +823,8 @@ namespace eosio {
       std::chrono::nanoseconds get_last_bytes_sent() const { return last_bytes_sent.load(); }
       size_t get_block_sync_bytes_received() const { return block_sync_bytes_received.load(); }
       size_t get_block_sync_bytes_sent() const { return block_sync_total_bytes_sent.load(); }
+      size_t get_writes() const { return writes.load(); }
+      size_t get_write_buffers() const { return write_buffers.load(); }
       bool get_block_sync_throttling() const { return block_sync_throttling.load(); }
       boost::asio::ip::port_type get_remote_endpoint_port() const { return remote_endpoint_port.load(); }
       void set_heartbeat_timeout(std::chrono::milliseconds msec) {
@@ -876,7 +868,12 @@ namespace eosio {
       size_t                          block_sync_frame_bytes_sent{0}; // bytes sent in this set of enqueue blocks
       std::atomic<bool>               block_sync_throttling{false};
       std::atomic<std::chrono::nanoseconds>   last_bytes_sent{0ns};
+      std::atomic<size_t>             writes{0};         // completed socket writes, each a gather write of the out queue
+      std::atomic<size_t>             write_buffers{0};  // buffers gathered into those writes
       std::atomic<boost::asio::ip::port_type> remote_endpoint_port{0};
+      bool                            write_flush_pending{false}; // accessed only from strand threads
+
+      pending_batch<send_buffer_type> pending_votes; // votes waiting for a strand turn
 
    public:
       boost::asio::strand<tcp::socket::executor_type> strand;
@@ -1037,6 +1034,7 @@ namespace eosio {
                            queued_buffer::queue_t queue,
                            const std::shared_ptr<std::vector<char>>& send_buffer,
                            go_away_reason close_after_send);
+      void enqueue_vote( const send_buffer_type& msg );
       void cancel_sync();
       void flush_queues();
       bool enqueue_sync_block();
@@ -1681,6 +1679,18 @@ namespace eosio {
          close();
          return;
       }
+      if( buff->size() <= def_max_coalesce_msg_size && buffer_queue.write_queue_size() < def_send_slab_size ) {
+         // Let the handlers already queued on the strand, e.g. a batch of votes, add their small messages to the same
+         // write. Delays the write by at most one pass over the strand queue, a full slab is written right away.
+         if( !write_flush_pending ) {
+            write_flush_pending = true;
+            boost::asio::post( strand, [c=shared_from_this()]() {
+               c->write_flush_pending = false;
+               c->do_queue_write(std::nullopt);
+            });
+         }
+         return;
+      }
       do_queue_write(block_num);
    }
 
@@ -1699,6 +1709,7 @@ namespace eosio {
 
       std::vector<boost::asio::const_buffer> bufs;
       buffer_queue.fill_out_buffer( bufs );
+      write_buffers += bufs.size();
 
       boost::asio::async_write( *socket, bufs,
          boost::asio::bind_executor( strand, [c=shared_from_this(), socket=socket]( boost::system::error_code ec, std::size_t w ) {
@@ -1730,6 +1741,7 @@ namespace eosio {
                return;
             }
             c->bytes_sent += w;
+            ++c->writes;
             c->last_bytes_sent = c->get_time();
 
             c->buffer_queue.clear_out_queue(ec, w);
@@ -1967,6 +1979,21 @@ namespace eosio {
       enqueue_buffer( to_msg_type_t(m.index()), std::nullopt, queued_buffer::queue_t::general, send_buffer, close_after_send );
    }
 
+   // thread safe
+   void connection::enqueue_vote( const send_buffer_type& msg ) {
+      if( !pending_votes.add( msg ) ) // already posted, the strand handler sends this vote along with the others
+         return;
+
+      boost::asio::post(strand, [c=shared_from_this()]() {
+         vector<send_buffer_type> votes = c->pending_votes.take();
+         if (vote_logger.is_enabled(fc::log_level::debug))
+            peer_dlog(c, "sending ${n} vote msgs", ("n", votes.size()));
+         for( const auto& v : votes ) {
+            c->enqueue_buffer( msg_type_t::vote_message, std::nullopt, queued_buffer::queue_t::general, v, no_reason );
+         }
+      });
+   }
+
    // called from connection strand
    size_t connection::enqueue_block( const std::vector<char>& b, uint32_t block_num, queued_buffer::queue_t queue ) {
       peer_dlog( this, "enqueue block ${num}", ("num", block_num) );
@@ -2771,24 +2798,23 @@ namespace eosio {
    bool dispatch_manager::add_peer_txn( const transaction_id_type& id, const time_point_sec& trx_expires,
                                         uint32_t connection_id, const time_point_sec& now ) {
       fc::lock_guard g( local_txns_mtx );
-      auto tptr = local_txns.get<by_id>().find( std::make_tuple( std::ref( id ), connection_id ) );
-      bool added = (tptr == local_txns.end());
+      // expire at either transaction expiration or configured max expire time whichever is less
+      time_point_sec expires{now.to_time_point() + my_impl->p2p_dedup_cache_expire_time_us};
+      expires = std::min( trx_expires, expires );
+      auto [tptr, inserted] = local_txns.try_emplace( id, expires.to_time_point() );
+      auto& conns = tptr->connection_ids;
+      bool added = inserted || std::find( conns.begin(), conns.end(), connection_id ) == conns.end();
       if( added ) {
-         // expire at either transaction expiration or configured max expire time whichever is less
-         time_point_sec expires{now.to_time_point() + my_impl->p2p_dedup_cache_expire_time_us};
-         expires = std::min( trx_expires, expires );
-         local_txns.insert( node_transaction_state{
-            .id = id,
-            .expires = expires,
-            .connection_id = connection_id} );
+         conns.push_back( connection_id );
+         if( !inserted && expires.to_time_point() > local_txns.expiry_of( id ) )
+            local_txns.set_expiry( id, expires.to_time_point() );
       }
       return added;
    }
 
    bool dispatch_manager::have_txn( const transaction_id_type& tid ) const {
       fc::lock_guard g( local_txns_mtx );
-      const auto tptr = local_txns.get<by_id>().find( tid );
-      return tptr != local_txns.end();
+      return local_txns.contains( tid );
    }
 
    void dispatch_manager::expire_txns() {
@@ -2797,10 +2823,8 @@ namespace eosio {
 
       fc::unique_lock g( local_txns_mtx );
       start_size = local_txns.size();
-      auto& old = local_txns.get<by_expiry>();
-      auto ex_lo = old.lower_bound( fc::time_point_sec( 0 ) );
-      auto ex_up = old.upper_bound( now );
-      old.erase( ex_lo, ex_up );
+      local_txns.expire( now.to_time_point() );
+      end_size = local_txns.size();
       g.unlock();
 
       fc_dlog( logger, "expire_local_txns size ${s} removed ${r}", ("s", start_size)( "r", start_size - end_size ) );
@@ -2864,11 +2888,7 @@ namespace eosio {
          if( !cp->current() ) return true;
          if( cp->connection_id == exclude_peer ) return true;
          if (cp->protocol_version < proto_savanna) return true;
-         boost::asio::post(cp->strand, [cp, msg]() {
-            if (vote_logger.is_enabled(fc::log_level::debug))
-               peer_dlog(cp, "sending vote msg");
-            cp->enqueue_buffer( msg_type_t::vote_message, std::nullopt, queued_buffer::queue_t::general, msg, no_reason );
-         });
+         cp->enqueue_vote( msg );
          return true;
       } );
    }
@@ -5089,6 +5109,8 @@ namespace eosio {
             , .block_sync_bytes_received = c->get_block_sync_bytes_received()
             , .block_sync_bytes_sent = c->get_block_sync_bytes_sent()
             , .block_sync_throttling = c->get_block_sync_throttling()
+            , .writes = c->get_writes()
+            , .write_buffers = c->get_write_buffers()
             , .connection_start_time = c->connection_start_time
             , .p2p_address = p2p_addr
             , .unique_conn_node_id = conn_node_id
@@ -0,0 +1,203 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/net_plugin/write_batching.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <random>
+#include <thread>
+
+using namespace eosio;
+
+namespace {
+
+// message of size bytes framed as on the p2p wire: 4 byte length followed by the payload, payload bytes derived from id
+std::vector<char> make_msg(uint32_t id, uint32_t size) {
+   std::vector<char> msg(size);
+   const uint32_t payload_size = size - sizeof(uint32_t);
+   memcpy(msg.data(), &payload_size, sizeof(payload_size));
+   for (uint32_t i = sizeof(uint32_t); i < size; ++i)
+      msg[i] = static_cast<char>(id * 31 + i);
+   return msg;
+}
+
+std::vector<char> concat(const std::vector<boost::asio::const_buffer>& bufs) {
+   std::vector<char> result;
+   for (const auto& b : bufs)
+      result.insert(result.end(), static_cast<const char*>(b.data()), static_cast<const char*>(b.data()) + b.size());
+   return result;
+}
+
+// splits a stream of framed messages
+std::vector<std::vector<char>> split(const std::vector<char>& stream) {
+   std::vector<std::vector<char>> msgs;
+   for (size_t pos = 0; pos < stream.size();) {
+      uint32_t payload_size = 0;
+      BOOST_REQUIRE_LE(pos + sizeof(payload_size), stream.size());
+      memcpy(&payload_size, stream.data() + pos, sizeof(payload_size));
+      const size_t size = sizeof(payload_size) + payload_size;
+      BOOST_REQUIRE_LE(pos + size, stream.size());
+      msgs.emplace_back(stream.begin() + pos, stream.begin() + pos + size);
+      pos += size;
+   }
+   return msgs;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(write_batching)
+
+BOOST_AUTO_TEST_CASE(send_slab_pool_mixed_sizes) {
+   std::mt19937 rng(42);
+   std::uniform_int_distribution<uint32_t> small_size(sizeof(uint32_t) + 1, def_max_coalesce_msg_size);
+   std::uniform_int_distribution<uint32_t> large_size(def_max_coalesce_msg_size + 1, 2 * def_send_slab_size);
+
+   send_slab_pool pool;
+   for (uint32_t write = 0; write < 3; ++write) {
+      // runs of small messages spanning several slabs, broken by large ones
+      std::vector<std::vector<char>> msgs;
+      for (uint32_t i = 0; i < 200; ++i) {
+         const bool large = i % 50 == 49 || (write == 2 && i % 7 == 0);
+         msgs.push_back(make_msg(i, large ? large_size(rng) : small_size(rng)));
+      }
+      msgs.push_back(make_msg(200, def_max_coalesce_msg_size));     // largest coalesced
+      msgs.push_back(make_msg(201, def_max_coalesce_msg_size + 1)); // smallest not coalesced
+
+      std::vector<boost::asio::const_buffer> bufs;
+      size_t copied = 0;
+      for (const auto& m : msgs) {
+         if (pool.gather(bufs, m))
+            ++copied;
+      }
+
+      // same bytes in the same order, each message intact
+      BOOST_TEST(split(concat(bufs)) == msgs);
+
+      // large messages are written from their own buffer, small ones from slabs which they fill before the next one
+      size_t slab_bytes = 0, i = 0;
+      for (const auto& b : bufs) {
+         BOOST_REQUIRE_LT(i, msgs.size());
+         if (msgs[i].size() > def_max_coalesce_msg_size) {
+            BOOST_TEST(b.data() == msgs[i].data());
+            BOOST_TEST(b.size() == msgs[i].size());
+            ++i;
+            continue;
+         }
+         BOOST_TEST(b.size() <= def_send_slab_size);
+         size_t n = 0;
+         while (i < msgs.size() && msgs[i].size() <= def_max_coalesce_msg_size && n + msgs[i].size() <= b.size())
+            n += msgs[i++].size();
+         BOOST_TEST(n == b.size());
+         if (i < msgs.size() && msgs[i].size() <= def_max_coalesce_msg_size)
+            BOOST_TEST(b.size() + msgs[i].size() > def_send_slab_size); // next one did not fit
+         slab_bytes += b.size();
+      }
+      BOOST_TEST(i == msgs.size());
+      BOOST_TEST(copied == static_cast<size_t>(std::count_if(msgs.begin(), msgs.end(), [](const auto& m) {
+         return m.size() <= def_max_coalesce_msg_size; })));
+      BOOST_TEST(pool.out_slabs() > 1u);
+      BOOST_TEST(slab_bytes <= pool.out_slabs() * def_send_slab_size);
+
+      pool.release();
+      BOOST_TEST(pool.out_slabs() == 0u);
+      BOOST_TEST(pool.free_slabs() <= static_cast<size_t>(def_max_free_send_slabs));
+   }
+   BOOST_TEST(pool.free_slabs() == static_cast<size_t>(def_max_free_send_slabs));
+}
+
+BOOST_AUTO_TEST_CASE(send_slab_pool_new_write) {
+   send_slab_pool pool;
+   const auto m1 = make_msg(1, 100);
+   const auto m2 = make_msg(2, 100);
+
+   std::vector<boost::asio::const_buffer> first;
+   BOOST_TEST(pool.gather(first, m1));
+   pool.release();
+
+   // a new write does not append to the buffer of the previous one
+   std::vector<boost::asio::const_buffer> second;
+   BOOST_TEST(pool.gather(second, m2));
+   BOOST_REQUIRE(second.size() == 1u);
+   BOOST_TEST(split(concat(second)) == std::vector<std::vector<char>>{m2});
+}
+
+// votes broadcast from several threads to every connection, each connection draining its batch on its strand
+BOOST_AUTO_TEST_CASE(pending_batch_reaches_every_connection) {
+   constexpr uint32_t num_connections = 8;
+   constexpr uint32_t num_threads = 4;
+   constexpr uint32_t votes_per_thread = 2000;
+
+   struct connection {
+      explicit connection(boost::asio::io_context& ctx) : strand(ctx.get_executor()) {}
+
+      boost::asio::strand<boost::asio::io_context::executor_type> strand;
+      pending_batch<uint32_t> pending_votes;
+      std::vector<uint32_t>   received; // accessed only from strand
+      uint32_t                handlers = 0; // accessed only from strand
+   };
+
+   boost::asio::io_context ctx;
+   auto work = boost::asio::make_work_guard(ctx);
+   std::vector<std::unique_ptr<connection>> connections;
+   for (uint32_t i = 0; i < num_connections; ++i)
+      connections.emplace_back(std::make_unique<connection>(ctx));
+
+   std::vector<std::thread> strand_threads;
+   for (uint32_t i = 0; i < 2; ++i)
+      strand_threads.emplace_back([&ctx]() { ctx.run(); });
+
+   auto bcast_vote = [&](uint32_t vote) {
+      for (auto& c : connections) {
+         if (!c->pending_votes.add(vote))
+            continue;
+         boost::asio::post(c->strand, [c = c.get()]() {
+            auto votes = c->pending_votes.take();
+            c->received.insert(c->received.end(), votes.begin(), votes.end());
+            ++c->handlers;
+         });
+      }
+   };
+
+   std::vector<std::thread> producers;
+   for (uint32_t t = 0; t < num_threads; ++t) {
+      producers.emplace_back([&, t]() {
+         for (uint32_t v = 0; v < votes_per_thread; ++v)
+            bcast_vote(t * votes_per_thread + v);
+      });
+   }
+   for (auto& t : producers)
+      t.join();
+
+   // drained once every posted handler ran
+   for (auto& c : connections) {
+      std::promise<void> drained;
+      boost::asio::post(c->strand, [&drained]() { drained.set_value(); });
+      drained.get_future().wait();
+   }
+   work.reset();
+   for (auto& t : strand_threads)
+      t.join();
+
+   for (const auto& c : connections) {
+      BOOST_REQUIRE_EQUAL(c->received.size(), num_threads * votes_per_thread);
+      // every vote once, in the order each thread broadcast them
+      std::vector<uint32_t> last(num_threads, 0);
+      std::vector<bool> seen(num_threads * votes_per_thread, false);
+      for (uint32_t v : c->received) {
+         BOOST_REQUIRE(!seen.at(v));
+         seen[v] = true;
+         const uint32_t t = v / votes_per_thread;
+         BOOST_REQUIRE_GE(v, last[t]);
+         last[t] = v;
+      }
+      BOOST_TEST(c->handlers <= c->received.size());
+      BOOST_TEST_MESSAGE("connection received " << c->received.size() << " votes in " << c->handlers << " strand handlers");
+   }
+   BOOST_TEST(connections[0]->pending_votes.take().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
 #include <eosio/chain_plugin/chain_plugin.hpp>
 #include <eosio/chain/snapshot_scheduler.hpp>
 #include <eosio/signature_provider_plugin/signature_provider_plugin.hpp>
+#include <eosio/producer_plugin/ro_window_scheduler.hpp>
 
 #include <eosio/chain/application.hpp>
 
@@ -157,6 +158,33 @@ public:
 
    void register_update_speculative_block_metrics(std::function<void(chain::speculative_block_metrics)>&&);
 
+   // reported once per block when read-only-prescreen-trxs is enabled
+   struct prescreen_metrics {
+      std::size_t num_screened         = 0;
+      std::size_t num_likely_good      = 0;
+      std::size_t num_deprioritized    = 0;
+      std::size_t num_dropped          = 0; // expired or duplicate, dropped without executing on the main thread
+      int64_t     screen_time_us       = 0; // time spent pre-screening, on the read-only threads
+      int64_t     main_thread_saved_us = 0; // estimated main thread time not spent on dropped transactions
+   };
+   void register_update_prescreen_metrics(std::function<void(prescreen_metrics)>&&);
+
+   // reported at the end of each read window when read-only-threads > 0
+   struct ro_window_metrics {
+      int64_t                             write_window_us        = 0; // length chosen for the preceding write window
+      int64_t                             read_window_us         = 0; // length chosen for the read window
+      int64_t                             read_window_elapsed_us = 0; // the read window ends early when drained or a block is received
+      ro_window_scheduler::reason         write_window_reason    = ro_window_scheduler::reason::fixed;
+      ro_window_scheduler::reason         read_window_reason     = ro_window_scheduler::reason::fixed;
+      uint64_t                            read_window_tasks      = 0; // read tasks executed in the read window
+      int64_t                             avg_read_task_us       = 0;
+      // time tasks waited in each queue, for the tasks executed in the preceding write window and the read window
+      appbase::queue_wait_histogram       read_only_wait;
+      appbase::queue_wait_histogram       read_exclusive_wait;
+      appbase::queue_wait_histogram       read_write_wait;
+   };
+   void register_update_ro_window_metrics(std::function<void(const ro_window_metrics&)>&&);
+
    inline static bool test_mode_{false}; // to be moved into appbase (application_base)
 
  private:
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace eosio {
+
+/**
+ * Sizes the write and read windows in which the producer_plugin alternates between the main thread and the read-only
+ * thread pool, instead of using fixed lengths.
+ *
+ * The read window is sized to drain the queued read tasks, estimated from the queue depths and a moving average of
+ * the measured time of a read task. The write window shrinks towards its minimum when reads are waiting and the
+ * read_write queue is shallow, so reads are not queued behind an idle write window. While received blocks are waiting
+ * to be applied the write window is at its maximum and the read window at its minimum, so block application is not
+ * delayed by reads. Read-only transactions which ran out of read window are retried in the max read window, as their
+ * time limit is derived from it.
+ *
+ * Not thread safe, used from the main thread, or the read-only thread switching windows while the others are idle.
+ */
+class ro_window_scheduler {
+public:
+   struct config {
+      fc::microseconds min_write_window;
+      fc::microseconds max_write_window;
+      fc::microseconds min_read_window;
+      fc::microseconds max_read_window;
+      uint32_t         num_read_threads = 1;
+      bool             adaptive         = true; // when false, always the max windows
+   };
+
+   // what a window was sized from
+   enum class reason {
+      fixed,          // not adaptive
+      idle,           // no read tasks waiting
+      blocks_pending, // received blocks waiting to be applied
+      exhausted,      // read-only trxs ran out of read window, retried in the max window
+      read_backlog,   // sized from the queued read tasks
+      balanced        // write window shared with the queued read tasks
+   };
+
+   struct queue_state {
+      size_t read_write     = 0;
+      size_t read_only      = 0;
+      size_t read_exclusive = 0;
+      bool   blocks_pending = false;
+      bool   exhausted      = false; // read-only trxs ran out of read window and are to be retried
+   };
+
+   struct decision {
+      fc::microseconds window;
+      reason           why = reason::fixed;
+   };
+
+   ro_window_scheduler() = default;
+   explicit ro_window_scheduler(const config& cfg)
+      : cfg(cfg) {}
+
+   void set_config(const config& c) { cfg = c; }
+   const config& get_config() const { return cfg; }
+
+   /// Record the read tasks executed in a read window and their execution time summed over all threads
+   void record_read_window(uint64_t num_tasks, fc::microseconds exec_time) {
+      if (num_tasks == 0)
+         return;
+      const int64_t avg = std::max<int64_t>(exec_time.count() / static_cast<int64_t>(num_tasks), 1);
+      avg_task_us = avg_task_us == 0 ? avg : avg_task_us + (avg - avg_task_us) / smoothing_factor;
+   }
+
+   /// @return moving average of the execution time of a read task, 0 until one is recorded
+   fc::microseconds avg_read_task_time() const { return fc::microseconds(avg_task_us); }
+
+   decision next_write_window(const queue_state& qs) const {
+      if (!cfg.adaptive)
+         return {cfg.max_write_window, reason::fixed};
+      if (qs.blocks_pending)
+         return {cfg.max_write_window, reason::blocks_pending};
+      const size_t reads = qs.read_only + qs.read_exclusive;
+      if (reads == 0)
+         return {cfg.max_write_window, reason::idle};
+      if (qs.read_write == 0)
+         return {cfg.min_write_window, reason::read_backlog};
+      // share of the max write window in proportion to the queued read_write tasks
+      const int64_t us = cfg.max_write_window.count() * static_cast<int64_t>(qs.read_write) / static_cast<int64_t>(qs.read_write + reads);
+      return {clamp_write(us), reason::balanced};
+   }
+
+   decision next_read_window(const queue_state& qs) const {
+      if (!cfg.adaptive)
+         return {cfg.max_read_window, reason::fixed};
+      if (qs.blocks_pending)
+         return {cfg.min_read_window, reason::blocks_pending};
+      // read-only trx time is limited to fit in the max read window, a smaller one could exhaust the same trxs again
+      if (qs.exhausted)
+         return {cfg.max_read_window, reason::exhausted};
+      if (avg_task_us == 0) // nothing measured yet
+         return {cfg.max_read_window, reason::read_backlog};
+      const size_t  reads   = qs.read_only + qs.read_exclusive;
+      const int64_t threads = std::max<uint32_t>(cfg.num_read_threads, 1);
+      // expected time to drain the queued reads across the read threads, with 25% headroom
+      const int64_t backlog_us = static_cast<int64_t>(std::min<size_t>(reads, max_counted_tasks)) * avg_task_us / threads;
+      return {clamp_read(backlog_us + backlog_us / 4), reason::read_backlog};
+   }
+
+private:
+   fc::microseconds clamp_write(int64_t us) const {
+      return fc::microseconds(std::clamp(us, cfg.min_write_window.count(), cfg.max_write_window.count()));
+   }
+   fc::microseconds clamp_read(int64_t us) const {
+      return fc::microseconds(std::clamp(us, cfg.min_read_window.count(), cfg.max_read_window.count()));
+   }
+
+   static constexpr int64_t smoothing_factor  = 4;         // new sample weight of 1/4
+   static constexpr size_t  max_counted_tasks = 1000*1000; // bound the backlog estimate against overflow
+
+   config  cfg;
+   int64_t avg_task_us = 0;
+};
+
+inline const char* to_string(ro_window_scheduler::reason r) {
+   switch (r) {
+      case ro_window_scheduler::reason::fixed:          return "fixed";
+      case ro_window_scheduler::reason::idle:           return "idle";
+      case ro_window_scheduler::reason::blocks_pending: return "blocks_pending";
+      case ro_window_scheduler::reason::exhausted:      return "exhausted";
+      case ro_window_scheduler::reason::read_backlog:   return "read_backlog";
+      case ro_window_scheduler::reason::balanced:       return "balanced";
+   }
+   return "unknown";
+}
+
+} // namespace eosio
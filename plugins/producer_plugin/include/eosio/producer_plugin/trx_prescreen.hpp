@@ -0,0 +1,85 @@
+#pragma once
+
+#include <eosio/chain/authorization_manager.hpp>
+#include <eosio/chain/controller.hpp>
+#include <eosio/chain/exceptions.hpp>
+#include <eosio/chain/transaction_metadata.hpp>
+#include <eosio/chain/unapplied_transaction_queue.hpp>
+
+#include <vector>
+
+namespace eosio::trx_prescreen {
+
+using status = chain::transaction_metadata::prescreen_status;
+
+/**
+ * Screen a queued transaction against the head state of chain, the transaction is not executed.
+ * Only reads chain, may be called from the read-only threads during the read window.
+ * @return the new status of trx, unchanged if it was already screened
+ */
+inline status screen(const chain::controller& chain, chain::transaction_metadata& trx, const fc::time_point& next_block_time) {
+   if (trx.prescreen != status::unscreened)
+      return trx.prescreen;
+
+   // only the authorization check needs the actions, the others do not materialize the transaction
+   const chain::transaction_header& h = trx.packed_trx()->get_header();
+   if (h.expiration.to_time_point() < next_block_time) {
+      trx.prescreen = status::expired;
+   } else if (chain.is_known_unexpired_transaction(trx.id())) {
+      trx.prescreen = status::duplicate;
+   } else {
+      try {
+         chain.validate_tapos(h);
+         chain.get_authorization_manager().check_authorization(trx.packed_trx()->get_transaction().actions,
+                                                               trx.recovered_keys(), {}, fc::seconds(h.delay_sec.value));
+         trx.prescreen = status::likely_good;
+      } catch (const fc::exception&) {
+         trx.prescreen = status::deprioritized;
+      }
+   }
+   return trx.prescreen;
+}
+
+/**
+ * Collect up to max_trxs unscreened transactions of [begin, end) of unapplied_transaction.
+ * Tapos, authorization and duplicate checks depend on the fork, so when head_moved deprioritized and duplicate
+ * transactions are reset to unscreened to be screened again.
+ */
+template <typename Itr>
+std::vector<chain::transaction_metadata_ptr> collect(Itr begin, Itr end, bool head_moved, size_t max_trxs) {
+   std::vector<chain::transaction_metadata_ptr> trxs;
+   for (auto itr = begin; itr != end && trxs.size() < max_trxs; ++itr) {
+      auto& prescreen = itr->trx_meta->prescreen;
+      if (head_moved && (prescreen == status::deprioritized || prescreen == status::duplicate))
+         prescreen = status::unscreened;
+      if (prescreen == status::unscreened)
+         trxs.push_back(itr->trx_meta);
+   }
+   return trxs;
+}
+
+/**
+ * Called on the main thread before executing a queued transaction.
+ * A duplicate is checked again against the current head, the block including it may have been forked out since it
+ * was screened, in which case it is reset to unscreened and executed.
+ * @return the exception to reject ut with, null if it should be executed
+ */
+inline fc::exception_ptr rejection(const chain::controller& chain, const chain::unapplied_transaction& ut) {
+   const auto& trx = ut.trx_meta;
+   switch (trx->prescreen.load()) {
+      case status::expired:
+         return std::static_pointer_cast<fc::exception>(std::make_shared<chain::expired_tx_exception>(
+            FC_LOG_MESSAGE(error, "expired transaction ${id}, expiration ${e}", ("id", trx->id())("e", ut.expiration()))));
+      case status::duplicate:
+         if (!chain.is_known_unexpired_transaction(trx->id())) {
+            trx->prescreen = status::unscreened;
+            return {};
+         }
+         return std::static_pointer_cast<fc::exception>(std::make_shared<chain::tx_duplicate>(
+            FC_LOG_MESSAGE(info, "duplicate transaction ${id}", ("id", trx->id()))));
+      default:
+         return {};
+   }
+}
+
+} // namespace eosio::trx_prescreen
@@ -1,6 +1,7 @@
 #include <eosio/producer_plugin/producer_plugin.hpp>
 #include <eosio/producer_plugin/block_timing_util.hpp>
 #include <eosio/producer_plugin/production_pause_vote_tracker.hpp>
+#include <eosio/producer_plugin/trx_prescreen.hpp>
 #include <eosio/chain/plugin_interface.hpp>
 #include <eosio/chain/global_property_object.hpp>
 #include <eosio/chain/generated_transaction_object.hpp>
@@ -799,6 +800,14 @@ public:
    fc::microseconds                  _ro_read_window_time_us{60000};
    static constexpr fc::microseconds _ro_read_window_minimum_time_us{10000};
    fc::microseconds                  _ro_read_window_effective_time_us{0}; // calculated during option initialization
+   fc::microseconds                  _ro_write_window_min_time_us{20000};
+   fc::microseconds                  _ro_read_window_min_time_us{20000};
+   ro_window_scheduler               _ro_window_scheduler;                 // sizes each window, max windows when not adaptive
+   ro_window_scheduler::decision     _ro_write_window_decision;
+   ro_window_scheduler::decision     _ro_read_window_decision;
+   producer_plugin::ro_window_metrics _ro_window_metrics;                  // accumulated over a write and read window
+   std::atomic<bool>                 _ro_trx_exhausted{false};             // a read-only trx ran out of read window since the last read window started
+   std::function<void(const producer_plugin::ro_window_metrics&)> _update_ro_window_metrics;
    alignas(hardware_destructive_interference_sz)
    std::atomic<int64_t>              _ro_all_threads_exec_time_us; // total time spent by all threads executing transactions.
                                                                    // use atomic for simplicity and performance
@@ -811,6 +820,30 @@ public:
    std::atomic<uint32_t>          _ro_num_active_exec_tasks{0};
    std::vector<std::future<bool>> _ro_exec_tasks_fut;
 
+   // pre-screening of queued incoming transactions, done on the read-only threads during the read window
+   struct prescreen_stats_t {
+      std::atomic<size_t>  num_screened{0};
+      std::atomic<size_t>  num_likely_good{0};
+      std::atomic<size_t>  num_deprioritized{0};
+      std::atomic<int64_t> screen_time_us{0};
+      // only modified on the main thread
+      size_t               num_dropped{0};
+      int64_t              main_thread_saved_us{0};
+   };
+   bool                           _ro_prescreen_enabled{false};
+   uint32_t                       _ro_prescreen_max_trxs{10000};
+   prescreen_stats_t              _prescreen_stats;
+   block_num_type                 _prescreen_head_num{0}; // head when deprioritized trxs were last reset, main thread only
+   int64_t                        _avg_failed_trx_us{0}; // moving average of main thread time of failed trxs, main thread only
+   std::function<void(producer_plugin::prescreen_metrics)> _update_prescreen_metrics;
+
+   void post_prescreen_tasks();
+   void prescreen_trxs(const std::vector<transaction_metadata_ptr>& trxs);
+   bool drop_prescreened_trx(const unapplied_transaction& ut);
+   void report_prescreen_metrics();
+
+   ro_window_scheduler::queue_state ro_queue_state();
+   void report_ro_window_metrics(bool read_window);
    void start_write_window();
    void switch_to_write_window();
    void switch_to_read_window();
@@ -900,6 +933,7 @@ public:
          _time_tracker.report(block_num, block_producer, now);
       }
       _time_tracker.clear();
+      report_prescreen_metrics();
    }
 
    // called on incoming blocks from net_plugin on the main thread. Will notify controller to process any
@@ -977,8 +1011,7 @@ public:
                                       bool                                 return_failure_traces,
                                       next_function<transaction_trace_ptr> next) {
 
-      const transaction& t = trx->get_transaction();
-      EOS_ASSERT( t.delay_sec.value == 0, transaction_exception, "transaction cannot be delayed" );
+      EOS_ASSERT( trx->get_header().delay_sec.value == 0, transaction_exception, "transaction cannot be delayed" );
 
       if (trx_type == transaction_metadata::trx_type::read_only) {
          assert(_ro_thread_pool_size > 0); // enforced by chain_plugin
@@ -1305,6 +1338,20 @@ void producer_plugin::set_program_options(
           "Time in microseconds the write window lasts.")
          ("read-only-read-window-time-us", bpo::value<uint32_t>()->default_value(my->_ro_read_window_time_us.count()),
           "Time in microseconds the read window lasts.")
+         ("read-only-adaptive-windows", bpo::value<bool>()->default_value(false),
+          "Size each write and read window from the depth of the read_write and read-only queues, received blocks waiting "
+          "to be applied and the measured time of read tasks, between the read-only-*-window-min-time-us and the "
+          "read-only-*-window-time-us. When false the windows always last read-only-write-window-time-us and read-only-read-window-time-us.")
+         ("read-only-write-window-min-time-us", bpo::value<uint32_t>()->default_value(my->_ro_write_window_min_time_us.count()),
+          "Minimum time in microseconds of the write window when read-only-adaptive-windows is enabled.")
+         ("read-only-read-window-min-time-us", bpo::value<uint32_t>()->default_value(my->_ro_read_window_min_time_us.count()),
+          "Minimum time in microseconds of the read window when read-only-adaptive-windows is enabled.")
+         ("read-only-prescreen-trxs", bpo::value<bool>()->default_value(false),
+          "Pre-screen queued incoming transactions against head state on the read-only threads during the read window. "
+          "Expired and duplicate transactions are dropped and transactions failing tapos or authorization are processed last. "
+          "Read-only threads are not allowed on producers, so this only applies to non-producing nodes.")
+         ("read-only-prescreen-max-trxs", bpo::value<uint32_t>()->default_value(my->_ro_prescreen_max_trxs),
+          "Maximum number of queued transactions to pre-screen per read window.")
          ;
    config_file_options.add(producer_options);
 }
@@ -1482,6 +1529,29 @@ void producer_plugin_impl::plugin_initialize(const boost::program_options::varia
       _ro_read_window_effective_time_us = _ro_read_window_time_us;
       ilog("read-only-write-window-time-us: ${ww} us, read-only-read-window-time-us: ${rw} us, effective read window time to be used: ${w} us",
            ("ww", _ro_write_window_time_us)("rw", _ro_read_window_time_us)("w", _ro_read_window_effective_time_us));
+
+      const bool adaptive_windows  = options.at("read-only-adaptive-windows").as<bool>();
+      _ro_write_window_min_time_us = fc::microseconds(options.at("read-only-write-window-min-time-us").as<uint32_t>());
+      _ro_read_window_min_time_us  = fc::microseconds(options.at("read-only-read-window-min-time-us").as<uint32_t>());
+      if (adaptive_windows) {
+         EOS_ASSERT(_ro_write_window_min_time_us > fc::microseconds(0) && _ro_write_window_min_time_us <= _ro_write_window_time_us,
+                    plugin_config_exception,
+                    "read-only-write-window-min-time-us (${min}) must be greater than 0 and at most read-only-write-window-time-us (${max})",
+                    ("min", _ro_write_window_min_time_us)("max", _ro_write_window_time_us));
+         EOS_ASSERT(_ro_read_window_min_time_us > _ro_read_window_minimum_time_us && _ro_read_window_min_time_us <= _ro_read_window_time_us,
+                    plugin_config_exception,
+                    "read-only-read-window-min-time-us (${min}) must be greater than ${least} us and at most read-only-read-window-time-us (${max})",
+                    ("min", _ro_read_window_min_time_us)("least", _ro_read_window_minimum_time_us)("max", _ro_read_window_time_us));
+         ilog("read-only-adaptive-windows enabled, write window ${wmin}-${wmax} us, read window ${rmin}-${rmax} us",
+              ("wmin", _ro_write_window_min_time_us)("wmax", _ro_write_window_time_us)
+              ("rmin", _ro_read_window_min_time_us)("rmax", _ro_read_window_effective_time_us));
+      }
+      _ro_window_scheduler.set_config({.min_write_window = _ro_write_window_min_time_us,
+                                       .max_write_window = _ro_write_window_time_us,
+                                       .min_read_window  = _ro_read_window_min_time_us,
+                                       .max_read_window  = _ro_read_window_effective_time_us,
+                                       .num_read_threads = _ro_thread_pool_size,
+                                       .adaptive         = adaptive_windows});
       // Make sure _ro_max_trx_time_us is always set.
       // Make sure a read-only transaction can finish within the read
       // window if scheduled at the very beginning of the window.
@@ -1502,6 +1572,11 @@ void producer_plugin_impl::plugin_initialize(const boost::program_options::varia
            ("rot", _ro_max_trx_time_us)("row", _ro_read_window_effective_time_us));
       ilog("read-only-threads ${s}, max read-only trx time to be enforced: ${t} us", ("s", _ro_thread_pool_size)("t", _ro_max_trx_time_us));
 
+      _ro_prescreen_enabled  = options.at("read-only-prescreen-trxs").as<bool>();
+      _ro_prescreen_max_trxs = options.at("read-only-prescreen-max-trxs").as<uint32_t>();
+      if (_ro_prescreen_enabled)
+         ilog("read-only-prescreen-trxs enabled, pre-screening at most ${m} transactions per read window", ("m", _ro_prescreen_max_trxs));
+
       app().executor().init_read_threads(_ro_thread_pool_size);
    }
 
@@ -2448,7 +2523,7 @@ void producer_plugin_impl::log_trx_results(const packed_transaction_ptr& trx,
          fc_dlog(is_transient ? _transient_trx_failed_trace_log : _trx_failed_trace_log,
                  "[TRX_TRACE] Block ${block_num} for producer ${prod} is REJECTING ${desc}tx: ${txid}, auth: ${a}, ${details}",
                  ("block_num", chain.head().block_num() + 1)("prod", get_pending_block_producer())("desc", is_transient ? "transient " : "")
-                 ("txid", trx->id())("a", trx->get_transaction().first_authorizer())
+                 ("txid", trx->id())("a", trx->packed_trx()->first_authorizer())
                  ("details", get_detailed_contract_except_info(trx, trace, except_ptr)));
 
          if (!is_transient) {
@@ -2464,7 +2539,7 @@ void producer_plugin_impl::log_trx_results(const packed_transaction_ptr& trx,
          fc_dlog(is_transient ? _transient_trx_failed_trace_log : _trx_failed_trace_log,
                  "[TRX_TRACE] Speculative execution is REJECTING ${desc}tx: ${txid}, auth: ${a} : ${details}",
                  ("desc", is_transient ? "transient " : "")("txid", trx->id())
-                 ("a", trx->get_transaction().first_authorizer())("details", get_detailed_contract_except_info(trx, trace, except_ptr)));
+                 ("a", trx->packed_trx()->first_authorizer())("details", get_detailed_contract_except_info(trx, trace, except_ptr)));
          if (!is_transient) {
             fc_dlog(_trx_log, "[TRX_TRACE] Speculative execution is REJECTING tx: ${trx} ",
                     ("trx", chain_plug->get_log_trx(trx->get_transaction())));
@@ -2478,7 +2553,7 @@ void producer_plugin_impl::log_trx_results(const packed_transaction_ptr& trx,
          fc_dlog(is_transient ? _transient_trx_successful_trace_log : _trx_successful_trace_log,
                  "[TRX_TRACE] Block ${block_num} for producer ${prod} is ACCEPTING ${desc}tx: ${txid}, auth: ${a}, cpu: ${cpu}",
                  ("block_num", chain.head().block_num() + 1)("prod", get_pending_block_producer())("desc", is_transient ? "transient " : "")
-                 ("txid", trx->id())("a", trx->get_transaction().first_authorizer())("cpu", billed_cpu_us));
+                 ("txid", trx->id())("a", trx->packed_trx()->first_authorizer())("cpu", billed_cpu_us));
          if (!is_transient) {
             fc_dlog(_trx_log, "[TRX_TRACE] Block ${block_num} for producer ${prod} is ACCEPTING tx: ${trx}",
                     ("block_num", chain.head().block_num() + 1)("prod", get_pending_block_producer())
@@ -2490,7 +2565,7 @@ void producer_plugin_impl::log_trx_results(const packed_transaction_ptr& trx,
       } else {
          fc_dlog(is_transient ? _transient_trx_successful_trace_log : _trx_successful_trace_log,
                  "[TRX_TRACE] Speculative execution is ACCEPTING ${desc}tx: ${txid}, auth: ${a}, cpu: ${cpu}",
-                 ("desc", is_transient ? "transient " : "")("txid", trx->id())("a", trx->get_transaction().first_authorizer())
+                 ("desc", is_transient ? "transient " : "")("txid", trx->id())("a", trx->packed_trx()->first_authorizer())
                  ("cpu", billed_cpu_us));
          if (!is_transient) {
             fc_dlog(_trx_log, "[TRX_TRACE] Speculative execution is ACCEPTING tx: ${trx}", ("trx", chain_plug->get_log_trx(trx->get_transaction())));
@@ -2514,7 +2589,7 @@ producer_plugin_impl::push_result producer_plugin_impl::push_transaction(const f
    chain::controller&         chain           = chain_plug->chain();
    chain::subjective_billing& subjective_bill = chain.get_mutable_subjective_billing();
 
-   auto first_auth = trx->packed_trx()->get_transaction().first_authorizer();
+   auto first_auth = trx->packed_trx()->first_authorizer();
 
    bool disable_subjective_enforcement = (api_trx && _disable_subjective_api_billing) ||
                                          (!api_trx && _disable_subjective_p2p_billing) ||
@@ -2593,6 +2668,10 @@ producer_plugin_impl::handle_push_result(const transaction_metadata_ptr&
       } else {
          pr.failed              = true;
          const fc::exception& e = *trace->except;
+         if (_ro_prescreen_enabled && !trx->is_transient()) {
+            // used to estimate the main thread time saved by dropping transactions during pre-screening
+            _avg_failed_trx_us += ((end - start).count() - _avg_failed_trx_us) / 8;
+         }
          if (e.code() != tx_duplicate::code_value) {
             fc_tlog(_log, "Subjective bill for failed ${a}: ${b} elapsed ${t}us, time ${r}us",
                     ("a", first_auth)("b", sub_bill)("t", trace->elapsed)("r", end - start));
@@ -2780,34 +2859,79 @@ bool producer_plugin_impl::process_incoming_trxs(const fc::time_point& deadline,
       fc_dlog(_log, "Processing ${n} pending transactions", ("n", _unapplied_transactions.incoming_size()));
       const chain::controller& chain             = chain_plug->chain();
       const auto               pending_block_num = chain.pending_block_num();
+      // transactions that failed pre-screening are processed after all others
+      std::vector<transaction_id_type> deprioritized;
+      auto push_incoming = [&](unapplied_transaction_queue::iterator& trx_itr) {
+         auto trx_meta = trx_itr->trx_meta;
+         bool api_trx  = trx_itr->trx_type == trx_enum_type::incoming_api;
+
+         auto trx_tracker = _time_tracker.start_trx(trx_meta->is_transient());
+         push_result pr = push_transaction(deadline, trx_meta, api_trx, trx_itr->return_failure_trace, trx_tracker, trx_itr->next);
+
+         if (pr.trx_exhausted) {
+            ++trx_itr; // leave in incoming
+         } else {
+            trx_itr = _unapplied_transactions.erase(trx_itr);
+         }
+         return pr.block_exhausted;
+      };
       while (itr != end) {
          if (should_interrupt_start_block(deadline, pending_block_num)) {
             exhausted = true;
             break;
          }
 
-         auto trx_meta = itr->trx_meta;
-         bool api_trx  = itr->trx_type == trx_enum_type::incoming_api;
-
-         auto trx_tracker = _time_tracker.start_trx(trx_meta->is_transient());
-         push_result pr = push_transaction(deadline, trx_meta, api_trx, itr->return_failure_trace, trx_tracker, itr->next);
-
-         exhausted = pr.block_exhausted;
-         if (pr.trx_exhausted) {
-            ++itr; // leave in incoming
-         } else {
-            itr = _unapplied_transactions.erase(itr);
+         if (_ro_prescreen_enabled) {
+            if (drop_prescreened_trx(*itr)) {
+               itr = _unapplied_transactions.erase(itr);
+               continue;
+            }
+            const auto& trx_meta = itr->trx_meta;
+            if (trx_meta->prescreen == transaction_metadata::prescreen_status::deprioritized) {
+               deprioritized.push_back(trx_meta->id());
+               ++itr;
+               continue;
+            }
          }
 
+         exhausted = push_incoming(itr);
          if (exhausted)
             break;
          ++processed;
       }
-      fc_dlog(_log, "Processed ${n} pending transactions, ${p} left", ("n", processed)("p", _unapplied_transactions.incoming_size()));
+      for (size_t i = 0; !exhausted && i < deprioritized.size(); ++i) {
+         if (should_interrupt_start_block(deadline, pending_block_num)) {
+            exhausted = true;
+            break;
+         }
+         auto ditr = _unapplied_transactions.lower_bound(deprioritized[i]);
+         if (ditr == end)
+            continue;
+         exhausted = push_incoming(ditr);
+         ++processed;
+      }
+      fc_dlog(_log, "Processed ${n} pending transactions, ${d} deprioritized, ${p} left",
+              ("n", processed)("d", deprioritized.size())("p", _unapplied_transactions.incoming_size()));
    }
    return !exhausted;
 }
 
+// Called on the main thread while processing queued transactions.
+// Drops transactions pre-screening found to be deterministically invalid. Caller is responsible for erasing them.
+bool producer_plugin_impl::drop_prescreened_trx(const unapplied_transaction& ut) {
+   const auto& trx = ut.trx_meta;
+   fc::exception_ptr except_ptr = trx_prescreen::rejection(chain_plug->chain(), ut);
+   if (!except_ptr)
+      return false;
+   fc_dlog(_trx_failed_trace_log, "[TRX_TRACE] Pre-screening is REJECTING tx: ${txid} : ${why}",
+           ("txid", trx->id())("why", except_ptr->what()));
+   if (ut.next)
+      ut.next(except_ptr);
+   ++_prescreen_stats.num_dropped;
+   _prescreen_stats.main_thread_saved_us += _avg_failed_trx_us;
+   return true;
+}
+
 bool producer_plugin_impl::block_is_exhausted() const {
    const chain::controller& chain = chain_plug->chain();
    const auto&              rl    = chain.get_resource_limits_manager();
@@ -3061,6 +3185,45 @@ void producer_plugin::log_failed_transaction(const transaction_id_type&    trx_i
            ("entire_trx", packed_trx_ptr ? my->chain_plug->get_log_trx(packed_trx_ptr->get_transaction()) : fc::variant{trx_id}));
 }
 
+// Called from the app thread or the read-only thread switching windows, while the other read-only threads are idle.
+// Queue sizes are read without locking as in the write window.
+ro_window_scheduler::queue_state producer_plugin_impl::ro_queue_state() {
+   return {.read_write     = app().executor().read_write_queue_size(),
+           .read_only      = app().executor().read_only_queue_size(),
+           .read_exclusive = app().executor().read_exclusive_queue_size(),
+           .blocks_pending = _received_block > chain_plug->chain().head().block_num(),
+           .exhausted      = _ro_trx_exhausted || !_ro_exhausted_trx_queue.empty()};
+}
+
+// Called from only one read_only thread at the end of the read window, or from the app thread when there is no read
+// window because no read tasks are queued
+void producer_plugin_impl::report_ro_window_metrics(bool read_window) {
+   auto& m = _ro_window_metrics;
+   // the read tasks executed since the start of the read window, or in the write window when there was none
+   const auto read_only_wait      = app().executor().take_queue_wait_histogram(exec_queue::read_only);
+   const auto read_exclusive_wait = app().executor().take_queue_wait_histogram(exec_queue::read_exclusive);
+   if (read_window) {
+      m.read_window_tasks = read_only_wait.count + read_exclusive_wait.count;
+      _ro_window_scheduler.record_read_window(m.read_window_tasks, fc::microseconds(app().executor().take_read_window_exec_time_us()));
+      m.read_window_us         = _ro_read_window_decision.window.count();
+      m.read_window_reason     = _ro_read_window_decision.why;
+      m.read_window_elapsed_us = (fc::time_point::now() - _ro_read_window_start_time).count();
+   } else {
+      m.read_window_reason     = ro_window_scheduler::reason::idle;
+   }
+
+   m.read_only_wait      += read_only_wait;
+   m.read_exclusive_wait += read_exclusive_wait;
+   m.read_write_wait     += app().executor().take_queue_wait_histogram(exec_queue::read_write);
+   m.write_window_us     = _ro_write_window_decision.window.count();
+   m.write_window_reason = _ro_write_window_decision.why;
+   m.avg_read_task_us    = _ro_window_scheduler.avg_read_task_time().count();
+
+   if (_update_ro_window_metrics)
+      _update_ro_window_metrics(m);
+   m = {};
+}
+
 // Called from only one read_only thread
 void producer_plugin_impl::switch_to_write_window() {
    fc_dlog(_log, "Read-only threads ${n}, read window ${r}us, total all threads ${t}us",
@@ -3077,6 +3240,7 @@ void producer_plugin_impl::switch_to_write_window() {
    EOS_ASSERT(_ro_num_active_exec_tasks.load() == 0 && _ro_exec_tasks_fut.empty(), producer_exception,
               "no read-only tasks should be running before switching to write window");
 
+   report_ro_window_metrics(true);
    start_write_window();
 }
 
@@ -3091,8 +3255,9 @@ void producer_plugin_impl::start_write_window() {
    auto now = fc::time_point::now();
    _time_tracker.unpause(now);
 
-   _ro_window_deadline = now + _ro_write_window_time_us; // not allowed on block producers, so no need to limit to block deadline
-   auto expire_time = boost::posix_time::microseconds(_ro_write_window_time_us.count());
+   _ro_write_window_decision = _ro_window_scheduler.next_write_window(ro_queue_state());
+   _ro_window_deadline = now + _ro_write_window_decision.window; // not allowed on block producers, so no need to limit to block deadline
+   auto expire_time = boost::posix_time::microseconds(_ro_write_window_decision.window.count());
    _ro_timer.expires_from_now(expire_time);
    _ro_timer.async_wait([this](const boost::system::error_code& ec) {
       if (ec != boost::asio::error::operation_aborted) {
@@ -3112,23 +3277,34 @@ void producer_plugin_impl::switch_to_read_window() {
 
    _time_tracker.pause();
 
+   if (_ro_prescreen_enabled)
+      post_prescreen_tasks();
+
    // we are in write window, so no read-only trx threads are processing transactions.
    if (app().executor().read_only_queue_empty() && app().executor().read_exclusive_queue_empty()) { // no read-only tasks to process. stay in write window
+      report_ro_window_metrics(false);
       start_write_window();                          // restart write window timer for next round
       return;
    }
    fc_dlog(_log, "Read only queue size ${s1}, read exclusive size ${s2}",
            ("s1", app().executor().read_only_queue_size())("s2", app().executor().read_exclusive_queue_size()));
 
+   // tasks executed in the write window, the read window ones are taken at its end
+   _ro_window_metrics.read_only_wait      += app().executor().take_queue_wait_histogram(exec_queue::read_only);
+   _ro_window_metrics.read_exclusive_wait += app().executor().take_queue_wait_histogram(exec_queue::read_exclusive);
+
    uint32_t pending_block_num = chain.head().block_num() + 1;
+   _ro_read_window_decision   = _ro_window_scheduler.next_read_window(ro_queue_state());
+   _ro_trx_exhausted          = false;
    _ro_read_window_start_time = fc::time_point::now();
-   _ro_window_deadline        = _ro_read_window_start_time + _ro_read_window_effective_time_us;
+   _ro_window_deadline        = _ro_read_window_start_time + _ro_read_window_decision.window;
    app().executor().set_to_read_window([received_block = &_received_block, pending_block_num, ro_window_deadline = _ro_window_deadline]() {
          return fc::time_point::now() >= ro_window_deadline || (received_block->load() >= pending_block_num); // should_exit()
       });
    chain.set_to_read_window();
    chain.set_db_read_only_mode();
    _ro_all_threads_exec_time_us = 0;
+   app().executor().take_read_window_exec_time_us(); // discard any from before the read window
 
    // start a read-only execution task in each thread in the thread pool
    _ro_num_active_exec_tasks = _ro_thread_pool_size;
@@ -3138,7 +3314,7 @@ void producer_plugin_impl::switch_to_read_window() {
          _ro_thread_pool.get_executor(), [self = this, pending_block_num]() { return self->read_only_execution_task(pending_block_num); }));
    }
 
-   auto expire_time = boost::posix_time::microseconds(_ro_read_window_time_us.count());
+   auto expire_time = boost::posix_time::microseconds(_ro_read_window_decision.window.count());
    _ro_timer.expires_from_now(expire_time);
    // Needs to be on read_only because that is what is being processed until switch_to_write_window().
    _ro_timer.async_wait([this](const boost::system::error_code& ec) {
@@ -3207,6 +3383,85 @@ void producer_plugin_impl::repost_exhausted_transactions(const fc::time_point& d
    }
 }
 
+// Called only from app thread, in the write window before switching to the read window
+void producer_plugin_impl::post_prescreen_tasks() {
+   // tapos, authorization and duplicate results depend on head state, screen those trxs again once head has moved
+   const auto head_num = chain_plug->chain().head().block_num();
+   const bool rescreen = head_num != _prescreen_head_num;
+   _prescreen_head_num = head_num;
+
+   auto trxs = trx_prescreen::collect(_unapplied_transactions.incoming_begin(), _unapplied_transactions.incoming_end(),
+                                      rescreen, _ro_prescreen_max_trxs);
+   if (trxs.empty())
+      return;
+
+   // split evenly across the read-only threads, each task screens its own disjoint set
+   const size_t per_task = (trxs.size() + _ro_thread_pool_size - 1) / _ro_thread_pool_size;
+   for (size_t i = 0; i < trxs.size(); i += per_task) {
+      std::vector<transaction_metadata_ptr> task_trxs(trxs.begin() + i, trxs.begin() + std::min(trxs.size(), i + per_task));
+      app().executor().post(priority::low, exec_queue::read_only, [this, task_trxs{std::move(task_trxs)}]() {
+         prescreen_trxs(task_trxs);
+      });
+   }
+}
+
+// Called from a read only thread during the read window, or from app thread in the write window.
+// Only performs checks that are valid against the head state, the transactions are not executed as the
+// database is read-only during the read window.
+void producer_plugin_impl::prescreen_trxs(const std::vector<transaction_metadata_ptr>& trxs) {
+   using status = transaction_metadata::prescreen_status;
+   const chain::controller& chain           = chain_plug->chain();
+   const auto               next_block_time = chain.head().timestamp().next().to_time_point();
+   const auto               start           = fc::time_point::now();
+
+   size_t num_screened = 0, num_good = 0, num_deprioritized = 0;
+   for (const auto& trx : trxs) {
+      if (fc::time_point::now() >= _ro_window_deadline)
+         break; // remaining are screened in a later read window
+      if (trx->prescreen != status::unscreened)
+         continue;
+      ++num_screened;
+
+      switch (trx_prescreen::screen(chain, *trx, next_block_time)) {
+         case status::likely_good:
+            ++num_good;
+            break;
+         case status::deprioritized:
+            fc_tlog(_log, "Pre-screening deprioritized trx ${id}", ("id", trx->id()));
+            ++num_deprioritized;
+            break;
+         default:
+            break;
+      }
+   }
+
+   _prescreen_stats.num_screened      += num_screened;
+   _prescreen_stats.num_likely_good   += num_good;
+   _prescreen_stats.num_deprioritized += num_deprioritized;
+   _prescreen_stats.screen_time_us    += (fc::time_point::now() - start).count();
+}
+
+// Called only from app thread
+void producer_plugin_impl::report_prescreen_metrics() {
+   if (!_ro_prescreen_enabled)
+      return;
+   producer_plugin::prescreen_metrics metrics{
+      .num_screened         = _prescreen_stats.num_screened.exchange(0),
+      .num_likely_good      = _prescreen_stats.num_likely_good.exchange(0),
+      .num_deprioritized    = _prescreen_stats.num_deprioritized.exchange(0),
+      .num_dropped          = std::exchange(_prescreen_stats.num_dropped, 0),
+      .screen_time_us       = _prescreen_stats.screen_time_us.exchange(0),
+      .main_thread_saved_us = std::exchange(_prescreen_stats.main_thread_saved_us, 0)
+   };
+   if (metrics.num_screened > 0 || metrics.num_dropped > 0) {
+      fc_dlog(_log, "Pre-screened ${s} trxs in ${t}us: ${g} likely good, ${d} deprioritized, ${x} dropped saving ~${m}us",
+              ("s", metrics.num_screened)("t", metrics.screen_time_us)("g", metrics.num_likely_good)("d", metrics.num_deprioritized)
+              ("x", metrics.num_dropped)("m", metrics.main_thread_saved_us));
+   }
+   if (_update_prescreen_metrics)
+      _update_prescreen_metrics(metrics);
+}
+
 // Called from a read_only_trx execution thread, or from app thread when executing exclusively
 // Return whether the trx needs to be retried in next read window
 bool producer_plugin_impl::push_read_only_transaction(transaction_metadata_ptr trx, next_function<transaction_trace_ptr> next) {
@@ -3216,6 +3471,7 @@ bool producer_plugin_impl::push_read_only_transaction(transaction_metadata_ptr t
       auto               start = fc::time_point::now();
       chain::controller& chain = chain_plug->chain();
       if (!chain.is_building_block()) {
+         _ro_trx_exhausted = true;
          _ro_exhausted_trx_queue.push_front({std::move(trx), std::move(next)});
          return true;
       }
@@ -3238,6 +3494,7 @@ bool producer_plugin_impl::push_read_only_transaction(transaction_metadata_ptr t
       // the end of read window. Retry in next round.
       retry = pr.trx_exhausted;
       if (retry) {
+         _ro_trx_exhausted = true;
          _ro_exhausted_trx_queue.push_front({std::move(trx), std::move(next)});
       }
 
@@ -3261,4 +3518,12 @@ void producer_plugin::register_update_speculative_block_metrics(std::function<vo
    my->_update_speculative_block_metrics = std::move(fun);
 }
 
+void producer_plugin::register_update_prescreen_metrics(std::function<void(prescreen_metrics)>&& fun) {
+   my->_update_prescreen_metrics = std::move(fun);
+}
+
+void producer_plugin::register_update_ro_window_metrics(std::function<void(const ro_window_metrics&)>&& fun) {
+   my->_update_ro_window_metrics = std::move(fun);
+}
+
 } // namespace eosio
@@ -0,0 +1,105 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/producer_plugin/ro_window_scheduler.hpp>
+
+using namespace eosio;
+
+namespace {
+
+ro_window_scheduler::config make_config(bool adaptive = true) {
+   return {.min_write_window = fc::milliseconds(20),
+           .max_write_window = fc::milliseconds(200),
+           .min_read_window  = fc::milliseconds(20),
+           .max_read_window  = fc::milliseconds(60),
+           .num_read_threads = 4,
+           .adaptive         = adaptive};
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(ro_window_scheduler_tests)
+
+BOOST_AUTO_TEST_CASE(test_fixed_windows) {
+   ro_window_scheduler s(make_config(false));
+   s.record_read_window(10, fc::microseconds(100));
+
+   for (const auto& qs : {ro_window_scheduler::queue_state{},
+                          ro_window_scheduler::queue_state{.read_only = 1000},
+                          ro_window_scheduler::queue_state{.read_write = 5, .read_exclusive = 3, .blocks_pending = true}}) {
+      const auto w = s.next_write_window(qs);
+      const auto r = s.next_read_window(qs);
+      BOOST_TEST((w.window == fc::milliseconds(200)));
+      BOOST_TEST((r.window == fc::milliseconds(60)));
+      BOOST_TEST((w.why == ro_window_scheduler::reason::fixed));
+      BOOST_TEST((r.why == ro_window_scheduler::reason::fixed));
+   }
+}
+
+BOOST_AUTO_TEST_CASE(test_write_window) {
+   ro_window_scheduler s(make_config());
+   using reason = ro_window_scheduler::reason;
+
+   // nothing to read, keep writing
+   auto d = s.next_write_window({.read_write = 10});
+   BOOST_TEST((d.window == fc::milliseconds(200)));
+   BOOST_TEST((d.why == reason::idle));
+
+   // reads waiting and nothing to write
+   d = s.next_write_window({.read_only = 10});
+   BOOST_TEST((d.window == fc::milliseconds(20)));
+   BOOST_TEST((d.why == reason::read_backlog));
+
+   // shared in proportion to the queued tasks
+   d = s.next_write_window({.read_write = 10, .read_only = 5, .read_exclusive = 5});
+   BOOST_TEST((d.window == fc::milliseconds(100)));
+   BOOST_TEST((d.why == reason::balanced));
+
+   d = s.next_write_window({.read_write = 1, .read_only = 1000});
+   BOOST_TEST((d.window == fc::milliseconds(20))); // clamped to min
+
+   // block application is not shortened by reads
+   d = s.next_write_window({.read_only = 1000, .blocks_pending = true});
+   BOOST_TEST((d.window == fc::milliseconds(200)));
+   BOOST_TEST((d.why == reason::blocks_pending));
+}
+
+BOOST_AUTO_TEST_CASE(test_read_window) {
+   ro_window_scheduler s(make_config());
+   using reason = ro_window_scheduler::reason;
+
+   // max until a read task time is measured
+   BOOST_TEST((s.avg_read_task_time() == fc::microseconds(0)));
+   auto d = s.next_read_window({.read_only = 1});
+   BOOST_TEST((d.window == fc::milliseconds(60)));
+
+   s.record_read_window(0, fc::milliseconds(5)); // ignored
+   BOOST_TEST((s.avg_read_task_time() == fc::microseconds(0)));
+
+   s.record_read_window(10, fc::milliseconds(10)); // 1ms a task
+   BOOST_TEST((s.avg_read_task_time() == fc::milliseconds(1)));
+
+   // 160 tasks of 1ms on 4 threads, with 25% headroom
+   d = s.next_read_window({.read_only = 100, .read_exclusive = 60});
+   BOOST_TEST((d.window == fc::milliseconds(50)));
+   BOOST_TEST((d.why == reason::read_backlog));
+
+   d = s.next_read_window({.read_only = 4});
+   BOOST_TEST((d.window == fc::milliseconds(20))); // clamped to min
+
+   d = s.next_read_window({.read_only = 100000});
+   BOOST_TEST((d.window == fc::milliseconds(60))); // clamped to max
+
+   d = s.next_read_window({.read_only = 100, .blocks_pending = true});
+   BOOST_TEST((d.window == fc::milliseconds(20)));
+   BOOST_TEST((d.why == reason::blocks_pending));
+
+   // exhausted trxs are retried in the max window, the read-only trx time limit is sized from it
+   d = s.next_read_window({.read_only = 4, .exhausted = true});
+   BOOST_TEST((d.window == fc::milliseconds(60)));
+   BOOST_TEST((d.why == reason::exhausted));
+
+   // moving average, new samples weigh 1/4
+   s.record_read_window(10, fc::milliseconds(50)); // 5ms a task
+   BOOST_TEST((s.avg_read_task_time() == fc::milliseconds(2)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+#include <eosio/producer_plugin/trx_prescreen.hpp>
+#include <eosio/testing/tester.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace eosio;
+using namespace eosio::chain;
+using namespace eosio::testing;
+
+namespace {
+
+using status = transaction_metadata::prescreen_status;
+
+signed_transaction make_trx(tester& chain, uint64_t nonce, uint32_t expiration = base_tester::DEFAULT_EXPIRATION_DELTA) {
+   signed_transaction trx;
+   trx.actions.emplace_back(vector<permission_level>{{"alice"_n, config::active_name}}, "alice"_n, "noop"_n, fc::raw::pack(nonce));
+   chain.set_transaction_headers(trx, expiration);
+   return trx;
+}
+
+transaction_metadata_ptr sign_and_recover(tester& chain, signed_transaction trx) {
+   trx.sign(chain.get_private_key("alice"_n, "active"), chain.get_chain_id());
+   return transaction_metadata::recover_keys(std::make_shared<packed_transaction>(std::move(trx)), chain.get_chain_id(),
+                                             fc::microseconds::maximum(), transaction_metadata::trx_type::input);
+}
+
+fc::time_point next_block_time(const tester& chain) {
+   return chain.control->head().timestamp().next().to_time_point();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(trx_prescreen_tests)
+
+BOOST_AUTO_TEST_CASE(test_screen) try {
+   tester chain;
+   chain.create_accounts({"alice"_n});
+   chain.produce_block();
+
+   auto good = sign_and_recover(chain, make_trx(chain, 1));
+   BOOST_TEST((trx_prescreen::screen(*chain.control, *good, next_block_time(chain)) == status::likely_good));
+
+   // expires before the next block
+   auto expired = sign_and_recover(chain, make_trx(chain, 2, 0));
+   BOOST_TEST((trx_prescreen::screen(*chain.control, *expired, next_block_time(chain)) == status::expired));
+
+   // tapos referencing a block not on this fork
+   auto bad_tapos = make_trx(chain, 3);
+   bad_tapos.ref_block_prefix += 1;
+   auto tapos = sign_and_recover(chain, std::move(bad_tapos));
+   BOOST_TEST((trx_prescreen::screen(*chain.control, *tapos, next_block_time(chain)) == status::deprioritized));
+
+   // no recovered keys, fails authorization
+   auto unsigned_trx = transaction_metadata::create_no_recover_keys(std::make_shared<packed_transaction>(make_trx(chain, 4)),
+                                                                    transaction_metadata::trx_type::input);
+   BOOST_TEST((trx_prescreen::screen(*chain.control, *unsigned_trx, next_block_time(chain)) == status::deprioritized));
+
+   // already included in a block
+   auto dup_trx = make_trx(chain, 5);
+   dup_trx.sign(chain.get_private_key("alice"_n, "active"), chain.get_chain_id());
+   chain.push_transaction(dup_trx);
+   chain.produce_block();
+   auto dup = transaction_metadata::recover_keys(std::make_shared<packed_transaction>(dup_trx), chain.get_chain_id(),
+                                            fc::microseconds::maximum(), transaction_metadata::trx_type::input);
+   BOOST_TEST((trx_prescreen::screen(*chain.control, *dup, next_block_time(chain)) == status::duplicate));
+
+   // screened transactions are not screened again
+   BOOST_TEST((trx_prescreen::screen(*chain.control, *expired, next_block_time(chain) - fc::days(1)) == status::expired));
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(test_rejection) try {
+   tester chain;
+   chain.create_accounts({"alice"_n});
+   chain.produce_block();
+
+   auto expired = sign_and_recover(chain, make_trx(chain, 1, 0));
+   trx_prescreen::screen(*chain.control, *expired, next_block_time(chain));
+   auto except = trx_prescreen::rejection(*chain.control, unapplied_transaction{expired});
+   BOOST_REQUIRE(except);
+   BOOST_TEST(except->code() == expired_tx_exception::code_value);
+
+   auto dup_trx = make_trx(chain, 2);
+   dup_trx.sign(chain.get_private_key("alice"_n, "active"), chain.get_chain_id());
+   chain.push_transaction(dup_trx);
+   chain.produce_block();
+   auto dup = transaction_metadata::recover_keys(std::make_shared<packed_transaction>(dup_trx), chain.get_chain_id(),
+                                                 fc::microseconds::maximum(), transaction_metadata::trx_type::input);
+   trx_prescreen::screen(*chain.control, *dup, next_block_time(chain));
+   except = trx_prescreen::rejection(*chain.control, unapplied_transaction{dup});
+   BOOST_REQUIRE(except);
+   BOOST_TEST(except->code() == tx_duplicate::code_value);
+
+   // screened as a duplicate against a block that was since forked out, it is executed rather than rejected
+   auto forked_out = sign_and_recover(chain, make_trx(chain, 3));
+   forked_out->prescreen = status::duplicate;
+   BOOST_TEST(!trx_prescreen::rejection(*chain.control, unapplied_transaction{forked_out}));
+   BOOST_TEST((forked_out->prescreen == status::unscreened));
+
+   auto good = sign_and_recover(chain, make_trx(chain, 4));
+   trx_prescreen::screen(*chain.control, *good, next_block_time(chain));
+   BOOST_TEST(!trx_prescreen::rejection(*chain.control, unapplied_transaction{good}));
+
+   auto deprioritized = sign_and_recover(chain, make_trx(chain, 5));
+   deprioritized->prescreen = status::deprioritized;
+   BOOST_TEST(!trx_prescreen::rejection(*chain.control, unapplied_transaction{deprioritized}));
+   BOOST_TEST((deprioritized->prescreen == status::deprioritized));
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(test_rescreen_after_head_moves) try {
+   tester chain;
+   chain.create_accounts({"alice"_n});
+   chain.produce_block();
+
+   std::vector<unapplied_transaction> queue;
+   for (auto s : {status::unscreened, status::likely_good, status::deprioritized, status::expired, status::duplicate}) {
+      auto trx = sign_and_recover(chain, make_trx(chain, queue.size()));
+      trx->prescreen = s;
+      queue.push_back(unapplied_transaction{trx});
+   }
+
+   // head has not moved, only the unscreened one
+   auto trxs = trx_prescreen::collect(queue.begin(), queue.end(), false, 100);
+   BOOST_REQUIRE(trxs.size() == 1u);
+   BOOST_TEST(trxs[0] == queue[0].trx_meta);
+   BOOST_TEST((queue[2].trx_meta->prescreen == status::deprioritized));
+   BOOST_TEST((queue[4].trx_meta->prescreen == status::duplicate));
+
+   // limited to max_trxs, the ones past it are left as they are
+   trxs = trx_prescreen::collect(queue.begin(), queue.end(), true, 2);
+   BOOST_REQUIRE(trxs.size() == 2u);
+   BOOST_TEST(trxs[1] == queue[2].trx_meta);
+   BOOST_TEST((queue[4].trx_meta->prescreen == status::duplicate));
+
+   // head moved, fork dependent results are screened again, deterministic ones are kept
+   trxs = trx_prescreen::collect(queue.begin(), queue.end(), true, 100);
+   BOOST_REQUIRE(trxs.size() == 3u);
+   BOOST_TEST(trxs[0] == queue[0].trx_meta);
+   BOOST_TEST(trxs[1] == queue[2].trx_meta);
+   BOOST_TEST(trxs[2] == queue[4].trx_meta);
+   BOOST_TEST((queue[1].trx_meta->prescreen == status::likely_good));
+   BOOST_TEST((queue[3].trx_meta->prescreen == status::expired));
+   BOOST_TEST((queue[4].trx_meta->prescreen == status::unscreened));
+
+   // screened again against the new head
+   chain.produce_block();
+   for (const auto& trx : trxs)
+      trx_prescreen::screen(*chain.control, *trx, next_block_time(chain));
+   BOOST_TEST((queue[0].trx_meta->prescreen == status::likely_good));
+   BOOST_TEST((queue[2].trx_meta->prescreen == status::likely_good));
+   BOOST_TEST((queue[4].trx_meta->prescreen == status::likely_good));
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
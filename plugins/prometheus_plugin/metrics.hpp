@@ -4,12 +4,20 @@
 #include <eosio/net_plugin/net_plugin.hpp>
 #include <eosio/producer_plugin/producer_plugin.hpp>
 #include <eosio/chain_plugin/tracked_votes.hpp>
+#include <eosio/chain/recovered_key_cache.hpp>
+#include <eosio/chain/db_access_tracer.hpp>
 
 #include <prometheus/counter.h>
+#include <prometheus/histogram.h>
 #include <prometheus/info.h>
 #include <prometheus/registry.h>
 #include <prometheus/text_serializer.h>
 #include <fc/log/logger.hpp>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
 namespace eosio::metrics {
 
 struct catalog_type {
@@ -60,6 +68,9 @@ struct catalog_type {
       prometheus::Family<Gauge>& block_sync_bytes_received;
       prometheus::Family<Gauge>& block_sync_bytes_sent;
       prometheus::Family<Gauge>& block_sync_throttling;
+      prometheus::Family<Gauge>& writes;
+      prometheus::Family<Gauge>& write_buffers;
+      prometheus::Family<Gauge>& bytes_per_write;
       prometheus::Family<Gauge>& connection_start_time;
       prometheus::Family<Gauge>& peer_addr; // Empty gauge; we only want the label
    };
@@ -108,6 +119,37 @@ struct catalog_type {
    Counter& latency_us_incoming_block;
    Counter& blocks_incoming;
 
+   // pre-screening of incoming transactions
+   struct prescreen_metrics_type {
+      Counter& num_screened;
+      Counter& num_likely_good;
+      Counter& num_deprioritized;
+      Counter& num_dropped;
+      Counter& screen_time_us;
+      Counter& main_thread_saved_us;
+   };
+   prescreen_metrics_type prescreen_metrics;
+
+   // read-only/write window scheduling
+   struct ro_window_metrics_type {
+      Gauge&                                 write_window_us;
+      Gauge&                                 read_window_us;
+      Gauge&                                 avg_read_task_us;
+      Counter&                               read_window_elapsed_us;
+      Counter&                               read_window_tasks;
+      prometheus::Family<Counter>&           write_windows;
+      prometheus::Family<Counter>&           read_windows;
+      prometheus::Family<prometheus::Histogram>& queue_wait_us;
+   };
+   ro_window_metrics_type ro_window_metrics;
+
+   // keys recovered from transaction signatures
+   Counter& recovered_key_cache_hits;
+   Counter& recovered_key_cache_misses;
+   Gauge&   recovered_key_cache_entries;
+   Gauge&   recovered_key_cache_hit_ratio;
+   chain::recovered_key_cache::stats last_recovered_key_cache_stats;
+
    // prometheus exporter
    Counter& bytes_transferred;
    Counter& num_scrapes;
@@ -137,6 +179,9 @@ struct catalog_type {
             , .block_sync_bytes_received{family<Gauge>("nodeos_p2p_block_sync_bytes_received", "bytes of blocks received during syncing")}
             , .block_sync_bytes_sent{family<Gauge>("nodeos_p2p_block_sync_bytes_sent", "bytes of blocks sent during syncing")}
             , .block_sync_throttling{family<Gauge>("nodeos_p2p_block_sync_throttling", "is block sync throttling currently active")}
+            , .writes{family<Gauge>("nodeos_p2p_writes", "total socket writes to peer")}
+            , .write_buffers{family<Gauge>("nodeos_p2p_write_buffers", "total buffers gathered into socket writes to peer")}
+            , .bytes_per_write{family<Gauge>("nodeos_p2p_bytes_per_write", "average bytes per socket write to peer")}
             , .connection_start_time{family<Gauge>("nodeos_p2p_connection_start_time", "time of last connection to peer")}
             , .peer_addr{family<Gauge>("nodeos_p2p_peer_addr", "peer address")}
          }
@@ -184,11 +229,30 @@ struct catalog_type {
        , net_usage_us_incoming_block(net_usage_us.Add({{"block_type", "incoming"}}))
        , latency_us_incoming_block(build<Counter>("nodeos_incoming_us_block_latency", "total incoming block latency"))
        , blocks_incoming(build<Counter>("nodeos_blocks_incoming", "number of incoming blocks"))
+       , prescreen_metrics{ .num_screened{build<Counter>("nodeos_prescreen_trxs_total", "number of incoming transactions pre-screened")}
+                          , .num_likely_good{build<Counter>("nodeos_prescreen_likely_good_trxs_total", "number of pre-screened transactions that passed all checks")}
+                          , .num_deprioritized{build<Counter>("nodeos_prescreen_deprioritized_trxs_total", "number of pre-screened transactions failing tapos or authorization")}
+                          , .num_dropped{build<Counter>("nodeos_prescreen_dropped_trxs_total", "number of expired or duplicate transactions dropped by pre-screening")}
+                          , .screen_time_us{build<Counter>("nodeos_prescreen_time_us_total", "time spent pre-screening on read-only threads")}
+                          , .main_thread_saved_us{build<Counter>("nodeos_prescreen_main_thread_saved_us_total", "estimated main thread time saved by pre-screening")} }
+       , ro_window_metrics{ .write_window_us{build<Gauge>("nodeos_ro_write_window_us", "length chosen for the last write window")}
+                          , .read_window_us{build<Gauge>("nodeos_ro_read_window_us", "length chosen for the last read window, 0 when skipped")}
+                          , .avg_read_task_us{build<Gauge>("nodeos_ro_avg_read_task_us", "moving average of the execution time of a read task")}
+                          , .read_window_elapsed_us{build<Counter>("nodeos_ro_read_window_elapsed_us_total", "time spent in read windows")}
+                          , .read_window_tasks{build<Counter>("nodeos_ro_read_window_tasks_total", "number of read tasks executed in read windows")}
+                          , .write_windows{family<Counter>("nodeos_ro_write_windows_total", "number of write windows by what their length was chosen from")}
+                          , .read_windows{family<Counter>("nodeos_ro_read_windows_total", "number of read windows by what their length was chosen from")}
+                          , .queue_wait_us{family<prometheus::Histogram>("nodeos_exec_queue_wait_us", "time tasks waited in an executor queue before being executed")} }
+       , recovered_key_cache_hits(build<Counter>("nodeos_recovered_key_cache_hits_total", "number of signatures whose public key was found in the recovered key cache"))
+       , recovered_key_cache_misses(build<Counter>("nodeos_recovered_key_cache_misses_total", "number of signatures recovered and added to the recovered key cache"))
+       , recovered_key_cache_entries(build<Gauge>("nodeos_recovered_key_cache_entries", "current number of entries in the recovered key cache"))
+       , recovered_key_cache_hit_ratio(build<Gauge>("nodeos_recovered_key_cache_hit_ratio", "ratio of recovered key cache lookups that were hits since startup"))
        , bytes_transferred(build<Counter>("exposer_transferred_bytes_total",
                                           "total number of bytes for responses to prometheus scrape requests"))
        , num_scrapes(build<Counter>("exposer_scrapes_total", "total number of prometheus scrape requests received")) {}
 
    std::string report() {
+      update(chain::recovered_key_cache::instance().get_stats());
       const prometheus::TextSerializer serializer;
       auto                             result = serializer.Serialize(registry.Collect());
       bytes_transferred.Increment(result.size());
@@ -196,6 +260,15 @@ struct catalog_type {
       return result;
    }
 
+   void update(const chain::recovered_key_cache::stats& stats) {
+      // the cache keeps totals, counters are incremented by the change since the last scrape
+      recovered_key_cache_hits.Increment(stats.hits - last_recovered_key_cache_stats.hits);
+      recovered_key_cache_misses.Increment(stats.misses - last_recovered_key_cache_stats.misses);
+      recovered_key_cache_entries.Set(stats.entries);
+      recovered_key_cache_hit_ratio.Set(stats.hit_ratio());
+      last_recovered_key_cache_stats = stats;
+   }
+
    void update(const http_plugin::metrics& metrics) {
       http_request_counts.Add({{"handler", metrics.target}}).Increment(1);
    }
@@ -230,6 +303,9 @@ struct catalog_type {
          add_and_set_gauge(p2p_metrics.block_sync_bytes_received, peer.block_sync_bytes_received);
          add_and_set_gauge(p2p_metrics.block_sync_bytes_sent, peer.block_sync_bytes_sent);
          add_and_set_gauge(p2p_metrics.block_sync_throttling, peer.block_sync_throttling);
+         add_and_set_gauge(p2p_metrics.writes, peer.writes);
+         add_and_set_gauge(p2p_metrics.write_buffers, peer.write_buffers);
+         add_and_set_gauge(p2p_metrics.bytes_per_write, peer.writes ? double(peer.bytes_sent) / peer.writes : 0.0);
          add_and_set_gauge(p2p_metrics.connection_start_time, peer.connection_start_time.count());
       }
    }
@@ -269,6 +345,44 @@ struct catalog_type {
       update(speculative_metrics, metrics);
    }
 
+   void update(const producer_plugin::prescreen_metrics& metrics) {
+      prescreen_metrics.num_screened.Increment(metrics.num_screened);
+      prescreen_metrics.num_likely_good.Increment(metrics.num_likely_good);
+      prescreen_metrics.num_deprioritized.Increment(metrics.num_deprioritized);
+      prescreen_metrics.num_dropped.Increment(metrics.num_dropped);
+      prescreen_metrics.screen_time_us.Increment(metrics.screen_time_us);
+      prescreen_metrics.main_thread_saved_us.Increment(metrics.main_thread_saved_us);
+   }
+
+   // upper bounds of the buckets of appbase::queue_wait_histogram but the last, which is +Inf
+   static const prometheus::Histogram::BucketBoundaries& queue_wait_boundaries() {
+      static const prometheus::Histogram::BucketBoundaries boundaries = []() {
+         prometheus::Histogram::BucketBoundaries b;
+         for (size_t n = 0; n + 1 < appbase::queue_wait_histogram::num_buckets; ++n)
+            b.push_back(double((uint64_t(1) << n) - 1));
+         return b;
+      }();
+      return boundaries;
+   }
+
+   void update(const producer_plugin::ro_window_metrics& metrics) {
+      auto& m = ro_window_metrics;
+      m.write_window_us.Set(metrics.write_window_us);
+      m.read_window_us.Set(metrics.read_window_us);
+      m.avg_read_task_us.Set(metrics.avg_read_task_us);
+      m.read_window_elapsed_us.Increment(metrics.read_window_elapsed_us);
+      m.read_window_tasks.Increment(metrics.read_window_tasks);
+      m.write_windows.Add({{"reason", to_string(metrics.write_window_reason)}}).Increment(1);
+      m.read_windows.Add({{"reason", to_string(metrics.read_window_reason)}}).Increment(1);
+      for (const auto& [queue, h] : {std::pair{"read_only", &metrics.read_only_wait},
+                                     std::pair{"read_exclusive", &metrics.read_exclusive_wait},
+                                     std::pair{"read_write", &metrics.read_write_wait}}) {
+         if (h->count > 0)
+            m.queue_wait_us.Add({{"queue", queue}}, queue_wait_boundaries())
+               .ObserveMultiple(std::vector<double>(h->buckets.begin(), h->buckets.end()), double(h->sum_us));
+      }
+   }
+
    void update(const incoming_block_metrics& metrics) {
       trxs_incoming_total.Increment(metrics.trxs_incoming_total);
       blocks_incoming.Increment(1);
@@ -316,6 +430,14 @@ struct catalog_type {
               [&strand, this](const speculative_block_metrics& metrics) {
                  strand.post([metrics, this]() { update(metrics); });
               });
+      producer.register_update_prescreen_metrics(
+              [&strand, this](const producer_plugin::prescreen_metrics& metrics) {
+                 strand.post([metrics, this]() { update(metrics); });
+              });
+      producer.register_update_ro_window_metrics(
+              [&strand, this](const producer_plugin::ro_window_metrics& metrics) {
+                 strand.post([metrics, this]() { update(metrics); });
+              });
 
       auto& chain = app().get_plugin<chain_plugin>().chain();
       chain.register_update_produced_block_metrics(
@@ -329,4 +451,197 @@ struct catalog_type {
    }
 };
 
+// Bounds the label values of a metric family to the n keys with the most accesses, all other keys are reported under a
+// single "other" label value. Accesses are decayed by half at every reselection so that the labelled keys follow the
+// current load. Keys are admitted as soon as they are seen while fewer than n are labelled.
+template <typename Key>
+class top_n_labels {
+public:
+   explicit top_n_labels(size_t n) : n(n) {}
+
+   /// @return true if key has its own label values, false if it is reported as "other"
+   bool record(const Key& key, uint64_t accesses) {
+      scores[key] += accesses;
+      if (labelled.contains(key))
+         return true;
+      if (labelled.size() < n) {
+         labelled.insert(key);
+         return true;
+      }
+      return false;
+   }
+
+   /// select the n keys with the highest scores, remove_series is called for each key no longer labelled
+   template <typename F>
+   void reselect(F&& remove_series) {
+      std::vector<std::pair<uint64_t, Key>> ranked;
+      ranked.reserve(scores.size());
+      for (const auto& [key, score] : scores)
+         ranked.emplace_back(score, key);
+      std::ranges::sort(ranked, std::greater<>{});
+
+      std::set<Key> selected;
+      for (size_t i = 0; i < ranked.size() && i < n; ++i)
+         selected.insert(ranked[i].second);
+      for (const auto& key : labelled) {
+         if (!selected.contains(key))
+            remove_series(key);
+      }
+      labelled = std::move(selected);
+
+      // decay, and only remember enough keys to rank the next selection
+      scores.clear();
+      for (size_t i = 0; i < ranked.size() && i < max_scored * n; ++i) {
+         if (ranked[i].first / 2 > 0)
+            scores.emplace(ranked[i].second, ranked[i].first / 2);
+      }
+   }
+
+private:
+   static constexpr size_t  max_scored = 8;
+   const size_t             n;
+   std::map<Key, uint64_t>  scores;
+   std::set<Key>            labelled;
+};
+
+// contract table accesses recorded by the db access tracer of the controller, labelled by table and by receiver. Kept
+// in their own registry, served by /v1/prometheus/db_access, so that their cardinality does not weigh on the scrapes
+// of the nodeos metrics. Only the max_labelled most accessed tables and receivers are labelled, see top_n_labels.
+struct db_access_catalog_type {
+
+   using Counter   = prometheus::Counter;
+   using Histogram = prometheus::Histogram;
+
+   static constexpr size_t   max_labelled     = 256;
+   static constexpr uint32_t reselect_blocks  = 120; // once a minute
+   inline static const std::string other_label = "other";
+
+   template <typename T>
+   prometheus::Family<T>& family(const std::string& name, const std::string& help) {
+      return prometheus::detail::Builder<T>{}.Name(name).Help(help).Register(registry);
+   }
+
+   prometheus::Registry registry;
+   Counter& blocks;
+   Counter& transactions;
+   prometheus::Family<Counter>&   table_reads;
+   prometheus::Family<Counter>&   table_writes;
+   prometheus::Family<Counter>&   table_read_bytes;
+   prometheus::Family<Counter>&   table_write_bytes;
+   prometheus::Family<Counter>&   table_rows;
+   prometheus::Family<Histogram>& table_access_bytes;
+   prometheus::Family<Counter>&   account_reads;
+   prometheus::Family<Counter>&   account_writes;
+   prometheus::Family<Counter>&   account_read_bytes;
+   prometheus::Family<Counter>&   account_write_bytes;
+   top_n_labels<std::pair<chain::account_name, chain::table_name>> top_tables{max_labelled};
+   top_n_labels<chain::account_name>                                 top_accounts{max_labelled};
+   uint32_t                                                          blocks_since_reselect = 0;
+
+   db_access_catalog_type()
+       : blocks(family<Counter>("nodeos_db_access_blocks_total", "number of blocks traced").Add({}))
+       , transactions(family<Counter>("nodeos_db_access_trxs_total", "number of traced transactions accessing contract tables").Add({}))
+       , table_reads(family<Counter>("nodeos_db_access_table_reads_total", "number of row reads of a contract table"))
+       , table_writes(family<Counter>("nodeos_db_access_table_writes_total", "number of row writes of a contract table"))
+       , table_read_bytes(family<Counter>("nodeos_db_access_table_read_bytes_total", "bytes of rows read from a contract table"))
+       , table_write_bytes(family<Counter>("nodeos_db_access_table_write_bytes_total", "bytes of rows written to a contract table"))
+       , table_rows(family<Counter>("nodeos_db_access_table_rows_total", "number of distinct rows of a contract table accessed, summed over blocks"))
+       , table_access_bytes(family<Histogram>("nodeos_db_access_table_access_bytes", "row accesses of a contract table by bytes"))
+       , account_reads(family<Counter>("nodeos_db_access_account_reads_total", "number of row reads by the actions of a receiver"))
+       , account_writes(family<Counter>("nodeos_db_access_account_writes_total", "number of row writes by the actions of a receiver"))
+       , account_read_bytes(family<Counter>("nodeos_db_access_account_read_bytes_total", "bytes of rows read by the actions of a receiver"))
+       , account_write_bytes(family<Counter>("nodeos_db_access_account_write_bytes_total", "bytes of rows written by the actions of a receiver")) {}
+
+   // upper bounds of the buckets of db_access_table_stats::bytes_histogram but the last, which is +Inf
+   static const Histogram::BucketBoundaries& bytes_boundaries() {
+      static const Histogram::BucketBoundaries boundaries = []() {
+         Histogram::BucketBoundaries b;
+         for (size_t n = 0; n + 1 < chain::db_access_table_stats::num_bytes_buckets; ++n)
+            b.push_back(double((uint64_t(1) << n) - 1));
+         return b;
+      }();
+      return boundaries;
+   }
+
+   std::string report() {
+      const prometheus::TextSerializer serializer;
+      return serializer.Serialize(registry.Collect());
+   }
+
+   static prometheus::Labels table_labels(const std::pair<chain::account_name, chain::table_name>& t) {
+      return {{"code", t.first.to_string()}, {"table", t.second.to_string()}};
+   }
+
+   static prometheus::Labels account_labels(const chain::account_name& receiver) {
+      return {{"receiver", receiver.to_string()}};
+   }
+
+   template <typename T>
+   static void remove_series(prometheus::Family<T>& family, const prometheus::Labels& labels) {
+      if (family.Has(labels))
+         family.Remove(&family.Add(labels));
+   }
+
+   // tables and receivers that dropped out of the most accessed no longer have their own series
+   void reselect() {
+      top_tables.reselect([this](const auto& t) {
+         const auto labels = table_labels(t);
+         remove_series(table_reads, labels);
+         remove_series(table_writes, labels);
+         remove_series(table_read_bytes, labels);
+         remove_series(table_write_bytes, labels);
+         remove_series(table_rows, labels);
+         if (table_access_bytes.Has(labels))
+            table_access_bytes.Remove(&table_access_bytes.Add(labels, bytes_boundaries()));
+      });
+      top_accounts.reselect([this](const auto& a) {
+         const auto labels = account_labels(a);
+         remove_series(account_reads, labels);
+         remove_series(account_writes, labels);
+         remove_series(account_read_bytes, labels);
+         remove_series(account_write_bytes, labels);
+      });
+   }
+
+   void update(const chain::db_access_block_summary& summary) {
+      blocks.Increment(1);
+      transactions.Increment(summary.transactions);
+      if (++blocks_since_reselect >= reselect_blocks) {
+         blocks_since_reselect = 0;
+         reselect();
+      }
+      for (const auto& t : summary.tables) {
+         const std::pair key{t.code, t.table};
+         const prometheus::Labels labels = top_tables.record(key, t.reads + t.writes)
+                                              ? table_labels(key)
+                                              : prometheus::Labels{{"code", other_label}, {"table", other_label}};
+         table_reads.Add(labels).Increment(t.reads);
+         table_writes.Add(labels).Increment(t.writes);
+         table_read_bytes.Add(labels).Increment(t.read_bytes);
+         table_write_bytes.Add(labels).Increment(t.write_bytes);
+         table_rows.Add(labels).Increment(t.rows);
+         table_access_bytes.Add(labels, bytes_boundaries())
+            .ObserveMultiple(std::vector<double>(t.bytes_histogram.begin(), t.bytes_histogram.end()), double(t.read_bytes + t.write_bytes));
+      }
+      for (const auto& a : summary.accounts) {
+         const prometheus::Labels labels = top_accounts.record(a.receiver, a.reads + a.writes)
+                                              ? account_labels(a.receiver)
+                                              : prometheus::Labels{{"receiver", other_label}};
+         account_reads.Add(labels).Increment(a.reads);
+         account_writes.Add(labels).Increment(a.writes);
+         account_read_bytes.Add(labels).Increment(a.read_bytes);
+         account_write_bytes.Add(labels).Increment(a.write_bytes);
+      }
+   }
+
+   void register_update_handlers(boost::asio::io_context::strand& strand) {
+      auto* tracer = app().get_plugin<chain_plugin>().chain().get_db_access_tracer(false);
+      if (!tracer)
+         return;
+      tracer->register_summary_callback([&strand, this](const chain::db_access_block_summary& summary) {
+         strand.post([summary, this]() { update(summary); });
+      });
+   }
+};
+
 } // namespace eosio::metrics
@@ -20,6 +20,7 @@ namespace eosio {
       eosio::chain::named_thread_pool<struct prom> _prometheus_thread_pool;
       boost::asio::io_context::strand              _prometheus_strand{_prometheus_thread_pool.get_executor()};
       metrics::catalog_type                        _catalog;
+      metrics::db_access_catalog_type              _db_access_catalog;
       fc::microseconds                             _max_response_time_us;
    };
 
@@ -44,19 +45,27 @@ namespace eosio {
             results(_impl->_catalog.report());
          });
       }
+
+      void db_access(const fc::variant_object&, chain::plugin_interface::next_function<std::string> results) {
+         _impl->_prometheus_strand.post([this, results=std::move(results)]() {
+            results(_impl->_db_access_catalog.report());
+         });
+      }
    };
    using metrics_params = fc::variant_object;
 
 
    void prometheus_plugin::plugin_initialize(const variables_map& options) {
       my->_catalog.register_update_handlers(my->_prometheus_strand);
+      my->_db_access_catalog.register_update_handlers(my->_prometheus_strand);
 
       auto& _http_plugin = app().get_plugin<http_plugin>();
       my->_max_response_time_us = _http_plugin.get_max_response_time();
 
       prometheus_api_handle handle{my.get()};
       app().get_plugin<http_plugin>().add_async_api({
-        CALL_ASYNC_WITH_400(prometheus, prometheus, handle, eosio, metrics, std::string, 200, http_params_types::no_params)}
+        CALL_ASYNC_WITH_400(prometheus, prometheus, handle, eosio, metrics, std::string, 200, http_params_types::no_params),
+        CALL_ASYNC_WITH_400(prometheus, prometheus, handle, eosio, db_access, std::string, 200, http_params_types::no_params)}
         , http_content_type::plaintext);
    }
 
@@ -6,13 +6,20 @@
 #include <eosio/chain/types.hpp>
 #include <eosio/chain/controller.hpp>
 
+#include <fc/io/io_uring_reader.hpp>
+#include <fc/scoped_exit.hpp>
+
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/beast/websocket.hpp>
 #include <memory>
 
+#include <unistd.h>
+#include <zlib.h>
+
 extern const char* const state_history_plugin_abi;
 
 namespace eosio::state_history {
@@ -37,12 +44,25 @@ class session final : public session_base {
 public:
    session(SocketType&& s, chain::controller& controller,
            std::optional<log_catalog>& trace_log, std::optional<log_catalog>& chain_state_log, std::optional<log_catalog>& finality_data_log,
-           GetBlockID&& get_block_id, GetBlock&& get_block, OnDone&& on_done, fc::logger& logger) :
+           GetBlockID&& get_block_id, GetBlock&& get_block, OnDone&& on_done, fc::logger& logger, bool use_io_uring = false) :
     strand(s.get_executor()), stream(std::move(s)), wake_timer(strand), controller(controller),
     trace_log(trace_log), chain_state_log(chain_state_log), finality_data_log(finality_data_log),
     get_block_id(get_block_id), get_block(get_block), on_done(on_done), logger(logger), remote_endpoint_string(get_remote_endpoint_string()) {
       fc_ilog(logger, "incoming state history connection from ${a}", ("a", remote_endpoint_string));
 
+      if(use_io_uring && fc::io_uring_reader::is_supported()) {
+         try {
+            log_reader.emplace(log_read_window_size / log_read_op_size);
+            log_reader_event.emplace(strand, dup(log_reader->event_fd()));
+            log_read_window.resize(log_read_window_size);
+            log_reader->register_buffer(log_read_window);
+         } catch(...) {
+            fc_wlog(logger, "unable to set up io_uring for state history connection from ${a}, reading log entries synchronously", ("a", remote_endpoint_string));
+            log_reader_event.reset();
+            log_reader.reset();
+         }
+      }
+
       boost::asio::co_spawn(strand, read_loop(), [&](std::exception_ptr e) {check_coros_done(e);});
    }
 
@@ -201,6 +221,11 @@ private:
       history_pack_varuint64(ds, log_stream->get_uncompressed_size());
       co_await stream.async_write_some(false, boost::asio::buffer(buff, ds.tellp()));
 
+      if(log_reader) {
+         co_await write_log_entry_async_read(*log_stream, buff, sizeof(buff));
+         co_return;
+      }
+
       bio::filtering_istreambuf decompression_stream = log_stream->get_stream();
       std::streamsize red = 0;
       while((red = bio::read(decompression_stream, buff, sizeof(buff))) != -1) {
@@ -210,6 +235,54 @@ private:
       }
    }
 
+   /// reads the compressed entry a window at a time via io_uring, so that the strand's thread is not blocked on the disk
+   /// while the reads are in flight, and inflates each window into out as it arrives
+   boost::asio::awaitable<void> write_log_entry_async_read(ship_log_entry& entry, char* out, size_t out_size) {
+      z_stream zs = {};
+      EOS_ASSERT(inflateInit(&zs) == Z_OK, chain::plugin_exception, "failed to initialize state history log decompression");
+      auto end_inflate = fc::make_scoped_exit([&zs]() { inflateEnd(&zs); });
+
+      const uint64_t end = entry.compressed_data_offset + entry.compressed_data_size;
+      for(uint64_t pos = entry.compressed_data_offset; pos < end;) {
+         const size_t window = std::min<uint64_t>(log_read_window_size, end - pos);
+         size_t num_ops = 0;
+         for(size_t o = 0; o < window; o += log_read_op_size)
+            log_read_ops[num_ops++] = {.fd = entry.device.native_handle(), .offset = pos + o, .buffer = log_read_window.data() + o,
+                              .size = (uint32_t)std::min(log_read_op_size, window - o)};
+         const std::span<fc::io_uring_reader::read_op> batch(log_read_ops.data(), num_ops);
+
+         log_reader->submit(batch);
+         if(pos + window < end)
+            entry.device.read_ahead(pos + window, std::min<uint64_t>(log_read_window_size, end - pos - window));
+         while(log_reader->poll())
+            co_await log_reader_event->async_wait(boost::asio::posix::descriptor_base::wait_read, boost::asio::use_awaitable);
+
+         for(fc::io_uring_reader::read_op& op : batch) {
+            if(op.result != (ssize_t)op.size) //failed or short, retry synchronously
+               entry.device.read_batch({&op, 1});
+            EOS_ASSERT(op.result == (ssize_t)op.size, chain::plugin_exception, "unexpected end of state history log");
+         }
+         pos += window;
+
+         zs.next_in  = (Bytef*)log_read_window.data();
+         zs.avail_in = window;
+         while(true) {
+            zs.next_out  = (Bytef*)out;
+            zs.avail_out = out_size;
+            const int ret = inflate(&zs, Z_NO_FLUSH);
+            EOS_ASSERT(ret == Z_OK || ret == Z_STREAM_END || ret == Z_BUF_ERROR, chain::plugin_exception,
+                       "failed to decompress state history log entry: ${e}", ("e", zs.msg ? zs.msg : ""));
+            if(const size_t produced = out_size - zs.avail_out)
+               co_await stream.async_write_some(false, boost::asio::buffer(out, produced));
+            if(ret == Z_STREAM_END)
+               co_return;
+            if(zs.avail_in == 0 && zs.avail_out)
+               break;
+         }
+      }
+      EOS_THROW(chain::plugin_exception, "state history log entry ended before the end of its compressed data");
+   }
+
    boost::asio::awaitable<void> write_loop() {
       co_await readwrite_coro_exception_wrapper([this]() -> boost::asio::awaitable<void> {
          get_status_result_v1 current_status_result;
@@ -313,6 +386,14 @@ private:
    unsigned                          coros_running = 0;
    std::atomic_flag                  has_logged_exception;  //left as atomic_flag for useful test_and_set() interface
 
+   static constexpr size_t           log_read_window_size = 1024*1024;
+   static constexpr size_t           log_read_op_size     = 256*1024;
+   //the window and ops must outlive log_reader, which waits for any reads still in flight on destruction
+   std::vector<char>                                                             log_read_window;
+   std::array<fc::io_uring_reader::read_op, log_read_window_size/log_read_op_size> log_read_ops;
+   std::optional<fc::io_uring_reader>                                            log_reader;       //unset: log entries are read synchronously
+   std::optional<boost::asio::posix::stream_descriptor>                          log_reader_event;
+
    ///these items must only ever be touched on the main thread
    std::deque<bool>                  queued_status_requests;  //false for v0, true for v1
 
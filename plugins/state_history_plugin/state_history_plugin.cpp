@@ -58,6 +58,7 @@ private:
    std::optional<scoped_connection> accepted_block_connection;
    string                           endpoint_address;
    string                           unix_path;
+   bool                             use_io_uring = false;
    state_history::trace_converter   trace_converter;
 
    named_thread_pool<struct ship>   thread_pool;
@@ -119,7 +120,7 @@ public:
                                                      app().executor().post(priority::high, exec_queue::read_write, [conn, this]() {
                                                         connections.erase(connections.find(conn));
                                                      });
-                                                  }, _log));
+                                                  }, _log, use_io_uring));
                });
             });
          });
@@ -242,6 +243,8 @@ void state_history_plugin::set_program_options(options_description& cli, options
            "your internal network.");
    options("state-history-unix-socket-path", bpo::value<string>(),
            "the path (relative to data-dir) to create a unix socket upon which to listen for incoming connections.");
+   options("state-history-io-uring", bpo::value<bool>()->default_value(false),
+           "read state history log entries sent to clients with io_uring, when supported by the kernel, instead of blocking reads on the connection's thread");
    options("trace-history-debug-mode", bpo::bool_switch()->default_value(false), "enable debug mode for trace history");
    options("state-history-log-retain-blocks", bpo::value<uint32_t>(), "if set, periodically prune the state history files to store only configured number of most recent blocks");
 }
@@ -279,6 +282,7 @@ void state_history_plugin_impl::plugin_initialize(const variables_map& options)
          resmon_plugin->monitor_directory(state_history_dir);
 
       endpoint_address = options.at("state-history-endpoint").as<string>();
+      use_io_uring = options.at("state-history-io-uring").as<bool>();
 
       if(options.count("state-history-unix-socket-path")) {
          std::filesystem::path sock_path = options.at("state-history-unix-socket-path").as<string>();
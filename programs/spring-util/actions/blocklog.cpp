@@ -75,6 +75,7 @@ void blocklog_actions::setup(CLI::App& app) {
    // subcommand - make index
    auto* make_index = sub->add_subcommand("make-index", "Create blocks.index from blocks.log. Must give 'blocks-dir'. Give 'output-file' relative to current directory or absolute path (default is <blocks-dir>/blocks.index).")->callback([err_guard]() { err_guard(&blocklog_actions::make_index); });
    make_index->add_option("--output-file,-o", opt->output_file, "The file to write the output to (absolute or relative path).  If not specified then output is to stdout.");
+   make_index->add_option("--threads", opt->threads, "The number of threads used to index blocks.log in parallel chunks.");
 
    // subcommand - trim blocklog
    auto* trim_blocklog = sub->add_subcommand("trim-blocklog", "Trim blocks.log and blocks.index. Must give 'blocks-dir' and 'first' and/or 'last'.")->callback([err_guard]() { err_guard(&blocklog_actions::trim_blocklog); });
@@ -99,8 +100,22 @@ void blocklog_actions::setup(CLI::App& app) {
    merge_blocks->add_option("--blocks-dir", opt->blocks_dir, "The location of the blocks directory (absolute path or relative to the current directory).");
    merge_blocks->add_option("--output-dir", opt->output_dir, "The output directory for the merged block log.")->required();
 
+   // subcommand - compress blocks
+   auto* compress_blocks = sub->add_subcommand("compress", "Compress block log files in 'blocks-dir' with the file pattern 'blocks-\\d+-\\d+.[log,index]' to 'blocks-\\d+-\\d+.zlog' "
+          "which can be read in place when 'blocks-dir' is the blocks-retained-dir of nodeos.")->callback([err_guard]() { err_guard(&blocklog_actions::compress_blocks); });
+   compress_blocks->add_option("--blocks-dir", opt->blocks_dir, "The location of the blocks directory (absolute path or relative to the current directory).");
+   compress_blocks->add_option("--blocks-per-frame", opt->blocks_per_frame, "The number of blocks compressed together, reading a block decompresses all the blocks of its frame.");
+   compress_blocks->add_flag("--keep", opt->keep, "Keep the uncompressed block log files.");
+
+   // subcommand - decompress blocks
+   auto* decompress_blocks = sub->add_subcommand("decompress", "Restore 'blocks-\\d+-\\d+.[log,index]' from each 'blocks-\\d+-\\d+.zlog' in 'blocks-dir'.")->callback([err_guard]() { err_guard(&blocklog_actions::decompress_blocks); });
+   decompress_blocks->add_option("--blocks-dir", opt->blocks_dir, "The location of the blocks directory (absolute path or relative to the current directory).");
+   decompress_blocks->add_flag("--keep", opt->keep, "Keep the compressed block log files.");
+
    // subcommand - smoke test
-   sub->add_subcommand("smoke-test", "Quick test that blocks.log and blocks.index are well formed and agree with each other.")->callback([err_guard]() { err_guard(&blocklog_actions::smoke_test); });
+   auto* smoke_test = sub->add_subcommand("smoke-test", "Quick test that blocks.log and blocks.index are well formed and agree with each other.")->callback([err_guard]() { err_guard(&blocklog_actions::smoke_test); });
+   smoke_test->add_flag("--full", opt->full, "Deserialize every block and check that it agrees with blocks.index and links to the previous block.");
+   smoke_test->add_option("--threads", opt->threads, "The number of threads used to check blocks in parallel chunks with --full.");
 
    // subcommand - vacuum
    sub->add_subcommand("vacuum", "Vacuum a pruned blocks.log in to an un-pruned blocks.log")->callback([err_guard]() { err_guard(&blocklog_actions::do_vacuum); });
@@ -143,7 +158,7 @@ int blocklog_actions::make_index() {
    report_time rt("making index");
    const auto log_level = fc::logger::get(DEFAULT_LOGGER).get_log_level();
    fc::logger::get(DEFAULT_LOGGER).set_log_level(fc::log_level::debug);
-   block_log::construct_index(block_file.generic_string(), out_file.generic_string());
+   block_log::construct_index(block_file.generic_string(), out_file.generic_string(), opt->threads);
    fc::logger::get(DEFAULT_LOGGER).set_log_level(log_level);
    rt.report();
 
@@ -228,7 +243,13 @@ int blocklog_actions::smoke_test() {
    using namespace std;
    std::filesystem::path block_dir = opt->blocks_dir;
    cout << "\nSmoke test of blocks.log and blocks.index in directory " << block_dir << '\n';
-   block_log::smoke_test(block_dir, 0);
+   if (opt->full) {
+      report_time rt("full smoke test");
+      block_log::full_smoke_test(block_dir, opt->threads);
+      rt.report();
+   } else {
+      block_log::smoke_test(block_dir, 0);
+   }
    cout << "\nno problems found\n"; // if get here there were no exceptions
    return 0;
 }
@@ -358,4 +379,20 @@ int blocklog_actions::split_blocks() {
 int blocklog_actions::merge_blocks() {
    block_log::merge_blocklogs(opt->blocks_dir, opt->output_dir);
    return 0;
+}
+
+int blocklog_actions::compress_blocks() {
+   report_time rt("compressing blocks");
+   auto n = block_log::compress_blocklogs(opt->blocks_dir, opt->blocks_per_frame, opt->keep);
+   rt.report();
+   ilog("compressed ${n} block log files", ("n", n));
+   return 0;
+}
+
+int blocklog_actions::decompress_blocks() {
+   report_time rt("decompressing blocks");
+   auto n = block_log::decompress_blocklogs(opt->blocks_dir, opt->keep);
+   rt.report();
+   ilog("decompressed ${n} block log files", ("n", n));
+   return 0;
 }
\ No newline at end of file
@@ -11,10 +11,14 @@ struct blocklog_options {
    uint32_t last_block = std::numeric_limits<uint32_t>::max();
    std::string output_dir = "";
    uint32_t stride = 100000;
+   uint32_t blocks_per_frame = block_log::default_blocks_per_compressed_frame;
+   uint32_t threads = 1;
 
    // flags
    bool no_pretty_print = false;
    bool as_json_array = false;
+   bool keep = false;
+   bool full = false;
 
    block_log_config blog_conf;
 };
@@ -40,4 +44,6 @@ protected:
 
    int split_blocks();
    int merge_blocks();
+   int compress_blocks();
+   int decompress_blocks();
 };
\ No newline at end of file
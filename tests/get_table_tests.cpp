@@ -678,4 +678,103 @@ BOOST_FIXTURE_TEST_CASE( get_table_next_key_test, validating_tester ) try {
 
 } FC_LOG_AND_RETHROW() /// get_table_next_key_test
 
+BOOST_FIXTURE_TEST_CASE( get_table_cursor_test, validating_tester ) try {
+   create_account("test"_n);
+
+   set_code( "test"_n, test_contracts::get_table_test_wasm() );
+   set_abi( "test"_n, test_contracts::get_table_test_abi() );
+   produce_block();
+
+   // duplicate secondary keys, which next_key can not page through one row at a time
+   for (uint64_t input : {2, 5, 5, 5, 7})
+      push_action("test"_n, "addnumobj"_n, "test"_n, mutable_variant_object()("input", input));
+   produce_block();
+
+   std::optional<eosio::chain_apis::tracked_votes> _tracked_votes;
+   chain_apis::read_only plugin(*(this->control), {}, {}, _tracked_votes, fc::microseconds::maximum(), fc::microseconds::maximum(), {});
+   chain_apis::read_only::get_table_rows_params params{};
+   params.json = true;
+   params.code = "test"_n;
+   params.scope = "test";
+   params.table = "numobjs"_n;
+   params.limit = 1;
+
+   // page through with the cursor, returning the primary keys in order
+   auto walk = [&](chain_apis::read_only::get_table_rows_params p) {
+      std::vector<uint64_t> keys;
+      p.cursor = "";
+      for (;;) {
+         auto res = get_table_rows_full(plugin, p, fc::time_point::maximum());
+         BOOST_REQUIRE(res.next_cursor.has_value());
+         for (const auto& row : res.rows)
+            keys.push_back(row["key"].as<uint64_t>());
+         if (!res.more) {
+            BOOST_TEST(res.next_cursor->empty());
+            break;
+         }
+         BOOST_REQUIRE(!res.next_cursor->empty());
+         BOOST_REQUIRE(keys.size() < 10u);
+         p.cursor = *res.next_cursor;
+      }
+      return keys;
+   };
+
+   // no next_cursor unless requested
+   BOOST_TEST(!get_table_rows_full(plugin, params, fc::time_point::maximum()).next_cursor.has_value());
+
+   params.key_type = "i64";
+   params.index_position = "1";
+   BOOST_TEST((walk(params) == std::vector<uint64_t>{0, 1, 2, 3, 4}));
+
+   params.index_position = "2"; // sec64
+   BOOST_TEST((walk(params) == std::vector<uint64_t>{0, 1, 2, 3, 4}));
+
+   params.reverse = true;
+   BOOST_TEST((walk(params) == std::vector<uint64_t>{4, 3, 2, 1, 0}));
+   params.reverse = false;
+
+   params.lower_bound = "5";
+   params.upper_bound = "5";
+   BOOST_TEST((walk(params) == std::vector<uint64_t>{1, 2, 3}));
+   params.lower_bound.clear();
+   params.upper_bound.clear();
+
+   // rows erased between pages are skipped, no row is returned twice
+   params.cursor = "";
+   auto res = get_table_rows_full(plugin, params, fc::time_point::maximum());
+   BOOST_REQUIRE(res.more);
+   BOOST_TEST(res.rows[0]["key"].as<uint64_t>() == 0u);
+   push_action("test"_n, "erasenumobj"_n, "test"_n, mutable_variant_object()("id", 1));
+   produce_block();
+   params.cursor = *res.next_cursor;
+   res = get_table_rows_full(plugin, params, fc::time_point::maximum());
+   BOOST_REQUIRE(res.rows.size() == 1u);
+   BOOST_TEST(res.rows[0]["key"].as<uint64_t>() == 2u);
+
+   // a cursor is only valid for the index and direction it was returned for
+   params.index_position = "3";
+   params.key_type = "i128";
+   BOOST_CHECK_THROW(plugin.get_table_rows(params, fc::time_point::maximum()), contract_table_query_exception);
+   params.index_position = "2";
+   params.key_type = "i64";
+   params.reverse = true;
+   BOOST_CHECK_THROW(plugin.get_table_rows(params, fc::time_point::maximum()), contract_table_query_exception);
+   params.reverse = false;
+   params.cursor = "not a cursor";
+   BOOST_CHECK_THROW(plugin.get_table_rows(params, fc::time_point::maximum()), contract_table_query_exception);
+
+   // stream: rows followed by the continuation line
+   params.cursor.reset();
+   params.limit = 10;
+   auto lines_v = plugin.get_table_rows_stream(params, fc::time_point::maximum())();
+   BOOST_REQUIRE(!std::holds_alternative<fc::exception_ptr>(lines_v));
+   auto lines = std::get<fc::variants>(std::move(lines_v));
+   BOOST_REQUIRE_EQUAL(lines.size(), 5u);
+   BOOST_TEST(lines[0]["key"].as<uint64_t>() == 0u);
+   BOOST_TEST(lines[3]["key"].as<uint64_t>() == 4u);
+   BOOST_TEST(lines[4]["more"].as_bool() == false);
+   BOOST_TEST(lines[4]["next_cursor"].as_string().empty());
+
+} FC_LOG_AND_RETHROW() /// get_table_cursor_test
+
 BOOST_AUTO_TEST_SUITE_END()
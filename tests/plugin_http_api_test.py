@@ -610,6 +610,27 @@ class PluginHttpTest(unittest.TestCase):
         ret_json = self.nodeos.processUrllibRequest(resource, command, payload, endpoint=endpoint)
         self.assertEqual(type(ret_json["payload"]["rows"]), list)
 
+        # batch with empty parameter
+        command = "batch"
+        ret_json = self.nodeos.processUrllibRequest(resource, command, endpoint=endpoint)
+        self.assertEqual(ret_json["code"], 400)
+        self.assertEqual(ret_json["error"]["code"], 3200006)
+        # batch with invalid parameter
+        ret_json = self.nodeos.processUrllibRequest(resource, command, self.http_post_invalid_param, endpoint=endpoint)
+        self.assertEqual(ret_json["code"], 400)
+        self.assertEqual(ret_json["error"]["code"], 3200006)
+        # batch with valid parameter, results in request order with their own codes
+        payload = [{"path":"get_producers", "params":{"json":"true","lower_bound":""}},
+                   {"path":"/v1/chain/get_currency_balance", "params":{"code":"eosio.token", "account":"unknown"}},
+                   {"path":"get_info", "params":{}}]
+        ret_json = self.nodeos.processUrllibRequest(resource, command, payload, endpoint=endpoint)
+        self.assertEqual(len(ret_json["payload"]), 3)
+        self.assertEqual(ret_json["payload"][0]["code"], 200)
+        self.assertEqual(type(ret_json["payload"][0]["result"]["rows"]), list)
+        self.assertEqual(ret_json["payload"][1]["code"], 400)
+        self.assertEqual(ret_json["payload"][2]["code"], 400)
+        self.assertEqual(ret_json["payload"][2]["result"]["error"]["code"], 3200006)
+
         # get_producer_schedule with empty parameter
         command = "get_producer_schedule"
         ret_json = self.nodeos.processUrllibRequest(resource, command, endpoint=endpoint)
@@ -59,6 +59,8 @@ int main(int argc, char** argv) {
          ("monitor-max-lag-duration-us", bpo::value<int64_t>(&max_lag_duration_us)->default_value(1000000), "Max microseconds that transaction generation can be in violation before quitting. Defaults to 1000000 (1s).")
          ("log-dir", bpo::value<std::string>(&trx_gen_base_config._log_dir), "set the logs directory")
          ("stop-on-trx-failed", bpo::value<bool>(&trx_gen_base_config._stop_on_trx_failed)->default_value(true), "stop transaction generation if sending fails.")
+         ("signer-threads", bpo::value<uint16_t>(&trx_gen_base_config._signer_threads)->default_value(2), "Number of threads signing and serializing transactions ahead of sending. 0 signs each transaction on the sending thread. Defaults to 2.")
+         ("presigned-trxs", bpo::value<uint32_t>(&trx_gen_base_config._presigned_trxs)->default_value(1000), "Number of transactions the signer threads keep signed ahead of sending. Must be greater than 0 when signer-threads is set. Defaults to 1000.")
          ("abi-file", bpo::value<std::string>(&user_trx_config._abi_data_file_path), "The path to the contract abi file to use for the supplied transaction action data")
          ("actions-data", bpo::value<std::string>(&user_trx_config._actions_data_json_file_or_str), "The json actions data file or json actions data description string to use")
          ("actions-auths", bpo::value<std::string>(&user_trx_config._actions_auths_json_file_or_str), "The json actions auth file or json actions auths description string to use, containting authAcctName to activePrivateKey pairs.")
@@ -180,6 +182,12 @@ int main(int argc, char** argv) {
          cli.print(std::cerr);
          return INITIALIZE_FAIL;
       }
+
+      if(trx_gen_base_config._signer_threads > 0 && trx_gen_base_config._presigned_trxs == 0) {
+         ilog("Initialization error: presigned-trxs must be greater than 0 when signer-threads is set");
+         cli.print(std::cerr);
+         return INITIALIZE_FAIL;
+      }
    } catch(bpo::unknown_option& ex) {
       std::cerr << ex.what() << std::endl;
       cli.print(std::cerr);
@@ -8,6 +8,7 @@
 #include <fc/bitutil.hpp>
 #include <fc/io/raw.hpp>
 #include <regex>
+#include <thread>
 
 namespace eosio::testing {
    using namespace chain::literals;
@@ -113,6 +114,7 @@ namespace eosio::testing {
 
       ilog("Update each trx to qualify as unique and fresh timestamps, re-sign trx, and send each updated transactions via p2p transaction provider");
 
+      start_signers();
       _provider.setup();
       return true;
    }
@@ -181,7 +183,10 @@ namespace eosio::testing {
    void trx_generator::update_resign_transaction(chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
                                                  const fc::microseconds& trx_expiration, const chain::chain_id_type& chain_id, const chain::block_id_type& last_irr_block_id) {
       trx.actions.clear();
-      trx.actions = generate_actions();
+      {
+         std::lock_guard g(_generate_actions_mtx);
+         trx.actions = generate_actions();
+      }
       trx_generator_base::update_resign_transaction(trx, priv_key, nonce_prefix, nonce, trx_expiration, chain_id, last_irr_block_id);
    }
 
@@ -281,11 +286,13 @@ namespace eosio::testing {
       ilog("Update each trx to qualify as unique and fresh timestamps and update each action with unique generated account name if necessary,"
            " re-sign trx, and send each updated transactions via p2p transaction provider");
 
+      start_signers();
       _provider.setup();
       return true;
    }
 
    bool trx_generator_base::tear_down() {
+      stop_signers();
       _provider.teardown();
       _provider.log_trxs(_config._log_dir);
 
@@ -301,14 +308,19 @@ namespace eosio::testing {
    bool trx_generator_base::generate_and_send() {
       try {
          if (_trxs.size()) {
-            size_t index_to_send = _txcount % _trxs.size();
-            push_transaction(_trxs.at(index_to_send), ++_nonce_prefix, _nonce, _config._trx_expiration_us, _config._chain_id,
-                             _config._last_irr_block_id);
+            prepared_trx trx = _signed_trxs ? next_signed_trx() : prepare_trx(_txcount);
+            if (_txcount == 0) {
+               log_first_trx(_config._log_dir, trx._trx_id);
+            }
+            _provider.send(std::move(trx));
             ++_txcount;
          } else {
             elog("no transactions available to send");
             return false;
          }
+      } catch (const fc::exception &e) {
+         elog("${e}", ("e", e.to_detail_string()));
+         return false;
       } catch (const std::exception &e) {
          elog("${e}", ("e", e.what()));
          return false;
@@ -320,22 +332,92 @@ namespace eosio::testing {
       return true;
    }
 
-   void trx_generator_base::log_first_trx(const std::string& log_dir, const chain::signed_transaction& trx) {
+   void trx_generator_base::log_first_trx(const std::string& log_dir, const chain::transaction_id_type& trx_id) {
       std::ostringstream fileName;
       fileName << log_dir << "/first_trx_" << getpid() << ".txt";
       std::ofstream out(fileName.str());
 
-      out << std::string(trx.id()) << "\n";
+      out << std::string(trx_id) << "\n";
       out.close();
    }
 
-   void trx_generator_base::push_transaction(signed_transaction_w_signer& trx, uint64_t& nonce_prefix, uint64_t& nonce,
-                                             const fc::microseconds& trx_expiration, const chain::chain_id_type& chain_id, const chain::block_id_type& last_irr_block_id) {
-      update_resign_transaction(trx._trx, trx._signer, ++nonce_prefix, nonce, trx_expiration, chain_id, last_irr_block_id);
-      if (_txcount == 0) {
-         log_first_trx(_config._log_dir, trx._trx);
+   prepared_trx trx_generator_base::prepare_trx(uint64_t trx_num) {
+      // nonces derived from trx_num rather than incremented, so that transactions can be signed in any order on any thread
+      signed_transaction_w_signer trx = _trxs.at(trx_num % _trxs.size());
+      uint64_t nonce_prefix = _nonce_prefix + 1 + trx_num;
+      uint64_t nonce = _nonce + trx_num;
+      update_resign_transaction(trx._trx, trx._signer, nonce_prefix, nonce, _config._trx_expiration_us, _config._chain_id, _config._last_irr_block_id);
+      return _provider.prepare(trx._trx);
+   }
+
+   void trx_generator_base::start_signers() {
+      if (!_config._signer_threads || !_config._presigned_trxs || _trxs.empty()) {
+         ilog("Signing transactions on the sending thread");
+         return;
+      }
+
+      ilog("Start ${n} signer threads, presigning ${p} transactions", ("n", _config._signer_threads)("p", _config._presigned_trxs));
+      _signing_failed = false;
+      _next_trx_to_sign = 0;
+      _signed_trx_waits = 0;
+      _signed_trxs = std::make_unique<prepared_trx_ring>(_config._presigned_trxs);
+      _signer_thread_pool.start(_config._signer_threads, [this](const fc::exception& e) {
+         elog("Signer thread exception ${e}", ("e", e.to_detail_string()));
+         _signing_failed = true;
+      });
+
+      const fc::time_point start = fc::time_point::now();
+      for (uint32_t i = 0; i < _config._presigned_trxs; ++i) {
+         post_sign_trx();
+      }
+      while (_signed_trxs->size() < _config._presigned_trxs && !_signing_failed) {
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      ilog("Presigned ${n} transactions in ${t}us", ("n", _signed_trxs->size())("t", (fc::time_point::now() - start).count()));
+   }
+
+   void trx_generator_base::stop_signers() {
+      if (!_signed_trxs) {
+         return;
+      }
+      _signer_thread_pool.stop();
+      ilog("Sending thread waited for a signed transaction ${w} times, ${n} signed transactions unsent",
+           ("w", _signed_trx_waits)("n", _signed_trxs->size()));
+      _signed_trxs.reset();
+   }
+
+   void trx_generator_base::post_sign_trx() {
+      boost::asio::post(_signer_thread_pool.get_executor(), [this]() {
+         if (_signing_failed) {
+            return;
+         }
+         try {
+            if (!_signed_trxs->push(prepare_trx(_next_trx_to_sign++))) {
+               elog("Presigned transaction ring full");
+               _signing_failed = true;
+            }
+         } catch (const fc::exception& e) {
+            elog("Failed to sign transaction: ${e}", ("e", e.to_detail_string()));
+            _signing_failed = true;
+         } catch (const std::exception& e) {
+            elog("Failed to sign transaction: ${e}", ("e", e.what()));
+            _signing_failed = true;
+         }
+      });
+   }
+
+   prepared_trx trx_generator_base::next_signed_trx() {
+      std::optional<prepared_trx> trx = _signed_trxs->pop();
+      if (!trx) {
+         ++_signed_trx_waits;
+         do {
+            FC_ASSERT(!_signing_failed, "Signer threads failed to sign transactions");
+            std::this_thread::yield();
+            trx = _signed_trxs->pop();
+         } while (!trx);
       }
-      _provider.send(trx._trx);
+      post_sign_trx();
+      return std::move(*trx);
    }
 
    void trx_generator_base::stop_generation() {
@@ -7,6 +7,13 @@
 #include <eosio/chain/abi_serializer.hpp>
 #include <fc/io/json.hpp>
 
+#include <boost/lockfree/queue.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+
 namespace eosio::testing {
 
    struct signed_transaction_w_signer {
@@ -26,6 +33,53 @@ namespace eosio::testing {
       fc::crypto::private_key _second_act_priv_key;
    };
 
+   // Bounded lock-free queue of transactions signed and serialized ahead of sending, filled by the signer threads
+   // and drained by the sending thread. The slots and queue nodes are allocated at construction, transactions are
+   // moved in and out of the slots, so only their payloads, built by the signer threads, are allocated per transaction.
+   struct prepared_trx_ring {
+      explicit prepared_trx_ring(size_t capacity) : _slots(capacity), _free(capacity), _full(capacity), _capacity(capacity) {
+         for (size_t i = 0; i < capacity; ++i) {
+            _free.bounded_push(i);
+         }
+      }
+
+      prepared_trx_ring(const prepared_trx_ring&) = delete;
+      prepared_trx_ring& operator=(const prepared_trx_ring&) = delete;
+
+      /// @return false if the ring is full, trx is left as it is
+      bool push(prepared_trx&& trx) {
+         size_t i = 0;
+         if (!_free.pop(i)) {
+            return false;
+         }
+         _slots[i] = std::move(trx);
+         ++_size;
+         _full.bounded_push(i); // cannot fail, there are only capacity indexes
+         return true;
+      }
+
+      std::optional<prepared_trx> pop() {
+         size_t i = 0;
+         if (!_full.pop(i)) {
+            return {};
+         }
+         --_size;
+         std::optional<prepared_trx> trx(std::move(_slots[i]));
+         _free.bounded_push(i);
+         return trx;
+      }
+
+      size_t size() const { return _size; }
+      size_t capacity() const { return _capacity; }
+
+    private:
+      std::vector<prepared_trx>           _slots;
+      boost::lockfree::queue<size_t>      _free; // indexes of _slots available to push
+      boost::lockfree::queue<size_t>      _full; // indexes of _slots to pop, in push order
+      const size_t                        _capacity;
+      std::atomic<size_t>                 _size = 0;
+   };
+
    struct account_name_generator {
       // This account_name_generator provides the means to generate 12 character account names where the left-most 2 characters are reserved
       // to identify the trx generator.  The right 10 characters are determined based on incrementing through the allowed char_map one at a time
@@ -102,12 +156,15 @@ namespace eosio::testing {
       eosio::chain::block_id_type _last_irr_block_id = eosio::chain::block_id_type();
       std::string _log_dir = ".";
       bool _stop_on_trx_failed = true;
+      uint16_t _signer_threads = 2;     // 0 signs on the sending thread
+      uint32_t _presigned_trxs = 1000;  // transactions signed ahead of sending when signing on signer threads
 
       std::string to_string() const {
          std::ostringstream ss;
          ss << " generator id: " << _generator_id << " chain id: " << std::string(_chain_id) << " contract owner account: " 
             << _contract_owner_account << " trx expiration seconds: " << _trx_expiration_us.to_seconds() << " lib id: " << std::string(_last_irr_block_id)
-            << " log dir: " << _log_dir << " stop on trx failed: " << _stop_on_trx_failed;
+            << " log dir: " << _log_dir << " stop on trx failed: " << _stop_on_trx_failed << " signer threads: " << _signer_threads
+            << " presigned trxs: " << _presigned_trxs;
          return std::move(ss).str();
       };
    };
@@ -170,6 +227,12 @@ namespace eosio::testing {
       uint64_t _nonce = 0;
       uint64_t _nonce_prefix = 0;
 
+      std::unique_ptr<prepared_trx_ring> _signed_trxs;
+      std::atomic<uint64_t> _next_trx_to_sign = 0;
+      std::atomic<bool> _signing_failed = false;
+      uint64_t _signed_trx_waits = 0;
+      // declared after _signed_trxs, so that it is stopped before the ring is destroyed
+      eosio::chain::named_thread_pool<struct trx_signer> _signer_thread_pool;
 
       trx_generator_base(const trx_generator_base_config& trx_gen_base_config, const provider_base_config& provider_config);
 
@@ -178,9 +241,14 @@ namespace eosio::testing {
       virtual void update_resign_transaction(eosio::chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
                                      const fc::microseconds& trx_expiration, const eosio::chain::chain_id_type& chain_id, const eosio::chain::block_id_type& last_irr_block_id);
 
-      void push_transaction(signed_transaction_w_signer& trx, uint64_t& nonce_prefix,
-                            uint64_t& nonce, const fc::microseconds& trx_expiration, const eosio::chain::chain_id_type& chain_id,
-                            const eosio::chain::block_id_type& last_irr_block_id);
+      /// updates, re-signs and serializes a copy of transaction trx_num % _trxs.size(), thread safe once setup
+      prepared_trx prepare_trx(uint64_t trx_num);
+
+      /// starts the signer threads and waits for them to sign _presigned_trxs transactions
+      void start_signers();
+      void stop_signers();
+      void post_sign_trx();
+      prepared_trx next_signed_trx();
 
       void set_transaction_headers(eosio::chain::transaction& trx, const eosio::chain::block_id_type& last_irr_block_id, const fc::microseconds& expiration, uint32_t delay_sec = 0);
 
@@ -188,7 +256,7 @@ namespace eosio::testing {
                                                                   uint64_t& nonce, const fc::microseconds& trx_expiration, const eosio::chain::chain_id_type& chain_id,
                                                                   const eosio::chain::block_id_type& last_irr_block_id);
 
-      void log_first_trx(const std::string& log_dir, const eosio::chain::signed_transaction& trx);
+      void log_first_trx(const std::string& log_dir, const eosio::chain::transaction_id_type& trx_id);
 
       bool generate_and_send();
       bool tear_down();
@@ -222,6 +290,7 @@ namespace eosio::testing {
       eosio::chain::abi_serializer _abi;
       std::vector<fc::mutable_variant_object> _unpacked_actions;
       std::map<int, std::vector<std::string>> _acct_gen_fields;
+      std::mutex _generate_actions_mtx; // generate_actions is called from the signer threads
 
       const fc::microseconds abi_serializer_max_time = fc::seconds(10); // No risk to client side serialization taking a long time
 
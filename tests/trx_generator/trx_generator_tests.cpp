@@ -366,6 +366,145 @@ BOOST_AUTO_TEST_CASE(tps_cant_keep_up_monitored)
    BOOST_REQUIRE_LT(generator->_calls.size(), expected_trxs);
 }
 
+BOOST_AUTO_TEST_CASE(tps_jitter_tracker_report)
+{
+   const fc::time_point start{fc::microseconds{1000000}};
+   tps_jitter_tracker jitter(10, start);
+
+   // 10 in the first second, on schedule, 8 in the second, each 50ms late, 3 in the partial third second
+   for (int64_t i = 0; i < 10; ++i) {
+      const fc::time_point scheduled = start + fc::microseconds{i * 100000};
+      jitter.record_send(scheduled, scheduled);
+   }
+   for (int64_t i = 10; i < 18; ++i) {
+      const fc::time_point scheduled = start + fc::microseconds{i * 100000};
+      jitter.record_send(scheduled, scheduled + fc::microseconds{50000});
+   }
+   for (int64_t i = 20; i < 23; ++i) {
+      const fc::time_point scheduled = start + fc::microseconds{i * 100000};
+      jitter.record_send(scheduled, scheduled);
+   }
+
+   tps_jitter_report r = jitter.report(start + fc::microseconds{2500000});
+   BOOST_REQUIRE_EQUAL(r._target_tps, 10u);
+   BOOST_REQUIRE_EQUAL(r._trxs_sent, 21u);
+   BOOST_REQUIRE_CLOSE(r._achieved_tps, 8.4, 0.001);
+   BOOST_REQUIRE_EQUAL(r._windows, 2u);
+   BOOST_REQUIRE_EQUAL(r._min_window_tps, 8u);
+   BOOST_REQUIRE_EQUAL(r._max_window_tps, 10u);
+   BOOST_REQUIRE_CLOSE(r._window_tps_deviation, std::sqrt(2.0), 0.001);
+   BOOST_REQUIRE_EQUAL(r._avg_send_delay_us, 50000);
+   BOOST_REQUIRE_EQUAL(r._max_send_delay_us, 50000);
+}
+
+BOOST_AUTO_TEST_CASE(tps_jitter_report_of_run)
+{
+   constexpr uint32_t test_duration_s = 3;
+   constexpr uint32_t test_tps = 100;
+   constexpr uint32_t expected_trxs = test_duration_s * test_tps;
+
+   std::shared_ptr<mock_trx_generator> generator = std::make_shared<mock_trx_generator>(expected_trxs);
+   std::shared_ptr<simple_tps_monitor> monitor = std::make_shared<simple_tps_monitor>(expected_trxs);
+
+   trx_tps_tester<mock_trx_generator, simple_tps_monitor> t1(generator, monitor, {test_duration_s, test_tps});
+   t1.run();
+
+   BOOST_REQUIRE_EQUAL(t1._jitter_report._target_tps, test_tps);
+   BOOST_REQUIRE_EQUAL(t1._jitter_report._trxs_sent, expected_trxs);
+   BOOST_REQUIRE_GE(t1._jitter_report._windows, test_duration_s - 1);
+   BOOST_REQUIRE_LE(t1._jitter_report._min_window_tps, t1._jitter_report._max_window_tps);
+   BOOST_REQUIRE_GT(t1._jitter_report._achieved_tps, 0);
+}
+
+BOOST_AUTO_TEST_CASE(prepared_trx_ring_push_pop)
+{
+   prepared_trx_ring ring(2);
+   BOOST_REQUIRE(!ring.pop());
+
+   BOOST_REQUIRE(ring.push({chain::transaction_id_type(), "1"}));
+   BOOST_REQUIRE(ring.push({chain::transaction_id_type(), "2"}));
+   BOOST_REQUIRE(!ring.push({chain::transaction_id_type(), "3"}));
+   BOOST_REQUIRE_EQUAL(ring.size(), 2u);
+
+   BOOST_REQUIRE_EQUAL(ring.pop()->_payload, "1");
+   BOOST_REQUIRE(ring.push({chain::transaction_id_type(), "3"}));
+   BOOST_REQUIRE_EQUAL(ring.pop()->_payload, "2");
+   BOOST_REQUIRE_EQUAL(ring.pop()->_payload, "3");
+   BOOST_REQUIRE(!ring.pop());
+   BOOST_REQUIRE_EQUAL(ring.size(), 0u);
+
+   // a trx that does not fit is left to the caller
+   BOOST_REQUIRE(ring.push({chain::transaction_id_type(), "4"}));
+   BOOST_REQUIRE(ring.push({chain::transaction_id_type(), "5"}));
+   prepared_trx dropped{chain::transaction_id_type(), "6"};
+   BOOST_REQUIRE(!ring.push(std::move(dropped)));
+   BOOST_REQUIRE_EQUAL(dropped._payload, "6");
+}
+
+BOOST_AUTO_TEST_CASE(prepared_trx_ring_threads)
+{
+   constexpr uint32_t num_producers = 4;
+   constexpr uint32_t trxs_per_producer = 10000;
+   prepared_trx_ring ring(100);
+
+   std::vector<std::thread> producers;
+   for (uint32_t p = 0; p < num_producers; ++p) {
+      producers.emplace_back([&ring, p]() {
+         for (uint32_t i = 0; i < trxs_per_producer; ++i) {
+            const std::string payload = std::to_string(p * trxs_per_producer + i);
+            while (!ring.push({chain::transaction_id_type(), payload})) {
+               std::this_thread::yield();
+            }
+         }
+      });
+   }
+
+   std::vector<bool> received(num_producers * trxs_per_producer, false);
+   for (uint32_t n = 0; n < received.size();) {
+      if (auto trx = ring.pop()) {
+         const uint32_t i = std::stoul(trx->_payload);
+         BOOST_REQUIRE(!received.at(i));
+         received[i] = true;
+         ++n;
+      } else {
+         std::this_thread::yield();
+      }
+   }
+
+   for (auto& t : producers) {
+      t.join();
+   }
+   BOOST_REQUIRE(!ring.pop());
+}
+
+BOOST_AUTO_TEST_CASE(trx_provider_prepare_p2p)
+{
+   provider_base_config p_config{"p2p", "127.0.0.1", 9876};
+   trx_provider provider(p_config);
+
+   chain::signed_transaction trx;
+   trx.expiration = fc::time_point_sec{fc::time_point::now() + fc::seconds(3600)};
+   trx.actions.emplace_back(std::vector<chain::permission_level>{{chain::name("testacct1"), chain::config::active_name}},
+                            chain::name("eosio.token"), chain::name("transfer"), chain::bytes{'a', 'b', 'c'});
+   trx.sign(fc::crypto::private_key::generate(), chain::chain_id_type::empty_chain_id());
+
+   prepared_trx prepared = provider.prepare(trx);
+   BOOST_REQUIRE(prepared._trx_id == trx.id());
+
+   // net message: uint32_t payload size, net_message which of packed_transaction, packed_transaction
+   fc::datastream<const char*> ds(prepared._payload.data(), prepared._payload.size());
+   uint32_t payload_size = 0;
+   ds.read(reinterpret_cast<char*>(&payload_size), sizeof(payload_size));
+   BOOST_REQUIRE_EQUAL(payload_size, prepared._payload.size() - sizeof(payload_size));
+   fc::unsigned_int which;
+   fc::raw::unpack(ds, which);
+   BOOST_REQUIRE_EQUAL(which.value, 8u);
+   chain::packed_transaction pt;
+   fc::raw::unpack(ds, pt);
+   BOOST_REQUIRE(pt.id() == trx.id());
+   BOOST_REQUIRE_EQUAL(ds.remaining(), 0u);
+}
+
 BOOST_AUTO_TEST_CASE(trx_generator_constructor)
 {
    trx_generator_base_config tg_config{1, chain::chain_id_type("999"), chain::name("eosio"), fc::seconds(3600),
@@ -9,6 +9,9 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <eosio/chain/exceptions.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace eosio::testing {
    using namespace boost::asio;
    using namespace std::literals::string_literals;
@@ -17,7 +20,7 @@ namespace eosio::testing {
    constexpr auto message_header_size = sizeof(uint32_t);
    constexpr uint32_t packed_trx_which = 8; // this is the "which" for packed_transaction in the net_message variant
 
-   static send_buffer_type create_send_buffer( const chain::packed_transaction& m ) {
+   static std::string create_send_buffer( const chain::packed_transaction& m ) {
       const uint32_t which_size = fc::raw::pack_size(chain::unsigned_int(packed_trx_which));
       const uint32_t payload_size = which_size + fc::raw::pack_size( m );
       const size_t buffer_size = message_header_size + payload_size;
@@ -25,8 +28,8 @@ namespace eosio::testing {
       const char* const header = reinterpret_cast<const char* const>(&payload_size); // avoid variable size encoding of uint32_t
 
 
-      auto send_buffer = std::make_shared<std::vector<char>>(buffer_size);
-      fc::datastream<char*> ds( send_buffer->data(), buffer_size);
+      std::string send_buffer(buffer_size, '\0');
+      fc::datastream<char*> ds( send_buffer.data(), buffer_size);
       ds.write( header, message_header_size );
       fc::raw::pack( ds, fc::unsigned_int(packed_trx_which));
       fc::raw::pack( ds, m );
@@ -34,6 +37,10 @@ namespace eosio::testing {
       return send_buffer;
    }
 
+   void provider_connection::send_transaction(const chain::packed_transaction& trx) {
+      send_serialized_transaction(trx.id(), serialize_transaction(trx));
+   }
+
    void provider_connection::init_and_connect() {
       _connection_thread_pool.start(1,
                                     [&](const fc::exception &e) {
@@ -92,12 +99,14 @@ namespace eosio::testing {
       }
    }
 
-   void p2p_connection::send_transaction(const chain::packed_transaction& trx) {
-      send_buffer_type msg = create_send_buffer(trx);
+   std::string p2p_connection::serialize_transaction(const chain::packed_transaction& trx) const {
+      return create_send_buffer(trx);
+   }
 
+   void p2p_connection::send_serialized_transaction(const eosio::chain::transaction_id_type& trx_id, std::string&& payload) {
       ++_sent;
-      _strand.post( [this, msg{std::move(msg)}, id{trx.id()}]() {
-         boost::asio::write(_p2p_socket, boost::asio::buffer(*msg));
+      _strand.post( [this, msg{std::move(payload)}, id{trx_id}]() {
+         boost::asio::write(_p2p_socket, boost::asio::buffer(msg));
          trx_acknowledged(id, fc::time_point::min()); //using min to identify ack time as not applicable for p2p
          ++_sent_callback_num;
       } );
@@ -137,15 +146,17 @@ namespace eosio::testing {
       return _config._api_endpoint == "/v1/chain/send_read_only_transaction";
    }
 
-   void http_connection::send_transaction(const chain::packed_transaction& trx) {
+   std::string http_connection::serialize_transaction(const chain::packed_transaction& trx) const {
+      bool retry                = false;
+      bool tx_rtn_failure_trace = true;
+      auto to_send              = fc::mutable_variant_object()("return_failure_trace", tx_rtn_failure_trace)("retry_trx", retry)("transaction", trx);
+      return fc::json::to_string(to_send, fc::time_point::maximum());
+   }
+
+   void http_connection::send_serialized_transaction(const eosio::chain::transaction_id_type& trx_id, std::string&& payload) {
       const int         http_version = 11;
       const std::string content_type = "application/json"s;
 
-      bool        retry                = false;
-      bool        tx_rtn_failure_trace = true;
-      auto        to_send              = fc::mutable_variant_object()("return_failure_trace", tx_rtn_failure_trace)("retry_trx", retry)("transaction", trx);
-      std::string msg_body             = fc::json::to_string(to_send, fc::time_point::maximum());
-
       http_client_async::http_request_params params{_connection_thread_pool.get_executor(),
                                                     _config._peer_endpoint,
                                                     _config._port,
@@ -153,8 +164,8 @@ namespace eosio::testing {
                                                     http_version,
                                                     content_type};
       http_client_async::async_http_request(
-          params, std::move(msg_body),
-          [this, trx_id = trx.id()](boost::beast::error_code                                      ec,
+          params, std::move(payload),
+          [this, trx_id](boost::beast::error_code                                      ec,
                                     boost::beast::http::response<boost::beast::http::string_body> response) {
              trx_acknowledged(trx_id, fc::time_point::now());
              if (ec) {
@@ -247,10 +258,18 @@ namespace eosio::testing {
 
    void trx_provider::setup() { _peer_connection->init_and_connect(); }
 
-   void trx_provider::send(const chain::signed_transaction& trx) {
+   prepared_trx trx_provider::prepare(const chain::signed_transaction& trx) const {
       chain::packed_transaction pt(trx);
-      _peer_connection->send_transaction(pt);
-      _sent_trx_data.push_back(logged_trx_data(trx.id()));
+      return prepared_trx{pt.id(), _peer_connection->serialize_transaction(pt)};
+   }
+
+   void trx_provider::send(prepared_trx&& trx) {
+      _peer_connection->send_serialized_transaction(trx._trx_id, std::move(trx._payload));
+      _sent_trx_data.push_back(logged_trx_data(trx._trx_id));
+   }
+
+   void trx_provider::send(const chain::signed_transaction& trx) {
+      send(prepare(trx));
    }
 
    void trx_provider::log_trxs(const std::string& log_dir) {
@@ -285,6 +304,52 @@ namespace eosio::testing {
       _peer_connection->cleanup_and_disconnect();
    }
 
+   void tps_jitter_tracker::record_send(const fc::time_point& scheduled, const fc::time_point& sent) {
+      const size_t window = (sent - _start_time).count() / std::chrono::microseconds(1s).count();
+      if (window >= _window_trxs.size()) {
+         _window_trxs.resize(window + 1);
+      }
+      ++_window_trxs[window];
+      ++_trxs_sent;
+
+      const int64_t delay_us = (sent - scheduled).count();
+      if (delay_us > 0) {
+         ++_trxs_delayed;
+         _total_send_delay_us += delay_us;
+         _max_send_delay_us = std::max(_max_send_delay_us, delay_us);
+      }
+   }
+
+   tps_jitter_report tps_jitter_tracker::report(const fc::time_point& end_time) const {
+      tps_jitter_report r;
+      r._target_tps = _target_tps;
+      r._trxs_sent  = _trxs_sent;
+
+      const int64_t elapsed_us = (end_time - _start_time).count();
+      if (elapsed_us > 0) {
+         r._achieved_tps = _trxs_sent * double(std::chrono::microseconds(1s).count()) / elapsed_us;
+      }
+
+      r._windows = std::min<size_t>(elapsed_us / std::chrono::microseconds(1s).count(), _window_trxs.size());
+      if (r._windows) {
+         const auto windows_end = _window_trxs.begin() + r._windows;
+         r._min_window_tps = *std::min_element(_window_trxs.begin(), windows_end);
+         r._max_window_tps = *std::max_element(_window_trxs.begin(), windows_end);
+         double sum_squares = 0;
+         for (auto w = _window_trxs.begin(); w != windows_end; ++w) {
+            const double diff = double(*w) - _target_tps;
+            sum_squares += diff * diff;
+         }
+         r._window_tps_deviation = std::sqrt(sum_squares / r._windows);
+      }
+
+      if (_trxs_delayed) {
+         r._avg_send_delay_us = _total_send_delay_us / _trxs_delayed;
+      }
+      r._max_send_delay_us = _max_send_delay_us;
+      return r;
+   }
+
    bool tps_performance_monitor::monitor_test(const tps_test_stats &stats) {
       if ((!stats.expected_sent) || (stats.last_run - stats.start_time < _spin_up_time)) {
          return true;
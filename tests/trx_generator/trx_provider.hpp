@@ -16,7 +16,12 @@
 using namespace std::chrono_literals;
 
 namespace eosio::testing {
-   using send_buffer_type = std::shared_ptr<std::vector<char>>;
+
+   // transaction serialized for the connection it is sent on, ready to be written
+   struct prepared_trx {
+      eosio::chain::transaction_id_type _trx_id;
+      std::string                       _payload; // p2p message or http request body
+   };
 
    struct logged_trx_data {
       eosio::chain::transaction_id_type _trx_id;
@@ -74,8 +79,12 @@ namespace eosio::testing {
       fc::time_point get_trx_ack_time(const eosio::chain::transaction_id_type& trx_id);
       void trx_acknowledged(const eosio::chain::transaction_id_type& trx_id, const fc::time_point& ack_time);
 
+      void send_transaction(const chain::packed_transaction& trx);
+
       virtual acked_trx_trace_info get_acked_trx_trace_info(const eosio::chain::transaction_id_type& trx_id) = 0;
-      virtual void send_transaction(const chain::packed_transaction& trx) = 0;
+      /// thread safe
+      virtual std::string serialize_transaction(const chain::packed_transaction& trx) const = 0;
+      virtual void send_serialized_transaction(const eosio::chain::transaction_id_type& trx_id, std::string&& payload) = 0;
 
     private:
       virtual void connect()    = 0;
@@ -93,7 +102,8 @@ namespace eosio::testing {
       explicit http_connection(const provider_base_config& provider_config)
           : provider_connection(provider_config) {}
 
-      void send_transaction(const chain::packed_transaction& trx) final;
+      std::string serialize_transaction(const chain::packed_transaction& trx) const final;
+      void send_serialized_transaction(const eosio::chain::transaction_id_type& trx_id, std::string&& payload) final;
       void record_trx_info(const eosio::chain::transaction_id_type& trx_id, uint32_t block_num, uint32_t cpu_usage_us,
                            uint32_t net_usage_words, const std::string& block_time);
       acked_trx_trace_info get_acked_trx_trace_info(const eosio::chain::transaction_id_type& trx_id) override final;
@@ -117,7 +127,8 @@ namespace eosio::testing {
           , _p2p_socket(_connection_thread_pool.get_executor())
           , _strand(_connection_thread_pool.get_executor()){}
 
-      void send_transaction(const chain::packed_transaction& trx) final;
+      std::string serialize_transaction(const chain::packed_transaction& trx) const final;
+      void send_serialized_transaction(const eosio::chain::transaction_id_type& trx_id, std::string&& payload) final;
 
       acked_trx_trace_info get_acked_trx_trace_info(const eosio::chain::transaction_id_type& trx_id) override final;
 
@@ -130,6 +141,9 @@ namespace eosio::testing {
       explicit trx_provider(const provider_base_config& provider_config);
 
       void setup();
+      /// packs and serializes trx for the connection, thread safe
+      prepared_trx prepare(const chain::signed_transaction& trx) const;
+      void send(prepared_trx&& trx);
       void send(const chain::signed_transaction& trx);
       void log_trxs(const std::string& log_dir);
       void teardown();
@@ -153,6 +167,43 @@ namespace eosio::testing {
       uint32_t         expected_sent;
    };
 
+   struct tps_jitter_report {
+      uint32_t _target_tps           = 0;
+      uint32_t _trxs_sent            = 0;
+      double   _achieved_tps         = 0;
+      uint32_t _windows              = 0; // whole seconds of the run, partial last second excluded
+      uint32_t _min_window_tps       = 0;
+      uint32_t _max_window_tps       = 0;
+      double   _window_tps_deviation = 0; // root mean square of the difference between window and target tps
+      int64_t  _avg_send_delay_us    = 0; // of the transactions sent after their scheduled time
+      int64_t  _max_send_delay_us    = 0;
+
+      std::string to_string() const {
+         std::ostringstream ss;
+         ss << "TPS jitter: target tps: " << _target_tps << " trxs sent: " << _trxs_sent << " achieved tps: " << _achieved_tps
+            << " windows: " << _windows << " min window tps: " << _min_window_tps << " max window tps: " << _max_window_tps
+            << " window tps deviation: " << _window_tps_deviation << " avg send delay us: " << _avg_send_delay_us
+            << " max send delay us: " << _max_send_delay_us;
+         return ss.str();
+      }
+   };
+
+   // tracks the achieved versus the target tps, by one second windows, and how late transactions are sent
+   struct tps_jitter_tracker {
+      uint32_t              _target_tps;
+      fc::time_point        _start_time;
+      std::vector<uint32_t> _window_trxs;
+      uint32_t              _trxs_sent           = 0;
+      uint32_t              _trxs_delayed        = 0;
+      int64_t               _total_send_delay_us = 0;
+      int64_t               _max_send_delay_us   = 0;
+
+      tps_jitter_tracker(uint32_t target_tps, const fc::time_point& start_time) : _target_tps(target_tps), _start_time(start_time) {}
+
+      void record_send(const fc::time_point& scheduled, const fc::time_point& sent);
+      tps_jitter_report report(const fc::time_point& end_time) const;
+   };
+
    constexpr int64_t min_sleep_us                  = 1;
    constexpr int64_t default_spin_up_time_us       = std::chrono::microseconds(1s).count();
    constexpr uint32_t default_max_lag_per          = 5;
@@ -193,6 +244,7 @@ namespace eosio::testing {
       std::shared_ptr<G> _generator;
       std::shared_ptr<M> _monitor;
       trx_tps_tester_config _config;
+      tps_jitter_report _jitter_report;
 
       explicit trx_tps_tester(std::shared_ptr<G> generator, std::shared_ptr<M> monitor, const trx_tps_tester_config& tester_config) :
             _generator(generator), _monitor(monitor), _config(tester_config) {
@@ -217,13 +269,16 @@ namespace eosio::testing {
          stats.expected_end_time = stats.start_time + fc::microseconds{_config._gen_duration_seconds * std::chrono::microseconds(1s).count()};
          stats.time_to_next_trx_us = 0;
 
+         tps_jitter_tracker jitter(_config._target_tps, stats.start_time);
          bool keep_running = true;
 
          while (keep_running) {
             stats.last_run = fc::time_point::now();
+            const fc::time_point scheduled = stats.start_time + fc::microseconds(stats.trx_interval.count() * stats.trxs_sent);
             stats.next_run = stats.start_time + fc::microseconds(stats.trx_interval.count() * (stats.trxs_sent+1));
 
             if (_generator->generate_and_send()) {
+               jitter.record_send(scheduled, stats.last_run);
                stats.trxs_sent++;
             } else {
                elog("generator unable to create/send a transaction");
@@ -247,6 +302,9 @@ namespace eosio::testing {
             }
          }
 
+         _jitter_report = jitter.report(fc::time_point::now());
+         ilog("${r}", ("r", _jitter_report.to_string()));
+
          _generator->tear_down();
 
          return true;
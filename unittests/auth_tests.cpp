@@ -3,6 +3,7 @@
 #include <eosio/chain/abi_serializer.hpp>
 #include <eosio/chain/permission_object.hpp>
 #include <eosio/chain/authorization_manager.hpp>
+#include <eosio/chain/authorization_cache.hpp>
 
 #include <eosio/chain/resource_limits.hpp>
 #include <eosio/chain/resource_limits_private.hpp>
@@ -335,6 +336,57 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( link_then_update_auth, TESTER, validating_testers
 
 } FC_LOG_AND_RETHROW() }
 
+// cached authorization results must follow permission and link changes, also when the changes are undone
+BOOST_AUTO_TEST_CASE_TEMPLATE( authorization_cache_invalidation, TESTER, validating_testers ) { try {
+   TESTER chain;
+   const auto& cache = chain.control->get_authorization_manager().get_cache();
+
+   chain.create_account(name("alice"));
+   const auto first_priv_key = chain.get_private_key(name("alice"), "first");
+   const auto second_priv_key = chain.get_private_key(name("alice"), "second");
+   chain.set_authority(name("alice"), name("first"), authority{first_priv_key.get_public_key()}, name("active"));
+   chain.link_authority(name("alice"), name("eosio"), name("first"), name("reqauth"));
+   const uint32_t changed_block_num = chain.control->head().block_num() + 1;
+
+   // alice bypasses the cache until her changes are irreversible
+   const size_t authority_size = cache.authority_size();
+   const size_t link_size = cache.link_size();
+   chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key });
+   BOOST_TEST(cache.authority_size() == authority_size);
+   BOOST_TEST(cache.link_size() == link_size);
+   while( chain.last_irreversible_block_num() < changed_block_num )
+      chain.produce_block();
+   chain.produce_block();
+
+   chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key });
+   BOOST_TEST(cache.authority_size() == authority_size + 1);
+   BOOST_TEST(cache.link_size() == link_size + 1);
+   chain.produce_block();
+   // the cached result still reports the irrelevant signature
+   BOOST_CHECK_THROW(chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key, second_priv_key }),
+                     tx_irrelevant_sig);
+
+   // update within the same block, the cached result for the old key must not be used
+   chain.set_authority(name("alice"), name("first"), authority{second_priv_key.get_public_key()}, name("active"));
+   BOOST_CHECK_THROW(chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key }), unsatisfied_authorization);
+   chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { second_priv_key });
+
+   // undo the update, the result for the new key must not outlive it
+   chain.control->abort_block();
+   BOOST_CHECK_THROW(chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { second_priv_key }), unsatisfied_authorization);
+   chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key });
+   chain.produce_blocks(4);
+
+   // unlink, the cached link must not be used
+   chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key });
+   chain.produce_block();
+   chain.unlink_authority(name("alice"), name("eosio"), name("reqauth"));
+   BOOST_CHECK_THROW(chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key }), irrelevant_auth_exception);
+   chain.control->abort_block();
+   chain.push_reqauth(name("alice"), { permission_level{"alice"_n, name("first")} }, { first_priv_key });
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE_TEMPLATE( create_account, TESTER, validating_testers ) { try {
    TESTER chain;
    chain.create_account(name("joe"));
@@ -776,6 +776,38 @@ static const char memory_growth_memset_test[] = R"=====(
 )
 )=====";
 
+// action 0 writes to every OS page of 40 wasm pages, action 1 asserts the same 40 pages are all zero
+static const char memory_reset_many_pages_wast[] = R"=====(
+(module
+ (export "apply" (func $apply))
+ (import "env" "eosio_assert" (func $eosio_assert (param i32 i32)))
+ (memory $0 1)
+ (func $apply (param $0 i64)(param $1 i64)(param $2 i64)
+  (local $addr i32)
+  (drop (grow_memory (i32.const 39)))
+  (if (i64.eq (get_local $2) (i64.const 0)) (then
+    (block $done
+      (loop $dirty
+        (br_if $done (i32.ge_u (get_local $addr) (i32.const 2621440)))
+        (i64.store (get_local $addr) (i64.const -1))
+        (set_local $addr (i32.add (get_local $addr) (i32.const 4096)))
+        (br $dirty)
+      )
+    )
+    (return)
+  ))
+  (block $done
+    (loop $check
+      (br_if $done (i32.ge_u (get_local $addr) (i32.const 2621440)))
+      (call $eosio_assert (i64.eqz (i64.load (get_local $addr))) (i32.const 0))
+      (set_local $addr (i32.add (get_local $addr) (i32.const 8)))
+      (br $check)
+    )
+  )
+ )
+)
+)=====";
+
 static const char large_maligned_host_ptr[] = R"=====(
 (module
  (export "apply" (func $$apply))
@@ -0,0 +1,159 @@
+#include <eosio/chain/db_access_tracer.hpp>
+#include <eosio/testing/tester.hpp>
+
+#include <fc/io/cfile.hpp>
+#include <fc/variant_object.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <test_contracts.hpp>
+
+using namespace eosio;
+using namespace eosio::chain;
+using namespace eosio::testing;
+
+namespace {
+
+const db_access_table_stats* find_table( const db_access_block_summary& s, account_name code, table_name table ) {
+   for( const auto& t : s.tables )
+      if( t.code == code && t.table == table )
+         return &t;
+   return nullptr;
+}
+
+const db_access_account_stats* find_account( const db_access_block_summary& s, account_name receiver ) {
+   for( const auto& a : s.accounts )
+      if( a.receiver == receiver )
+         return &a;
+   return nullptr;
+}
+
+fc::variant_object row( name scope, uint64_t id ) {
+   return fc::mutable_variant_object()
+      ( "scope", scope )
+      ( "id", id )
+      ( "payload", fc::sha256::hash( std::to_string( id ) ) );
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(db_access_tracer_tests)
+
+BOOST_AUTO_TEST_CASE(bytes_bucket) {
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 0 ), 0u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 1 ), 1u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 2 ), 2u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 3 ), 2u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 40 ), 6u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 16383 ), 14u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( 16384 ), 15u );
+   BOOST_CHECK_EQUAL( db_access_table_stats::bytes_bucket( std::numeric_limits<uint32_t>::max() ),
+                      db_access_table_stats::num_bytes_buckets - 1 );
+}
+
+BOOST_AUTO_TEST_CASE(summarize) {
+   const vector<db_access> accesses{
+      { "alice"_n, "token"_n, "alice"_n, "accounts"_n, 1, db_index_type::i64, db_access_type::read,  16 },
+      { "alice"_n, "token"_n, "alice"_n, "accounts"_n, 1, db_index_type::i64, db_access_type::write, 16 },
+      { "alice"_n, "token"_n, "bob"_n,   "accounts"_n, 1, db_index_type::i64, db_access_type::write, 16 },
+      { "bob"_n,   "token"_n, "bob"_n,   "accounts"_n, 1, db_index_type::i64, db_access_type::read,   0 },
+      { "bob"_n,   "token"_n, "bob"_n,   "stat"_n,     7, db_index_type::idx64, db_access_type::read, 8 },
+   };
+   const auto s = db_access_tracer::summarize( accesses );
+
+   BOOST_REQUIRE_EQUAL( s.tables.size(), 2u );
+   const auto* accounts = find_table( s, "token"_n, "accounts"_n );
+   BOOST_REQUIRE( accounts );
+   BOOST_CHECK_EQUAL( accounts->reads, 2u );
+   BOOST_CHECK_EQUAL( accounts->writes, 2u );
+   BOOST_CHECK_EQUAL( accounts->read_bytes, 16u );
+   BOOST_CHECK_EQUAL( accounts->write_bytes, 32u );
+   BOOST_CHECK_EQUAL( accounts->scopes, 2u );
+   BOOST_CHECK_EQUAL( accounts->rows, 2u );
+   BOOST_CHECK_EQUAL( accounts->bytes_histogram[0], 1u );
+   BOOST_CHECK_EQUAL( accounts->bytes_histogram[5], 3u );
+
+   const auto* stat = find_table( s, "token"_n, "stat"_n );
+   BOOST_REQUIRE( stat );
+   BOOST_CHECK_EQUAL( stat->reads, 1u );
+   BOOST_CHECK_EQUAL( stat->writes, 0u );
+   BOOST_CHECK_EQUAL( stat->rows, 1u );
+
+   BOOST_REQUIRE_EQUAL( s.accounts.size(), 2u );
+   BOOST_CHECK( s.accounts[0].receiver == "alice"_n );
+   BOOST_CHECK_EQUAL( s.accounts[0].reads, 1u );
+   BOOST_CHECK_EQUAL( s.accounts[0].writes, 2u );
+   BOOST_CHECK_EQUAL( s.accounts[0].write_bytes, 32u );
+   BOOST_CHECK( s.accounts[1].receiver == "bob"_n );
+   BOOST_CHECK_EQUAL( s.accounts[1].reads, 2u );
+   BOOST_CHECK_EQUAL( s.accounts[1].read_bytes, 8u );
+}
+
+BOOST_AUTO_TEST_CASE(trace_blocks) try {
+   fc::temp_directory tempdir;
+   const auto dump_file = tempdir.path() / "db_access.bin";
+
+   tester chain;
+   chain.create_account( "snapshot"_n );
+   chain.set_code( "snapshot"_n, test_contracts::snapshot_test_wasm() );
+   chain.set_abi( "snapshot"_n, test_contracts::snapshot_test_abi() );
+   chain.produce_block();
+
+   db_access_tracer tracer( dump_file );
+   vector<db_access_block_summary> summaries;
+   tracer.register_summary_callback( [&]( const db_access_block_summary& s ) { summaries.push_back( s ); } );
+   chain.control->enable_db_access_tracing( &tracer );
+   BOOST_CHECK( chain.control->get_db_access_tracer( false ) == &tracer );
+   BOOST_CHECK( chain.control->get_db_access_tracer( true ) == nullptr );
+
+   // the pending block was started before tracing was enabled
+   chain.produce_block();
+   summaries.clear();
+
+   // id, 8 bytes, and payload, 32 bytes, per row
+   chain.push_action( "snapshot"_n, "add"_n, "snapshot"_n, row( "alice"_n, 1 ) );
+   chain.push_action( "snapshot"_n, "add"_n, "snapshot"_n, row( "bob"_n, 2 ) );
+   chain.push_action( "snapshot"_n, "verify"_n, "snapshot"_n, row( "alice"_n, 1 ) );
+   // failed transactions are not part of the block and not traced
+   BOOST_CHECK_THROW( chain.push_action( "snapshot"_n, "remove"_n, "snapshot"_n, fc::mutable_variant_object()
+                                         ( "scope", "carol"_n )( "id", 3 ) ),
+                      eosio_assert_message_exception );
+   auto block = chain.produce_block();
+
+   BOOST_REQUIRE_EQUAL( summaries.size(), 1u );
+   const auto& s = summaries.front();
+   BOOST_CHECK_EQUAL( s.block_num, block->block_num() );
+   BOOST_CHECK( s.block_id == block->calculate_id() );
+   BOOST_CHECK_GE( s.transactions, 3u );
+
+   const auto* test = find_table( s, "snapshot"_n, "test"_n );
+   BOOST_REQUIRE( test );
+   BOOST_CHECK_EQUAL( test->writes, 2u );
+   BOOST_CHECK_EQUAL( test->write_bytes, 80u );
+   BOOST_CHECK_GE( test->reads, 2u );
+   BOOST_CHECK_GE( test->read_bytes, 40u );
+   BOOST_CHECK_EQUAL( test->scopes, 2u );
+   BOOST_CHECK_EQUAL( test->rows, 2u );
+
+   const auto* receiver = find_account( s, "snapshot"_n );
+   BOOST_REQUIRE( receiver );
+   BOOST_CHECK_EQUAL( receiver->writes, 2u );
+
+   // secondary indices are traced too
+   chain.push_action( "snapshot"_n, "increment"_n, "snapshot"_n, fc::mutable_variant_object()( "value", 1 ) );
+   chain.produce_block();
+   BOOST_REQUIRE_EQUAL( summaries.size(), 2u );
+   const auto* data = find_table( summaries.back(), "snapshot"_n, "data"_n );
+   BOOST_REQUIRE( data );
+   BOOST_CHECK_GT( data->rows, 1u ); // primary and secondary index rows
+   BOOST_CHECK_GE( data->writes, 6u );
+
+   const auto dumped = db_access_tracer::read_dump_file( dump_file );
+   BOOST_REQUIRE_EQUAL( dumped.size(), 3u ); // including the block pending when tracing was enabled
+   BOOST_CHECK_EQUAL( dumped[1].block_num, s.block_num );
+   BOOST_CHECK( dumped[1].block_id == s.block_id );
+   BOOST_CHECK_EQUAL( dumped[1].tables.size(), s.tables.size() );
+   BOOST_CHECK_EQUAL( dumped[2].block_num, summaries.back().block_num );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
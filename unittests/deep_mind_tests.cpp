@@ -5,6 +5,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+
 #include <deep-mind.hpp>
 
 
@@ -48,9 +50,33 @@ struct deep_mind_log_fixture
 };
 
 // We only test deep-mind in Savanna
+// Same steps as setup_policy::full, but activates the protocol features recorded in deep-mind.log instead of every
+// builtin feature. Block ids, and so the whole log, change with the activated features; add a new feature to
+// logged_features when regenerating the log with --save-dmlog.
 struct deep_mind_tester : deep_mind_log_fixture, savanna_validating_tester
 {
-   deep_mind_tester() : savanna_validating_tester({}, &deep_mind_logger, setup_policy::full) {}
+   deep_mind_tester() : savanna_validating_tester({}, &deep_mind_logger, setup_policy::none) {
+      const auto& pfm = control->get_protocol_feature_manager();
+      schedule_protocol_features_wo_preactivation( { *pfm.get_builtin_digest(builtin_protocol_feature_t::preactivate_feature) } );
+      produce_block();
+      set_before_producer_authority_bios_contract();
+      preactivate_builtin_protocol_features( logged_features() );
+      produce_block();
+      set_bios_contract();
+      finalizer_keys fin_keys(*this, 1u /* num_keys */, 1u /* finset_size */);
+      fin_keys.activate_savanna(0u /* first_key_idx */);
+   }
+
+   // in the same order as setup_policy::full
+   static std::vector<builtin_protocol_feature_t> logged_features() {
+      std::vector<builtin_protocol_feature_t> features;
+      for( const auto& f : builtin_protocol_feature_codenames ) {
+         if( f.first != builtin_protocol_feature_t::bulk_db_iteration )
+            features.push_back( f.first );
+      }
+      std::sort( features.begin(), features.end() );
+      return features;
+   }
 };
 
 namespace {
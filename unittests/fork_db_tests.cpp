@@ -1,8 +1,16 @@
 #include <eosio/chain/types.hpp>
 #include <eosio/chain/fork_database.hpp>
+#include <eosio/chain/fork_database_journal.hpp>
 #include <eosio/testing/tester.hpp>
 #include <fc/bitutil.hpp>
+#include <fc/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <thread>
 
 
 namespace eosio::chain {
@@ -215,4 +223,340 @@ BOOST_FIXTURE_TEST_CASE(validated_block_exists, generate_fork_db_state) try {
 
 } FC_LOG_AND_RETHROW();
 
+// readers looking up blocks by id and head/root from other threads while the main thread adds blocks and advances root,
+// the way net, http and vote threads use the fork database. Readers must always see a consistent fork database and
+// lookup latency is reported to show readers are not held up by the writer.
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(concurrent_readers) try {
+   using namespace std::chrono;
+   constexpr size_t num_blocks  = 5000;
+   constexpr size_t lib_lag     = 20;
+   constexpr size_t num_readers = 4;
+
+   nonce = 0;
+   fork_database_if_t fork_db;
+   block_state_ptr root = test_block_state_accessor::make_genesis_block_state();
+   std::vector<block_state_ptr> blocks;
+   blocks.reserve(num_blocks);
+   for (size_t i = 0; i < num_blocks; ++i) {
+      blocks.push_back(test_block_state_accessor::make_unique_block_state(11 + i, i == 0 ? root : blocks.back()));
+      blocks.back()->set_valid(true);
+   }
+   fork_db.reset_root(root);
+
+   struct reader_stats {
+      uint64_t               lookups = 0;
+      uint64_t               found   = 0;
+      std::vector<uint64_t>  latency_ns;
+   };
+   std::vector<reader_stats> stats(num_readers);
+   std::atomic<bool> done{false};
+   std::atomic<bool> failed{false};
+
+   std::vector<std::thread> readers;
+   for (size_t r = 0; r < num_readers; ++r) {
+      readers.emplace_back([&, r]() {
+         auto& s = stats[r];
+         s.latency_ns.reserve(1'000'000);
+         uint32_t last_head = 0, last_root = 0;
+         uint64_t x = r + 1;
+         while (!done.load(std::memory_order_relaxed)) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            const auto& b = blocks[x % num_blocks];
+
+            auto start = steady_clock::now();
+            auto found  = fork_db.get_block(b->id());
+            auto head   = fork_db.head(include_root_t::yes);
+            auto rt     = fork_db.root();
+            auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+            if (s.latency_ns.size() < s.latency_ns.capacity())
+               s.latency_ns.push_back(elapsed);
+
+            ++s.lookups;
+            if (found)
+               ++s.found;
+            // blocks are only ever appended and root only advances, a reader never sees either go backwards
+            if ((found && found != b) || !head || !rt) {
+               failed = true;
+               continue;
+            }
+            if (head->block_num() < last_head || rt->block_num() < last_root)
+               failed = true;
+            last_head = head->block_num();
+            last_root = rt->block_num();
+         }
+      });
+   }
+
+   std::vector<uint64_t> write_ns;
+   write_ns.reserve(num_blocks);
+   for (size_t i = 0; i < num_blocks; ++i) {
+      auto start = steady_clock::now();
+      BOOST_REQUIRE((fork_db.add(blocks[i], ignore_duplicate_t::no) == fork_db_add_t::appended_to_head));
+      if (i >= lib_lag)
+         fork_db.advance_root(blocks[i - lib_lag]->id());
+      write_ns.push_back(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+   }
+   done = true;
+   for (auto& t : readers)
+      t.join();
+
+   BOOST_TEST(!failed);
+   BOOST_TEST(fork_db.head() == blocks.back());
+   BOOST_TEST(fork_db.root() == blocks[num_blocks - 1 - lib_lag]);
+   BOOST_TEST(fork_db.size() == lib_lag);
+   for (size_t i = 0; i < num_blocks; ++i)
+      BOOST_TEST(fork_db.block_exists(blocks[i]->id()) == (i >= num_blocks - lib_lag));
+
+   auto percentile = [](std::vector<uint64_t>& v, double p) -> uint64_t {
+      if (v.empty())
+         return 0;
+      auto n = std::min<size_t>(v.size() - 1, v.size() * p);
+      std::nth_element(v.begin(), v.begin() + n, v.end());
+      return v[n];
+   };
+   for (size_t r = 0; r < num_readers; ++r) {
+      auto& s = stats[r];
+      BOOST_TEST_MESSAGE("reader " << r << ": " << s.lookups << " lookups, " << s.found << " found, latency ns p50 "
+                         << percentile(s.latency_ns, 0.5) << " p99 " << percentile(s.latency_ns, 0.99)
+                         << " max " << percentile(s.latency_ns, 1.0));
+   }
+   BOOST_TEST_MESSAGE("writer: " << num_blocks << " add + advance_root, latency ns p50 " << percentile(write_ns, 0.5)
+                      << " p99 " << percentile(write_ns, 0.99) << " max " << percentile(write_ns, 1.0));
+} FC_LOG_AND_RETHROW();
+
+// a fork database that was never closed, as after a crash, is recovered from its journal
+// -------------------------------------------------------------
+BOOST_FIXTURE_TEST_CASE(journal_recovery, generate_fork_db_state) try {
+   fc::temp_directory tempdir;
+   const auto dir          = tempdir.path();
+   const auto journal_file = dir / config::fork_db_journal_filename;
+   const auto saved_file   = dir / "saved.journal";
+   validator_t validator   = [](block_timestamp_type, const flat_set<digest_type>&, const vector<digest_type>&) {};
+
+   for (auto& b : all)
+      b->set_valid(true);
+
+   {
+      fork_database fdb(dir, true);
+      fdb.open(validator);
+      fdb.switch_to(fork_database::in_use_t::savanna);
+      fdb.apply_s<void>([&](auto& fdb_s) {
+         fdb_s.reset_root(root);
+         for (auto& b : all)
+            fdb_s.add(b, ignore_duplicate_t::no);
+         fdb_s.advance_root(bsp11b->id());
+         fdb_s.remove(bsp12bb->id());
+         fdb_s.set_pending_savanna_lib_id(bsp12b->id());
+      });
+      fdb.flush_journal();
+      BOOST_REQUIRE(std::filesystem::exists(journal_file));
+      std::filesystem::copy_file(journal_file, saved_file);
+   }
+   // closed cleanly, fork_db.dat replaces the journal
+   BOOST_TEST(std::filesystem::exists(dir / config::fork_db_filename));
+   BOOST_TEST(!std::filesystem::exists(journal_file));
+
+   // crash: no fork_db.dat, journal ends with a partially written record
+   std::filesystem::remove(dir / config::fork_db_filename);
+   std::filesystem::copy_file(saved_file, journal_file);
+   {
+      std::ofstream out(journal_file, std::ios::binary | std::ios::app);
+      out.write("\x40\x00\x00\x00\x01\x02\x03\x04\x05\x06", 10);
+   }
+
+   fork_database fdb(dir, true);
+   fdb.open(validator);
+   BOOST_TEST((fdb.version_in_use() == fork_database::in_use_t::savanna));
+   fdb.apply_s<void>([&](auto& fdb_s) {
+      BOOST_TEST(fdb_s.root()->id() == bsp11b->id());
+      BOOST_TEST(fdb_s.root()->is_valid());
+      BOOST_TEST(fdb_s.head()->id() == bsp14b->id());
+      BOOST_TEST(fdb_s.pending_savanna_lib_id() == bsp12b->id());
+      // only 12b, 13b, 14b and 12bbb build on 11b once 12bb and its descendants are removed
+      BOOST_TEST(fdb_s.size() == 4u);
+      BOOST_TEST(!fdb_s.block_exists(bsp12bb->id()));
+      BOOST_TEST(!fdb_s.block_exists(bsp13bb->id()));
+      BOOST_TEST(!fdb_s.block_exists(bsp11a->id()));
+      for (auto& b : {bsp12b, bsp13b, bsp14b}) {
+         auto recovered = fdb_s.get_block(b->id());
+         BOOST_REQUIRE(recovered);
+         BOOST_TEST(recovered->previous() == b->previous());
+         BOOST_TEST(recovered->timestamp() == b->timestamp());
+         BOOST_TEST(recovered->strong_digest == b->strong_digest);
+      }
+   });
+   // recovered state is journaled again
+   fdb.flush_journal();
+   BOOST_TEST(std::filesystem::exists(journal_file));
+} FC_LOG_AND_RETHROW();
+
+// a journal whose last record was torn by a crash is recovered up to the last complete record
+// -------------------------------------------------------------
+BOOST_FIXTURE_TEST_CASE(journal_recovery_torn_record, generate_fork_db_state) try {
+   fc::temp_directory tempdir;
+   const auto dir          = tempdir.path();
+   const auto journal_file = dir / config::fork_db_journal_filename;
+   const auto saved_file   = dir / "saved.journal";
+   validator_t validator   = [](block_timestamp_type, const flat_set<digest_type>&, const vector<digest_type>&) {};
+
+   for (auto& b : all)
+      b->set_valid(true);
+
+   block_id_type lib_before_last_record;
+   {
+      fork_database fdb(dir, true);
+      fdb.open(validator);
+      fdb.switch_to(fork_database::in_use_t::savanna);
+      fdb.apply_s<void>([&](auto& fdb_s) {
+         fdb_s.reset_root(root);
+         for (auto& b : all)
+            fdb_s.add(b, ignore_duplicate_t::no);
+         fdb_s.advance_root(bsp11b->id());
+         lib_before_last_record = fdb_s.pending_savanna_lib_id();
+         // last record: frame header (size, crc32) and payload (op, savanna, id)
+         BOOST_REQUIRE(fdb_s.set_pending_savanna_lib_id(bsp12b->id()));
+      });
+      fdb.flush_journal();
+      std::filesystem::copy_file(journal_file, saved_file);
+   }
+   const auto journal_size = std::filesystem::file_size(saved_file);
+   constexpr uint64_t last_record_size = 2 * sizeof(uint32_t) + 2 + sizeof(block_id_type);
+
+   auto flip_last_byte = [&]() {
+      std::fstream f(journal_file, std::ios::binary | std::ios::in | std::ios::out);
+      f.seekg(journal_size - 1);
+      char c = 0;
+      f.read(&c, 1);
+      c ^= 0x5a;
+      f.seekp(journal_size - 1);
+      f.write(&c, 1);
+   };
+
+   const std::vector<std::pair<std::string, std::function<void()>>> tears = {
+      {"torn payload",           [&]() { std::filesystem::resize_file(journal_file, journal_size - 10); }},
+      {"torn frame header",      [&]() { std::filesystem::resize_file(journal_file, journal_size - last_record_size + 4); }},
+      {"payload crc mismatch",   flip_last_byte}
+   };
+   for (const auto& [desc, tear] : tears) {
+      BOOST_TEST_CONTEXT(desc) {
+         std::filesystem::remove(dir / config::fork_db_filename);
+         std::filesystem::remove(journal_file);
+         std::filesystem::copy_file(saved_file, journal_file);
+         tear();
+
+         fork_database fdb(dir, true);
+         BOOST_REQUIRE_NO_THROW(fdb.open(validator));
+         BOOST_TEST((fdb.version_in_use() == fork_database::in_use_t::savanna));
+         fdb.apply_s<void>([&](auto& fdb_s) {
+            BOOST_TEST(fdb_s.root()->id() == bsp11b->id());
+            BOOST_TEST(fdb_s.head()->id() == bsp14b->id());
+            BOOST_TEST(fdb_s.block_exists(bsp13bb->id()));
+            // the torn record is not applied
+            BOOST_TEST(fdb_s.pending_savanna_lib_id() == lib_before_last_record);
+         });
+      }
+   }
+} FC_LOG_AND_RETHROW();
+
+// the journal is rewritten from the current state so it does not grow without bound
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(journal_compaction) try {
+   constexpr size_t num_blocks = 500;
+   constexpr size_t lib_lag    = 5;
+   fc::temp_directory tempdir;
+   const auto journal_file = tempdir.path() / config::fork_db_journal_filename;
+
+   nonce = 0;
+   block_state_ptr root = test_block_state_accessor::make_genesis_block_state();
+   std::vector<block_state_ptr> blocks;
+   for (size_t i = 0; i < num_blocks; ++i) {
+      blocks.push_back(test_block_state_accessor::make_unique_block_state(11 + i, i == 0 ? root : blocks.back()));
+      blocks.back()->set_valid(true);
+   }
+
+   fork_database_if_t fork_db;
+   fork_db.reset_root(root);
+   {
+      fork_database_journal journal(journal_file, 1);
+      journal.open([&]() { fork_db.set_journal(&journal); });
+      for (size_t i = 0; i < num_blocks; ++i) {
+         fork_db.add(blocks[i], ignore_duplicate_t::no);
+         if (i >= lib_lag)
+            fork_db.advance_root(blocks[i - lib_lag]->id());
+      }
+      fork_db.set_journal(nullptr);
+      journal.close();
+   }
+
+   fork_database_if_t recovered;
+   size_t num_records = fork_database_journal::read(journal_file, [&](fork_database_journal::record&& r) {
+      if (r.op == fork_database_journal::op_t::in_use)
+         return;
+      BOOST_REQUIRE(r.savanna);
+      switch (r.op) {
+         case fork_database_journal::op_t::reset_root:   recovered.reset_root(r.bsp_s); break;
+         case fork_database_journal::op_t::add:          recovered.add(r.bsp_s, ignore_duplicate_t::no); break;
+         case fork_database_journal::op_t::advance_root: recovered.advance_root(r.id); break;
+         default: BOOST_FAIL("unexpected journal record");
+      }
+   });
+   BOOST_TEST(num_records < 4 * (lib_lag + 2)); // one add and one advance_root per block without compaction
+   BOOST_TEST(recovered.root()->id() == fork_db.root()->id());
+   BOOST_TEST(recovered.head()->id() == fork_db.head()->id());
+   BOOST_TEST(recovered.size() == lib_lag);
+} FC_LOG_AND_RETHROW();
+
+// a node restarted after a crash recovers its reversible blocks from the journal
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(journal_tester_restart) try {
+   fc::temp_directory tempdir;
+   eosio::testing::tester chain(tempdir, [](controller::config& cfg) { cfg.fork_db_journal = true; }, true);
+   chain.execute_setup_policy(eosio::testing::setup_policy::full);
+   chain.produce_blocks(10);
+
+   const auto head = chain.control->fork_db_head();
+   const auto root = chain.control->fork_db_root();
+   BOOST_REQUIRE(root.block_num() < head.block_num());
+
+   const auto journal_file = chain.get_config().blocks_dir / config::reversible_blocks_dir_name / config::fork_db_journal_filename;
+   const auto saved_file   = tempdir.path() / "saved.journal";
+
+   // records are written by the journal thread, wait for it to catch up with the fork database
+   auto journaled = [&]() {
+      block_id_type journal_head, journal_root;
+      if (!std::filesystem::exists(journal_file))
+         return false;
+      fork_database_journal::read(journal_file, [&](fork_database_journal::record&& r) {
+         if (r.op == fork_database_journal::op_t::add && r.savanna)
+            journal_head = r.bsp_s->id();
+         else if (r.op == fork_database_journal::op_t::reset_root && r.savanna)
+            journal_root = r.bsp_s->id();
+         else if (r.op == fork_database_journal::op_t::advance_root && r.savanna)
+            journal_root = r.id;
+      });
+      return journal_head == head.id() && journal_root == root.id();
+   };
+   const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+   while (!journaled() && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   BOOST_REQUIRE(journaled());
+   std::filesystem::copy_file(journal_file, saved_file);
+
+   chain.close();
+   // crash: fork_db.dat was never written, the journal is left in place
+   const auto fork_db_file = chain.get_config().blocks_dir / config::reversible_blocks_dir_name / config::fork_db_filename;
+   BOOST_REQUIRE(std::filesystem::exists(fork_db_file));
+   std::filesystem::remove(fork_db_file);
+   std::filesystem::copy_file(saved_file, journal_file);
+
+   chain.open();
+   BOOST_TEST(chain.control->fork_db_head().id() == head.id());
+   BOOST_TEST(chain.control->fork_db_root().id() == root.id());
+   for (auto num = root.block_num() + 1; num <= head.block_num(); ++num)
+      BOOST_TEST(chain.control->fetch_block_by_number(num));
+   chain.produce_blocks(2);
+   BOOST_TEST(chain.control->fork_db_head().block_num() == head.block_num() + 2);
+} FC_LOG_AND_RETHROW();
+
 BOOST_AUTO_TEST_SUITE_END()
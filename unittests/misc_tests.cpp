@@ -3,6 +3,8 @@
 #include <eosio/chain/authority_checker.hpp>
 #include <eosio/chain/types.hpp>
 #include <eosio/chain/thread_utils.hpp>
+#include <eosio/chain/recovered_key_cache.hpp>
+#include <eosio/chain/transaction_view.hpp>
 #include <eosio/testing/tester.hpp>
 
 #include <fc/io/json.hpp>
@@ -12,6 +14,10 @@
 
 #include <thread>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include <boost/test/unit_test.hpp>
 
 using namespace eosio::chain;
@@ -771,16 +777,25 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( transaction_test, T, validating_testers ) { try {
    BOOST_CHECK_EQUAL(pkt.get_signed_transaction().id(), pkt2.id());
 
    flat_set<public_key_type> keys;
+   auto& key_cache = recovered_key_cache::instance();
+   key_cache.clear();
+   const auto stats0 = key_cache.get_stats();
    auto cpu_time1 = pkt.get_signed_transaction().get_signature_keys(test.get_chain_id(), fc::time_point::maximum(), keys);
    BOOST_CHECK_EQUAL(1u, keys.size());
    BOOST_CHECK_EQUAL(public_key, *keys.begin());
+   BOOST_CHECK(cpu_time1 > fc::microseconds(0));
+   const auto stats1 = key_cache.get_stats();
+   BOOST_CHECK_EQUAL(stats1.misses - stats0.misses, 1u);
+   BOOST_CHECK_EQUAL(stats1.hits - stats0.hits, 0u);
+
+   // second recovery served by the recovered key cache
    keys.clear();
-   auto cpu_time2 = pkt.get_signed_transaction().get_signature_keys(test.get_chain_id(), fc::time_point::maximum(), keys);
+   pkt.get_signed_transaction().get_signature_keys(test.get_chain_id(), fc::time_point::maximum(), keys);
    BOOST_CHECK_EQUAL(1u, keys.size());
    BOOST_CHECK_EQUAL(public_key, *keys.begin());
-
-   BOOST_CHECK(cpu_time1 > fc::microseconds(0));
-   BOOST_CHECK(cpu_time2 > fc::microseconds(0));
+   const auto stats2 = key_cache.get_stats();
+   BOOST_CHECK_EQUAL(stats2.misses - stats1.misses, 0u);
+   BOOST_CHECK_EQUAL(stats2.hits - stats1.hits, 1u);
 
    // pack
    uint32_t pack_size = fc::raw::pack_size( pkt );
@@ -1272,6 +1287,83 @@ BOOST_AUTO_TEST_CASE(named_thread_pool_test) {
    }
 }
 
+BOOST_AUTO_TEST_CASE(thread_cpu_affinity_test) {
+   BOOST_TEST( (parse_cpu_list("0-3,8,10-11") == std::vector<uint32_t>{0, 1, 2, 3, 8, 10, 11}) );
+   BOOST_TEST( (parse_cpu_list(" 5 ") == std::vector<uint32_t>{5}) );
+   BOOST_CHECK_THROW( parse_cpu_list("3-1"), fc::exception );
+   BOOST_CHECK_THROW( parse_cpu_list("1,,2"), fc::exception );
+   BOOST_CHECK_THROW( parse_cpu_list("a"), fc::exception );
+
+#ifdef __linux__
+   // pin to the first cpu this process is allowed to run on
+   cpu_set_t allowed;
+   BOOST_REQUIRE( pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) == 0 );
+   uint32_t cpu = 0;
+   while( !CPU_ISSET(cpu, &allowed) )
+      ++cpu;
+
+   set_thread_pool_cpu_affinity( "affin", {cpu} );
+   named_thread_pool<struct affin> thread_pool;
+   thread_pool.start( 2, {} );
+   std::vector<std::future<int>> cpus;
+   for( size_t i = 0; i < 4; ++i ) {
+      auto p = std::make_shared<std::promise<int>>();
+      cpus.emplace_back( p->get_future() );
+      boost::asio::post( thread_pool.get_executor(), [p](){ p->set_value( sched_getcpu() ); } );
+   }
+   for( auto& f : cpus )
+      BOOST_TEST( f.get() == static_cast<int>(cpu) );
+   thread_pool.stop();
+   set_thread_pool_cpu_affinity( "affin", {} );
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(thread_cpu_affinity_main_pinned_test) {
+#ifdef __linux__
+   const auto allowed = get_current_thread_cpu_affinity();
+   BOOST_REQUIRE( !allowed.empty() );
+   if( allowed.size() < 2 ) {
+      BOOST_TEST_MESSAGE( "thread_cpu_affinity_main_pinned_test needs at least 2 cpus, skipped" );
+      return;
+   }
+
+   auto pool_cpus = [](auto& thread_pool) {
+      auto p = std::make_shared<std::promise<std::vector<uint32_t>>>();
+      auto f = p->get_future();
+      boost::asio::post( thread_pool.get_executor(), [p](){ p->set_value( get_current_thread_cpu_affinity() ); } );
+      return f.get();
+   };
+
+   // run on a thread standing in for main, so the affinity of the test thread is left as is; checked after the join
+   std::vector<uint32_t> main_cpus, unpinned_cpus, pinned_cpus;
+   std::thread main_thread( [&]() {
+      set_default_cpu_affinity( get_current_thread_cpu_affinity() );
+      set_current_thread_cpu_affinity( {allowed.front()} );
+      main_cpus = get_current_thread_cpu_affinity();
+
+      // a pool without cpus of its own runs on the cpus of the process, not of the pinned main thread
+      named_thread_pool<struct unpin> unpinned;
+      unpinned.start( 1, {} );
+      unpinned_cpus = pool_cpus( unpinned );
+      unpinned.stop();
+
+      // a pool with cpus of its own is still pinned to them
+      set_thread_pool_cpu_affinity( "pinned", {allowed.back()} );
+      named_thread_pool<struct pinned> pinned;
+      pinned.start( 1, {} );
+      pinned_cpus = pool_cpus( pinned );
+      pinned.stop();
+      set_thread_pool_cpu_affinity( "pinned", {} );
+   } );
+   main_thread.join();
+   set_default_cpu_affinity( {} );
+
+   BOOST_TEST( (main_cpus == std::vector<uint32_t>{allowed.front()}) );
+   BOOST_TEST( unpinned_cpus == allowed );
+   BOOST_TEST( (pinned_cpus == std::vector<uint32_t>{allowed.back()}) );
+#endif
+}
+
 BOOST_AUTO_TEST_CASE(public_key_from_hash) {
    auto private_key_string = std::string("5KQwrPbwdL6PhXujxW37FSSQZ1JiwsST4cqQzDeyXtP79zkvFD3");
    auto expected_public_key = std::string("EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV");
@@ -1292,6 +1384,137 @@ BOOST_AUTO_TEST_CASE(public_key_from_hash) {
    ilog( "public key with no known private key: ${k}", ("k", eos_unknown_pk) );
 }
 
+BOOST_AUTO_TEST_CASE(recovered_key_cache_test) {
+   constexpr uint32_t max_entries = 4 * recovered_key_cache::num_shards;
+   auto k1_key = fc::crypto::private_key::generate();
+   auto r1_key = fc::crypto::private_key::generate_r1();
+
+   std::vector<std::pair<digest_type, signature_type>> sigs;
+   for( uint32_t i = 0; i < max_entries * 4; ++i ) {
+      auto digest = digest_type::hash( std::to_string(i) );
+      sigs.emplace_back( digest, (i % 2 ? k1_key : r1_key).sign( digest ) );
+   }
+
+   recovered_key_cache cache( max_entries );
+   for( uint32_t i = 0; i < 4; ++i ) {
+      const auto& [digest, sig] = sigs[i];
+      BOOST_CHECK_EQUAL( cache.recover( sig, digest ), public_key_type( sig, digest ) );
+   }
+   auto stats = cache.get_stats();
+   BOOST_CHECK_EQUAL( stats.hits, 0u );
+   BOOST_CHECK_EQUAL( stats.misses, 4u );
+   BOOST_CHECK_EQUAL( stats.entries, 4u );
+
+   for( uint32_t i = 0; i < 4; ++i ) {
+      const auto& [digest, sig] = sigs[i];
+      BOOST_CHECK_EQUAL( cache.recover( sig, digest ), (i % 2 ? k1_key : r1_key).get_public_key() );
+   }
+   stats = cache.get_stats();
+   BOOST_CHECK_EQUAL( stats.hits, 4u );
+   BOOST_CHECK_EQUAL( stats.misses, 4u );
+   BOOST_CHECK_EQUAL( stats.hit_ratio(), 0.5 );
+
+   // same signature of a different digest, e.g. on another chain, is not a hit
+   BOOST_CHECK( cache.recover( sigs[1].second, sigs[0].first ) != k1_key.get_public_key() );
+   BOOST_CHECK_EQUAL( cache.get_stats().misses, 5u );
+
+   // another signature of the same digest is not a hit
+   BOOST_CHECK_EQUAL( cache.recover( k1_key.sign( sigs[0].first ), sigs[0].first ), k1_key.get_public_key() );
+   BOOST_CHECK_EQUAL( cache.get_stats().misses, 6u );
+
+   // bounded
+   for( const auto& [digest, sig] : sigs )
+      cache.recover( sig, digest );
+   BOOST_CHECK_LE( cache.get_stats().entries, max_entries );
+
+   cache.set_max_entries( recovered_key_cache::num_shards );
+   BOOST_CHECK_LE( cache.get_stats().entries, recovered_key_cache::num_shards );
+
+   // disabled
+   cache.set_max_entries( 0 );
+   BOOST_CHECK_EQUAL( cache.get_stats().entries, 0u );
+   stats = cache.get_stats();
+   BOOST_CHECK_EQUAL( cache.recover( sigs[0].second, sigs[0].first ), r1_key.get_public_key() );
+   BOOST_CHECK_EQUAL( cache.get_stats().hits, stats.hits );
+   BOOST_CHECK_EQUAL( cache.get_stats().misses, stats.misses );
+}
+
+BOOST_AUTO_TEST_CASE(packed_transaction_view_test) { try {
+   const chain_id_type chain_id( fc::sha256::hash( std::string("packed_transaction_view_test") ).str() );
+   auto priv = fc::crypto::private_key::generate();
+
+   signed_transaction trx;
+   trx.expiration          = fc::time_point_sec{1000};
+   trx.ref_block_num       = 7;
+   trx.ref_block_prefix    = 11;
+   trx.max_net_usage_words = 300;
+   trx.context_free_actions.emplace_back( vector<permission_level>{}, "eosio"_n, "nonce"_n, fc::raw::pack( std::string("cfa") ) );
+   trx.actions.emplace_back( vector<permission_level>{{"alice"_n, config::active_name}, {"bob"_n, config::owner_name}},
+                             "eosio.token"_n, "transfer"_n, bytes( 200, 'x' ) );
+   trx.context_free_data.emplace_back( bytes( 10, 'c' ) );
+   trx.sign( priv, chain_id );
+
+   // unpacked as received over p2p or in a block, not materialized
+   auto lazy = fc::raw::unpack<packed_transaction>( fc::raw::pack( packed_transaction( trx ) ) );
+   BOOST_CHECK( !lazy.is_materialized() );
+   BOOST_CHECK_EQUAL( lazy.id(), trx.id() );
+   BOOST_CHECK( lazy.expiration() == trx.expiration );
+   BOOST_CHECK_EQUAL( lazy.get_header().max_net_usage_words.value, trx.max_net_usage_words.value );
+   BOOST_CHECK( lazy.first_authorizer() == "alice"_n );
+   BOOST_CHECK_EQUAL( lazy.sig_digest( chain_id ), trx.sig_digest( chain_id, trx.context_free_data ) );
+   flat_set<public_key_type> keys;
+   lazy.get_signature_keys( chain_id, fc::time_point::maximum(), keys );
+   BOOST_REQUIRE_EQUAL( keys.size(), 1u );
+   BOOST_CHECK_EQUAL( *keys.begin(), priv.get_public_key() );
+   BOOST_CHECK( !lazy.is_materialized() );
+
+   const bytes& packed_trx = lazy.get_packed_transaction();
+   auto view = transaction_view::parse( packed_trx.data(), packed_trx.size() );
+   BOOST_REQUIRE( view );
+   BOOST_CHECK_EQUAL( view->packed().size(), packed_trx.size() );
+   BOOST_CHECK_EQUAL( view->context_free_actions_size(), 1u );
+   BOOST_CHECK_EQUAL( view->actions_size(), 1u );
+   view->for_each_action( [&]( const action_view& a ) {
+      BOOST_CHECK( a.account == "eosio.token"_n );
+      BOOST_CHECK( a.name == "transfer"_n );
+      BOOST_REQUIRE_EQUAL( a.authorization_size, 2u );
+      BOOST_CHECK( a.authorization( 1 ) == (permission_level{"bob"_n, config::owner_name}) );
+      BOOST_CHECK_EQUAL( a.data.size(), 200u );
+      BOOST_CHECK( fc::raw::pack( a.materialize() ) == fc::raw::pack( trx.actions[0] ) );
+   } );
+   BOOST_CHECK( fc::raw::pack( view->materialize() ) == fc::raw::pack( static_cast<const transaction&>(trx) ) );
+
+   BOOST_CHECK( fc::raw::pack( lazy.get_signed_transaction() ) == fc::raw::pack( trx ) );
+   BOOST_CHECK( lazy.is_materialized() );
+   packed_transaction copy( lazy );
+   BOOST_CHECK( &copy.get_signed_transaction() == &lazy.get_signed_transaction() );
+
+   // context free data must be exactly one canonically encoded vector<bytes>
+   bytes cfd = fc::raw::pack( trx.context_free_data );
+   BOOST_CHECK_EQUAL( *parse_context_free_data( cfd.data(), cfd.size() ), 1u );
+   cfd.push_back( 0 );
+   BOOST_CHECK( !parse_context_free_data( cfd.data(), cfd.size() ) );
+
+   // an empty extensions size encoded non-canonically unpacks to the same transaction, its id is of the canonical encoding
+   transaction empty;
+   empty.expiration = fc::time_point_sec{1000};
+   bytes non_canonical = fc::raw::pack( empty );
+   BOOST_REQUIRE_EQUAL( non_canonical.back(), 0 );
+   non_canonical.back() = char(0x80);
+   non_canonical.push_back( 0 );
+   BOOST_CHECK( !transaction_view::parse( non_canonical.data(), non_canonical.size() ) );
+   packed_transaction eager( bytes( non_canonical ), vector<signature_type>(), bytes(), packed_transaction::compression_type::none );
+   BOOST_CHECK( eager.is_materialized() );
+   BOOST_CHECK_EQUAL( eager.id(), empty.id() );
+   BOOST_CHECK( eager.expiration() == empty.expiration );
+
+   // malformed transactions still fail on construction
+   bytes truncated( packed_trx.begin(), packed_trx.end() - 1 );
+   BOOST_CHECK( !transaction_view::parse( truncated.data(), truncated.size() ) );
+   BOOST_CHECK_THROW( packed_transaction( std::move( truncated ), vector<signature_type>(), bytes(), packed_transaction::compression_type::none ),
+                      fc::exception );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace eosio
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <sstream>
+#include <fstream>
 
 #include <eosio/chain/block_log.hpp>
 #include <eosio/chain/global_property_object.hpp>
@@ -627,4 +629,133 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( test_blocklog_split_then_merge, T, eosio::testing
    BOOST_CHECK(std::filesystem::exists(dest_dir.path() / "blocks-101-150.index"));
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_blocklog_compress_retained, T, eosio::testing::testers ) {
+
+   T chain;
+   chain.produce_blocks(160);
+   chain.close();
+
+   auto               blocks_dir   = chain.get_config().blocks_dir;
+   auto               retained_dir = blocks_dir / "retained";
+   fc::temp_directory orig_dir;
+
+   BOOST_REQUIRE_NO_THROW(eosio::chain::block_log::split_blocklog(blocks_dir, retained_dir, 50));
+   std::filesystem::remove(blocks_dir / "blocks.log");
+   std::filesystem::remove(blocks_dir / "blocks.index");
+   std::filesystem::copy(retained_dir, orig_dir.path());
+
+   uint32_t                       head_block_num = 0;
+   std::vector<std::vector<char>> serialized_blocks;
+   {
+      eosio::chain::block_log blog(blocks_dir, eosio::chain::partitioned_blocklog_config{ .retained_dir = retained_dir });
+      head_block_num = blog.head()->block_num();
+      for (uint32_t i = 1; i <= head_block_num; ++i)
+         serialized_blocks.push_back(blog.read_serialized_block_by_num(i));
+   }
+
+   // frames do not line up with the stride
+   BOOST_CHECK_EQUAL(eosio::chain::block_log::compress_blocklogs(retained_dir, 7, false), 4u);
+   BOOST_CHECK(std::filesystem::exists(retained_dir / "blocks-1-50.zlog"));
+   BOOST_CHECK(std::filesystem::exists(retained_dir / "blocks-51-100.zlog"));
+   BOOST_CHECK(std::filesystem::exists(retained_dir / "blocks-101-150.zlog"));
+   BOOST_CHECK(!std::filesystem::exists(retained_dir / "blocks-1-50.log"));
+   BOOST_CHECK(!std::filesystem::exists(retained_dir / "blocks-1-50.index"));
+
+   BOOST_CHECK(eosio::chain::block_log::extract_genesis_state(blocks_dir, retained_dir));
+
+   {
+      eosio::chain::block_log blog(blocks_dir, eosio::chain::partitioned_blocklog_config{ .retained_dir = retained_dir });
+      BOOST_REQUIRE_EQUAL(blog.head()->block_num(), head_block_num);
+      BOOST_CHECK_EQUAL(blog.first_block_num(), 1u);
+      // read out of order so that frames and files are switched
+      for (uint32_t i : { 150u, 1u, 7u, 8u, 51u, 100u, 99u, 101u, head_block_num, 50u }) {
+         BOOST_TEST(blog.read_serialized_block_by_num(i) == serialized_blocks[i - 1]);
+         BOOST_CHECK_EQUAL(blog.read_block_by_num(i)->block_num(), i);
+         BOOST_CHECK_EQUAL(blog.read_block_header_by_num(i)->block_num(), i);
+      }
+      for (uint32_t i = 1; i <= head_block_num; ++i)
+         BOOST_TEST(blog.read_serialized_block_by_num(i) == serialized_blocks[i - 1]);
+      BOOST_CHECK(!blog.read_block_by_num(head_block_num + 1));
+   }
+
+   // restores the original files byte for byte
+   BOOST_CHECK_EQUAL(eosio::chain::block_log::decompress_blocklogs(retained_dir, false), 4u);
+   for (const auto& entry : std::filesystem::directory_iterator(orig_dir.path())) {
+      auto restored = retained_dir / entry.path().filename();
+      BOOST_REQUIRE(std::filesystem::exists(restored));
+      std::ifstream a(entry.path(), std::ios::binary), b(restored, std::ios::binary);
+      BOOST_TEST(std::string(std::istreambuf_iterator<char>(a), {}) == std::string(std::istreambuf_iterator<char>(b), {}));
+   }
+   BOOST_CHECK(!std::filesystem::exists(retained_dir / "blocks-1-50.zlog"));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_blocklog_parallel_index, T, eosio::testing::testers ) {
+
+   T chain;
+   chain.produce_blocks(160);
+   chain.close();
+
+   auto blocks_dir = chain.get_config().blocks_dir;
+   auto read_file  = [](const std::filesystem::path& p) {
+      std::ifstream f(p, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(f), {});
+   };
+
+   fc::temp_directory temp_dir;
+   BOOST_REQUIRE_NO_THROW(eosio::chain::block_log::construct_index(blocks_dir / "blocks.log", temp_dir.path() / "blocks.index", 4));
+   BOOST_TEST(read_file(temp_dir.path() / "blocks.index") == read_file(blocks_dir / "blocks.index"));
+
+   BOOST_CHECK_NO_THROW(eosio::chain::block_log::full_smoke_test(blocks_dir, 4));
+
+   // an index entry pointing at the wrong block is detected
+   std::string index = read_file(blocks_dir / "blocks.index");
+   std::swap_ranges(index.begin() + 8 * 50, index.begin() + 8 * 51, index.begin() + 8 * 51);
+   std::ofstream(blocks_dir / "blocks.index", std::ios::binary | std::ios::trunc) << index;
+   BOOST_CHECK_THROW(eosio::chain::block_log::full_smoke_test(blocks_dir, 4), eosio::chain::block_log_exception);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_blocklog_parallel_index_chunks, T, eosio::testing::testers ) {
+
+   T chain;
+   chain.produce_blocks(160);
+   chain.close();
+
+   auto blocks_dir = chain.get_config().blocks_dir;
+   auto read_file  = [](const std::filesystem::path& p) {
+      std::ifstream f(p, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(f), {});
+   };
+   const std::string expected = read_file(blocks_dir / "blocks.index");
+   std::vector<uint64_t> positions(expected.size() / sizeof(uint64_t));
+   memcpy(positions.data(), expected.data(), expected.size());
+   const uint64_t log_size = std::filesystem::file_size(blocks_dir / "blocks.log");
+
+   struct restore_min_chunk_size {
+      ~restore_min_chunk_size() { eosio::chain::block_log::set_parallel_index_min_chunk_size(16 * 1024 * 1024); }
+   } restore;
+
+   // chunk sizes smaller than, close to and larger than a block entry, none aligned to entries
+   for (uint64_t min_chunk_size : {37u, 211u, 1009u, 2003u}) {
+      for (uint32_t threads : {2u, 16u}) {
+         BOOST_TEST_CONTEXT("min chunk size " << min_chunk_size << ", " << threads << " threads") {
+            // same split as parallel_block_log_scan
+            const uint64_t chunk_size = std::max<uint64_t>((log_size - positions.front()) / (threads * 8ull) + 1, min_chunk_size);
+            size_t num_boundaries = 0, num_straddling = 0;
+            for (uint64_t b = positions.front() + chunk_size; b < log_size; b += chunk_size) {
+               ++num_boundaries;
+               if (!std::binary_search(positions.begin(), positions.end(), b))
+                  ++num_straddling;
+            }
+            BOOST_REQUIRE_GT(num_boundaries, 2u);
+            BOOST_REQUIRE_GT(num_straddling, 0u);
+
+            eosio::chain::block_log::set_parallel_index_min_chunk_size(min_chunk_size);
+            fc::temp_directory temp_dir;
+            BOOST_REQUIRE_NO_THROW(eosio::chain::block_log::construct_index(blocks_dir / "blocks.log", temp_dir.path() / "blocks.index", threads));
+            BOOST_TEST(read_file(temp_dir.path() / "blocks.index") == expected);
+         }
+      }
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2316,4 +2316,107 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(set_finalizers_test, T, testers) { try {
                        c.error("alice does not have permission to call this API"));
 } FC_LOG_AND_RETHROW() }
 
+// stores a row keyed by the action name, then calls db_get_rows_i64 with the end iterator of the table plus the int32
+// offset of the action data, which must return the iterator unchanged and no rows
+static const char bulk_db_end_iterator_wast[] = R"=====(
+(module
+   (import "env" "eosio_assert" (func $eosio_assert (param i32 i32)))
+   (import "env" "read_action_data" (func $read_action_data (param i32 i32) (result i32)))
+   (import "env" "db_store_i64" (func $db_store_i64 (param i64 i64 i64 i64 i32 i32) (result i32)))
+   (import "env" "db_end_i64" (func $db_end_i64 (param i64 i64 i64) (result i32)))
+   (import "env" "db_get_rows_i64" (func $db_get_rows_i64 (param i32 i32 i32 i32) (result i32)))
+   (memory 1)
+   (data (i32.const 32) "not an end iterator\00")
+   (data (i32.const 64) "iterator changed\00")
+   (data (i32.const 96) "rows past the end\00")
+   (export "apply" (func $apply))
+   (func $apply (param $receiver i64) (param $account i64) (param $action_name i64)
+      (local $end i32)
+      (drop (call $read_action_data (i32.const 0) (i32.const 4)))
+      (drop (call $db_store_i64 (get_local $receiver) (i64.const 0) (get_local $receiver) (get_local $action_name) (i32.const 0) (i32.const 0)))
+      (set_local $end (call $db_end_i64 (get_local $receiver) (get_local $receiver) (i64.const 0)))
+      (call $eosio_assert (i32.lt_s (get_local $end) (i32.const -1)) (i32.const 32))
+      (i32.store (i32.const 16) (i32.const -1))
+      (call $eosio_assert (i32.eq (call $db_get_rows_i64 (i32.add (get_local $end) (i32.load (i32.const 0))) (i32.const 1) (i32.const 16) (i32.const 16))
+                                  (get_local $end))
+                          (i32.const 64))
+      (call $eosio_assert (i32.eqz (i32.load (i32.const 16))) (i32.const 96))
+   )
+)
+)=====";
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(bulk_db_iteration_end_iterator_test, T, testers) { try {
+   T c( setup_policy::preactivate_feature_and_new_bios );
+
+   const auto& pfm = c.control->get_protocol_feature_manager();
+   const auto& d = pfm.get_builtin_digest(builtin_protocol_feature_t::bulk_db_iteration);
+   BOOST_REQUIRE(d);
+   c.preactivate_protocol_features( {*d} );
+   c.produce_block();
+
+   c.create_account("bob"_n);
+   c.set_code("bob"_n, bulk_db_end_iterator_wast);
+   c.produce_block();
+
+   auto push = [&](action_name name, int32_t offset) {
+      signed_transaction trx;
+      trx.actions.emplace_back(vector<permission_level>{{"bob"_n, config::active_name}}, "bob"_n, name, fc::raw::pack(offset));
+      c.set_transaction_headers(trx);
+      trx.sign(c.get_private_key("bob"_n, "active"), c.get_chain_id());
+      return c.push_transaction(trx);
+   };
+
+   // a real end iterator reads no rows and is returned as is
+   push("valid"_n, 0);
+
+   // a negative handle that is not the end iterator of any table is rejected rather than returned
+   BOOST_CHECK_EXCEPTION( push("bogus"_n, -100), invalid_table_iterator, fc_exception_message_is( "not a valid end iterator" ) );
+   BOOST_CHECK_EXCEPTION( push("farend"_n, std::numeric_limits<int32_t>::min() / 2), invalid_table_iterator,
+                          fc_exception_message_is( "not a valid end iterator" ) );
+   c.produce_block();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(bulk_db_iteration_test, T, testers) { try {
+   T c( setup_policy::preactivate_feature_and_new_bios );
+
+   const auto& pfm = c.control->get_protocol_feature_manager();
+   const auto& d = pfm.get_builtin_digest(builtin_protocol_feature_t::bulk_db_iteration);
+   BOOST_REQUIRE(d);
+
+   const auto alice_account = account_name("alice");
+   c.create_accounts( {alice_account} );
+   c.produce_block();
+
+   BOOST_CHECK_EXCEPTION( c.set_code( alice_account, test_contracts::bulk_db_test_wasm() ),
+                          wasm_exception,
+                          fc_exception_message_is( "env.db_get_rows_i64 unresolveable" ) );
+
+   c.preactivate_protocol_features( {*d} );
+   c.produce_block();
+
+   // ensure it now resolves
+   c.set_code( alice_account, test_contracts::bulk_db_test_wasm() );
+   c.set_abi( alice_account, test_contracts::bulk_db_test_abi() );
+   c.produce_block();
+
+   c.push_action( alice_account, "store"_n, alice_account, mutable_variant_object()("first", 0)("count", 100)("size", 10) );
+   c.push_action( alice_account, "store"_n, alice_account, mutable_variant_object()("first", 1000)("count", 20)("size", 0) );
+   c.push_action( alice_account, "scan"_n, alice_account, mutable_variant_object()("expected", 120) );
+
+   // rows read one at a time, in batches, all at once
+   for( uint32_t max_rows : { 1u, 7u, 100u, 1000u } ) {
+      c.push_action( alice_account, "bulkscan"_n, alice_account, mutable_variant_object()("expected", 120)("max_rows", max_rows) );
+   }
+   BOOST_CHECK_EXCEPTION( c.push_action( alice_account, "bulkscan"_n, alice_account, mutable_variant_object()("expected", 120)("max_rows", 0) ),
+                          eosio_assert_message_exception, eosio_assert_message_is( "row does not fit in the buffer" ) );
+   c.produce_block();
+
+   // rows of 64KiB fit the buffer of the contract but not with the row count and row header
+   c.push_action( alice_account, "store"_n, alice_account, mutable_variant_object()("first", 2000)("count", 1)("size", 65536) );
+   c.push_action( alice_account, "scan"_n, alice_account, mutable_variant_object()("expected", 121) );
+   BOOST_CHECK_EXCEPTION( c.push_action( alice_account, "bulkscan"_n, alice_account, mutable_variant_object()("expected", 121)("max_rows", 1000) ),
+                          eosio_assert_message_exception, eosio_assert_message_is( "row does not fit in the buffer" ) );
+   c.produce_block();
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
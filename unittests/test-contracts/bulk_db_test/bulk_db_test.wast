@@ -0,0 +1,100 @@
+(module
+   (import "env" "require_auth" (func $require_auth (param i64)))
+   (import "env" "eosio_assert" (func $eosio_assert (param i32 i32)))
+   (import "env" "read_action_data" (func $read_action_data (param i32 i32) (result i32)))
+   (import "env" "db_store_i64" (func $db_store_i64 (param i64 i64 i64 i64 i32 i32) (result i32)))
+   (import "env" "db_lowerbound_i64" (func $db_lowerbound_i64 (param i64 i64 i64 i64) (result i32)))
+   (import "env" "db_get_i64" (func $db_get_i64 (param i32 i32 i32) (result i32)))
+   (import "env" "db_next_i64" (func $db_next_i64 (param i32 i32) (result i32)))
+   (import "env" "db_get_rows_i64" (func $db_get_rows_i64 (param i32 i32 i32 i32) (result i32)))
+
+   ;; 0: action data, 16: primary key of db_next_i64, 32: messages, 65536: 64KiB row buffer
+   (memory 2)
+   (data (i32.const 32) "unexpected number of rows\00")
+   (data (i32.const 64) "row does not fit in the buffer\00")
+   (data (i32.const 96) "rows out of order\00")
+   (data (i32.const 128) "row too large\00")
+   (export "apply" (func $apply))
+
+   ;; store(uint64_t first, uint32_t count, uint32_t size): stores rows first to first + count - 1 of size bytes in the rows table
+   (func $store (param $receiver i64)
+      (local $id i64) (local $end i64) (local $size i32)
+      (call $require_auth (get_local $receiver))
+      (drop (call $read_action_data (i32.const 0) (i32.const 16)))
+      (set_local $id (i64.load (i32.const 0)))
+      (set_local $end (i64.add (get_local $id) (i64.extend_u/i32 (i32.load (i32.const 8)))))
+      (set_local $size (i32.load (i32.const 12)))
+      (call $eosio_assert (i32.le_u (get_local $size) (i32.const 65536)) (i32.const 128))
+      (block $done
+         (loop $next
+            (br_if $done (i64.ge_u (get_local $id) (get_local $end)))
+            (drop (call $db_store_i64 (get_local $receiver) (i64.const 0xbd39800000000000) (get_local $receiver) (get_local $id) (i32.const 65536) (get_local $size)))
+            (set_local $id (i64.add (get_local $id) (i64.const 1)))
+            (br $next)
+         )
+      )
+   )
+
+   ;; scan(uint32_t expected): reads the rows table with a db_get_i64 and db_next_i64 call per row
+   (func $scan (param $receiver i64)
+      (local $itr i32) (local $rows i32)
+      (drop (call $read_action_data (i32.const 0) (i32.const 4)))
+      (set_local $itr (call $db_lowerbound_i64 (get_local $receiver) (get_local $receiver) (i64.const 0xbd39800000000000) (i64.const 0)))
+      (block $done
+         (loop $next
+            (br_if $done (i32.lt_s (get_local $itr) (i32.const 0)))
+            (drop (call $db_get_i64 (get_local $itr) (i32.const 65536) (i32.const 65536)))
+            (set_local $rows (i32.add (get_local $rows) (i32.const 1)))
+            (set_local $itr (call $db_next_i64 (get_local $itr) (i32.const 16)))
+            (br $next)
+         )
+      )
+      (call $eosio_assert (i32.eq (get_local $rows) (i32.load (i32.const 0))) (i32.const 32))
+   )
+
+   ;; bulkscan(uint32_t expected, uint32_t max_rows): reads the rows table with a db_get_rows_i64 call per max_rows rows,
+   ;; checking that the primary keys of the rows read are increasing
+   (func $bulkscan (param $receiver i64)
+      (local $itr i32) (local $rows i32) (local $n i32) (local $p i32) (local $id i64) (local $last i64)
+      (drop (call $read_action_data (i32.const 0) (i32.const 8)))
+      (set_local $itr (call $db_lowerbound_i64 (get_local $receiver) (get_local $receiver) (i64.const 0xbd39800000000000) (i64.const 0)))
+      (block $done
+         (loop $next
+            (br_if $done (i32.lt_s (get_local $itr) (i32.const 0)))
+            (set_local $itr (call $db_get_rows_i64 (get_local $itr) (i32.load (i32.const 4)) (i32.const 65536) (i32.const 65536)))
+            (set_local $n (i32.load (i32.const 65536)))
+            (call $eosio_assert (i32.ne (get_local $n) (i32.const 0)) (i32.const 64))
+            (set_local $p (i32.const 65540))
+            (block $rows_done
+               (loop $next_row
+                  (br_if $rows_done (i32.eqz (get_local $n)))
+                  (set_local $id (i64.load (get_local $p)))
+                  (call $eosio_assert (i32.or (i32.eqz (get_local $rows)) (i64.gt_u (get_local $id) (get_local $last))) (i32.const 96))
+                  (set_local $last (get_local $id))
+                  (set_local $p (i32.add (get_local $p) (i32.add (i32.const 12) (i32.load offset=8 (get_local $p)))))
+                  (set_local $rows (i32.add (get_local $rows) (i32.const 1)))
+                  (set_local $n (i32.sub (get_local $n) (i32.const 1)))
+                  (br $next_row)
+               )
+            )
+            (br $next)
+         )
+      )
+      (call $eosio_assert (i32.eq (get_local $rows) (i32.load (i32.const 0))) (i32.const 32))
+   )
+
+   (func $apply (param $receiver i64) (param $account i64) (param $action_name i64)
+      (if (i64.ne (get_local $receiver) (get_local $account))
+         (return)
+      )
+      (if (i64.eq (get_local $action_name) (i64.const 0xc669750000000000)) ;; store
+         (call $store (get_local $receiver))
+      )
+      (if (i64.eq (get_local $action_name) (i64.const 0xc20d300000000000)) ;; scan
+         (call $scan (get_local $receiver))
+      )
+      (if (i64.eq (get_local $action_name) (i64.const 0x3ea30c20d3000000)) ;; bulkscan
+         (call $bulkscan (get_local $receiver))
+      )
+   )
+)
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <array>
+#include <thread>
 #include <utility>
 
 #include <eosio/chain/abi_serializer.hpp>
@@ -7,6 +9,10 @@
 #include <eosio/chain/resource_limits.hpp>
 #include <eosio/chain/wasm_eosio_constraints.hpp>
 #include <eosio/chain/wast_to_wasm.hpp>
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+#include <eosio/chain/webassembly/eos-vm-oc/memory.hpp>
+#include <sys/mman.h>
+#endif
 #include <eosio/testing/tester.hpp>
 
 #include <Inline/Serialization.h>
@@ -158,6 +164,59 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( prove_mem_reset, T, validating_testers ) try {
 
 } FC_LOG_AND_RETHROW() /// prove_mem_reset
 
+/**
+ * Prove the contracts used before a shutdown are instantiated in the background on restart when wasm_warm_cache_size
+ * is configured, and report the latency of the first action after the restart with and without the warm cache
+ */
+BOOST_AUTO_TEST_CASE( warm_cache_restart ) try {
+   // @return the time taken by the first action pushed after a restart
+   auto first_action_after_restart = [](uint32_t warm_cache_size) {
+      fc::temp_directory tempdir;
+      auto [cfg, genesis] = tester::default_config(tempdir);
+      cfg.wasm_warm_cache_size = warm_cache_size;
+      // codes compiled by eos-vm-oc tier-up are not warmed
+      cfg.eosvmoc_tierup = wasm_interface::vm_oc_enable::oc_none;
+      tester chain(cfg, genesis);
+
+      chain.create_accounts( {"asserter"_n} );
+      chain.set_code("asserter"_n, test_contracts::asserter_wasm());
+      chain.produce_block();
+
+      auto push_assert = [&]() {
+         signed_transaction trx;
+         trx.actions.emplace_back( vector<permission_level>{{"asserter"_n,config::active_name}},
+                                   assertdef {1, "Should Not Assert!"} );
+         chain.set_transaction_headers(trx);
+         trx.sign( chain.get_private_key( "asserter"_n, "active" ), chain.get_chain_id() );
+         auto start = fc::time_point::now();
+         chain.push_transaction( trx );
+         auto elapsed = fc::time_point::now() - start;
+         chain.produce_block();
+         return elapsed;
+      };
+
+      push_assert();
+      BOOST_TEST( chain.is_code_cached("asserter"_n) );
+
+      chain.close();
+      BOOST_TEST( std::filesystem::exists(cfg.state_dir / config::wasm_warm_code_filename) == (warm_cache_size > 0) );
+
+      chain.open();
+      // eos-vm-oc keeps its own code cache on disk, it is not warmed
+      const bool warmed = warm_cache_size > 0 && cfg.wasm_runtime != wasm_interface::vm_type::eos_vm_oc;
+      for (int i = 0; warmed && i < 1000 && !chain.is_code_cached("asserter"_n); ++i)
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      BOOST_TEST( chain.is_code_cached("asserter"_n) == warmed );
+      return push_assert();
+   };
+
+   // timings are reported rather than compared, they depend on the host and the runtime
+   const auto cold = first_action_after_restart(0);
+   const auto warm = first_action_after_restart(10);
+   BOOST_TEST_MESSAGE("first action after restart: " << cold.count() << "us without warm cache, "
+                      << warm.count() << "us with warm cache");
+} FC_LOG_AND_RETHROW() /// warm_cache_restart
+
 /**
  * Prove the modifications to global variables are wiped between runs
  */
@@ -1558,6 +1617,52 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( mem_growth_memset, T, validating_testers ) try {
    }
 } FC_LOG_AND_RETHROW()
 
+// linear memory is reset after each action, more than memory::max_memset_reset_pages are discarded rather than cleared
+BOOST_AUTO_TEST_CASE_TEMPLATE( mem_reset_many_pages, T, validating_testers ) try {
+   T chain;
+
+   chain.create_accounts( {"resetter"_n} );
+   chain.set_code("resetter"_n, memory_reset_many_pages_wast);
+   chain.produce_block();
+
+   auto push_actions = [&](std::vector<name> action_names) {
+      signed_transaction trx;
+      for (auto n : action_names)
+         trx.actions.emplace_back(vector<permission_level>{{"resetter"_n,config::active_name}}, "resetter"_n, n, bytes{});
+      chain.set_transaction_headers(trx);
+      trx.sign(chain.get_private_key( "resetter"_n, "active" ), chain.get_chain_id());
+      chain.push_transaction(trx);
+   };
+
+   // dirtied and checked by consecutive actions of the same transaction, and of separate transactions
+   push_actions({name(0), name(1)});
+   push_actions({name(0)});
+   push_actions({name(1)});
+   chain.produce_block();
+} FC_LOG_AND_RETHROW()
+
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+// the pages backed by the memory slices are discarded with MADV_REMOVE, those past them with MADV_DONTNEED
+BOOST_AUTO_TEST_CASE( eosvmoc_reset_linear_memory ) try {
+   constexpr uint64_t page_size = wasm_constraints::wasm_page_size;
+   constexpr uint64_t pages     = eosvmoc::memory::sliced_pages_for_ro_thread + eosvmoc::memory::max_memset_reset_pages;
+   eosvmoc::memory mem(eosvmoc::memory::sliced_pages_for_ro_thread);
+
+   // pages past the slices are only made accessible on demand, as the executor does when memory grows past them
+   uint8_t* const base = mem.full_page_memory_base();
+   BOOST_REQUIRE(mprotect(base + eosvmoc::memory::sliced_pages_for_ro_thread * page_size,
+                          (pages - eosvmoc::memory::sliced_pages_for_ro_thread) * page_size, PROT_READ | PROT_WRITE) == 0);
+
+   for (uint64_t reset_pages : {eosvmoc::memory::max_memset_reset_pages, pages}) {
+      BOOST_TEST_CONTEXT("reset " << reset_pages << " pages") {
+         memset(base, 0xff, reset_pages * page_size);
+         mem.reset_linear_memory(reset_pages);
+         BOOST_TEST(std::all_of(base, base + reset_pages * page_size, [](uint8_t b) { return b == 0; }));
+      }
+   }
+} FC_LOG_AND_RETHROW()
+#endif
+
 INCBIN(fuzz1, "fuzz1.wasm");
 INCBIN(fuzz2, "fuzz2.wasm");
 INCBIN(fuzz3, "fuzz3.wasm");